@@ -53,8 +53,9 @@ struct SimConfigData {
   bool mUniformField = false;                 // uniform magnetic field
   bool mAsService = false;                    // if simulation should be run as service/deamon (does not exit after run)
   bool mNoGeant = false;                      // if Geant transport should be turned off (when one is only interested in the generated events)
+  bool mFlatKinematics = false;               // if the kinematics is also written as memory-mappable flat file
 
-  ClassDefNV(SimConfigData, 4);
+  ClassDefNV(SimConfigData, 5);
 };
 
 // A singleton class which can be used
@@ -120,6 +121,7 @@ class SimConfig
   bool asService() const { return mConfigData.mAsService; }
   uint64_t getTimestamp() const { return mConfigData.mTimestamp; }
   bool isNoGeant() const { return mConfigData.mNoGeant; }
+  bool writeFlatKinematics() const { return mConfigData.mFlatKinematics; }
 
  private:
   SimConfigData mConfigData; //!
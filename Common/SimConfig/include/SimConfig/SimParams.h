@@ -35,6 +35,8 @@ struct SimCutParams : public o2::conf::ConfigurableParamHelper<SimCutParams> {
 
   float globalDensityFactor = 1.f; // global factor that scales all material densities for systematic studies
 
+  bool stepProfiling = false; // count the steps and the time spent in the stepping per module (O2MCApplication), reported for each event
+
   O2ParamDef(SimCutParams, "SimCutParams");
 };
 
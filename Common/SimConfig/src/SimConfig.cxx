@@ -54,7 +54,8 @@ void SimConfig::initOptions(boost::program_options::options_description& options
     "CCDBUrl", bpo::value<std::string>()->default_value("ccdb-test.cern.ch:8080"), "URL for CCDB to be used.")(
     "timestamp", bpo::value<uint64_t>(), "global timestamp value in ms (for anchoring) - default is now")(
     "asservice", bpo::value<bool>()->default_value(false), "run in service/server mode")(
-    "noGeant", bpo::bool_switch(), "prohibits any Geant transport/physics (by using tight cuts)");
+    "noGeant", bpo::bool_switch(), "prohibits any Geant transport/physics (by using tight cuts)")(
+    "flatKinematics", bpo::bool_switch(), "also write the kinematics to a memory-mappable flat file, for fast MC track lookups");
 }
 
 bool SimConfig::resetFromParsedMap(boost::program_options::variables_map const& vm)
@@ -170,6 +171,7 @@ bool SimConfig::resetFromParsedMap(boost::program_options::variables_map const&
   mConfigData.mCCDBUrl = vm["CCDBUrl"].as<std::string>();
   mConfigData.mAsService = vm["asservice"].as<bool>();
   mConfigData.mNoGeant = vm["noGeant"].as<bool>();
+  mConfigData.mFlatKinematics = vm["flatKinematics"].as<bool>();
   if (vm.count("noemptyevents")) {
     mConfigData.mFilterNoHitEvents = true;
   }
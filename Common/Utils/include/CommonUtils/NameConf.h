@@ -48,6 +48,12 @@ class NameConf : public o2::conf::ConfigurableParamHelper<NameConf>
     return o2::utils::Str::concat_string(prefix, "_", KINE_STRING, ".root");
   }
 
+  // Filename of the memory-mappable flat copy of the kinematics (optional)
+  static std::string getMCKinematicsFlatFileName(const std::string_view prefix = STANDARDSIMPREFIX)
+  {
+    return o2::utils::Str::concat_string(prefix, "_", KINE_STRING, ".flat");
+  }
+
   // Filename to store kinematics + TrackRefs
   static std::string getMCHeadersFileName(const std::string_view prefix = STANDARDSIMPREFIX)
   {
@@ -20,6 +20,8 @@
 #include <cassert>
 #include <type_traits>
 #include <cstddef>
+#include <cmath>
+#include <algorithm>
 #include <Rtypes.h>
 #include "rANS/rans.h"
 #include "rANS/utils.h"
@@ -55,6 +57,8 @@ using namespace o2::rans;
 constexpr size_t Alignment = 16;
 
 constexpr int WrappersSplitLevel = 99;
+constexpr size_t PackingRANSOverhead = 16;  // approximate size in bytes of the rANS coder state flushed with every block
+constexpr double PackingMaxSizeLoss = 0.02; // fixed width packing is preferred to rANS if its size is larger by at most this fraction
 constexpr int WrappersCompressionLevel = 1;
 
 /// This is the type of the vector to be used for the EncodedBlocks buffer allocation
@@ -91,13 +95,94 @@ inline size_t calculatePaddedSize(size_t nElems) noexcept
   return (sizeOfDestT / sizeOfSourceT) * calculateNDestTElements<source_T, dest_T>(nElems);
 };
 
+/// number of bits needed to store values in the range [0, range]
+inline int calculatePackingBits(uint64_t range) noexcept
+{
+  int nbits = 0;
+  while (range >> nbits) {
+    nbits++;
+  }
+  return nbits;
+}
+
+/// number of W words needed to store nElems values of nbits each
+template <typename W>
+inline size_t calculateNPackedWords(size_t nElems, int nbits) noexcept
+{
+  constexpr size_t WBits = sizeof(W) * 8;
+  return (nElems * nbits + WBits - 1) / WBits;
+}
+
+/// store the values of [srcBegin, srcEnd) shifted by -offset as consecutive nbits wide fields (nbits <= 32)
+/// @return number of W words written
+template <typename input_IT, typename W>
+size_t packBits(const input_IT srcBegin, const input_IT srcEnd, int64_t offset, int nbits, W* dest) noexcept
+{
+  constexpr int WBits = sizeof(W) * 8;
+  static_assert(WBits <= 32, "packing needs storage words of at most 32 bits");
+  W* out = dest;
+  if (nbits == 0) {
+    return 0;
+  }
+  uint64_t acc = 0; // pending bits, never more than WBits - 1 + 32 of them
+  int nacc = 0;
+  for (auto it = srcBegin; it != srcEnd; ++it) {
+    acc |= uint64_t(int64_t(*it) - offset) << nacc;
+    nacc += nbits;
+    while (nacc >= WBits) {
+      *out++ = W(acc);
+      acc >>= WBits;
+      nacc -= WBits;
+    }
+  }
+  if (nacc) {
+    *out++ = W(acc);
+  }
+  return out - dest;
+}
+
+/// inverse of packBits: extract nElems values of nbits each from src and shift them by offset
+template <typename D_IT, typename W>
+void unpackBits(const W* src, size_t nElems, int64_t offset, int nbits, D_IT dest) noexcept
+{
+  constexpr int WBits = sizeof(W) * 8;
+  using dest_t = typename std::iterator_traits<D_IT>::value_type;
+  if (nbits == 0) {
+    std::fill_n(dest, nElems, dest_t(offset));
+    return;
+  }
+  const uint64_t mask = (uint64_t(1) << nbits) - 1;
+  uint64_t acc = 0;
+  int nacc = 0;
+  for (size_t i = 0; i < nElems; i++) {
+    while (nacc < nbits) {
+      acc |= uint64_t(*src++) << nacc;
+      nacc += WBits;
+    }
+    *dest++ = dest_t(int64_t(acc & mask) + offset);
+    acc >>= nbits;
+    nacc -= nbits;
+  }
+}
+
 ///>>======================== Auxiliary classes =======================>>
 
 struct ANSHeader {
+  static constexpr uint8_t PackingMajorVersion = 0; // first format version which may contain Metadata::OptStore::PACK blocks
+  static constexpr uint8_t PackingMinorVersion = 2;
+
   uint8_t majorVersion;
   uint8_t minorVersion;
 
   void clear() { majorVersion = minorVersion = 0; }
+  bool supportsPacking() const { return majorVersion > PackingMajorVersion || (majorVersion == PackingMajorVersion && minorVersion >= PackingMinorVersion); }
+  void requirePacking()
+  {
+    if (!supportsPacking()) {
+      majorVersion = PackingMajorVersion;
+      minorVersion = PackingMinorVersion;
+    }
+  }
   ClassDefNV(ANSHeader, 1);
 };
 
@@ -106,7 +191,9 @@ struct Metadata {
     EENCODE,                      // entropy encoding applied
     ROOTCompression,              // original data repacked to array with slot-size = streamSize and saved with root compression
     NONE,                         // original data repacked to array with slot-size = streamSize and saved w/o compression
-    NODATA                        // no data was provided
+    NODATA,                       // no data was provided
+    PACK,                         // data shifted by min and packed with fixed width of bits needed for max-min, chosen automatically instead of EENCODE (ANSHeader >= 0.2)
+    LAST = PACK                   // last storage option known to this version, newer ones are rejected by the decoder
   };
   size_t messageLength = 0;
   size_t nLiterals = 0;
@@ -134,7 +221,7 @@ struct Metadata {
     nDataWords = 0;
     nLiteralWords = 0;
   }
-  ClassDefNV(Metadata, 2);
+  ClassDefNV(Metadata, 3);
 };
 
 /// registry struct for the buffer start and offsets of writable space
@@ -735,7 +822,8 @@ void EncodedBlocks<H, N, W>::print(const std::string& prefix, int verbosity) con
       LOG(info) << "Block " << i << " for " << static_cast<uint32_t>(mMetadata[i].messageLength) << " message words of "
                 << static_cast<uint32_t>(mMetadata[i].messageWordSize) << " bytes |"
                 << " NDictWords: " << mBlocks[i].getNDict() << " NDataWords: " << mBlocks[i].getNData()
-                << " NLiteralWords: " << mBlocks[i].getNLiterals();
+                << " NLiteralWords: " << mBlocks[i].getNLiterals()
+                << (mMetadata[i].opt == Metadata::OptStore::PACK ? " (bit-packed)" : "");
     }
   } else if (verbosity == 0) {
     size_t inpSize = 0, ndict = 0, ndata = 0, nlit = 0;
@@ -774,8 +862,21 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
 
   using dest_t = typename std::iterator_traits<D_IT>::value_type;
 
+  if (md.opt > Metadata::OptStore::LAST) {
+    LOG(error) << "Unknown storage option " << int(md.opt) << " for slot " << slot << ", the data were written by a newer version";
+    throw std::runtime_error("Unknown storage option of the encoded block");
+  }
+  if (md.opt == Metadata::OptStore::PACK && !mANSHeader.supportsPacking()) {
+    LOG(error) << "Bit-packed block in slot " << slot << " of data with format version " << int(mANSHeader.majorVersion) << "." << int(mANSHeader.minorVersion)
+               << ", packing requires at least " << int(ANSHeader::PackingMajorVersion) << "." << int(ANSHeader::PackingMinorVersion);
+    throw std::runtime_error("Bit-packed block in data with format version predating it");
+  }
+
   // decode
-  if (block.getNStored()) {
+  if (md.opt == Metadata::OptStore::PACK) { // constant data have nothing stored
+    // the range is computed modulo 2^32, as the min/max of unsigned data may not fit in int32
+    unpackBits(block.getData(), md.messageLength, md.min, calculatePackingBits(uint32_t(uint32_t(md.max) - uint32_t(md.min))), dest);
+  } else if (block.getNStored()) {
     if (md.opt == Metadata::OptStore::EENCODE) {
       if (!decoderExt && !block.getNDict()) {
         LOG(error) << "Dictionaty is not saved for slot " << slot << " and no external decoder is provided";
@@ -876,14 +977,57 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
     constexpr size_t SizeEstMarginAbs = 10 * 1024;
     const float SizeEstMarginRel = 1.5 * memfc;
 
-    const auto [inplaceEncoder, frequencyTable] = [&]() {
+    const rans::FrequencyTable frequencyTable = encoderExt ? rans::FrequencyTable{} : rans::makeFrequencyTableFromSamples(srcBegin, srcEnd);
+
+    // low entropy or short columns are cheaper to pack with fixed width than to entropy encode
+    if constexpr (sizeof(input_t) <= sizeof(uint32_t)) {
+      int64_t minVal, maxVal;
+      bool usePacking = false;
       if (encoderExt) {
-        return std::make_tuple(ransEncoder_t{}, rans::FrequencyTable{});
+        const auto* extEncoder = reinterpret_cast<ransEncoder_t const*>(encoderExt);
+        minVal = maxVal = *srcBegin;
+        size_t nOutOfDict = 0; // these will be stored as literals
+        for (auto it = srcBegin; it != srcEnd; ++it) {
+          int64_t v = *it;
+          minVal = std::min(minVal, v);
+          maxVal = std::max(maxVal, v);
+          nOutOfDict += (v < extEncoder->getMinSymbol() || v > extEncoder->getMaxSymbol());
+        }
+        // the in-dictionary symbols are assumed to cost nothing, i.e. pack only if it is cheaper in any case
+        size_t packedSize = calculateNPackedWords<storageBuffer_t>(messageLength, calculatePackingBits(maxVal - minVal)) * sizeof(storageBuffer_t);
+        usePacking = packedSize <= PackingRANSOverhead + nOutOfDict * sizeof(input_t);
       } else {
-        rans::FrequencyTable frequencyTable = rans::makeFrequencyTableFromSamples(srcBegin, srcEnd);
-        RenormedFrequencyTable renormedFrequencyTable = rans::renorm(frequencyTable, symbolTablePrecision);
-        return std::make_tuple(ransEncoder_t{renormedFrequencyTable}, frequencyTable);
+        minVal = frequencyTable.getMinSymbol();
+        maxVal = frequencyTable.getMaxSymbol();
+        double entropyBits = 0.;
+        for (auto freq : frequencyTable) {
+          if (freq) {
+            entropyBits -= freq * std::log2(double(freq) / messageLength);
+          }
+        }
+        double ransSize = entropyBits / 8 + frequencyTable.size() * sizeof(storageBuffer_t) + PackingRANSOverhead;
+        size_t packedSize = calculateNPackedWords<storageBuffer_t>(messageLength, calculatePackingBits(maxVal - minVal)) * sizeof(storageBuffer_t);
+        usePacking = packedSize <= ransSize * (1. + PackingMaxSizeLoss);
+      }
+      if (usePacking) {
+        const int nbits = calculatePackingBits(maxVal - minVal);
+        const size_t nWords = calculateNPackedWords<storageBuffer_t>(messageLength, nbits);
+        expandStorage(nWords);
+        thisBlock->setNData(packBits(srcBegin, srcEnd, minVal, nbits, thisBlock->getCreateData()));
+        thisBlock->realignBlock();
+        *thisMetadata = Metadata{messageLength, 0, sizeof(input_t), sizeof(ransState_t), sizeof(storageBuffer_t), symbolTablePrecision, Metadata::OptStore::PACK,
+                                 static_cast<int32_t>(minVal), static_cast<int32_t>(maxVal), 0, static_cast<int32_t>(nWords), 0};
+        get(thisBlock->registry->head)->mANSHeader.requirePacking(); // readers predating the packing must refuse this data
+        return;
+      }
+    }
+
+    const ransEncoder_t inplaceEncoder = [&]() {
+      if (encoderExt) {
+        return ransEncoder_t{};
       }
+      RenormedFrequencyTable renormedFrequencyTable = rans::renorm(frequencyTable, symbolTablePrecision);
+      return ransEncoder_t{renormedFrequencyTable};
     }();
     ransEncoder_t const* const encoder = encoderExt ? reinterpret_cast<ransEncoder_t const* const>(encoderExt) : &inplaceEncoder;
 
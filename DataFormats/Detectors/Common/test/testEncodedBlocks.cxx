@@ -0,0 +1,95 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EncodedBlocks
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+using namespace o2::ctf;
+using EB = EncodedBlocks<CTFDictHeader, 4, uint32_t>;
+
+BOOST_AUTO_TEST_CASE(BitPacking_test)
+{
+  std::mt19937 eng(1234);
+  for (int nbits = 0; nbits <= 32; nbits++) {
+    for (size_t n : {0, 1, 7, 1000}) {
+      std::vector<int32_t> src(n);
+      const uint32_t mask = nbits == 32 ? 0xffffffff : (1u << nbits) - 1;
+      for (auto& v : src) {
+        v = int32_t(-10 + int64_t(eng() & mask));
+      }
+      std::vector<uint32_t> packed(calculateNPackedWords<uint32_t>(n, nbits) + 1, 0xdeadbeef);
+      auto nw = packBits(src.begin(), src.end(), -10, nbits, packed.data());
+      BOOST_CHECK(nw == calculateNPackedWords<uint32_t>(n, nbits));
+      BOOST_CHECK(packed[nw] == 0xdeadbeef); // nothing written beyond the packed words
+      std::vector<int32_t> dst(n);
+      unpackBits(packed.data(), n, -10, nbits, dst.begin());
+      BOOST_TEST(src == dst, boost::test_tools::per_element());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PackedBlocks_test)
+{
+  std::mt19937 eng(4321);
+  std::vector<int32_t> constant(5000, 42);
+  std::vector<uint8_t> flags(5000);
+  for (auto& v : flags) { // uniform over 4 values: packing is optimal
+    v = eng() & 0x3;
+  }
+  std::vector<uint16_t> tiny{1000, 1010, 1003}; // dictionary would cost more than the data
+  std::vector<uint32_t> skewed(5000);
+  std::geometric_distribution<uint32_t> geom(0.3);
+  for (auto& v : skewed) { // entropy well below the bits needed for the range: rANS wins
+    v = geom(eng);
+  }
+
+  std::vector<BufferType> buff;
+  EB::create(buff);
+  EB::get(buff.data())->encode(constant, 0, 16, Metadata::OptStore::EENCODE, &buff);
+  EB::get(buff.data())->encode(flags, 1, 16, Metadata::OptStore::EENCODE, &buff);
+  EB::get(buff.data())->encode(tiny, 2, 16, Metadata::OptStore::EENCODE, &buff);
+  EB::get(buff.data())->encode(skewed, 3, 16, Metadata::OptStore::EENCODE, &buff);
+  const auto* ec = EB::get(buff.data());
+  ec->print("", 1);
+
+  BOOST_CHECK(ec->getMetadata(0).opt == Metadata::OptStore::PACK);
+  BOOST_CHECK(ec->getBlock(0).getNStored() == 0);
+  BOOST_CHECK(ec->getMetadata(1).opt == Metadata::OptStore::PACK);
+  BOOST_CHECK(ec->getBlock(1).getNData() == int(calculateNPackedWords<uint32_t>(flags.size(), 2)));
+  BOOST_CHECK(ec->getMetadata(2).opt == Metadata::OptStore::PACK);
+  BOOST_CHECK(ec->getMetadata(3).opt == Metadata::OptStore::EENCODE);
+
+  std::vector<int32_t> constantD;
+  std::vector<uint8_t> flagsD;
+  std::vector<uint16_t> tinyD;
+  std::vector<uint32_t> skewedD;
+  ec->decode(constantD, 0);
+  ec->decode(flagsD, 1);
+  ec->decode(tinyD, 2);
+  ec->decode(skewedD, 3);
+  BOOST_TEST(constant == constantD, boost::test_tools::per_element());
+  BOOST_TEST(flags == flagsD, boost::test_tools::per_element());
+  BOOST_TEST(tiny == tinyD, boost::test_tools::per_element());
+  BOOST_TEST(skewed == skewedD, boost::test_tools::per_element());
+
+  // packed blocks require the format version introducing them
+  BOOST_CHECK(ec->getANSHeader().supportsPacking());
+  auto* ecw = EB::get(buff.data());
+  ecw->getANSHeader().majorVersion = 0;
+  ecw->getANSHeader().minorVersion = 1;
+  BOOST_CHECK_THROW(ec->decode(flagsD, 1), std::runtime_error);
+  BOOST_CHECK_NO_THROW(ec->decode(skewedD, 3));
+}
@@ -17,6 +17,9 @@
 #ifndef ALICEO2_MCH_TRACKMCH_H_
 #define ALICEO2_MCH_TRACKMCH_H_
 
+#include <algorithm>
+#include <Math/SMatrix.h>
+#include <Math/SVector.h>
 #include <TMatrixD.h>
 #include <iosfwd>
 
@@ -31,9 +34,14 @@ namespace mch
 class TrackMCH
 {
   using ClusRef = o2::dataformats::RangeRefComp<5>;
+  using SMatrix5 = ROOT::Math::SVector<double, 5>;
+  using SMatrix55Sym = ROOT::Math::SMatrix<double, 5, 5, ROOT::Math::MatRepSym<double, 5>>;
 
  public:
   TrackMCH() = default;
+  TrackMCH(double z, const SMatrix5& param, const SMatrix55Sym& cov, double chi2, int firstClIdx, int nClusters,
+           double zAtMID, const SMatrix5& paramAtMID, const SMatrix55Sym& covAtMID);
+  /// deprecated: constructor from 5x1 parameter and 5x5 covariance TMatrixD, kept for backward compatibility
   TrackMCH(double z, const TMatrixD& param, const TMatrixD& cov, double chi2, int firstClIdx, int nClusters,
            double zAtMID, const TMatrixD& paramAtMID, const TMatrixD& covAtMID);
   ~TrackMCH() = default;
@@ -63,6 +71,8 @@ class TrackMCH
   /// get the track parameters
   const double* getParameters() const { return mParam; }
   /// set the track parameters
+  void setParameters(const SMatrix5& param) { std::copy(param.begin(), param.end(), mParam); }
+  /// deprecated: set the track parameters from a 5x1 TMatrixD
   void setParameters(const TMatrixD& param) { param.GetMatrix2Array(mParam); }
 
   /// get the track parameter covariances
@@ -70,6 +80,8 @@ class TrackMCH
   /// get the covariance between track parameters i and j
   double getCovariance(int i, int j) const { return mCov[SCovIdx[i][j]]; }
   /// set the track parameter covariances
+  void setCovariances(const SMatrix55Sym& cov) { setCovariances(cov, mCov); }
+  /// deprecated: set the track parameter covariances from a 5x5 TMatrixD
   void setCovariances(const TMatrixD& cov) { setCovariances(cov, mCov); }
 
   /// get the track z position on the MID side where the parameters are evaluated
@@ -80,6 +92,8 @@ class TrackMCH
   /// get the track parameters on the MID side
   const double* getParametersAtMID() const { return mParamAtMID; }
   /// set the track parameters on the MID side
+  void setParametersAtMID(const SMatrix5& param) { std::copy(param.begin(), param.end(), mParamAtMID); }
+  /// deprecated: set the track parameters on the MID side from a 5x1 TMatrixD
   void setParametersAtMID(const TMatrixD& param) { param.GetMatrix2Array(mParamAtMID); }
 
   /// get the track parameter covariances on the MID side
@@ -87,6 +101,8 @@ class TrackMCH
   /// get the covariance between track parameters i and j on the MID side
   double getCovarianceAtMID(int i, int j) const { return mCovAtMID[SCovIdx[i][j]]; }
   /// set the track parameter covariances on the MID side
+  void setCovariancesAtMID(const SMatrix55Sym& cov) { setCovariances(cov, mCovAtMID); }
+  /// deprecated: set the track parameter covariances on the MID side from a 5x5 TMatrixD
   void setCovariancesAtMID(const TMatrixD& cov) { setCovariances(cov, mCovAtMID); }
 
   /// get the track chi2
@@ -117,6 +133,7 @@ class TrackMCH
                                                       {6, 7, 8, 9, 13},
                                                       {10, 11, 12, 13, 14}};
 
+  void setCovariances(const SMatrix55Sym& src, double (&dest)[SCovSize]);
   void setCovariances(const TMatrixD& src, double (&dest)[SCovSize]);
 
   double mZ = 0.;                 ///< z position where the parameters are evaluated
@@ -27,12 +27,24 @@ namespace o2
 namespace mch
 {
 
+//__________________________________________________________________________
+TrackMCH::TrackMCH(double z, const SMatrix5& param, const SMatrix55Sym& cov, double chi2, int firstClIdx, int nClusters,
+                   double zAtMID, const SMatrix5& paramAtMID, const SMatrix55Sym& covAtMID)
+  : mZ(z), mChi2(chi2), mClusRef(firstClIdx, nClusters), mZAtMID(zAtMID)
+{
+  /// constructor
+  setParameters(param);
+  setCovariances(cov);
+  setParametersAtMID(paramAtMID);
+  setCovariancesAtMID(covAtMID);
+}
+
 //__________________________________________________________________________
 TrackMCH::TrackMCH(double z, const TMatrixD& param, const TMatrixD& cov, double chi2, int firstClIdx, int nClusters,
                    double zAtMID, const TMatrixD& paramAtMID, const TMatrixD& covAtMID)
   : mZ(z), mChi2(chi2), mClusRef(firstClIdx, nClusters), mZAtMID(zAtMID)
 {
-  /// constructor
+  /// constructor from TMatrixD, kept for backward compatibility
   setParameters(param);
   setCovariances(cov);
   setParametersAtMID(paramAtMID);
@@ -77,7 +89,7 @@ double TrackMCH::getP() const
 }
 
 //__________________________________________________________________________
-void TrackMCH::setCovariances(const TMatrixD& src, double (&dest)[SCovSize])
+void TrackMCH::setCovariances(const SMatrix55Sym& src, double (&dest)[SCovSize])
 {
   /// set the track parameter covariances
   for (int i = 0; i < SNParams; i++) {
@@ -87,6 +99,17 @@ void TrackMCH::setCovariances(const TMatrixD& src, double (&dest)[SCovSize])
   }
 }
 
+//__________________________________________________________________________
+void TrackMCH::setCovariances(const TMatrixD& src, double (&dest)[SCovSize])
+{
+  /// set the track parameter covariances from a TMatrixD
+  for (int i = 0; i < SNParams; i++) {
+    for (int j = 0; j <= i; j++) {
+      dest[SCovIdx[i][j]] = src(i, j);
+    }
+  }
+}
+
 std::ostream& operator<<(std::ostream& os, const o2::mch::TrackMCH& t)
 {
   os << asString(t);
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE MCH TrackMCH
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include "DataFormatsMCH/TrackMCH.h"
+
+using o2::mch::TrackMCH;
+using SMatrix5 = ROOT::Math::SVector<double, 5>;
+using SMatrix55Sym = ROOT::Math::SMatrix<double, 5, 5, ROOT::Math::MatRepSym<double, 5>>;
+
+struct TestParams {
+  TMatrixD param{5, 1};
+  TMatrixD cov{5, 5};
+  SMatrix5 sparam{};
+  SMatrix55Sym scov{};
+
+  explicit TestParams(unsigned int seed)
+  {
+    std::mt19937 eng(seed);
+    std::uniform_real_distribution<double> rnd(-1., 1.);
+    for (int i = 0; i < 5; i++) {
+      param(i, 0) = sparam(i) = rnd(eng);
+      for (int j = 0; j <= i; j++) {
+        cov(i, j) = cov(j, i) = scov(i, j) = rnd(eng);
+      }
+    }
+  }
+};
+
+void checkSame(const TrackMCH& t1, const TrackMCH& t2)
+{
+  for (int i = 0; i < 5; i++) {
+    BOOST_CHECK_EQUAL(t1.getParameters()[i], t2.getParameters()[i]);
+    BOOST_CHECK_EQUAL(t1.getParametersAtMID()[i], t2.getParametersAtMID()[i]);
+    for (int j = 0; j < 5; j++) {
+      BOOST_CHECK_EQUAL(t1.getCovariance(i, j), t2.getCovariance(i, j));
+      BOOST_CHECK_EQUAL(t1.getCovarianceAtMID(i, j), t2.getCovarianceAtMID(i, j));
+    }
+  }
+  BOOST_CHECK_EQUAL(t1.getZ(), t2.getZ());
+  BOOST_CHECK_EQUAL(t1.getZAtMID(), t2.getZAtMID());
+  BOOST_CHECK_EQUAL(t1.getChi2(), t2.getChi2());
+  BOOST_CHECK_EQUAL(t1.getFirstClusterIdx(), t2.getFirstClusterIdx());
+  BOOST_CHECK_EQUAL(t1.getNClusters(), t2.getNClusters());
+}
+
+BOOST_AUTO_TEST_CASE(TMatrixDAndSMatrixConstructorsAgree)
+{
+  TestParams p(1), pMID(2);
+  TrackMCH told(-520., p.param, p.cov, 12.5, 3, 10, -1700., pMID.param, pMID.cov);
+  TrackMCH tnew(-520., p.sparam, p.scov, 12.5, 3, 10, -1700., pMID.sparam, pMID.scov);
+  checkSame(told, tnew);
+  for (int i = 0; i < 5; i++) {
+    BOOST_CHECK_EQUAL(tnew.getParameters()[i], p.param(i, 0));
+    for (int j = 0; j < 5; j++) {
+      BOOST_CHECK_EQUAL(tnew.getCovariance(i, j), p.cov(i, j));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TMatrixDAndSMatrixSettersAgree)
+{
+  TestParams p(3), pMID(4);
+  TrackMCH told, tnew;
+  told.setParameters(p.param);
+  told.setCovariances(p.cov);
+  told.setParametersAtMID(pMID.param);
+  told.setCovariancesAtMID(pMID.cov);
+  tnew.setParameters(p.sparam);
+  tnew.setCovariances(p.scov);
+  tnew.setParametersAtMID(pMID.sparam);
+  tnew.setCovariancesAtMID(pMID.scov);
+  checkSame(told, tnew);
+}
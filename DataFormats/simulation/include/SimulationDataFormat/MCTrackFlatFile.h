@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MCTrackFlatFile.h
+/// \brief Memory-mappable flat copy of the MC kinematics, for fast random access to MCTracks
+
+#ifndef ALICEO2_DATA_MCTRACKFLATFILE_H_
+#define ALICEO2_DATA_MCTRACKFLATFILE_H_
+
+#include "SimulationDataFormat/MCTrack.h"
+#include <gsl/span>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace dataformats
+{
+
+static_assert(std::is_trivially_copyable<o2::MCTrack>::value, "MCTrack records are stored as raw bytes");
+
+/// Layout of the flat kinematics file:
+/// - this header
+/// - the MCTracks of all events, one after the other, as raw fixed size records
+/// - an index of nEvents + 1 entries giving the first record of each event (the last one is the total)
+/// The index is written when the file is closed: a file without index (e.g. from an
+/// interrupted simulation) is not valid and is ignored by the reader.
+struct MCTrackFlatFileHeader {
+  static constexpr uint64_t MAGIC = 0x454e494b5432444f; // "OD2TKINE"
+  static constexpr uint32_t VERSION = 1;
+
+  uint64_t magic = MAGIC;
+  uint32_t version = VERSION;
+  uint32_t recordSize = sizeof(o2::MCTrack);
+  uint64_t nEvents = 0;
+  uint64_t indexOffset = 0; ///< offset in bytes of the event index, 0 as long as the file is not closed
+  uint64_t reserved[4] = {0};
+};
+static_assert(sizeof(MCTrackFlatFileHeader) == 64, "the header must keep its size");
+
+/// Sequential writer of the flat kinematics file, events are added in the order of the kinematics tree
+class MCTrackFlatFileWriter
+{
+ public:
+  MCTrackFlatFileWriter() = default;
+  ~MCTrackFlatFileWriter() { close(); }
+
+  /// (re)create the file, closing the current one if any
+  bool open(std::string const& filename);
+  bool isOpen() const { return mFile.is_open(); }
+
+  /// append the tracks of the next event
+  void addEvent(gsl::span<const o2::MCTrack> tracks);
+
+  /// write the index and the final header
+  bool close();
+
+ private:
+  std::ofstream mFile;
+  std::string mFileName;
+  std::vector<uint64_t> mIndex; // first record of each event
+};
+
+/// Read access to the flat kinematics file through a read-only memory mapping:
+/// the tracks of any event are available in O(1) without any deserialization
+class MCTrackFlatFileReader
+{
+ public:
+  MCTrackFlatFileReader() = default;
+  MCTrackFlatFileReader(MCTrackFlatFileReader&& other) noexcept { *this = std::move(other); }
+  MCTrackFlatFileReader& operator=(MCTrackFlatFileReader&& other) noexcept;
+  MCTrackFlatFileReader(MCTrackFlatFileReader const&) = delete;
+  MCTrackFlatFileReader& operator=(MCTrackFlatFileReader const&) = delete;
+  ~MCTrackFlatFileReader() { close(); }
+
+  /// map the file, returns false if it does not exist or is not a valid (complete) flat kinematics file
+  bool open(std::string const& filename);
+  void close();
+  bool isOpen() const { return mMapping != nullptr; }
+
+  size_t getNEvents() const { return mNEvents; }
+
+  /// all tracks of a given event, empty span if the event does not exist
+  gsl::span<const o2::MCTrack> getTracks(int event) const
+  {
+    if (event < 0 || size_t(event) >= mNEvents) {
+      return {};
+    }
+    return gsl::span<const o2::MCTrack>(mTracks + mIndex[event], mIndex[event + 1] - mIndex[event]);
+  }
+
+  /// a single track, nullptr if it does not exist
+  o2::MCTrack const* getTrack(int event, int track) const
+  {
+    if (event < 0 || size_t(event) >= mNEvents || track < 0 || uint64_t(track) >= mIndex[event + 1] - mIndex[event]) {
+      return nullptr;
+    }
+    return mTracks + mIndex[event] + track;
+  }
+
+ private:
+  void* mMapping = nullptr;
+  size_t mMappingSize = 0;
+  size_t mNEvents = 0;
+  o2::MCTrack const* mTracks = nullptr;
+  uint64_t const* mIndex = nullptr;
+};
+
+} // namespace dataformats
+} // namespace o2
+
+#endif
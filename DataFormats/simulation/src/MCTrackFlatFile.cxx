@@ -0,0 +1,138 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "SimulationDataFormat/MCTrackFlatFile.h"
+#include <fairlogger/Logger.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace o2::dataformats;
+
+bool MCTrackFlatFileWriter::open(std::string const& filename)
+{
+  close();
+  mFile.open(filename, std::ios::binary | std::ios::trunc);
+  if (!mFile.is_open()) {
+    LOG(error) << "Could not create flat kinematics file " << filename;
+    return false;
+  }
+  mFileName = filename;
+  mIndex.clear();
+  mIndex.push_back(0);
+  // placeholder, rewritten on close
+  MCTrackFlatFileHeader header;
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return mFile.good();
+}
+
+void MCTrackFlatFileWriter::addEvent(gsl::span<const o2::MCTrack> tracks)
+{
+  if (!mFile.is_open()) {
+    return;
+  }
+  mFile.write(reinterpret_cast<const char*>(tracks.data()), tracks.size() * sizeof(o2::MCTrack));
+  mIndex.push_back(mIndex.back() + tracks.size());
+}
+
+bool MCTrackFlatFileWriter::close()
+{
+  if (!mFile.is_open()) {
+    return false;
+  }
+  MCTrackFlatFileHeader header;
+  header.nEvents = mIndex.size() - 1;
+  header.indexOffset = sizeof(header) + mIndex.back() * sizeof(o2::MCTrack);
+  mFile.write(reinterpret_cast<const char*>(mIndex.data()), mIndex.size() * sizeof(uint64_t));
+  mFile.seekp(0);
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  bool ok = mFile.good();
+  mFile.close();
+  if (!ok) {
+    LOG(error) << "Failed writing flat kinematics file " << mFileName;
+  } else {
+    LOG(info) << "Wrote " << header.nEvents << " events with " << mIndex.back() << " tracks to flat kinematics file " << mFileName;
+  }
+  mIndex.clear();
+  return ok;
+}
+
+MCTrackFlatFileReader& MCTrackFlatFileReader::operator=(MCTrackFlatFileReader&& other) noexcept
+{
+  if (this != &other) {
+    close();
+    std::swap(mMapping, other.mMapping);
+    std::swap(mMappingSize, other.mMappingSize);
+    std::swap(mNEvents, other.mNEvents);
+    std::swap(mTracks, other.mTracks);
+    std::swap(mIndex, other.mIndex);
+  }
+  return *this;
+}
+
+bool MCTrackFlatFileReader::open(std::string const& filename)
+{
+  close();
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  void* mapping = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(MCTrackFlatFileHeader)) {
+    mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  mMapping = mapping;
+  mMappingSize = st.st_size;
+
+  // validate the layout before trusting any offset
+  auto header = reinterpret_cast<MCTrackFlatFileHeader const*>(mapping);
+  if (header->magic != MCTrackFlatFileHeader::MAGIC || header->version != MCTrackFlatFileHeader::VERSION ||
+      header->recordSize != sizeof(o2::MCTrack) || header->indexOffset < sizeof(MCTrackFlatFileHeader) ||
+      header->indexOffset > mMappingSize || header->nEvents >= (mMappingSize - header->indexOffset) / sizeof(uint64_t) ||
+      header->indexOffset + (header->nEvents + 1) * sizeof(uint64_t) != mMappingSize) {
+    LOG(warn) << "File " << filename << " is not a complete flat kinematics file, ignoring it";
+    close();
+    return false;
+  }
+  mNEvents = header->nEvents;
+  mTracks = reinterpret_cast<o2::MCTrack const*>(reinterpret_cast<char const*>(mapping) + sizeof(MCTrackFlatFileHeader));
+  mIndex = reinterpret_cast<uint64_t const*>(reinterpret_cast<char const*>(mapping) + header->indexOffset);
+  bool indexOK = mIndex[0] == 0 && sizeof(MCTrackFlatFileHeader) + mIndex[mNEvents] * sizeof(o2::MCTrack) == header->indexOffset;
+  for (size_t i = 0; indexOK && i < mNEvents; i++) {
+    indexOK = mIndex[i] <= mIndex[i + 1];
+  }
+  if (!indexOK) {
+    LOG(warn) << "Inconsistent event index in flat kinematics file " << filename << ", ignoring it";
+    close();
+    return false;
+  }
+  // hint the kernel that the access pattern of label lookups is random
+  madvise(mMapping, mMappingSize, MADV_RANDOM);
+  return true;
+}
+
+void MCTrackFlatFileReader::close()
+{
+  if (mMapping) {
+    munmap(mMapping, mMappingSize);
+  }
+  mMapping = nullptr;
+  mMappingSize = 0;
+  mNEvents = 0;
+  mTracks = nullptr;
+  mIndex = nullptr;
+}
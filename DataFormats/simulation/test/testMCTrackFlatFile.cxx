@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCTrackFlatFile
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/MCTrackFlatFile.h"
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace o2::dataformats;
+
+namespace
+{
+std::vector<std::vector<o2::MCTrack>> createEvents(int nEvents)
+{
+  std::mt19937 eng(1234);
+  std::uniform_real_distribution<double> val(-10., 10.);
+  std::vector<std::vector<o2::MCTrack>> events(nEvents);
+  for (int ev = 0; ev < nEvents; ev++) {
+    int nTracks = ev == 1 ? 0 : eng() % 500; // include an empty event
+    for (int i = 0; i < nTracks; i++) {
+      events[ev].emplace_back(211, i - 1, -1, -1, -1, val(eng), val(eng), val(eng), val(eng), val(eng), val(eng), 1e-9, 0);
+    }
+  }
+  return events;
+}
+
+bool sameTrack(o2::MCTrack const& a, o2::MCTrack const& b)
+{
+  return a.GetPdgCode() == b.GetPdgCode() && a.getMotherTrackId() == b.getMotherTrackId() &&
+         a.Px() == b.Px() && a.Py() == b.Py() && a.Pz() == b.Pz() && a.Vx() == b.Vx() && a.Vy() == b.Vy() && a.Vz() == b.Vz();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(MCTrackFlatFile_test)
+{
+  const std::string filename = "testMCTrackFlatFile.flat";
+  const auto events = createEvents(20);
+  {
+    MCTrackFlatFileWriter writer;
+    BOOST_CHECK(writer.open(filename));
+    for (auto& ev : events) {
+      writer.addEvent(ev);
+    }
+    BOOST_CHECK(writer.close());
+  }
+
+  MCTrackFlatFileReader reader;
+  BOOST_CHECK(reader.open(filename));
+  BOOST_CHECK(reader.getNEvents() == events.size());
+  for (int ev = 0; ev < events.size(); ev++) {
+    auto tracks = reader.getTracks(ev);
+    BOOST_CHECK(tracks.size() == events[ev].size());
+    for (int i = 0; i < tracks.size(); i++) {
+      BOOST_CHECK(sameTrack(tracks[i], events[ev][i]));
+    }
+  }
+  // random lookups, including out of range ones
+  std::mt19937 eng(4321);
+  for (int i = 0; i < 10000; i++) {
+    int ev = eng() % (events.size() + 1);
+    int tr = eng() % 510;
+    auto track = reader.getTrack(ev, tr);
+    if (ev < events.size() && tr < events[ev].size()) {
+      BOOST_CHECK(track && sameTrack(*track, events[ev][tr]));
+    } else {
+      BOOST_CHECK(track == nullptr);
+    }
+  }
+  BOOST_CHECK(reader.getTrack(-1, 0) == nullptr);
+
+  // the reader can be moved around, e.g. into a container
+  MCTrackFlatFileReader moved(std::move(reader));
+  BOOST_CHECK(!reader.isOpen());
+  BOOST_CHECK(moved.isOpen() && moved.getNEvents() == events.size());
+  moved.close();
+
+  // a file which was not closed properly (no index) is rejected
+  std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - sizeof(uint64_t));
+  BOOST_CHECK(!reader.open(filename));
+  {
+    MCTrackFlatFileWriter writer;
+    writer.open(filename);
+    writer.addEvent(events[0]);
+    // simulate a crash: the header is never finalized
+    std::filesystem::copy_file(filename, filename + ".partial", std::filesystem::copy_options::overwrite_existing);
+  }
+  BOOST_CHECK(!reader.open(filename + ".partial"));
+  BOOST_CHECK(reader.open(filename) && reader.getNEvents() == 1);
+  reader.close();
+  std::remove(filename.c_str());
+  std::remove((filename + ".partial").c_str());
+}
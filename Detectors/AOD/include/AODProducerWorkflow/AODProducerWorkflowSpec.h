@@ -42,6 +42,8 @@
 #include <boost/functional/hash.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/unordered_map.hpp>
+#include <algorithm>
+#include <array>
 #include <string>
 #include <vector>
 
@@ -175,6 +177,84 @@ struct TripletEqualTo : std::binary_function<Triplet_t, Triplet_t, bool> {
 
 typedef boost::unordered_map<Triplet_t, int, TripletHash, TripletEqualTo> TripletsMap_t;
 
+// sorted flat container of the global BCs of the TF, replacing std::map<uint64_t, int>:
+// the BC table index of a global BC is its position in the container
+class BCsMap
+{
+ public:
+  using const_iterator = std::vector<uint64_t>::const_iterator;
+
+  // add BC without ordering, sort() must be called before any lookup
+  void add(uint64_t bc) { mBCs.push_back(bc); }
+  void sort()
+  {
+    std::sort(mBCs.begin(), mBCs.end());
+    mBCs.erase(std::unique(mBCs.begin(), mBCs.end()), mBCs.end());
+  }
+  // insert BC keeping the ordering, it must precede the provided position
+  void insert(const_iterator pos, uint64_t bc) { mBCs.insert(pos, bc); }
+
+  // BC table index of the global BC or -1 if absent
+  int getBCID(uint64_t bc) const
+  {
+    auto it = lower_bound(bc);
+    return (it != mBCs.end() && *it == bc) ? int(it - mBCs.begin()) : -1;
+  }
+  const_iterator lower_bound(uint64_t bc) const { return std::lower_bound(mBCs.begin(), mBCs.end(), bc); }
+  const_iterator upper_bound(uint64_t bc) const { return std::upper_bound(mBCs.begin(), mBCs.end(), bc); }
+  const_iterator begin() const { return mBCs.begin(); }
+  const_iterator end() const { return mBCs.end(); }
+  uint64_t back() const { return mBCs.back(); }
+  size_t size() const { return mBCs.size(); }
+  bool empty() const { return mBCs.empty(); }
+  void clear() { mBCs.clear(); }
+
+ private:
+  std::vector<uint64_t> mBCs;
+};
+
+// flat replacement of std::unordered_map<GIndex, int> connecting global track indices with table indices:
+// per-source vectors indexed by the track index, -1 stands for the absent entry
+class GIDToTableIDMap
+{
+ public:
+  int find(GIndex gid) const
+  {
+    const auto& ids = mIDs[gid.getSource()];
+    return gid.getIndex() < ids.size() ? ids[gid.getIndex()] : -1;
+  }
+  bool contains(GIndex gid) const { return find(gid) != -1; }
+  void emplace(GIndex gid, int tableID)
+  {
+    auto& ids = mIDs[gid.getSource()];
+    if (gid.getIndex() >= ids.size()) {
+      ids.resize(gid.getIndex() + 1, -1);
+    }
+    if (ids[gid.getIndex()] == -1) {
+      ids[gid.getIndex()] = tableID;
+    }
+  }
+  // return true if the entry was set and invalidate it, used to process every stored track only once
+  bool consume(GIndex gid)
+  {
+    auto& ids = mIDs[gid.getSource()];
+    if (gid.getIndex() >= ids.size() || ids[gid.getIndex()] == -1) {
+      return false;
+    }
+    ids[gid.getIndex()] = -1;
+    return true;
+  }
+  void clear()
+  {
+    for (auto& ids : mIDs) {
+      ids.clear();
+    }
+  }
+
+ private:
+  std::array<std::vector<int>, GIndex::NSources> mIDs;
+};
+
 class AODProducerWorkflowDPL : public Task
 {
  public:
@@ -198,6 +278,7 @@ class AODProducerWorkflowDPL : public Task
 
   bool mUseMC = true;
   bool mEnableSV = true;             // enable secondary vertices
+  int mNThreads = 1;                 // number of threads used to precompute barrel tracks info
   const float cSpeed = 0.029979246f; // speed of light in TOF units
 
   GID::mask_t mInputSources;
@@ -212,15 +293,16 @@ class AODProducerWorkflowDPL : public Task
   TString mAnchorProd{""};
   TString mRecoPass{""};
   TStopwatch mTimer;
+  TStopwatch mTimerTracks; // time spent in filling of the track tables
 
-  // unordered map connects global indices and table indices of barrel tracks
-  std::unordered_map<GIndex, int> mGIDToTableID;
+  // flat map connects global indices and table indices of barrel tracks
+  GIDToTableIDMap mGIDToTableID;
   int mTableTrID{0};
-  // unordered map connects global indices and table indices of fwd tracks
-  std::unordered_map<GIndex, int> mGIDToTableFwdID;
+  // flat map connects global indices and table indices of fwd tracks
+  GIDToTableIDMap mGIDToTableFwdID;
   int mTableTrFwdID{0};
-  // unordered map connects global indices and table indices of MFT tracks
-  std::unordered_map<GIndex, int> mGIDToTableMFTID;
+  // flat map connects global indices and table indices of MFT tracks
+  GIDToTableIDMap mGIDToTableMFTID;
   int mTableTrMFTID{0};
   // unordered map connects global indices and table indices of vertices
   std::unordered_map<GIndex, int> mVtxToTableCollID;
@@ -315,6 +397,11 @@ class AODProducerWorkflowDPL : public Task
     int bcSlice[2] = {-1, -1};
   };
 
+  // barrel tracks info precomputed in parallel for the whole TF (if mNThreads > 1):
+  // for every entry of the vertex-track association span the index of the precomputed info or -1
+  std::vector<int> mBarrelInfoIndex;
+  std::vector<TrackExtraInfo> mBarrelInfo;
+
   // helper struct for mc track labels
   // using -1 as dummies for AOD
   struct MCLabels {
@@ -328,11 +415,11 @@ class AODProducerWorkflowDPL : public Task
   void updateTimeDependentParams(ProcessingContext& pc);
 
   void addRefGlobalBCsForTOF(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices,
-                             const o2::globaltracking::RecoContainer& data, std::map<uint64_t, int>& bcsMap);
+                             const o2::globaltracking::RecoContainer& data, BCsMap& bcsMap);
 
   void collectBCs(const o2::globaltracking::RecoContainer& data,
                   const std::vector<o2::InteractionTimeRecord>& mcRecords,
-                  std::map<uint64_t, int>& bcsMap);
+                  BCsMap& bcsMap);
 
   uint64_t getTFNumber(const o2::InteractionRecord& tfStartIR, int runNumber);
 
@@ -346,16 +433,20 @@ class AODProducerWorkflowDPL : public Task
   template <typename mftTracksCursorType, typename AmbigMFTTracksCursorType>
   void addToMFTTracksTable(mftTracksCursorType& mftTracksCursor, AmbigMFTTracksCursorType& ambigMFTTracksCursor,
                            GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID,
-                           std::uint64_t collisionBC, const std::map<uint64_t, int>& bcsMap);
+                           std::uint64_t collisionBC, const BCsMap& bcsMap);
 
   template <typename fwdTracksCursorType, typename fwdTracksCovCursorType, typename AmbigFwdTracksCursorType>
   void addToFwdTracksTable(fwdTracksCursorType& fwdTracksCursor, fwdTracksCovCursorType& fwdTracksCovCursor, AmbigFwdTracksCursorType& ambigFwdTracksCursor,
-                           GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID, std::uint64_t collisionBC, const std::map<uint64_t, int>& bcsMap);
+                           GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID, std::uint64_t collisionBC, const BCsMap& bcsMap);
 
-  TrackExtraInfo processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
+  TrackExtraInfo processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const BCsMap& bcsMap);
 
   void cacheTriggers(const o2::globaltracking::RecoContainer& recoData);
 
+  // process in parallel the barrel tracks to be stored, in the order in which they are filled to the tables
+  void prepareBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& primVer2TRefs, const gsl::span<const GIndex>& GIndices,
+                           const o2::globaltracking::RecoContainer& data, const BCsMap& bcsMap);
+
   // helper for track tables
   // * fills tables collision by collision
   // * interaction time is for TOF information
@@ -376,7 +467,7 @@ class AODProducerWorkflowDPL : public Task
                                    FwdTracksCursorType& fwdTracksCursor,
                                    FwdTracksCovCursorType& fwdTracksCovCursor,
                                    AmbigFwdTracksCursorType& ambigFwdTracksCursor,
-                                   const std::map<uint64_t, int>& bcsMap);
+                                   const BCsMap& bcsMap);
 
   template <typename V0CursorType, typename CascadeCursorType>
   void fillSecondaryVertices(const o2::globaltracking::RecoContainer& data, V0CursorType& v0Cursor, CascadeCursorType& cascadeCursor);
@@ -397,7 +488,7 @@ class AODProducerWorkflowDPL : public Task
                               const gsl::span<const GIndex>& primVerGIs,
                               const o2::globaltracking::RecoContainer& data);
 
-  std::uint64_t fillBCSlice(int (&slice)[2], double tmin, double tmax, const std::map<uint64_t, int>& bcsMap) const;
+  std::uint64_t fillBCSlice(int (&slice)[2], double tmin, double tmax, const BCsMap& bcsMap) const;
 
   // helper for tpc clusters
   void countTPCClusters(const o2::tpc::TrackTPC& track,
@@ -413,7 +504,7 @@ class AODProducerWorkflowDPL : public Task
 
   template <typename TCaloCells, typename TCaloTriggerRecord, typename TCaloCursor, typename TCaloTRGTableCursor>
   void fillCaloTable(const TCaloCells& calocells, const TCaloTriggerRecord& caloCellTRGR, const TCaloCursor& caloCellCursor,
-                     const TCaloTRGTableCursor& caloCellTRGTableCursor, std::map<uint64_t, int>& bcsMap);
+                     const TCaloTRGTableCursor& caloCellTRGTableCursor, BCsMap& bcsMap);
 };
 
 /// create a processor spec
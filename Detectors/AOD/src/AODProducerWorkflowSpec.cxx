@@ -75,6 +75,9 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::framework;
 using namespace o2::math_utils::detail;
@@ -89,7 +92,7 @@ namespace o2::aodproducer
 
 void AODProducerWorkflowDPL::collectBCs(const o2::globaltracking::RecoContainer& data,
                                         const std::vector<o2::InteractionTimeRecord>& mcRecords,
-                                        std::map<uint64_t, int>& bcsMap)
+                                        BCsMap& bcsMap)
 {
   const auto& primVertices = data.getPrimaryVertices();
   const auto& fddRecPoints = data.getFDDRecPoints();
@@ -99,56 +102,53 @@ void AODProducerWorkflowDPL::collectBCs(const o2::globaltracking::RecoContainer&
   const auto& ctpDigits = data.getCTPDigits();
   const auto& zdcBCRecData = data.getZDCBCRecData();
 
-  bcsMap[mStartIR.toLong()] = 1; // store the start of TF
+  bcsMap.add(mStartIR.toLong()); // store the start of TF
 
   // collecting non-empty BCs and enumerating them
   for (auto& rec : mcRecords) {
     uint64_t globalBC = rec.toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& fddRecPoint : fddRecPoints) {
     uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& ft0RecPoint : ft0RecPoints) {
     uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& fv0RecPoint : fv0RecPoints) {
     uint64_t globalBC = fv0RecPoint.getInteractionRecord().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& zdcRecData : zdcBCRecData) {
     uint64_t globalBC = zdcRecData.ir.toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& vertex : primVertices) {
     auto& timeStamp = vertex.getTimeStamp();
     double tsTimeStamp = timeStamp.getTimeStamp() * 1E3; // mus to ns
     uint64_t globalBC = relativeTime_to_GlobalBC(tsTimeStamp);
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& emcaltrg : caloEMCCellsTRGR) {
     uint64_t globalBC = emcaltrg.getBCData().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& ctpDigit : ctpDigits) {
     uint64_t globalBC = ctpDigit.intRecord.toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
-  int bcID = 0;
-  for (auto& item : bcsMap) {
-    item.second = bcID;
-    bcID++;
-  }
+  // BCs are enumerated by their position in the sorted container
+  bcsMap.sort();
 }
 
 uint64_t AODProducerWorkflowDPL::getTFNumber(const o2::InteractionRecord& tfStartIR, int runNumber)
@@ -247,7 +247,7 @@ void AODProducerWorkflowDPL::addToTracksExtraTable(TracksExtraCursorType& tracks
 template <typename mftTracksCursorType, typename AmbigMFTTracksCursorType>
 void AODProducerWorkflowDPL::addToMFTTracksTable(mftTracksCursorType& mftTracksCursor, AmbigMFTTracksCursorType& ambigMFTTracksCursor,
                                                  GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID,
-                                                 std::uint64_t collisionBC, const std::map<uint64_t, int>& bcsMap)
+                                                 std::uint64_t collisionBC, const BCsMap& bcsMap)
 {
   // mft tracks
   int bcSlice[2] = {-1, -1};
@@ -301,7 +301,7 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                                                          FwdTracksCursorType& fwdTracksCursor,
                                                          FwdTracksCovCursorType& fwdTracksCovCursor,
                                                          AmbigFwdTracksCursorType& ambigFwdTracksCursor,
-                                                         const std::map<uint64_t, int>& bcsMap)
+                                                         const BCsMap& bcsMap)
 {
   for (int src = GIndex::NSources; src--;) {
     int start = trackRef.getFirstEntryOfSource(src);
@@ -310,21 +310,23 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
       auto& trackIndex = GIndices[ti];
       if (GIndex::includesSource(src, mInputSources)) {
         if (src == GIndex::Source::MFT) {                                                                // MFT tracks are treated separately since they are stored in a different table
-          if (trackIndex.isAmbiguous() && mGIDToTableMFTID.find(trackIndex) != mGIDToTableMFTID.end()) { // was it already stored ?
+          if (trackIndex.isAmbiguous() && mGIDToTableMFTID.contains(trackIndex)) { // was it already stored ?
             continue;
           }
           addToMFTTracksTable(mftTracksCursor, ambigMFTTracksCursor, trackIndex, data, collisionID, collisionBC, bcsMap);
         } else if (src == GIndex::Source::MCH || src == GIndex::Source::MFTMCH) {                        // FwdTracks tracks are treated separately since they are stored in a different table
-          if (trackIndex.isAmbiguous() && mGIDToTableFwdID.find(trackIndex) != mGIDToTableFwdID.end()) { // was it already stored ?
+          if (trackIndex.isAmbiguous() && mGIDToTableFwdID.contains(trackIndex)) { // was it already stored ?
             continue;
           }
           addToFwdTracksTable(fwdTracksCursor, fwdTracksCovCursor, ambigFwdTracksCursor, trackIndex, data, collisionID, collisionBC, bcsMap);
         } else {
           // barrel track: normal tracks table
-          if (trackIndex.isAmbiguous() && mGIDToTableID.find(trackIndex) != mGIDToTableID.end()) { // was it already stored ?
+          if (trackIndex.isAmbiguous() && mGIDToTableID.contains(trackIndex)) { // was it already stored ?
             continue;
           }
-          auto extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+          // use the info precomputed in parallel, if available
+          int infoIndex = mBarrelInfoIndex.empty() ? -1 : mBarrelInfoIndex[ti];
+          auto extraInfoHolder = infoIndex < 0 ? processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap) : mBarrelInfo[infoIndex];
           if (extraInfoHolder.trackTimeRes < 0.f) { // failed or rejected?
             LOG(warning) << "Barrel track " << trackIndex << " has no time set, rejection is not expected : time=" << extraInfoHolder.trackTime
                          << " timeErr=" << extraInfoHolder.trackTimeRes << " BCSlice: " << extraInfoHolder.bcSlice[0] << ":" << extraInfoHolder.bcSlice[1];
@@ -348,7 +350,7 @@ template <typename FwdTracksCursorType, typename FwdTracksCovCursorType, typenam
 void AODProducerWorkflowDPL::addToFwdTracksTable(FwdTracksCursorType& fwdTracksCursor, FwdTracksCovCursorType& fwdTracksCovCursor,
                                                  AmbigFwdTracksCursorType& ambigFwdTracksCursor, GIndex trackID,
                                                  const o2::globaltracking::RecoContainer& data, int collisionID, std::uint64_t collisionBC,
-                                                 const std::map<uint64_t, int>& bcsMap)
+                                                 const BCsMap& bcsMap)
 {
 
   // table columns must be floats, not double
@@ -774,13 +776,8 @@ void AODProducerWorkflowDPL::fillMCTrackLabelsTable(const MCTrackLabelCursorType
       const auto trackIndex = primVerGIs[ti];
 
       // check if the label was already stored (or the track was rejected for some reason in the fillTrackTablesPerCollision)
-      auto needToStore = [trackIndex](std::unordered_map<GIndex, int>& mp) {
-        auto entry = mp.find(trackIndex);
-        if (entry == mp.end() || entry->second == -1) {
-          return false;
-        }
-        entry->second = -1;
-        return true;
+      auto needToStore = [trackIndex](GIDToTableIDMap& mp) {
+        return mp.consume(trackIndex);
       };
 
       if (GIndex::includesSource(src, mInputSources)) {
@@ -860,16 +857,12 @@ void AODProducerWorkflowDPL::fillSecondaryVertices(const o2::globaltracking::Rec
     auto trPosID = v0.getProngID(0);
     auto trNegID = v0.getProngID(1);
     int posTableIdx = -1, negTableIdx = -1, collID = -1;
-    auto item = mGIDToTableID.find(trPosID);
-    if (item != mGIDToTableID.end()) {
-      posTableIdx = item->second;
-    } else {
+    posTableIdx = mGIDToTableID.find(trPosID);
+    if (posTableIdx == -1) {
       LOG(warn) << "Could not find a positive track index for prong ID " << trPosID;
     }
-    item = mGIDToTableID.find(trNegID);
-    if (item != mGIDToTableID.end()) {
-      negTableIdx = item->second;
-    } else {
+    negTableIdx = mGIDToTableID.find(trNegID);
+    if (negTableIdx == -1) {
       LOG(warn) << "Could not find a negative track index for prong ID " << trNegID;
     }
     auto itemV = mVtxToTableCollID.find(v0.getVertexID());
@@ -892,10 +885,8 @@ void AODProducerWorkflowDPL::fillSecondaryVertices(const o2::globaltracking::Rec
     }
     int v0tableID = itemV0->second, bachTableIdx = -1, collID = -1;
     auto bachelorID = cascade.getBachelorID();
-    auto item = mGIDToTableID.find(bachelorID);
-    if (item != mGIDToTableID.end()) {
-      bachTableIdx = item->second;
-    } else {
+    bachTableIdx = mGIDToTableID.find(bachelorID);
+    if (bachTableIdx == -1) {
       LOG(warn) << "Could not find a bachelor track index";
       continue;
     }
@@ -971,7 +962,7 @@ uint8_t AODProducerWorkflowDPL::getTRDPattern(const o2::trd::TrackTRD& track)
 // currently hardcoded for EMCal, can be expanded for PHOS
 template <typename TCaloCells, typename TCaloTriggerRecord, typename TCaloCursor, typename TCaloTRGTableCursor>
 void AODProducerWorkflowDPL::fillCaloTable(const TCaloCells& calocells, const TCaloTriggerRecord& caloCellTRGR, const TCaloCursor& caloCellCursor,
-                                           const TCaloTRGTableCursor& caloCellTRGTableCursor, std::map<uint64_t, int>& bcsMap)
+                                           const TCaloTRGTableCursor& caloCellTRGTableCursor, BCsMap& bcsMap)
 {
   uint64_t globalBC = 0;    // global BC ID
   uint64_t globalBCRel = 0; // BC id reltive to minGlBC (from FIT)
@@ -993,11 +984,8 @@ void AODProducerWorkflowDPL::fillCaloTable(const TCaloCells& calocells, const TC
     // check with Markus if globalBC ID is needed or globalBC - minGlBC
     // in case of collision vertex what is used is
     // uint64_t globalBC = std::round(tsTimeStamp / o2::constants::lhc::LHCBunchSpacingNS);
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getBCID(globalBC);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a EMCal point; globalBC = " << globalBC;
     }
 
@@ -1039,6 +1027,13 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   mRecoOnly = ic.options().get<int>("reco-mctracks-only");
   mTruncate = ic.options().get<int>("enable-truncation");
   mRunNumber = ic.options().get<int>("run-number");
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(warning) << "Multithreading is not supported, imposing single thread";
+    mNThreads = 1;
+  }
+#endif
 
   if (mTFNumber == -1L) {
     LOG(info) << "TFNumber will be obtained from CCDB";
@@ -1128,6 +1123,8 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   fResFile->Close();
 
   mTimer.Reset();
+  mTimerTracks.Stop();
+  mTimerTracks.Reset();
 }
 
 void AODProducerWorkflowDPL::run(ProcessingContext& pc)
@@ -1264,11 +1261,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
       }
     }
     uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getBCID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
     }
     fv0aCursor(0,
@@ -1281,11 +1275,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   for (auto zdcRecData : zdcBCRecData) {
     uint64_t bc = zdcRecData.ir.toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getBCID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
     }
     float energyZEM1 = 0;
@@ -1364,11 +1355,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     for (int iCol = 0; iCol < nMCCollisions; iCol++) {
       auto time = mcRecords[iCol].getTimeNS();
       auto globalBC = mcRecords[iCol].toLong();
-      auto item = bcsMap.find(globalBC);
-      int bcID = -1;
-      if (item != bcsMap.end()) {
-        bcID = item->second;
-      } else {
+      int bcID = bcsMap.getBCID(globalBC);
+      if (bcID < 0) {
         LOG(fatal) << "Error: could not find a corresponding BC ID for MC collision; BC = " << globalBC << ", mc collision = " << iCol;
       }
       auto& colParts = mcParts[iCol];
@@ -1417,11 +1405,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
     uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
     uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getBCID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
     }
     fddCursor(0,
@@ -1457,11 +1442,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
     uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
     uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getBCID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
     }
     ft0Cursor(0,
@@ -1487,6 +1469,11 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   cacheTriggers(recoData);
 
+  mTimerTracks.Start(false);
+  if (mNThreads > 1 && !primVer2TRefs.empty()) {
+    prepareBarrelTracks(primVer2TRefs, primVerGIs, recoData, bcsMap);
+  }
+
   // filling unassigned tracks first
   // so that all unassigned tracks are stored in the beginning of the table together
   auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
@@ -1506,11 +1493,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     LOG(debug) << "global BC " << globalBC << " local BC " << localBC << " relative interaction time " << interactionTime;
     // collision timestamp in ns wrt the beginning of collision BC
     const float relInteractionTime = static_cast<float>(localBC * o2::constants::lhc::LHCBunchSpacingNS - interactionTime);
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getBCID(globalBC);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a collision; BC = " << globalBC << ", collisionID = " << collisionID;
     }
     collisionsCursor(0,
@@ -1538,6 +1522,9 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
                                 fwdTracksCursor, fwdTracksCovCursor, ambigFwdTracksCursor, bcsMap);
     collisionID++;
   }
+  mBarrelInfoIndex.clear();
+  mBarrelInfo.clear();
+  mTimerTracks.Stop();
 
   fillSecondaryVertices(recoData, v0sCursor, cascadesCursor);
 
@@ -1553,8 +1540,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   // filling BC table
   uint64_t triggerMask = 0;
-  for (auto& item : bcsMap) {
-    uint64_t bc = item.first;
+  for (auto bc : bcsMap) {
     if (mInputSources[GID::CTP]) {
       auto bcClassPair = bcToClassMask.find(bc);
       if (bcClassPair != bcToClassMask.end()) {
@@ -1688,8 +1674,61 @@ void AODProducerWorkflowDPL::cacheTriggers(const o2::globaltracking::RecoContain
   }
 }
 
+void AODProducerWorkflowDPL::prepareBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& primVer2TRefs, const gsl::span<const GIndex>& GIndices,
+                                                 const o2::globaltracking::RecoContainer& data, const BCsMap& bcsMap)
+{
+  // Enumerate barrel tracks in the order they are filled by fillTrackTablesPerCollision: unassigned tracks first,
+  // then collision by collision. The ambiguous tracks are processed only for their 1st occurrence, as they are stored once.
+  // The processing of the selected tracks is then done in parallel, the table cursors are filled serially from the results,
+  // so the output does not depend on the number of threads.
+  struct BarrelTrackRef {
+    int collisionID = -1;
+    int entry = -1; // position in GIndices
+    std::uint64_t collisionBC = 0;
+  };
+  std::vector<BarrelTrackRef> refs;
+  refs.reserve(GIndices.size());
+  mBarrelInfoIndex.clear();
+  mBarrelInfoIndex.resize(GIndices.size(), -1);
+  GIDToTableIDMap seen;
+  int nVertices = primVer2TRefs.size() - 1; // last slot refers to unassigned tracks
+  const auto& primVertices = data.getPrimaryVertices();
+  for (int iref = -1; iref < nVertices; iref++) {
+    const auto& trackRef = primVer2TRefs[iref < 0 ? nVertices : iref];
+    std::uint64_t collisionBC = iref < 0 ? std::uint64_t(-1) : relativeTime_to_GlobalBC(primVertices[iref].getTimeStamp().getTimeStamp() * 1E3);
+    for (int src = GIndex::NSources; src--;) {
+      if (!GIndex::includesSource(src, mInputSources) || src == GIndex::Source::MFT || src == GIndex::Source::MCH || src == GIndex::Source::MFTMCH) {
+        continue;
+      }
+      int start = trackRef.getFirstEntryOfSource(src);
+      int end = start + trackRef.getEntriesOfSource(src);
+      for (int ti = start; ti < end; ti++) {
+        const auto& trackIndex = GIndices[ti];
+        if (trackIndex.isAmbiguous()) {
+          if (seen.contains(trackIndex)) { // eventual later occurrences of rejected tracks are processed on the fly
+            continue;
+          }
+          seen.emplace(trackIndex, ti);
+        }
+        mBarrelInfoIndex[ti] = refs.size();
+        refs.push_back({iref, ti, collisionBC});
+      }
+    }
+  }
+  mBarrelInfo.clear();
+  mBarrelInfo.resize(refs.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < int(refs.size()); i++) {
+    const auto& ref = refs[i];
+    mBarrelInfo[i] = processBarrelTrack(ref.collisionID, ref.collisionBC, GIndices[ref.entry], data, bcsMap);
+  }
+  LOGP(debug, "Precomputed {} barrel tracks info with {} threads", refs.size(), mNThreads);
+}
+
 AODProducerWorkflowDPL::TrackExtraInfo AODProducerWorkflowDPL::processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
-                                                                                  const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+                                                                                  const o2::globaltracking::RecoContainer& data, const BCsMap& bcsMap)
 {
   TrackExtraInfo extraInfoHolder;
   if (collisionID < 0) {
@@ -1814,7 +1853,7 @@ void AODProducerWorkflowDPL::updateTimeDependentParams(ProcessingContext& pc)
 }
 
 void AODProducerWorkflowDPL::addRefGlobalBCsForTOF(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices,
-                                                   const o2::globaltracking::RecoContainer& data, std::map<uint64_t, int>& bcsMap)
+                                                   const o2::globaltracking::RecoContainer& data, BCsMap& bcsMap)
 {
   // Orphan tracks need to refer to some globalBC and for tracks with TOF this BC should be whithin an orbit
   // from the track abs time (to guarantee time precision). Therefore, we may need to insert some dummy globalBCs
@@ -1864,8 +1903,8 @@ void AODProducerWorkflowDPL::addRefGlobalBCsForTOF(const o2::dataformats::VtxTra
       auto bc = relativeTime_to_GlobalBC(tofSignal);
 
       auto it = bcsMap.lower_bound(bc);
-      if (it == bcsMap.end() || it->first > bc + maxGapBC) {
-        bcsMap.emplace_hint(it, bc, 1);
+      if (it == bcsMap.end() || *it > bc + maxGapBC) {
+        bcsMap.insert(it, bc);
         LOG(debug) << "adding dummy BC " << bc;
       }
       if (bc > maxBC) {
@@ -1874,18 +1913,12 @@ void AODProducerWorkflowDPL::addRefGlobalBCsForTOF(const o2::dataformats::VtxTra
     }
   }
   // make sure there is a globalBC exceeding the max encountered bc
-  if ((--bcsMap.end())->first <= maxBC) {
-    bcsMap.emplace_hint(bcsMap.end(), maxBC + 1, 1);
-  }
-  // renumber BCs
-  int bcID = 0;
-  for (auto& item : bcsMap) {
-    item.second = bcID;
-    bcID++;
+  if (bcsMap.back() <= maxBC) {
+    bcsMap.insert(bcsMap.end(), maxBC + 1);
   }
 }
 
-std::uint64_t AODProducerWorkflowDPL::fillBCSlice(int (&slice)[2], double tmin, double tmax, const std::map<uint64_t, int>& bcsMap) const
+std::uint64_t AODProducerWorkflowDPL::fillBCSlice(int (&slice)[2], double tmin, double tmax, const BCsMap& bcsMap) const
 {
   // for ambiguous tracks (no or multiple vertices) we store the BC slice corresponding to track time window used for track-vertex matching,
   // see VertexTrackMatcher::extractTracks creator method, i.e. central time estimated +- uncertainty defined as:
@@ -1905,9 +1938,9 @@ std::uint64_t AODProducerWorkflowDPL::fillBCSlice(int (&slice)[2], double tmin,
   }
   slice[0] = std::distance(bcsMap.begin(), lower);
   slice[1] = std::distance(bcsMap.begin(), upper);
-  auto bcOfTimeRef = lower->first - this->mStartIR.toLong();
-  LOG(debug) << "BC slice t:" << tmin << " " << slice[0] << "(" << lower->first << "/" << lower->second << ")"
-             << " t: " << tmax << " " << slice[1] << "(" << upper->first << "/" << upper->second << ")"
+  auto bcOfTimeRef = *lower - this->mStartIR.toLong();
+  LOG(debug) << "BC slice t:" << tmin << " " << slice[0] << "(" << *lower << ")"
+             << " t: " << tmax << " " << slice[1] << "(" << *upper << ")"
              << " bcref: " << bcOfTimeRef;
   return bcOfTimeRef;
 }
@@ -1916,6 +1949,8 @@ void AODProducerWorkflowDPL::endOfStream(EndOfStreamContext& ec)
 {
   LOGF(info, "aod producer dpl total timing: Cpu: %.3e Real: %.3e s in %d slots",
        mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
+  LOGF(info, "aod producer track tables filling with %d threads: Cpu: %.3e Real: %.3e s",
+       mNThreads, mTimerTracks.CpuTime(), mTimerTracks.RealTime());
 }
 
 DataProcessorSpec getAODProducerWorkflowSpec(GID::mask_t src, bool enableSV, bool useMC, std::string resFile)
@@ -1981,6 +2016,7 @@ DataProcessorSpec getAODProducerWorkflowSpec(GID::mask_t src, bool enableSV, boo
       ConfigParamSpec{"anchor-pass", VariantType::String, "", {"AnchorPassName"}},
       ConfigParamSpec{"anchor-prod", VariantType::String, "", {"AnchorProduction"}},
       ConfigParamSpec{"reco-pass", VariantType::String, "", {"RecoPassName"}},
+      ConfigParamSpec{"nthreads", VariantType::Int, 1, {"Number of threads used to process barrel tracks"}},
       ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}}};
 }
 
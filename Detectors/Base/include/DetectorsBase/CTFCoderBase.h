@@ -55,6 +55,15 @@ class CTFCoderBase
   template <typename CTF>
   void createCodersFromFile(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op);
 
+  /// recreate the coders if the dictionary file passed to createCodersFromFile was (re)written since,
+  /// e.g. by the CTF writer in the online dictionary mode. Meant to be called between TFs.
+  template <typename CTF>
+  bool updateCodersFromFile(o2::ctf::CTFCoderBase::OpType op);
+
+  /// name of the copy of the dictionary file dictPath with the version of given time stamp, e.g. ctf_dictionary_<stamp>.root.
+  /// Such copies are kept by the CTF writer in the online dictionary mode, the decoders use them for CTFs encoded with older versions.
+  static std::string getDictVersionFileName(const std::string& dictPath, uint32_t dictTimeStamp);
+
   template <typename S>
   void createCoder(OpType op, const o2::rans::RenormedFrequencyTable& renormedFrequencyTable, int slot)
   {
@@ -97,11 +106,21 @@ class CTFCoderBase
     }
   }
 
-  void checkDictVersion(const CTFDictHeader& h) const;
+  void checkDictVersion(const CTFDictHeader& h);
+  bool loadDictVersion(const CTFDictHeader& h);
+
+  template <typename CTF>
+  bool loadCodersFromFile(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op);
+
+  using DictLoader = bool (CTFCoderBase::*)(const std::string&, OpType);
 
   std::vector<std::shared_ptr<void>> mCoders; // encoders/decoders
   DetID mDet;
   CTFDictHeader mExtHeader;      // external dictionary header
+  std::string mDictPath{};       // dictionary file to watch for updates
+  std::filesystem::file_time_type mDictFileTime{};
+  DictLoader mDictLoader = nullptr; // recreates the coders from a dictionary file, set by createCodersFromFile
+  OpType mDictOpType = OpType::Decoder;
   float mMemMarginFactor = 1.0f; // factor for memory allocation in EncodedBlocks
   int mVerbosity = 0;
 };
@@ -126,6 +145,11 @@ template <typename CTF>
 void CTFCoderBase::createCodersFromFile(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op)
 {
   bool mayFail = true;
+  mDictPath = dictPath;
+  mDictLoader = &CTFCoderBase::loadCodersFromFile<CTF>;
+  mDictOpType = op;
+  std::error_code ec;
+  mDictFileTime = std::filesystem::last_write_time(dictPath, ec);
   auto buff = readDictionaryFromFile<CTF>(dictPath, mayFail);
   if (!buff.size()) {
     if (mayFail) {
@@ -136,6 +160,38 @@ void CTFCoderBase::createCodersFromFile(const std::string& dictPath, o2::ctf::CT
   createCoders(buff, op);
 }
 
+///________________________________
+template <typename CTF>
+bool CTFCoderBase::updateCodersFromFile(o2::ctf::CTFCoderBase::OpType op)
+{
+  if (mDictPath.empty()) {
+    return false;
+  }
+  std::error_code ec;
+  auto fileTime = std::filesystem::last_write_time(mDictPath, ec);
+  if (ec || fileTime == mDictFileTime) {
+    return false;
+  }
+  mDictFileTime = fileTime;
+  if (!loadCodersFromFile<CTF>(mDictPath, op)) {
+    return false;
+  }
+  LOGP(info, "{}coders recreated from updated dictionary {}", getPrefix(), mDictPath);
+  return true;
+}
+
+///________________________________
+template <typename CTF>
+bool CTFCoderBase::loadCodersFromFile(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op)
+{
+  auto buff = readDictionaryFromFile<CTF>(dictPath, true);
+  if (!buff.size()) {
+    return false;
+  }
+  createCoders(buff, op);
+  return true;
+}
+
 ///________________________________
 template <typename CTF>
 std::vector<char> CTFCoderBase::readDictionaryFromFile(const std::string& dictPath, bool mayFail)
@@ -14,14 +14,54 @@
 /// \author ruben.shahoyan@cern.ch
 
 #include "DetectorsBase/CTFCoderBase.h"
+#include <map>
 
 using namespace o2::ctf;
 
-void CTFCoderBase::checkDictVersion(const CTFDictHeader& h) const
+void CTFCoderBase::checkDictVersion(const CTFDictHeader& h)
 {
   if (h.isValidDictTimeStamp()) { // external dictionary was used
-    if (h.isValidDictTimeStamp() && h != mExtHeader) {
+    if (h != mExtHeader && !loadDictVersion(h)) {
       throw std::runtime_error(fmt::format("Mismatch in {} CTF dictionary: need {}, provided {}", mDet.getName(), h.asString(), mExtHeader.asString()));
     }
   }
 }
+
+bool CTFCoderBase::loadDictVersion(const CTFDictHeader& h)
+{
+  // Look for the dictionary version used by the CTF among the versioned copies of the dictionary file.
+  // A copy contains all dictionaries valid at its time stamp, so the copies not older than the version are tried in increasing order.
+  if (mDictPath.empty() || !mDictLoader) {
+    return false;
+  }
+  std::filesystem::path dictPath(mDictPath);
+  auto dir = dictPath.has_parent_path() ? dictPath.parent_path() : std::filesystem::path(".");
+  auto prefix = dictPath.stem().string() + '_';
+  auto ext = dictPath.extension().string();
+  std::map<uint32_t, std::string> versions;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+    auto name = entry.path().filename().string();
+    if (name.size() <= prefix.size() + ext.size() || name.compare(0, prefix.size(), prefix) || name.compare(name.size() - ext.size(), ext.size(), ext)) {
+      continue;
+    }
+    auto stamp = name.substr(prefix.size(), name.size() - prefix.size() - ext.size());
+    if (stamp.find_first_not_of("0123456789") == std::string::npos && std::stoul(stamp) >= h.dictTimeStamp) {
+      versions[std::stoul(stamp)] = entry.path().string();
+    }
+  }
+  for (const auto& ver : versions) {
+    if ((this->*mDictLoader)(ver.second, mDictOpType) && h == mExtHeader) {
+      LOGP(info, "{}switched to {} from {}", getPrefix(), h.asString(), ver.second);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string CTFCoderBase::getDictVersionFileName(const std::string& dictPath, uint32_t dictTimeStamp)
+{
+  std::filesystem::path path(dictPath);
+  path.replace_filename(fmt::format("{}_{}{}", path.stem().string(), dictTimeStamp, path.extension().string()));
+  return path.string();
+}
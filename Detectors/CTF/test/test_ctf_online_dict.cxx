@@ -0,0 +1,164 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CTFOnlineDict
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CTFWorkflow/CTFWriterSpec.h"
+#include "Framework/ConfigParamStore.h"
+#include "Framework/ConfigParamRegistry.h"
+#include "Framework/SimpleOptionsRetriever.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/InitContext.h"
+#include "FV0Reconstruction/CTFCoder.h"
+#include "FV0Base/Constants.h"
+#include "CommonUtils/NameConf.h"
+#include "CommonUtils/StringUtils.h"
+#include "Framework/Logger.h"
+#include <TRandom.h>
+#include <filesystem>
+
+using namespace o2::fv0;
+using namespace o2::framework;
+using DetID = o2::detectors::DetID;
+
+namespace
+{
+constexpr int NTFWindow = 3; // TFs per window of the online dictionary refresh
+
+void generateDigits(std::vector<BCData>& digits, std::vector<ChannelData>& channels, int nDigits, int maxCharge)
+{
+  Triggers trigger;
+  o2::InteractionRecord ir(0, 0);
+  constexpr int MAXChan = Constants::nChannelsPerPm * Constants::nPms;
+  for (int idig = 0; idig < nDigits; idig++) {
+    ir += 1 + gRandom->Integer(200);
+    uint8_t ich = gRandom->Poisson(10);
+    auto start = channels.size();
+    while (ich < MAXChan) {
+      int16_t t = -256 + gRandom->Integer(512);
+      uint16_t q = gRandom->Integer(maxCharge);
+      channels.emplace_back(ich, t, q);
+      ich += 1 + gRandom->Poisson(10);
+    }
+    trigger.triggerSignals = gRandom->Integer(255);
+    digits.emplace_back(start, channels.size() - start, ir, trigger);
+  }
+}
+
+struct EncodedTF {
+  std::vector<o2::ctf::BufferType> ctf;
+  std::vector<BCData> digits;
+  std::vector<ChannelData> channels;
+};
+
+uint32_t getDictTimeStamp(const std::vector<o2::ctf::BufferType>& vec)
+{
+  return static_cast<const o2::ctf::CTFDictHeader&>(CTF::get(vec.data())->getHeader()).dictTimeStamp;
+}
+
+/// encode a window of TFs as the FV0 entropy encoder does, picking up the refreshed dictionary before every TF, and pass them to the CTF writer
+void processWindow(o2::ctf::CTFWriterSpec& writer, CTFCoder& encoder, int maxCharge, std::vector<EncodedTF>& tfs)
+{
+  for (int itf = 0; itf < NTFWindow; itf++) {
+    auto& tf = tfs.emplace_back();
+    generateDigits(tf.digits, tf.channels, 500, maxCharge);
+    encoder.updateCodersFromFile<CTF>(o2::ctf::CTFCoderBase::OpType::Encoder);
+    encoder.encode(tf.ctf, tf.digits, tf.channels);
+    writer.accumulateDictionary(DetID::FV0, CTF::getImage(tf.ctf.data()));
+    writer.checkOnlineDictionaries();
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(CTFOnlineDictTest)
+{
+  const std::string dictDir = "test_ctf_online_dict";
+  std::filesystem::remove_all(dictDir);
+  std::filesystem::create_directory(dictDir);
+  const auto dictFile = o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(dictDir), o2::base::NameConf::CTFDICT, ".root");
+  gRandom->SetSeed(1234);
+
+  // CTF writer in the online dictionary mode, configured as by DPL
+  auto spec = o2::ctf::getCTFWriterSpec(DetID::getMask(DetID::FV0), 0, "none", 0);
+  boost::property_tree::ptree opt;
+  opt.put<std::string>("ctf-dict-dir", dictDir);
+  opt.put<int>("online-dict-min-tf", NTFWindow);
+  opt.put<float>("online-dict-max-loss", 0.05f);
+  std::vector<std::unique_ptr<ParamRetriever>> retrievers;
+  retrievers.emplace_back(std::make_unique<SimpleOptionsRetriever>(opt, "test"));
+  auto store = std::make_unique<ConfigParamStore>(spec.options, std::move(retrievers));
+  store->preload();
+  store->activate();
+  ConfigParamRegistry registry(std::move(store));
+  ServiceRegistry services;
+  InitContext ic(registry, services);
+  o2::ctf::CTFWriterSpec writer(DetID::getMask(DetID::FV0), 0, "none", 0);
+  writer.init(ic);
+
+  CTFCoder encoder;
+  encoder.createCodersFromFile<CTF>(dictFile, o2::ctf::CTFCoderBase::OpType::Encoder);
+  std::vector<EncodedTF> tfs;
+
+  // 1st refresh: no dictionary yet, the CTFs carry per-TF dictionaries
+  processWindow(writer, encoder, 512, tfs);
+  BOOST_REQUIRE(std::filesystem::exists(dictFile));
+  for (const auto& tf : tfs) {
+    BOOST_CHECK_EQUAL(getDictTimeStamp(tf.ctf), 0);
+  }
+
+  // same statistics: the encoder uses the 1st version, whose loss is too small for a refresh
+  processWindow(writer, encoder, 512, tfs);
+  const auto stamp1 = getDictTimeStamp(tfs.back().ctf);
+  BOOST_CHECK(stamp1 != 0);
+  BOOST_CHECK(std::filesystem::exists(o2::ctf::CTFCoderBase::getDictVersionFileName(dictFile, stamp1)));
+  for (int itf = NTFWindow; itf < 2 * NTFWindow; itf++) {
+    BOOST_CHECK_EQUAL(getDictTimeStamp(tfs[itf].ctf), stamp1);
+    BOOST_CHECK_EQUAL(CTF::getImage(tfs[itf].ctf.data()).getBlock(CTF::BLC_charge).getNDict(), 0);
+  }
+
+  // 2nd refresh: the charges drift out of the dictionary and end up in literals. The blocks carry no frequencies,
+  // the new version is built from the symbols decoded by the writer
+  processWindow(writer, encoder, 768, tfs);
+  size_t nLiteralsDrift = 0;
+  for (int itf = 2 * NTFWindow; itf < 3 * NTFWindow; itf++) {
+    const auto image = CTF::getImage(tfs[itf].ctf.data());
+    BOOST_CHECK_EQUAL(getDictTimeStamp(tfs[itf].ctf), stamp1);
+    BOOST_CHECK_EQUAL(image.getBlock(CTF::BLC_charge).getNDict(), 0);
+    nLiteralsDrift += image.getMetadata(CTF::BLC_charge).nLiterals;
+  }
+  BOOST_CHECK(nLiteralsDrift > 0);
+
+  // the encoder follows the drift with the 2nd version
+  processWindow(writer, encoder, 768, tfs);
+  const auto stamp2 = getDictTimeStamp(tfs.back().ctf);
+  BOOST_CHECK(stamp2 > stamp1);
+  BOOST_CHECK(std::filesystem::exists(o2::ctf::CTFCoderBase::getDictVersionFileName(dictFile, stamp2)));
+  size_t nLiteralsRefreshed = 0;
+  for (int itf = 3 * NTFWindow; itf < 4 * NTFWindow; itf++) {
+    BOOST_CHECK_EQUAL(getDictTimeStamp(tfs[itf].ctf), stamp2);
+    nLiteralsRefreshed += CTF::getImage(tfs[itf].ctf.data()).getMetadata(CTF::BLC_charge).nLiterals;
+  }
+  BOOST_CHECK(nLiteralsRefreshed < nLiteralsDrift / 10);
+
+  // all the CTFs are decoded with the dictionary file and the versions kept by the writer
+  CTFCoder decoder;
+  decoder.createCodersFromFile<CTF>(dictFile, o2::ctf::CTFCoderBase::OpType::Decoder);
+  for (const auto& tf : tfs) {
+    std::vector<BCData> digitsD;
+    std::vector<ChannelData> channelsD;
+    decoder.decode(CTF::getImage(tf.ctf.data()), digitsD, channelsD);
+    BOOST_CHECK(digitsD == tf.digits);
+    BOOST_CHECK(channelsD == tf.channels);
+  }
+  std::filesystem::remove_all(dictDir);
+}
@@ -35,6 +35,8 @@ struct CTFReaderInp {
   int64_t delay_us = 0;
   int maxLoops = 0;
   int maxTFs = -1;
+  int readAhead = 0;                     // number of CTFs to read in advance on a separate thread (0: read synchronously)
+  size_t readAheadMemory = 1024ul << 20; // max size of the CTFs read in advance, at least 1 CTF is always allowed
 };
 
 /// create a processor spec
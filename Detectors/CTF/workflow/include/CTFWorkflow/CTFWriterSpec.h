@@ -17,12 +17,226 @@
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
 #include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFDictHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/FileMetaData.h"
+#include "Headers/DataHeader.h"
+#include "rANS/rans.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <TStopwatch.h>
+#include <array>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace o2
 {
 namespace ctf
 {
 
+using DetID = o2::detectors::DetID;
+using FTrans = o2::rans::FrequencyTable;
+using DictDecoder = o2::rans::LiteralDecoder64<int32_t>;
+
+class CTFWriterSpec : public o2::framework::Task
+{
+ public:
+  CTFWriterSpec() = delete;
+  CTFWriterSpec(DetID::mask_t dm, uint64_t r, const std::string& outType, int verbosity);
+  ~CTFWriterSpec() final { finalize(); }
+  void init(o2::framework::InitContext& ic) final;
+  void run(o2::framework::ProcessingContext& pc) final;
+  void endOfStream(o2::framework::EndOfStreamContext& ec) final { finalize(); }
+  void stop() final { finalize(); }
+  bool isPresent(DetID id) const { return mDets[id]; }
+
+  /// account the CTF of the detector in the dictionaries creation, done by run() for every TF
+  template <typename C>
+  void accumulateDictionary(DetID det, const C& ctfImage);
+  /// in the online dictionary mode decide at the end of the TF which dictionaries should be refreshed, done by run()
+  void checkOnlineDictionaries();
+
+ private:
+  template <typename C>
+  size_t processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree);
+  template <typename C>
+  void storeDictionary(DetID det, CTFHeader& header);
+  void storeDictionaries();
+  template <typename C>
+  void loadDictionary(DetID det, TTree& tree, const CTFHeader& header);
+  void loadDictionaries();
+  template <typename C>
+  void createDictDecoders(DetID det);
+  template <typename B>
+  void addDecodedSymbols(FTrans& freq, const B& block, const o2::ctf::Metadata& md, const DictDecoder& decoder);
+  void prepareDictionaryTreeAndFile(DetID det);
+  void closeDictionaryTreeAndFile(CTFHeader& header);
+  std::string dictionaryFileName(const std::string& detName = "", uint32_t version = 0);
+  void closeTFTreeAndFile();
+  void prepareTFTreeAndFile(const o2::header::DataHeader* dh);
+  size_t estimateCTFSize(o2::framework::ProcessingContext& pc);
+  size_t getAvailableDiskSpace(const std::string& path, int level);
+  void createLockFile(const o2::header::DataHeader* dh, int level);
+  void removeLockFile();
+  void finalize();
+
+  DetID::mask_t mDets; // detectors
+  bool mFinalized = false;
+  bool mWriteCTF = true;
+  bool mCreateDict = false;
+  bool mDictPerDetector = false;
+  bool mCreateRunEnvDir = true;
+  bool mStoreMetaFile = false;
+  int mVerbosity = 0;
+  int mSaveDictAfter = 0; // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
+  int mFlagMinDet = 1;    // append list of detectors to LHC period if their number is <= mFlagMinDet
+  uint64_t mRun = 0;
+  size_t mMinSize = 0;               // if > 0, accumulate CTFs in the same tree until the total size exceeds this minimum
+  size_t mMaxSize = 0;               // if > MinSize, and accumulated size will exceed this value, stop accumulation (even if mMinSize is not reached)
+  size_t mChkSize = 0;               // if > 0 and fallback storage provided, reserve this size per CTF file in production on primary storage
+  size_t mAccCTFSize = 0;            // so far accumulated size (if any)
+  size_t mCurrCTFSize = 0;           // size of currently processed CTF
+  size_t mNCTF = 0;                  // total number of CTFs written
+  size_t mNAccCTF = 0;               // total number of CTFs accumulated in the current file
+  size_t mCTFAutoSave = 0;           // if > 0, autosave after so many TFs
+  size_t mNCTFFiles = 0;             // total number of CTF files written
+  int mMaxCTFPerFile = 0;            // max CTFs per files to store
+  std::vector<uint32_t> mTFOrbits{}; // 1st orbits of TF accumulated in current file
+
+  std::string mOutputType{}; // RS FIXME once global/local options clash is solved, --output-type will become device option
+  std::string mLHCPeriod{};
+  std::string mEnvironmentID{}; // partition env. id
+  std::string mDictDir{};
+  std::string mCTFDir{};
+  std::string mCTFDirFallBack = "/dev/null";
+  std::string mCTFMetaFileDir = "/dev/null";
+  std::string mCurrentCTFFileName{};
+  std::string mCurrentCTFFileNameFull{};
+  const std::string LOCKFileDir = "/tmp/ctf-writer-locks";
+  std::string mLockFileName{};
+  int mLockFD = -1;
+  std::unique_ptr<TFile> mCTFFileOut;
+  std::unique_ptr<TTree> mCTFTreeOut;
+  std::unique_ptr<o2::dataformats::FileMetaData> mCTFFileMetaData;
+
+  std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
+  std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
+
+  // For the external dictionary creation we accumulate for each detector the frequency tables of its each block
+  // After accumulation over multiple TFs we store the dictionaries data in the standard CTF format of this detector,
+  // i.e. EncodedBlock stored in a tree, BUT with dictionary data only added to each block.
+  // The metadata of the block (min,max) will be used for the consistency check at the decoding
+  std::array<std::vector<FTrans>, DetID::nDetectors> mFreqsAccumulation;
+  std::array<std::vector<o2::ctf::Metadata>, DetID::nDetectors> mFreqsMetaData;
+  std::array<std::shared_ptr<void>, DetID::nDetectors> mHeaders;
+  std::array<std::vector<char>, DetID::nDetectors> mDictBlocks; // last dictionary created for each detector
+
+  // In the online dictionary mode the dictionaries are refreshed while writing the CTFs: for every window of
+  // mOnlineDictMinTFs TFs the fraction of the CTF size spent on the per-TF dictionaries and on the literals is
+  // measured, and if it exceeds mOnlineDictMaxLoss the dictionary of the detector is rebuilt from the window
+  // statistics. Every refresh is written to a new file carrying the version time stamp in its name, which also
+  // keeps the current dictionaries of the other detectors, and is then copied to the dictionary file watched by
+  // the entropy encoders, which pick it up at the next TF. The older versions are kept for decoding the CTFs.
+  // Blocks encoded with an external dictionary carry no frequencies, their statistics is obtained by decoding
+  // them with the last dictionary version of the writer. TFs encoded with another version are not sampled.
+  struct OnlineDictStat {
+    size_t lossBytes = 0; // bytes of per-TF dictionaries and literals
+    size_t totBytes = 0;
+    int nTFs = 0;
+    int nSampledTFs = 0; // TFs whose symbol frequencies were accumulated
+  };
+  std::array<OnlineDictStat, DetID::nDetectors> mOnlineDictStat;
+  std::array<std::vector<std::unique_ptr<DictDecoder>>, DetID::nDetectors> mDictDecoders; // decoders of the last dictionary version, per block
+  std::array<o2::ctf::CTFDictHeader, DetID::nDetectors> mDictDecodersHeader;               // version of mDictDecoders
+  std::vector<int32_t> mSampledSymbols;                                                     // workspace for the decoded symbols
+  int mOnlineDictMinTFs = 0;        // if > 0, refresh dictionaries online with windows of so many TFs
+  float mOnlineDictMaxLoss = 0.f;   // max compression loss before refreshing the dictionary
+  DetID::mask_t mDictRefreshMask{}; // detectors whose dictionary is to be rebuilt in the online mode
+  uint32_t mDictTimeStamp = 0;      // time stamp of the latest dictionary version
+  std::string mCurrentDictFileName{};
+  std::string mWatchedDictFileName{}; // dictionary file read by the encoders
+  TStopwatch mTimer;
+
+  static const std::string TMPFileEnding;
+};
+
+//___________________________________________________________________
+template <typename C>
+void CTFWriterSpec::accumulateDictionary(DetID det, const C& ctfImage)
+{
+  if (!mFreqsAccumulation[det].size()) {
+    mFreqsAccumulation[det].resize(C::getNBlocks());
+    mFreqsMetaData[det].resize(C::getNBlocks());
+  }
+  if (!mHeaders[det]) { // store 1st header
+    mHeaders[det] = ctfImage.cloneHeader();
+    auto& hb = *static_cast<o2::ctf::CTFDictHeader*>(mHeaders[det].get());
+    hb.dictTimeStamp = uint32_t(std::time(nullptr));
+    hb.det = det;
+  }
+  const auto& decoders = mDictDecoders[det];
+  bool sample = true; // in the online mode the TF is sampled only if all its entropy encoded blocks provide the frequencies
+  if (mOnlineDictMinTFs > 0) {
+    auto& stat = mOnlineDictStat[det];
+    bool knownVersion = !decoders.empty() && static_cast<const o2::ctf::CTFDictHeader&>(ctfImage.getHeader()) == mDictDecodersHeader[det];
+    for (int ib = 0; ib < C::getNBlocks(); ib++) {
+      const auto& bl = ctfImage.getBlock(ib);
+      const auto& md = ctfImage.getMetadata(ib);
+      if (md.opt == o2::ctf::Metadata::OptStore::EENCODE && bl.getNData() && !bl.getNDict() &&
+          !(knownVersion && decoders[ib] && decoders[ib]->getMinSymbol() == md.min && (md.messageWordSize == 1 || md.messageWordSize == 2 || md.messageWordSize == 4))) {
+        sample = false;
+      }
+      stat.lossBytes += size_t(md.nDictWords + md.nLiteralWords) * md.streamSize;
+    }
+    stat.totBytes += ctfImage.size();
+    stat.nTFs++;
+    stat.nSampledTFs += sample;
+  }
+  if (!sample) {
+    return;
+  }
+  for (int ib = 0; ib < C::getNBlocks(); ib++) {
+    const auto& bl = ctfImage.getBlock(ib);
+    const auto& md = ctfImage.getMetadata(ib);
+    auto& freq = mFreqsAccumulation[det][ib];
+    if (bl.getNDict()) {
+      freq.addFrequencies(bl.getDict(), bl.getDict() + bl.getNDict(), md.min);
+    } else if (mOnlineDictMinTFs > 0 && md.opt == o2::ctf::Metadata::OptStore::EENCODE && bl.getNData()) {
+      addDecodedSymbols(freq, bl, md, *decoders[ib]);
+    } else {
+      continue;
+    }
+    mFreqsMetaData[det][ib] = o2::ctf::Metadata{0, 0, md.messageWordSize, md.coderType, md.streamSize, md.probabilityBits, md.opt, freq.getMinSymbol(), freq.getMaxSymbol(), (int)freq.size(), 0, 0};
+  }
+}
+
+//___________________________________________________________________
+template <typename B>
+void CTFWriterSpec::addDecodedSymbols(FTrans& freq, const B& block, const o2::ctf::Metadata& md, const DictDecoder& decoder)
+{
+  // The literals are stored with the size of the source type but its signedness is not known: the type is taken
+  // as signed if the dictionary has negative symbols.
+  const bool isSigned = decoder.getMinSymbol() < 0;
+  const auto* litBytes = reinterpret_cast<const uint8_t*>(block.getLiterals());
+  std::vector<int32_t> literals(md.nLiterals);
+  for (size_t i = 0; i < md.nLiterals; i++) {
+    const auto* lit = litBytes + i * md.messageWordSize;
+    if (md.messageWordSize == 1) {
+      literals[i] = isSigned ? int32_t(*reinterpret_cast<const int8_t*>(lit)) : int32_t(*lit);
+    } else if (md.messageWordSize == 2) {
+      literals[i] = isSigned ? int32_t(*reinterpret_cast<const int16_t*>(lit)) : int32_t(*reinterpret_cast<const uint16_t*>(lit));
+    } else {
+      literals[i] = *reinterpret_cast<const int32_t*>(lit);
+    }
+  }
+  mSampledSymbols.resize(md.messageLength);
+  decoder.process(block.getData() + block.getNData(), mSampledSymbols.begin(), md.messageLength, literals);
+  freq.addSamples(mSampledSymbols.begin(), mSampledSymbols.end());
+}
+
 /// create a processor spec
 framework::DataProcessorSpec getCTFWriterSpec(o2::detectors::DetID::mask_t dets, uint64_t run, const std::string& outType, int verbosity);
 
@@ -12,8 +12,18 @@
 /// @file   CTFReaderSpec.cxx
 
 #include <vector>
+#include <array>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <chrono>
 #include <TFile.h>
 #include <TTree.h>
+#include <TROOT.h>
+#include <Monitoring/Monitoring.h>
 
 #include "Framework/Logger.h"
 #include "Framework/ControlService.h"
@@ -67,6 +77,25 @@ bool readFromTree(TTree& tree, const std::string brname, T& dest, int ev = 0)
 
 using DetID = o2::detectors::DetID;
 
+/// CTF read from the tree, ready to be sent
+struct CTFPayload {
+  CTFHeader header;
+  std::array<std::vector<o2::ctf::BufferType>, DetID::nDetectors> buffers;
+  int ctfCounter = 0; // cumulative counter of CTFs seen, including the skipped ones
+  long treeEntry = 0;
+  bool inOutput = false; // the detector data was read directly to the output messages rather than to the buffers
+  std::string entryDesc;
+
+  size_t size() const
+  {
+    size_t sz = sizeof(CTFPayload);
+    for (const auto& buf : buffers) {
+      sz += buf.size();
+    }
+    return sz;
+  }
+};
+
 class CTFReaderSpec : public o2::framework::Task
 {
  public:
@@ -77,11 +106,16 @@ class CTFReaderSpec : public o2::framework::Task
 
  private:
   void openCTFFile(const std::string& flname);
-  void processTF(ProcessingContext& pc);
+  bool loadNextCTF(CTFPayload& ctf, ProcessingContext* pc);
+  void readCTF(CTFPayload& ctf, ProcessingContext* pc);
+  bool popCTF(CTFPayload& ctf, ProcessingContext& pc);
+  void readAheadLoop();
+  void processTF(ProcessingContext& pc, CTFPayload& ctf);
   void checkTreeEntries();
   void stopReader();
   template <typename C>
-  void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const;
+  void readDetector(DetID det, CTFPayload& ctf, ProcessingContext* pc) const;
+  void sendDetector(DetID det, const CTFPayload& ctf, ProcessingContext& pc) const;
   void setMessageHeader(ProcessingContext& pc, const CTFHeader& ctfHeader, const std::string& lbl, unsigned subspec = 0) const;
   void tryToFixCTFHeader(CTFHeader& ctfHeader) const;
   CTFReaderInp mInput{};
@@ -94,8 +128,20 @@ class CTFReaderSpec : public o2::framework::Task
   int mFilesRead = 0;
   long mLastSendTime = 0L;
   long mCurrTreeEntry = 0;
+  int mReadCounter = 0;   // cumulative counter of CTFs seen by the reader
   size_t mSelIDEntry = 0; // next CTFID to select from the mInput.ctfIDs (if non-empty)
   TStopwatch mTimer;
+  // read-ahead: the files and trees are accessed by mReadAheadThread only
+  std::thread mReadAheadThread;
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueNotFull;
+  std::condition_variable mQueueNotEmpty;
+  std::deque<CTFPayload> mQueue;
+  size_t mQueueSize = 0;    // memory used by the queued CTFs
+  bool mReaderDone = false; // no more CTFs will be queued
+  std::exception_ptr mReaderError;
+  std::atomic<bool> mStopReadAhead{false};
+  double mStallTime = 0.; // total time spent waiting for the reader, in s
 };
 
 ///_______________________________________
@@ -117,9 +163,21 @@ void CTFReaderSpec::stopReader()
   if (!mFileFetcher) {
     return;
   }
+  if (mReadAheadThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mQueueMutex);
+      mStopReadAhead = true;
+    }
+    mQueueNotFull.notify_all();
+    mReadAheadThread.join();
+    mQueue.clear();
+  }
   LOGP(info, "CTFReader stops processing, {} files read, {} files failed", mFilesRead - mNFailedFiles, mNFailedFiles);
   LOGP(info, "CTF reading total timing: Cpu: {:.3f} Real: {:.3f} s for {} TFs in {} loops",
        mTimer.CpuTime(), mTimer.RealTime(), mCTFCounter, mFileFetcher->getNLoops());
+  if (mInput.readAhead > 0) {
+    LOGP(info, "CTF read-ahead of {} TFs: {:.3f} s spent waiting for the reader", mInput.readAhead, mStallTime);
+  }
   mRunning = false;
   mFileFetcher->stop();
   mFileFetcher.reset();
@@ -139,6 +197,10 @@ void CTFReaderSpec::init(InitContext& ic)
   mFileFetcher->setMaxFilesInQueue(mInput.maxFileCache);
   mFileFetcher->setMaxLoops(mInput.maxLoops);
   mFileFetcher->start();
+  if (mInput.readAhead > 0) {
+    ROOT::EnableThreadSafety();
+    mReadAheadThread = std::thread(&CTFReaderSpec::readAheadLoop, this);
+  }
 }
 
 ///_______________________________________
@@ -175,32 +237,50 @@ void CTFReaderSpec::run(ProcessingContext& pc)
     usleep(1000000);
   }
 
-  std::string tfFileName;
-  if (mCTFCounter >= mInput.maxTFs || (!mInput.ctfIDs.empty() && mSelIDEntry >= mInput.ctfIDs.size())) { // done
-    LOG(info) << "All CTFs from selected range were injected, stopping";
+  CTFPayload ctf;
+  if (mRunning && (mInput.readAhead > 0 ? popCTF(ctf, pc) : loadNextCTF(ctf, &pc))) {
+    LOG(debug) << "TF " << ctf.ctfCounter << " of " << mInput.maxTFs << " loop " << mFileFetcher->getNLoops();
+    processTF(pc, ctf);
+  } else {
     mRunning = false;
   }
 
-  while (mRunning) {
+  if (!mRunning) {
+    pc.services().get<ControlService>().endOfStream();
+    pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+    stopReader();
+  }
+}
+
+///_______________________________________
+bool CTFReaderSpec::loadNextCTF(CTFPayload& ctf, ProcessingContext* pc)
+{
+  // find and read the next selected CTF, return false if there is none left.
+  // If the processing context is provided, the detector data is read directly to the output messages
+  while (!mStopReadAhead) {
+    if (mReadCounter >= mInput.maxTFs || (!mInput.ctfIDs.empty() && mSelIDEntry >= mInput.ctfIDs.size())) { // done
+      LOG(info) << "All CTFs from selected range were injected, stopping";
+      return false;
+    }
     if (mCTFTree) { // there is a tree open with multiple CTF
-      if (mInput.ctfIDs.empty() || mInput.ctfIDs[mSelIDEntry] == mCTFCounter) { // no selection requested or matching CTF ID is found
-        LOG(debug) << "TF " << mCTFCounter << " of " << mInput.maxTFs << " loop " << mFileFetcher->getNLoops();
+      if (mInput.ctfIDs.empty() || mInput.ctfIDs[mSelIDEntry] == mReadCounter) { // no selection requested or matching CTF ID is found
         mSelIDEntry++;
-        processTF(pc);
-        break;
+        readCTF(ctf, pc);
+        checkTreeEntries();
+        mReadCounter++;
+        return true;
       } else { // explict CTF ID selection list was provided and current entry is not selected
-        LOGP(info, "Skipping CTF${} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+        LOGP(info, "Skipping CTF${} ({} of {} in {})", mReadCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
         checkTreeEntries();
-        mCTFCounter++;
+        mReadCounter++;
         continue;
       }
     }
     //
-    tfFileName = mFileFetcher->getNextFileInQueue();
+    auto tfFileName = mFileFetcher->getNextFileInQueue();
     if (tfFileName.empty()) {
       if (!mFileFetcher->isRunning()) { // nothing expected in the queue
-        mRunning = false;
-        break;
+        return false;
       }
       usleep(5000); // wait 5ms for the files cache to be filled
       continue;
@@ -208,27 +288,102 @@ void CTFReaderSpec::run(ProcessingContext& pc)
     LOG(info) << "Reading CTF input " << ' ' << tfFileName;
     openCTFFile(tfFileName);
   }
+  return false;
+}
 
-  if (!mRunning) {
-    pc.services().get<ControlService>().endOfStream();
-    pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
-    stopReader();
+///_______________________________________
+void CTFReaderSpec::readCTF(CTFPayload& ctf, ProcessingContext* pc)
+{
+  ctf.ctfCounter = mReadCounter;
+  ctf.treeEntry = mCurrTreeEntry;
+  ctf.inOutput = pc != nullptr;
+  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctf.header, mCurrTreeEntry)) {
+    throw std::runtime_error("did not find CTFHeader");
+  }
+  if (ctf.header.creationTime == 0) { // try to repair header with ad hoc data
+    tryToFixCTFHeader(ctf.header);
+  }
+
+  readDetector<o2::itsmft::CTF>(DetID::ITS, ctf, pc);
+  readDetector<o2::itsmft::CTF>(DetID::MFT, ctf, pc);
+  readDetector<o2::emcal::CTF>(DetID::EMC, ctf, pc);
+  readDetector<o2::hmpid::CTF>(DetID::HMP, ctf, pc);
+  readDetector<o2::phos::CTF>(DetID::PHS, ctf, pc);
+  readDetector<o2::tpc::CTF>(DetID::TPC, ctf, pc);
+  readDetector<o2::trd::CTF>(DetID::TRD, ctf, pc);
+  readDetector<o2::ft0::CTF>(DetID::FT0, ctf, pc);
+  readDetector<o2::fv0::CTF>(DetID::FV0, ctf, pc);
+  readDetector<o2::fdd::CTF>(DetID::FDD, ctf, pc);
+  readDetector<o2::tof::CTF>(DetID::TOF, ctf, pc);
+  readDetector<o2::mid::CTF>(DetID::MID, ctf, pc);
+  readDetector<o2::mch::CTF>(DetID::MCH, ctf, pc);
+  readDetector<o2::cpv::CTF>(DetID::CPV, ctf, pc);
+  readDetector<o2::zdc::CTF>(DetID::ZDC, ctf, pc);
+  readDetector<o2::ctp::CTF>(DetID::CTP, ctf, pc);
+
+  ctf.entryDesc = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+}
+
+///_______________________________________
+void CTFReaderSpec::readAheadLoop()
+{
+  // keep the queue filled with up to mInput.readAhead CTFs within the memory budget
+  try {
+    while (true) {
+      CTFPayload ctf;
+      if (!loadNextCTF(ctf, nullptr)) {
+        break;
+      }
+      auto sz = ctf.size();
+      std::unique_lock<std::mutex> lock(mQueueMutex);
+      mQueueNotFull.wait(lock, [this, sz]() {
+        return mStopReadAhead || mQueue.empty() || (int(mQueue.size()) < mInput.readAhead && mQueueSize + sz <= mInput.readAheadMemory);
+      });
+      if (mStopReadAhead) {
+        break;
+      }
+      mQueueSize += sz;
+      mQueue.emplace_back(std::move(ctf));
+      mQueueNotEmpty.notify_one();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    mReaderError = std::current_exception();
   }
+  std::lock_guard<std::mutex> lock(mQueueMutex);
+  mReaderDone = true;
+  mQueueNotEmpty.notify_one();
 }
 
 ///_______________________________________
-void CTFReaderSpec::processTF(ProcessingContext& pc)
+bool CTFReaderSpec::popCTF(CTFPayload& ctf, ProcessingContext& pc)
+{
+  auto tStart = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mQueueMutex);
+  mQueueNotEmpty.wait(lock, [this]() { return !mQueue.empty() || mReaderDone; });
+  std::chrono::duration<double> stall = std::chrono::steady_clock::now() - tStart;
+  mStallTime += stall.count();
+  pc.services().get<o2::monitoring::Monitoring>().send(o2::monitoring::Metric{float(stall.count() * 1e3), "ctf-reader-stall-ms"});
+  if (mQueue.empty()) {
+    if (mReaderError) { // the reader failed, report it in the processing thread
+      std::rethrow_exception(mReaderError);
+    }
+    return false;
+  }
+  ctf = std::move(mQueue.front());
+  mQueue.pop_front();
+  mQueueSize -= ctf.size();
+  mQueueNotFull.notify_one();
+  return true;
+}
+
+///_______________________________________
+void CTFReaderSpec::processTF(ProcessingContext& pc, CTFPayload& ctf)
 {
   auto cput = mTimer.CpuTime();
   mTimer.Start(false);
-
-  CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
-    throw std::runtime_error("did not find CTFHeader");
-  }
-  if (ctfHeader.creationTime == 0) { // try to repair header with ad hoc data
-    tryToFixCTFHeader(ctfHeader);
-  }
+  mCTFCounter = ctf.ctfCounter;
+  const auto& ctfHeader = ctf.header;
 
   LOG(info) << ctfHeader;
 
@@ -236,34 +391,19 @@ void CTFReaderSpec::processTF(ProcessingContext& pc)
   pc.outputs().snapshot({"header"}, ctfHeader);
   setMessageHeader(pc, ctfHeader, "header");
 
-  processDetector<o2::itsmft::CTF>(DetID::ITS, ctfHeader, pc);
-  processDetector<o2::itsmft::CTF>(DetID::MFT, ctfHeader, pc);
-  processDetector<o2::emcal::CTF>(DetID::EMC, ctfHeader, pc);
-  processDetector<o2::hmpid::CTF>(DetID::HMP, ctfHeader, pc);
-  processDetector<o2::phos::CTF>(DetID::PHS, ctfHeader, pc);
-  processDetector<o2::tpc::CTF>(DetID::TPC, ctfHeader, pc);
-  processDetector<o2::trd::CTF>(DetID::TRD, ctfHeader, pc);
-  processDetector<o2::ft0::CTF>(DetID::FT0, ctfHeader, pc);
-  processDetector<o2::fv0::CTF>(DetID::FV0, ctfHeader, pc);
-  processDetector<o2::fdd::CTF>(DetID::FDD, ctfHeader, pc);
-  processDetector<o2::tof::CTF>(DetID::TOF, ctfHeader, pc);
-  processDetector<o2::mid::CTF>(DetID::MID, ctfHeader, pc);
-  processDetector<o2::mch::CTF>(DetID::MCH, ctfHeader, pc);
-  processDetector<o2::cpv::CTF>(DetID::CPV, ctfHeader, pc);
-  processDetector<o2::zdc::CTF>(DetID::ZDC, ctfHeader, pc);
-  processDetector<o2::ctp::CTF>(DetID::CTP, ctfHeader, pc);
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    sendDetector(DetID(id), ctf, pc);
+  }
 
   // send sTF acknowledge message
   {
     auto& stfDist = pc.outputs().make<o2::header::STFHeader>(OutputRef{"STFDist", 0xccdb});
-    stfDist.id = uint64_t(mCurrTreeEntry);
+    stfDist.id = uint64_t(ctf.treeEntry);
     stfDist.firstOrbit = ctfHeader.firstTForbit;
     stfDist.runNumber = uint32_t(ctfHeader.run);
     setMessageHeader(pc, ctfHeader, "STFDist", 0xccdb);
   }
 
-  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
-  checkTreeEntries();
   mTimer.Stop();
   // do we need to way to respect the delay ?
   long tNow = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
@@ -276,7 +416,7 @@ void CTFReaderSpec::processTF(ProcessingContext& pc)
     mLastSendTime = tNow;
   }
   tNow = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-  LOGP(info, "Read CTF#{} {} in {:.3f} s, {:.4f} s elapsed from previous CTF", mCTFCounter, entryStr, mTimer.CpuTime() - cput, 1e-6 * (tNow - mLastSendTime));
+  LOGP(info, "Read CTF#{} {} in {:.3f} s, {:.4f} s elapsed from previous CTF", mCTFCounter, ctf.entryDesc, mTimer.CpuTime() - cput, 1e-6 * (tNow - mLastSendTime));
   mLastSendTime = tNow;
   mCTFCounter++;
 }
@@ -312,17 +452,41 @@ void CTFReaderSpec::setMessageHeader(ProcessingContext& pc, const CTFHeader& ctf
 
 ///_______________________________________
 template <typename C>
-void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const
+void CTFReaderSpec::readDetector(DetID det, CTFPayload& ctf, ProcessingContext* pc) const
+{
+  // read to the output message if the context is provided, otherwise to the payload buffer to be sent later
+  auto readTo = [this, det, &ctf](auto& bufVec) {
+    if (ctf.header.detectors[det]) {
+      C::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrTreeEntry);
+    } else if (!mInput.allowMissingDetectors) {
+      throw std::runtime_error(fmt::format("Requested detector {} is missing in the CTF", det.getName()));
+    }
+  };
+  ctf.buffers[det].clear();
+  if (mInput.detMask[det]) {
+    if (pc) {
+      readTo(pc->outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, ctf.header.detectors[det] ? sizeof(C) : 0));
+    } else {
+      auto& bufVec = ctf.buffers[det];
+      bufVec.resize(ctf.header.detectors[det] ? sizeof(C) : 0);
+      readTo(bufVec);
+    }
+  }
+}
+
+///_______________________________________
+void CTFReaderSpec::sendDetector(DetID det, const CTFPayload& ctf, ProcessingContext& pc) const
 {
   if (mInput.detMask[det]) {
     const auto lbl = det.getName();
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl}, ctfHeader.detectors[det] ? sizeof(C) : 0);
-    if (ctfHeader.detectors[det]) {
-      C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
-    } else if (!mInput.allowMissingDetectors) {
-      throw std::runtime_error(fmt::format("Requested detector {} is missing in the CTF", lbl));
+    if (!ctf.inOutput) { // read ahead to the payload buffer, copy it to the output
+      const auto& src = ctf.buffers[det];
+      auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl}, src.size());
+      if (!src.empty()) {
+        memcpy(bufVec.data(), src.data(), src.size() * sizeof(o2::ctf::BufferType));
+      }
     }
-    setMessageHeader(pc, ctfHeader, lbl);
+    setMessageHeader(pc, ctf.header, lbl);
   }
 }
 
@@ -20,6 +20,7 @@
 #include <FairMQDevice.h>
 
 #include "CTFWorkflow/CTFWriterSpec.h"
+#include "DetectorsBase/CTFCoderBase.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "CommonUtils/NameConf.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
@@ -81,92 +82,6 @@ size_t appendToTree(TTree& tree, const std::string brname, T& ptr)
   return s;
 }
 
-using DetID = o2::detectors::DetID;
-using FTrans = o2::rans::FrequencyTable;
-
-class CTFWriterSpec : public o2::framework::Task
-{
- public:
-  CTFWriterSpec() = delete;
-  CTFWriterSpec(DetID::mask_t dm, uint64_t r, const std::string& outType, int verbosity);
-  ~CTFWriterSpec() final { finalize(); }
-  void init(o2::framework::InitContext& ic) final;
-  void run(o2::framework::ProcessingContext& pc) final;
-  void endOfStream(o2::framework::EndOfStreamContext& ec) final { finalize(); }
-  void stop() final { finalize(); }
-  bool isPresent(DetID id) const { return mDets[id]; }
-
- private:
-  template <typename C>
-  size_t processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree);
-  template <typename C>
-  void storeDictionary(DetID det, CTFHeader& header);
-  void storeDictionaries();
-  void prepareDictionaryTreeAndFile(DetID det);
-  void closeDictionaryTreeAndFile(CTFHeader& header);
-  std::string dictionaryFileName(const std::string& detName = "");
-  void closeTFTreeAndFile();
-  void prepareTFTreeAndFile(const o2::header::DataHeader* dh);
-  size_t estimateCTFSize(ProcessingContext& pc);
-  size_t getAvailableDiskSpace(const std::string& path, int level);
-  void createLockFile(const o2::header::DataHeader* dh, int level);
-  void removeLockFile();
-  void finalize();
-
-  DetID::mask_t mDets; // detectors
-  bool mFinalized = false;
-  bool mWriteCTF = true;
-  bool mCreateDict = false;
-  bool mDictPerDetector = false;
-  bool mCreateRunEnvDir = true;
-  bool mStoreMetaFile = false;
-  int mVerbosity = 0;
-  int mSaveDictAfter = 0; // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
-  int mFlagMinDet = 1;    // append list of detectors to LHC period if their number is <= mFlagMinDet
-  uint64_t mRun = 0;
-  size_t mMinSize = 0;               // if > 0, accumulate CTFs in the same tree until the total size exceeds this minimum
-  size_t mMaxSize = 0;               // if > MinSize, and accumulated size will exceed this value, stop accumulation (even if mMinSize is not reached)
-  size_t mChkSize = 0;               // if > 0 and fallback storage provided, reserve this size per CTF file in production on primary storage
-  size_t mAccCTFSize = 0;            // so far accumulated size (if any)
-  size_t mCurrCTFSize = 0;           // size of currently processed CTF
-  size_t mNCTF = 0;                  // total number of CTFs written
-  size_t mNAccCTF = 0;               // total number of CTFs accumulated in the current file
-  size_t mCTFAutoSave = 0;           // if > 0, autosave after so many TFs
-  size_t mNCTFFiles = 0;             // total number of CTF files written
-  int mMaxCTFPerFile = 0;            // max CTFs per files to store
-  std::vector<uint32_t> mTFOrbits{}; // 1st orbits of TF accumulated in current file
-
-  std::string mOutputType{}; // RS FIXME once global/local options clash is solved, --output-type will become device option
-  std::string mLHCPeriod{};
-  std::string mEnvironmentID{}; // partition env. id
-  std::string mDictDir{};
-  std::string mCTFDir{};
-  std::string mCTFDirFallBack = "/dev/null";
-  std::string mCTFMetaFileDir = "/dev/null";
-  std::string mCurrentCTFFileName{};
-  std::string mCurrentCTFFileNameFull{};
-  const std::string LOCKFileDir = "/tmp/ctf-writer-locks";
-  std::string mLockFileName{};
-  int mLockFD = -1;
-  std::unique_ptr<TFile> mCTFFileOut;
-  std::unique_ptr<TTree> mCTFTreeOut;
-  std::unique_ptr<o2::dataformats::FileMetaData> mCTFFileMetaData;
-
-  std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
-  std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
-
-  // For the external dictionary creation we accumulate for each detector the frequency tables of its each block
-  // After accumulation over multiple TFs we store the dictionaries data in the standard CTF format of this detector,
-  // i.e. EncodedBlock stored in a tree, BUT with dictionary data only added to each block.
-  // The metadata of the block (min,max) will be used for the consistency check at the decoding
-  std::array<std::vector<FTrans>, DetID::nDetectors> mFreqsAccumulation;
-  std::array<std::vector<o2::ctf::Metadata>, DetID::nDetectors> mFreqsMetaData;
-  std::array<std::shared_ptr<void>, DetID::nDetectors> mHeaders;
-  TStopwatch mTimer;
-
-  static const std::string TMPFileEnding;
-};
-
 const std::string CTFWriterSpec::TMPFileEnding{".part"};
 
 //___________________________________________________________________
@@ -235,7 +150,16 @@ void CTFWriterSpec::init(InitContext& ic)
     }
   }
 
-  if (mCreateDict) { // make sure that there is no local dictonary
+  mOnlineDictMinTFs = ic.options().get<int>("online-dict-min-tf");
+  mOnlineDictMaxLoss = ic.options().get<float>("online-dict-max-loss");
+  if (mOnlineDictMinTFs > 0) {
+    if (mCreateDict) {
+      throw std::invalid_argument("online dictionary refresh is incompatible with the dictionary creation output type");
+    }
+    mCreateDict = true;
+    LOGP(info, "CTF dictionaries will be refreshed online when the compression loss over {} TFs exceeds {}", mOnlineDictMinTFs, mOnlineDictMaxLoss);
+    loadDictionaries();
+  } else if (mCreateDict) { // make sure that there is no local dictonary
     for (int id = 0; id < DetID::nDetectors; id++) {
       DetID det(id);
       if (isPresent(det)) {
@@ -268,26 +192,7 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
     header.detectors.set(det);
   }
   if (mCreateDict) {
-    if (!mFreqsAccumulation[det].size()) {
-      mFreqsAccumulation[det].resize(C::getNBlocks());
-      mFreqsMetaData[det].resize(C::getNBlocks());
-    }
-    if (!mHeaders[det]) { // store 1st header
-      mHeaders[det] = ctfImage.cloneHeader();
-      auto& hb = *static_cast<o2::ctf::CTFDictHeader*>(mHeaders[det].get());
-      hb.dictTimeStamp = uint32_t(std::time(nullptr));
-      hb.det = det;
-    }
-    for (int ib = 0; ib < C::getNBlocks(); ib++) {
-      const auto& bl = ctfImage.getBlock(ib);
-      if (bl.getNDict()) {
-        auto& freq = mFreqsAccumulation[det][ib];
-        auto& mdSave = mFreqsMetaData[det][ib];
-        const auto& md = ctfImage.getMetadata(ib);
-        freq.addFrequencies(bl.getDict(), bl.getDict() + bl.getNDict(), md.min);
-        mdSave = o2::ctf::Metadata{0, 0, md.messageWordSize, md.coderType, md.streamSize, md.probabilityBits, md.opt, freq.getMinSymbol(), freq.getMaxSymbol(), (int)freq.size(), 0, 0};
-      }
-    }
+    accumulateDictionary(det, ctfImage);
   }
   return sz;
 }
@@ -297,16 +202,28 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
 template <typename C>
 void CTFWriterSpec::storeDictionary(DetID det, CTFHeader& header)
 {
-  if (!isPresent(det) || !mFreqsAccumulation[det].size()) {
+  if (!isPresent(det)) {
     return;
   }
+  auto& dictBlocks = mDictBlocks[det];
+  if (mFreqsAccumulation[det].size() && (mOnlineDictMinTFs == 0 || mDictRefreshMask[det])) {
+    if (mOnlineDictMinTFs > 0) { // new version of the dictionary
+      static_cast<o2::ctf::CTFDictHeader*>(mHeaders[det].get())->dictTimeStamp = mDictTimeStamp;
+    }
+    // create vector whose data contains dictionary in CTF format (EncodedBlock)
+    dictBlocks = C::createDictionaryBlocks(mFreqsAccumulation[det], mFreqsMetaData[det]);
+    auto& h = C::get(dictBlocks.data())->getHeader();
+    h = *reinterpret_cast<typename std::remove_reference<decltype(h)>::type*>(mHeaders[det].get());
+    auto& hb = static_cast<o2::ctf::CTFDictHeader&>(h);
+    hb = *static_cast<const o2::ctf::CTFDictHeader*>(mHeaders[det].get());
+    if (mOnlineDictMinTFs > 0) {
+      createDictDecoders<C>(det);
+    }
+  }
+  if (dictBlocks.empty() || (mOnlineDictMinTFs > 0 && mDictPerDetector && !mDictRefreshMask[det])) {
+    return; // in the online mode only the files of refreshed detectors are rewritten, the combined file keeps all of them
+  }
   prepareDictionaryTreeAndFile(det);
-  // create vector whose data contains dictionary in CTF format (EncodedBlock)
-  auto dictBlocks = C::createDictionaryBlocks(mFreqsAccumulation[det], mFreqsMetaData[det]);
-  auto& h = C::get(dictBlocks.data())->getHeader();
-  h = *reinterpret_cast<typename std::remove_reference<decltype(h)>::type*>(mHeaders[det].get());
-  auto& hb = static_cast<o2::ctf::CTFDictHeader&>(h);
-  hb = *static_cast<const o2::ctf::CTFDictHeader*>(mHeaders[det].get());
 
   C::get(dictBlocks.data())->print(o2::utils::Str::concat_string("Storing dictionary for ", det.getName(), ": "));
   C::get(dictBlocks.data())->appendToTree(*mDictTreeOut.get(), det.getName()); // cast to EncodedBlock
@@ -447,7 +364,9 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   }
 
   mNCTF++;
-  if (mCreateDict && mSaveDictAfter > 0 && (mNCTF % mSaveDictAfter) == 0) {
+  if (mOnlineDictMinTFs > 0) {
+    checkOnlineDictionaries();
+  } else if (mCreateDict && mSaveDictAfter > 0 && (mNCTF % mSaveDictAfter) == 0) {
     storeDictionaries();
   }
 }
@@ -458,7 +377,7 @@ void CTFWriterSpec::finalize()
   if (mFinalized) {
     return;
   }
-  if (mCreateDict) {
+  if (mCreateDict && mOnlineDictMinTFs == 0) {
     storeDictionaries();
   }
   if (mWriteCTF) {
@@ -580,22 +499,27 @@ void CTFWriterSpec::prepareDictionaryTreeAndFile(DetID det)
     }
   }
   if (!mDictTreeOut) {
-    mDictFileOut.reset(TFile::Open(dictionaryFileName(det.getName()).c_str(), "recreate"));
+    // in the online mode a new version file is written under a temporary name, it is copied to the watched one when closed
+    mWatchedDictFileName = dictionaryFileName(det.getName());
+    mCurrentDictFileName = mOnlineDictMinTFs > 0 ? dictionaryFileName(det.getName(), mDictTimeStamp) : mWatchedDictFileName;
+    mDictFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentDictFileName, mOnlineDictMinTFs > 0 ? TMPFileEnding : "").c_str(), "recreate"));
     mDictTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFDICT).c_str(), "O2 CTF dictionary");
   }
 }
 
 //___________________________________________________________________
-std::string CTFWriterSpec::dictionaryFileName(const std::string& detName)
+std::string CTFWriterSpec::dictionaryFileName(const std::string& detName, uint32_t version)
 {
+  std::string name;
   if (mDictPerDetector) {
     if (detName.empty()) {
       throw std::runtime_error("Per-detector dictionary files are requested but detector name is not provided");
     }
-    return o2::utils::Str::concat_string(mDictDir, detName, '_', o2::base::NameConf::CTFDICT, ".root");
+    name = o2::utils::Str::concat_string(mDictDir, detName, '_', o2::base::NameConf::CTFDICT, ".root");
   } else {
-    return o2::utils::Str::concat_string(mDictDir, o2::base::NameConf::CTFDICT, ".root");
+    name = o2::utils::Str::concat_string(mDictDir, o2::base::NameConf::CTFDICT, ".root");
   }
+  return version ? o2::ctf::CTFCoderBase::getDictVersionFileName(name, version) : name;
 }
 
 //___________________________________________________________________
@@ -636,7 +560,133 @@ void CTFWriterSpec::closeDictionaryTreeAndFile(CTFHeader& header)
     mDictTreeOut->Write(mDictTreeOut->GetName(), TObject::kSingleKey);
     mDictTreeOut.reset();
     mDictFileOut.reset();
+    if (mOnlineDictMinTFs > 0) { // keep the new version and replace atomically the file watched by the encoders
+      std::filesystem::rename(o2::utils::Str::concat_string(mCurrentDictFileName, TMPFileEnding), mCurrentDictFileName);
+      auto watchedNameTmp = o2::utils::Str::concat_string(mWatchedDictFileName, TMPFileEnding);
+      std::filesystem::copy_file(mCurrentDictFileName, watchedNameTmp, std::filesystem::copy_options::overwrite_existing);
+      std::filesystem::rename(watchedNameTmp, mWatchedDictFileName);
+      LOGP(info, "Stored CTF dictionary version {} to {} and {}", mDictTimeStamp, mCurrentDictFileName, mWatchedDictFileName);
+    }
+  }
+}
+
+//___________________________________________________________________
+template <typename C>
+void CTFWriterSpec::loadDictionary(DetID det, TTree& tree, const CTFHeader& header)
+{
+  if (!isPresent(det) || !header.detectors[det]) {
+    return;
+  }
+  auto& dictBlocks = mDictBlocks[det];
+  C::readFromTree(dictBlocks, tree, det.getName());
+  const auto& hd = static_cast<const o2::ctf::CTFDictHeader&>(C::get(dictBlocks.data())->getHeader());
+  LOGP(info, "Loaded {} dictionary {}", det.getName(), hd.asString());
+  mDictTimeStamp = std::max(mDictTimeStamp, hd.dictTimeStamp);
+  createDictDecoders<C>(det);
+}
+
+//___________________________________________________________________
+template <typename C>
+void CTFWriterSpec::createDictDecoders(DetID det)
+{
+  // decoders of the dictionary in use by the encoders, to sample the blocks encoded without per-TF dictionary.
+  // As in CTFCoderBase::createCoder, a block with empty dictionary gets a decoder of literals only.
+  const auto dict = C::getImage(mDictBlocks[det].data());
+  auto& decoders = mDictDecoders[det];
+  decoders.clear();
+  for (int ib = 0; ib < C::getNBlocks(); ib++) {
+    decoders.push_back(std::make_unique<DictDecoder>(dict.getFrequencyTable(ib)));
+  }
+  mDictDecodersHeader[det] = static_cast<const o2::ctf::CTFDictHeader&>(dict.getHeader());
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::loadDictionaries()
+{
+  // In the online mode pick up the dictionaries the encoders start with, to carry them to the refreshed combined file.
+  // Their files are also kept as versions, so that the CTFs encoded with them can be decoded after a refresh.
+  std::vector<std::string> fileNames;
+  if (mDictPerDetector) {
+    for (auto id = DetID::First; id <= DetID::Last; id++) {
+      if (isPresent(id)) {
+        fileNames.push_back(dictionaryFileName(DetID::getName(id)));
+      }
+    }
+  } else {
+    fileNames.push_back(dictionaryFileName());
+  }
+  for (const auto& fileName : fileNames) {
+    if (!std::filesystem::exists(fileName)) {
+      continue;
+    }
+    std::unique_ptr<TFile> fileIn(TFile::Open(fileName.c_str()));
+    std::unique_ptr<TTree> tree(fileIn && !fileIn->IsZombie() ? (TTree*)fileIn->Get(std::string(o2::base::NameConf::CTFDICT).c_str()) : nullptr);
+    CTFHeader header;
+    if (!tree || !o2::ctf::CTFCoderBase::readFromTree(*tree.get(), "CTFHeader", header)) {
+      LOGP(warning, "Failed to read CTF dictionaries from {}", fileName);
+      continue;
+    }
+    auto timeStampPrev = mDictTimeStamp;
+    mDictTimeStamp = 0;
+    loadDictionary<o2::itsmft::CTF>(DetID::ITS, *tree.get(), header);
+    loadDictionary<o2::itsmft::CTF>(DetID::MFT, *tree.get(), header);
+    loadDictionary<o2::tpc::CTF>(DetID::TPC, *tree.get(), header);
+    loadDictionary<o2::trd::CTF>(DetID::TRD, *tree.get(), header);
+    loadDictionary<o2::tof::CTF>(DetID::TOF, *tree.get(), header);
+    loadDictionary<o2::ft0::CTF>(DetID::FT0, *tree.get(), header);
+    loadDictionary<o2::fv0::CTF>(DetID::FV0, *tree.get(), header);
+    loadDictionary<o2::fdd::CTF>(DetID::FDD, *tree.get(), header);
+    loadDictionary<o2::mid::CTF>(DetID::MID, *tree.get(), header);
+    loadDictionary<o2::mch::CTF>(DetID::MCH, *tree.get(), header);
+    loadDictionary<o2::emcal::CTF>(DetID::EMC, *tree.get(), header);
+    loadDictionary<o2::phos::CTF>(DetID::PHS, *tree.get(), header);
+    loadDictionary<o2::cpv::CTF>(DetID::CPV, *tree.get(), header);
+    loadDictionary<o2::zdc::CTF>(DetID::ZDC, *tree.get(), header);
+    loadDictionary<o2::hmpid::CTF>(DetID::HMP, *tree.get(), header);
+    loadDictionary<o2::ctp::CTF>(DetID::CTP, *tree.get(), header);
+    if (mDictTimeStamp) {
+      // the version copy is named after the newest dictionary of the file, see CTFCoderBase::loadDictVersion
+      auto versionName = o2::ctf::CTFCoderBase::getDictVersionFileName(fileName, mDictTimeStamp);
+      if (!std::filesystem::exists(versionName)) {
+        std::filesystem::copy_file(fileName, versionName);
+      }
+    }
+    mDictTimeStamp = std::max(mDictTimeStamp, timeStampPrev);
+  }
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::checkOnlineDictionaries()
+{
+  // at the end of each window decide which dictionaries should be rebuilt, then restart the accumulation
+  mDictRefreshMask.reset();
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    auto& stat = mOnlineDictStat[id];
+    if (!isPresent(id) || stat.nTFs < mOnlineDictMinTFs) {
+      continue;
+    }
+    float loss = stat.totBytes ? float(stat.lossBytes) / stat.totBytes : 0.f;
+    // the dictionary is rebuilt only if the statistics of most of the window could be sampled
+    bool sampled = 2 * stat.nSampledTFs > stat.nTFs;
+    bool refresh = loss > mOnlineDictMaxLoss && sampled && mFreqsAccumulation[id].size();
+    LOGP(info, "{} CTF compression loss over {} TFs: {:.4f} ({} of {} bytes){}", DetID::getName(id), stat.nTFs, loss, stat.lossBytes, stat.totBytes,
+         refresh ? ", refreshing dictionary" : (sampled ? "" : fmt::format(", only {} TFs sampled", stat.nSampledTFs)));
+    if (refresh) {
+      mDictRefreshMask.set(id);
+    }
+    stat = OnlineDictStat{};
+  }
+  if (mDictRefreshMask.any()) {
+    mDictTimeStamp = std::max(uint32_t(std::time(nullptr)), mDictTimeStamp + 1); // all refreshed dictionaries get the same new version
+    storeDictionaries();
+  }
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (mOnlineDictStat[id].nTFs == 0) { // new window was started
+      mFreqsAccumulation[id].clear();
+      mFreqsMetaData[id].clear();
+    }
   }
+  mDictRefreshMask.reset();
 }
 
 //___________________________________________________________________
@@ -741,6 +791,8 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, uint64_t run, const std::
             {"save-dict-after", VariantType::Int, 0, {"if > 0, in dictionary generation mode save it dictionary after certain number of TFs processed"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory, must exist"}},
             {"dict-per-det", VariantType::Bool, false, {"create dictionary file per detector"}},
+            {"online-dict-min-tf", VariantType::Int, 0, {"if > 0, refresh the dictionaries used by the encoders when the compression loss over so many TFs is too large"}},
+            {"online-dict-max-loss", VariantType::Float, 0.02f, {"max fraction of the CTF size spent on per-TF dictionaries and literals in the online dictionary mode"}},
             {"output-dir", VariantType::String, "none", {"CTF output directory, must exist"}},
             {"output-dir-alt", VariantType::String, "/dev/null", {"Alternative CTF output directory, must exist (if not /dev/null)"}},
             {"meta-output-dir", VariantType::String, "/dev/null", {"CTF metadata output directory, must exist (if not /dev/null)"}},
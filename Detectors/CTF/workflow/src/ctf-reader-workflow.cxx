@@ -57,6 +57,8 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"ctf-file-regex", VariantType::String, ".*o2_ctf_run.+\\.root$", {"regex string to identify CTF files"}});
   options.push_back(ConfigParamSpec{"remote-regex", VariantType::String, "^(alien://|)/alice/data/.+", {"regex string to identify remote files"}}); // Use "^/eos/aliceo2/.+" for direct EOS access
   options.push_back(ConfigParamSpec{"max-cached-files", VariantType::Int, 3, {"max CTF files queued (copied for remote source)"}});
+  options.push_back(ConfigParamSpec{"ctf-read-ahead", VariantType::Int, 0, {"read up to N CTFs in advance on a separate thread (0: no read-ahead)"}});
+  options.push_back(ConfigParamSpec{"ctf-read-ahead-memory", VariantType::Int, 1024, {"max memory in MB of the CTFs read in advance"}});
   options.push_back(ConfigParamSpec{"allow-missing-detectors", VariantType::Bool, false, {"send empty message if detector is missing in the CTF (otherwise throw)"}});
   options.push_back(ConfigParamSpec{"ctf-reader-verbosity", VariantType::Int, 0, {"verbosity level (0: summary per detector, 1: summary per block"}});
   options.push_back(ConfigParamSpec{"configKeyValues", VariantType::String, "", {"Semicolon separated key=value strings"}});
@@ -110,6 +112,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   ctfInput.tffileRegex = configcontext.options().get<std::string>("ctf-file-regex");
   ctfInput.remoteRegex = configcontext.options().get<std::string>("remote-regex");
   ctfInput.allowMissingDetectors = configcontext.options().get<bool>("allow-missing-detectors");
+  ctfInput.readAhead = std::max(0, configcontext.options().get<int>("ctf-read-ahead"));
+  ctfInput.readAheadMemory = size_t(std::max(1, configcontext.options().get<int>("ctf-read-ahead-memory"))) << 20;
 
   specs.push_back(o2::ctf::getCTFReaderSpec(ctfInput));
   int verbosity = configcontext.options().get<int>("ctf-reader-verbosity");
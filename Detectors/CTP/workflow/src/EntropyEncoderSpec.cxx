@@ -47,6 +47,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
   auto digits = pc.inputs().get<gsl::span<CTPDigit>>("digits");
 
   auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{"CTP", "CTFDATA", 0, Lifetime::Timeframe});
+  mCTFCoder.updateCodersFromFile<CTF>(o2::ctf::CTFCoderBase::OpType::Encoder);
   mCTFCoder.encode(buffer, digits);
   auto eeb = CTF::get(buffer.data()); // cast to container pointer
   eeb->compactify();                  // eliminate unnecessary padding
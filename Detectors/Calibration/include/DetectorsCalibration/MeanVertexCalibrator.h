@@ -45,7 +45,14 @@ class MeanVertexCalibrator final : public o2::calibration::TimeSlotCalibration<o
     mSMAdata.init(useFit, nBinsX, rangeX, nBinsY, rangeY, nBinsZ, rangeZ);
   }
 
-  ~MeanVertexCalibrator() final = default;
+  ~MeanVertexCalibrator() final
+  {
+    try {
+      stop(); // the asynchronous finalization uses the members of this class
+    } catch (const std::exception& e) {
+      LOG(error) << "Failed to finalize the pending slots: " << e.what();
+    }
+  }
 
   bool hasEnoughData(const Slot& slot) const final
   {
@@ -36,6 +36,8 @@ struct MeanVertexParams : public o2::conf::ConfigurableParamHelper<MeanVertexPar
   bool useFit = false;
   int tfPerSlot = 5;
   int maxTFdelay = 3;
+  int nThreads = 1;               // number of threads filling the slots
+  bool asyncFinalization = false; // finalize the slots without blocking the processing of the following TFs
 
   O2ParamDef(MeanVertexParams, "MeanVertexCalib");
 };
@@ -13,6 +13,7 @@
 #define DETECTOR_CALIB_TIMESLOT_H_
 
 #include <memory>
+#include <vector>
 #include <Rtypes.h>
 #include "Framework/Logger.h"
 
@@ -41,6 +42,8 @@ class TimeSlot
     }
     return *this;
   }
+  TimeSlot(TimeSlot&& src) = default;
+  TimeSlot& operator=(TimeSlot&& src) = default;
 
   ~TimeSlot() = default;
 
@@ -61,8 +64,43 @@ class TimeSlot
   {
     mContainer->merge(prev.mContainer.get());
     mTFStart = prev.mTFStart;
+    mFillTime += prev.mFillTime;
   }
 
+  // per-thread containers used for the parallel filling, they are created as copies of the
+  // still empty main container, hence the Container must be copy-constructible
+  size_t getNAuxContainers() const { return mAuxContainers.size(); }
+  Container* getAuxContainer(size_t i) { return mAuxContainers[i].get(); }
+  void setAuxContainersFilled() { mAuxFilled = true; }
+  void createAuxContainers(size_t n)
+  {
+    if (!mEmptyContainer) {
+      mEmptyContainer = std::make_unique<Container>(*mContainer);
+    }
+    while (mAuxContainers.size() < n) {
+      mAuxContainers.emplace_back(std::make_unique<Container>(*mEmptyContainer));
+    }
+  }
+
+  // merge the data of the per-thread containers to the main one and reset them
+  void mergeAuxContainers()
+  {
+    if (!mAuxFilled) {
+      return;
+    }
+    for (auto& aux : mAuxContainers) {
+      mContainer->merge(aux.get());
+      aux = std::make_unique<Container>(*mEmptyContainer);
+    }
+    mAuxFilled = false;
+  }
+
+  // time in ms spent in filling the slot and in its finalization
+  double getFillTime() const { return mFillTime; }
+  double getFinalizeTime() const { return mFinalizeTime; }
+  void addFillTime(double t) { mFillTime += t; }
+  void setFinalizeTime(double t) { mFinalizeTime = t; }
+
   void print() const
   {
     LOGF(info, "Calibration slot %5d <=TF<=  %5d", mTFStart, mTFEnd);
@@ -73,7 +111,12 @@ class TimeSlot
   TFType mTFStart = 0;
   TFType mTFEnd = 0;
   size_t mEntries = 0;
-  std::unique_ptr<Container> mContainer; // user object to accumulate the calibration data for this slot
+  std::unique_ptr<Container> mContainer;                  // user object to accumulate the calibration data for this slot
+  std::vector<std::unique_ptr<Container>> mAuxContainers; //! per-thread containers, merged to mContainer before its use
+  std::unique_ptr<Container> mEmptyContainer;             //! pristine copy of the container to reset the per-thread ones
+  bool mAuxFilled = false;                                //! per-thread containers got data since the last merge
+  double mFillTime = 0.;                                  //! ms spent in filling
+  double mFinalizeTime = 0.;                              //! ms spent in finalization
 
   ClassDefNV(TimeSlot, 1);
 };
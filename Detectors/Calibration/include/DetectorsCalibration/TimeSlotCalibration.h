@@ -15,9 +15,17 @@
 /// @brief Processor for the multiple time slots calibration
 
 #include "DetectorsCalibration/TimeSlot.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <exception>
+#include <future>
 #include <gsl/gsl>
 #include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace o2
 {
@@ -30,8 +38,16 @@ class TimeSlotCalibration
   using Slot = TimeSlot<Container>;
 
  public:
+  /// fill and finalization times of a finalized slot, in ms
+  struct SlotTiming {
+    TFType tfStart = 0;
+    TFType tfEnd = 0;
+    double fillTime = 0.;
+    double finalizeTime = 0.;
+  };
+
   TimeSlotCalibration() = default;
-  virtual ~TimeSlotCalibration() = default;
+  virtual ~TimeSlotCalibration() { discardPendingFinalization(); }
   uint64_t getMaxSlotsDelay() const { return mMaxSlotsDelay; }
   void setMaxSlotsDelay(uint64_t v) { mMaxSlotsDelay = v; }
 
@@ -49,6 +65,33 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  // Fill the slots from the span of inputs with n threads, each of them filling its own copy of the
+  // slot container, the copies being merged to the slot before checking or finalizing it. Requires
+  // a copy-constructible Container whose fill can be called on the sub-spans of the TF data. Must be
+  // set before the first TF is processed.
+  int getNThreads() const { return mNThreads; }
+  void setNThreads(int n) { mNThreads = n < 1 ? 1 : n; }
+
+  // Run finalizeSlot on a dedicated thread, so that the filling of the following TFs is not blocked.
+  // The finalizations are executed one at a time and in the order of the slots. finalizeSlot must
+  // compute its results on data not used by the processing thread and then publish them to the
+  // outputs while holding the lock returned by lockOutput(), which is not held during the rest of the
+  // finalization: the outputs must be accessed only while holding this lock. The thread
+  // is joined at the end of run (checkSlotsToFinalize(INFINITE_TF)) or by stop(). The base destructor
+  // drops the slots whose finalization did not start yet, but it cannot wait for the running one,
+  // since finalizeSlot may use members of the already destroyed derived class: a derived class which
+  // may be destroyed before the end of run must call stop() in its destructor.
+  bool getAsyncFinalization() const { return mAsyncFinalization; }
+  void setAsyncFinalization(bool v) { mAsyncFinalization = v; }
+  std::unique_lock<std::mutex> lockOutput() { return std::unique_lock<std::mutex>(mOutputMutex); }
+  // block until all pending finalizations are done, rethrowing the exception thrown by any of them
+  void waitForFinalization();
+  // finalize all pending slots and join the finalization thread, rethrowing the exception thrown by any of them
+  void stop();
+
+  // timings of the slots finalized since the last call
+  std::vector<SlotTiming> fetchSlotTimings();
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -80,6 +123,14 @@ class TimeSlotCalibration
 
  private:
   TFType tf2SlotMin(TFType tf) const;
+  Slot& createSlot(bool front, TFType tstart, TFType tend);
+  void fillSlot(Slot& slot, const gsl::span<const Input> data);
+  void doFinalizeSlot(Slot& slot);
+  void closeSlot(Slot& slot);
+  void finalizationLoop();
+  void stopFinalizationThread();
+  void discardPendingFinalization();
+  void checkFinalizationError();
 
   std::deque<Slot> mSlots;
 
@@ -100,6 +151,19 @@ class TimeSlotCalibration
                                                 // after how many TF to check again.
   bool mWasCheckedInfiniteSlot = false;         // flag to know whether the statistics of the infinite slot was already checked
 
+  int mNThreads = 1;                         //! number of threads filling the slots
+  bool mAsyncFinalization = false;           //! finalize the slots on mFinalizationThread
+  std::deque<Slot> mSlotsToFinalize;         //! closed slots waiting for the asynchronous finalization
+  bool mFinalizationBusy = false;            //! a slot taken from mSlotsToFinalize is being finalized
+  std::thread mFinalizationThread;           //!
+  std::mutex mFinalizationMutex;             //! protects mSlotsToFinalize, mFinalizationBusy, mStopFinalization and mFinalizationError
+  std::condition_variable mFinalizationCond; //!
+  bool mStopFinalization = false;            //!
+  std::exception_ptr mFinalizationError;     //! exception thrown by an asynchronous finalization
+  std::mutex mOutputMutex;                   //! protects the outputs published by finalizeSlot
+  std::mutex mTimingsMutex;                  //! protects mSlotTimings
+  std::vector<SlotTiming> mSlotTimings;      //!
+
   ClassDef(TimeSlotCalibration, 1);
 };
 
@@ -111,6 +175,7 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const DATA& data)
 
   // process current TF
 
+  checkFinalizationError();
   int maxDelay = mMaxSlotsDelay * mSlotLength;
   if (!mUpdateAtTheEndOfRunOnly) {                                                               // if you update at the end of run only, then you accept everything
     if (tf < mLastClosedTF || (!mSlots.empty() && getLastSlot().getTFStart() > tf + maxDelay)) { // ignore TF; note that if you have only 1 timeslot
@@ -123,7 +188,9 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const DATA& data)
   }
 
   auto& slotTF = getSlotForTF(tf);
+  auto start = std::chrono::steady_clock::now();
   slotTF.getContainer()->fill(data);
+  slotTF.addFillTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
   if (tf > mMaxSeenTF) {
     mMaxSeenTF = tf; // keep track of the most recent TF processed
   }
@@ -142,6 +209,7 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const gsl::span<c
 
   // process current TF
 
+  checkFinalizationError();
   int maxDelay = mMaxSlotsDelay * mSlotLength;
   if (!mUpdateAtTheEndOfRunOnly) {                                                               // if you update at the end of run only, then you accept everything
     if (tf < mLastClosedTF || (!mSlots.empty() && getLastSlot().getTFStart() > tf + maxDelay)) { // ignore TF; note that if you have only 1 timeslot
@@ -154,7 +222,7 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const gsl::span<c
   }
 
   auto& slotTF = getSlotForTF(tf);
-  slotTF.getContainer()->fill(data);
+  fillSlot(slotTF, data);
   if (tf > mMaxSeenTF) {
     mMaxSeenTF = tf; // keep track of the most recent TF processed
   }
@@ -185,6 +253,7 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
       checkInterval = mCheckDeltaIntervalInfiniteSlot + mLastCheckedTFInfiniteSlot;
     }
     if (tf >= checkInterval || tf == INFINITE_TF) {
+      mSlots[0].mergeAuxContainers();
       LOG(debug) << "mMaxSeenTF = " << mMaxSeenTF << ", mLastCheckedTFInfiniteSlot = " << mLastCheckedTFInfiniteSlot << ", checkInterval = " << checkInterval << ", mSlots[0].getTFStart() = " << mSlots[0].getTFStart();
       if (tf == INFINITE_TF) {
         LOG(info) << "End of run reached, trying to calibrate what we have, if we have enough statistics";
@@ -198,13 +267,13 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(info) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() + 1; // will not accept any TF below this
+        closeSlot(mSlots[0]);                     // will be removed after finalization
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
         if (tf != INFINITE_TF) {
           LOG(info) << "Creating new slot for " << mLastClosedTF << " <= TF <= " << INFINITE_TF_int64;
-          emplaceNewSlot(true, mLastClosedTF, INFINITE_TF_int64);
+          createSlot(true, mLastClosedTF, INFINITE_TF_int64);
         }
       } else {
         LOG(info) << "Not enough data to calibrate";
@@ -218,9 +287,10 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
     for (auto slot = mSlots.begin(); slot != mSlots.end();) {
       //if (maxDelay == 0 || (slot->getTFEnd() + maxDelay) < tf) {
       if ((slot->getTFEnd() + maxDelay) < tf) {
+        slot->mergeAuxContainers();
         if (hasEnoughData(*slot)) {
           LOG(debug) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          closeSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(info) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -237,6 +307,9 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
       }
     }
   }
+  if (tf == INFINITE_TF) {
+    stop(); // end of run: all the outputs must be available
+  }
 }
 
 //_________________________________________________
@@ -248,11 +321,188 @@ void TimeSlotCalibration<Input, Container>::finalizeOldestSlot()
     LOG(warning) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
+  mSlots.front().mergeAuxContainers();
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
+  closeSlot(mSlots.front());
   mSlots.erase(mSlots.begin());
 }
 
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::closeSlot(Slot& slot)
+{
+  // finalize the slot or, in asynchronous mode, move it to the finalization queue
+  if (!mAsyncFinalization) {
+    doFinalizeSlot(slot);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mFinalizationMutex);
+    mSlotsToFinalize.emplace_back(std::move(slot));
+  }
+  if (!mFinalizationThread.joinable()) {
+    mStopFinalization = false;
+    mFinalizationThread = std::thread(&TimeSlotCalibration::finalizationLoop, this);
+  }
+  mFinalizationCond.notify_all();
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::doFinalizeSlot(Slot& slot)
+{
+  auto start = std::chrono::steady_clock::now();
+  finalizeSlot(slot);
+  slot.setFinalizeTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+  LOG(info) << "Slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd() << " filled in " << slot.getFillTime()
+            << " ms, finalized in " << slot.getFinalizeTime() << " ms";
+  std::lock_guard<std::mutex> lock(mTimingsMutex);
+  mSlotTimings.push_back(SlotTiming{slot.getTFStart(), slot.getTFEnd(), slot.getFillTime(), slot.getFinalizeTime()});
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::finalizationLoop()
+{
+  std::unique_lock<std::mutex> lock(mFinalizationMutex);
+  while (true) {
+    mFinalizationCond.wait(lock, [this] { return mStopFinalization || !mSlotsToFinalize.empty(); });
+    if (mSlotsToFinalize.empty()) {
+      break; // stop requested and nothing left to do
+    }
+    Slot slot = std::move(mSlotsToFinalize.front());
+    mSlotsToFinalize.pop_front();
+    mFinalizationBusy = true;
+    lock.unlock();
+    try {
+      doFinalizeSlot(slot);
+    } catch (...) {
+      std::lock_guard<std::mutex> errorLock(mFinalizationMutex);
+      if (!mFinalizationError) {
+        mFinalizationError = std::current_exception();
+      }
+    }
+    lock.lock();
+    mFinalizationBusy = false;
+    mFinalizationCond.notify_all();
+  }
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::waitForFinalization()
+{
+  if (mFinalizationThread.joinable()) {
+    std::unique_lock<std::mutex> lock(mFinalizationMutex);
+    mFinalizationCond.wait(lock, [this] { return mSlotsToFinalize.empty() && !mFinalizationBusy; });
+  }
+  checkFinalizationError();
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::stop()
+{
+  // the finalization loop exits only once the queue is empty
+  stopFinalizationThread();
+  std::exception_ptr error;
+  std::swap(error, mFinalizationError);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::discardPendingFinalization()
+{
+  size_t nDiscarded = 0;
+  {
+    std::lock_guard<std::mutex> lock(mFinalizationMutex);
+    nDiscarded = mSlotsToFinalize.size();
+    mSlotsToFinalize.clear();
+  }
+  if (nDiscarded) {
+    LOG(warning) << "Discarding " << nDiscarded << " slots still waiting for finalization";
+  }
+  stopFinalizationThread();
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::stopFinalizationThread()
+{
+  if (!mFinalizationThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mFinalizationMutex);
+    mStopFinalization = true;
+  }
+  mFinalizationCond.notify_all();
+  mFinalizationThread.join();
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::checkFinalizationError()
+{
+  std::exception_ptr error;
+  if (mFinalizationThread.joinable()) {
+    std::lock_guard<std::mutex> lock(mFinalizationMutex);
+    std::swap(error, mFinalizationError);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+std::vector<typename TimeSlotCalibration<Input, Container>::SlotTiming> TimeSlotCalibration<Input, Container>::fetchSlotTimings()
+{
+  std::vector<SlotTiming> timings;
+  std::lock_guard<std::mutex> lock(mTimingsMutex);
+  std::swap(timings, mSlotTimings);
+  return timings;
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::fillSlot(Slot& slot, const gsl::span<const Input> data)
+{
+  // fill the slot, splitting the data between the per-thread containers if requested
+  auto start = std::chrono::steady_clock::now();
+  size_t nThreads = slot.getNAuxContainers() + 1;
+  if (nThreads < 2 || data.size() < nThreads) {
+    slot.getContainer()->fill(data);
+  } else {
+    size_t chunk = (data.size() + nThreads - 1) / nThreads;
+    std::vector<std::future<void>> workers;
+    for (size_t i = 1; i < nThreads && i * chunk < data.size(); i++) {
+      auto part = data.subspan(i * chunk, std::min(chunk, data.size() - i * chunk));
+      workers.emplace_back(std::async(std::launch::async, [cont = slot.getAuxContainer(i - 1), part]() { cont->fill(part); }));
+    }
+    slot.setAuxContainersFilled();
+    slot.getContainer()->fill(data.subspan(0, chunk));
+    for (auto& w : workers) {
+      w.get();
+    }
+  }
+  slot.addFillTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+TimeSlot<Container>& TimeSlotCalibration<Input, Container>::createSlot(bool front, TFType tstart, TFType tend)
+{
+  auto& slot = emplaceNewSlot(front, tstart, tend);
+  if (mNThreads > 1) {
+    slot.createAuxContainers(mNThreads - 1);
+  }
+  return slot;
+}
+
 //________________________________________
 template <typename Input, typename Container>
 inline TFType TimeSlotCalibration<Input, Container>::tf2SlotMin(TFType tf) const
@@ -280,7 +530,7 @@ TimeSlot<Container>& TimeSlotCalibration<Input, Container>::getSlotForTF(TFType
     if (!mSlots.empty() && mSlots.back().getTFEnd() < tf) {
       mSlots.back().setTFEnd(tf);
     } else if (mSlots.empty()) {
-      emplaceNewSlot(true, mFirstTF, tf);
+      createSlot(true, mFirstTF, tf);
     }
     return mSlots.back();
   }
@@ -290,7 +540,7 @@ TimeSlot<Container>& TimeSlotCalibration<Input, Container>::getSlotForTF(TFType
     auto tftgt = tf2SlotMin(tf);                             // min TF of the slot to which the TF "tf" would belong
     while (tfmn >= tftgt) {
       LOG(info) << "Adding new slot for " << tfmn << " <= TF <= " << tfmn + mSlotLength - 1;
-      emplaceNewSlot(true, tfmn, tfmn + mSlotLength - 1);
+      createSlot(true, tfmn, tfmn + mSlotLength - 1);
       if (!tfmn) {
         break;
       }
@@ -308,7 +558,7 @@ TimeSlot<Container>& TimeSlotCalibration<Input, Container>::getSlotForTF(TFType
   auto tfmn = mSlots.empty() ? tf2SlotMin(tf) : tf2SlotMin(mSlots.back().getTFEnd() + 1);
   do {
     LOG(info) << "Adding new slot for " << tfmn << " <= TF <= " << tfmn + mSlotLength - 1;
-    emplaceNewSlot(false, tfmn, tfmn + mSlotLength - 1);
+    createSlot(false, tfmn, tfmn + mSlotLength - 1);
     tfmn = tf2SlotMin(mSlots.back().getTFEnd() + 1);
   } while (tf > mSlots.back().getTFEnd());
 
@@ -146,8 +146,12 @@ void MeanVertexCalibrator::finalizeSlot(Slot& slot)
   std::map<std::string, std::string> md;
   auto clName = o2::utils::MemFileHelper::getClassName(mSMAMVobj);
   auto flName = o2::ccdb::CcdbApi::generateFileName(clName);
-  mInfoVector.emplace_back("GLO/Calib/MeanVertex", clName, flName, md, startValidity, 99999999999999);
-  mMeanVertexVector.emplace_back(mSMAMVobj);
+  CcdbObjectInfo info("GLO/Calib/MeanVertex", clName, flName, md, startValidity, 99999999999999);
+  {
+    auto lock = lockOutput(); // publish the result, the outputs might be sent concurrently by the processing thread
+    mInfoVector.emplace_back(std::move(info));
+    mMeanVertexVector.emplace_back(mSMAMVobj);
+  }
 
   slot.print();
 }
@@ -0,0 +1,196 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TimeSlotCalibration
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "DetectorsCalibration/TPCVDriftTglCalibration.h"
+
+using namespace o2::calibration;
+using Input = o2::dataformats::Pair<float, float>;
+using Slot = TimeSlot<TPCVDTglContainer>;
+
+constexpr TFType EndOfRunTF = std::numeric_limits<TFType>::max();
+constexpr TFType SlotLength = 10;
+constexpr TFType NTFs = 60;
+
+/// what the toy calibrator extracts from a finalized slot
+struct SlotResult {
+  TFType tfStart = 0;
+  TFType tfEnd = 0;
+  size_t entries = 0;
+  std::vector<float> histo;
+
+  bool operator==(const SlotResult& o) const { return tfStart == o.tfStart && tfEnd == o.tfEnd && entries == o.entries && histo == o.histo; }
+};
+
+std::ostream& operator<<(std::ostream& os, const SlotResult& r)
+{
+  return os << "slot " << r.tfStart << ":" << r.tfEnd << " entries " << r.entries;
+}
+
+/// toy calibrator on top of an instance of TimeSlotCalibration which has a dictionary
+class ToyCalibrator final : public TimeSlotCalibration<Input, TPCVDTglContainer>
+{
+ public:
+  ToyCalibrator(std::shared_ptr<std::vector<SlotResult>> sink, int delayMS = 0, TFType failingSlot = EndOfRunTF)
+    : mSink(sink), mDelayMS(delayMS), mFailingSlot(failingSlot)
+  {
+    setSlotLength(SlotLength);
+    setMaxSlotsDelay(1);
+  }
+
+  ~ToyCalibrator() final
+  {
+    try {
+      stop(); // finalizeSlot uses mSink
+    } catch (const std::exception& e) {
+      LOG(error) << "Failed to finalize the pending slots: " << e.what();
+    }
+  }
+
+  bool hasEnoughData(const Slot& slot) const final { return slot.getContainer()->entries > 0; }
+  void initOutput() final {}
+  void finalizeSlot(Slot& slot) final
+  {
+    if (mDelayMS) { // the earlier slots take longer to finalize
+      std::this_thread::sleep_for(std::chrono::milliseconds(mDelayMS * int(NTFs - slot.getTFStart()) / int(SlotLength)));
+    }
+    if (slot.getTFStart() == mFailingSlot) {
+      throw std::runtime_error("toy finalization failure");
+    }
+    const auto* cont = slot.getContainer();
+    SlotResult res{slot.getTFStart(), slot.getTFEnd(), cont->entries, cont->histo->getBase()};
+    auto lock = lockOutput();
+    mSink->push_back(std::move(res));
+  }
+  Slot& emplaceNewSlot(bool front, TFType tstart, TFType tend) final
+  {
+    auto& cont = getSlots();
+    auto& slot = front ? cont.emplace_front(tstart, tend) : cont.emplace_back(tstart, tend);
+    slot.setContainer(std::make_unique<TPCVDTglContainer>(20, 1., 20, 0.2));
+    return slot;
+  }
+
+ private:
+  std::shared_ptr<std::vector<SlotResult>> mSink;
+  int mDelayMS = 0;
+  TFType mFailingSlot = EndOfRunTF;
+};
+
+std::vector<Input> makeTFData(TFType tf)
+{
+  std::mt19937 eng(tf + 1);
+  std::uniform_real_distribution<float> tgl(-0.9, 0.9), dtgl(-0.15, 0.15);
+  std::vector<Input> data(50 + tf % 7 * 30);
+  for (auto& p : data) {
+    p.first = tgl(eng);
+    p.second = p.first - dtgl(eng);
+  }
+  return data;
+}
+
+void feed(ToyCalibrator& calib, TFType nTFs)
+{
+  for (TFType tf = 0; tf < nTFs; tf++) {
+    auto data = makeTFData(tf);
+    calib.process(tf, gsl::span<const Input>(data));
+  }
+}
+
+std::vector<SlotResult> runToy(bool async, int nThreads, int delayMS = 0)
+{
+  auto sink = std::make_shared<std::vector<SlotResult>>();
+  ToyCalibrator calib(sink, delayMS);
+  calib.setAsyncFinalization(async);
+  calib.setNThreads(nThreads);
+  feed(calib, NTFs);
+  calib.checkSlotsToFinalize(EndOfRunTF);
+  return *sink; // complete already before the destruction of the calibrator
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_AsyncVsSync)
+{
+  const auto ref = runToy(false, 1);
+  BOOST_REQUIRE_EQUAL(ref.size(), NTFs / SlotLength);
+  for (int nThreads : {1, 4}) {
+    for (bool async : {false, true}) {
+      const auto res = runToy(async, nThreads);
+      BOOST_TEST(res == ref, boost::test_tools::per_element());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_AsyncOrder)
+{
+  // the earlier slots are slower to finalize, the results must still come in the slots order
+  const auto ref = runToy(false, 1);
+  const auto res = runToy(true, 2, 5);
+  BOOST_TEST(res == ref, boost::test_tools::per_element());
+  for (size_t i = 1; i < res.size(); i++) {
+    BOOST_CHECK(res[i].tfStart > res[i - 1].tfEnd);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_DestroyWithPendingSlots)
+{
+  const auto ref = runToy(false, 1);
+  auto sink = std::make_shared<std::vector<SlotResult>>();
+  {
+    ToyCalibrator calib(sink, 10);
+    calib.setAsyncFinalization(true);
+    feed(calib, NTFs); // closes the slots ending before NTFs - SlotLength, no end of run
+  }
+  const size_t nClosed = (NTFs - 2 * SlotLength) / SlotLength;
+  BOOST_REQUIRE_EQUAL(sink->size(), nClosed);
+  for (size_t i = 0; i < nClosed; i++) {
+    BOOST_CHECK((*sink)[i] == ref[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_OutputLockDuringFinalization)
+{
+  // the processing thread must get the output lock while a slot is being finalized
+  auto sink = std::make_shared<std::vector<SlotResult>>();
+  ToyCalibrator calib(sink, 100); // the 1st slot takes 600 ms to finalize
+  calib.setAsyncFinalization(true);
+  feed(calib, 3 * SlotLength); // closes the 1st slot
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto start = std::chrono::steady_clock::now();
+  {
+    auto lock = calib.lockOutput();
+    BOOST_CHECK(sink->empty());
+  }
+  BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(300));
+  calib.stop();
+  BOOST_CHECK_EQUAL(sink->size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_AsyncError)
+{
+  auto sink = std::make_shared<std::vector<SlotResult>>();
+  ToyCalibrator calib(sink, 0, 2 * SlotLength);
+  calib.setAsyncFinalization(true);
+  auto run = [&]() {
+    feed(calib, NTFs);
+    calib.checkSlotsToFinalize(EndOfRunTF);
+  };
+  BOOST_CHECK_THROW(run(), std::runtime_error);
+  BOOST_CHECK_NO_THROW(calib.stop()); // the error is reported only once
+}
@@ -44,6 +44,8 @@ void MeanVertexCalibDevice::init(InitContext& ic)
   mCalibrator = std::make_unique<o2::calibration::MeanVertexCalibrator>(minEnt, useFit, nbX, rangeX, nbY, rangeY, nbZ, rangeZ, nSlots4SMA);
   mCalibrator->setSlotLength(slotL);
   mCalibrator->setMaxSlotsDelay(delay);
+  mCalibrator->setNThreads(params->nThreads);
+  mCalibrator->setAsyncFinalization(params->asyncFinalization);
 }
 
 //_____________________________________________________________
@@ -55,6 +57,7 @@ void MeanVertexCalibDevice::run(o2::framework::ProcessingContext& pc)
   auto data = pc.inputs().get<gsl::span<o2::dataformats::PrimaryVertex>>("input");
   LOG(info) << "Processing TF " << tfcounter << " with " << data.size() << " tracks";
   mCalibrator->process(tfcounter, data);
+  auto lock = mCalibrator->lockOutput(); // slots might be finalized asynchronously
   sendOutput(pc.outputs());
   const auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector();
   LOG(info) << "Created " << infoVec.size() << " objects for TF " << tfcounter;
@@ -68,6 +71,7 @@ void MeanVertexCalibDevice::endOfStream(o2::framework::EndOfStreamContext& ec)
   LOG(info) << "Finalizing calibration";
   constexpr uint64_t INFINITE_TF = 0xffffffffffffffff;
   mCalibrator->checkSlotsToFinalize(INFINITE_TF);
+  auto lock = mCalibrator->lockOutput();
   sendOutput(ec.outputs());
 }
 
@@ -0,0 +1,85 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_DCS_DATAPOINT_IDENTIFIER_INDEX_H
+#define O2_DCS_DATAPOINT_IDENTIFIER_INDEX_H
+
+#include "DetectorsDCS/DataPointIdentifier.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace o2
+{
+namespace dcs
+{
+
+/// Interned index of a fixed set of DataPointIdentifiers: each DPID added gets
+/// a dense slot number (0, 1, 2... in order of insertion), which can then be
+/// used to address flat arrays instead of maps keyed by the 64-byte DPID.
+/// The lookup is an open addressing table with a hash computed directly from
+/// the raw 64 bytes of the DPID (no string is built, unlike DPIDHash), which
+/// is kept at most half full.
+class DataPointIdentifierIndex
+{
+ public:
+  DataPointIdentifierIndex() = default;
+
+  /// Intern a DPID
+  /// @return its slot, the already existing one if the DPID was added before
+  int add(const DataPointIdentifier& dpid);
+
+  /// @return the slot of a DPID, -1 if it was not added
+  int find(const DataPointIdentifier& dpid) const
+  {
+    if (mIds.empty()) {
+      return -1;
+    }
+    for (auto pos = hash(dpid) & mMask;; pos = (pos + 1) & mMask) {
+      auto slot = mTable[pos];
+      if (slot < 0 || mIds[slot] == dpid) {
+        return slot;
+      }
+    }
+  }
+
+  /// @return the DPID of a slot
+  const DataPointIdentifier& get(int slot) const { return mIds[slot]; }
+
+  size_t size() const { return mIds.size(); }
+
+  void clear();
+
+  /// Hash of the full content (alias and type) of a DPID
+  static uint64_t hash(const DataPointIdentifier& dpid) noexcept
+  {
+    uint64_t words[8];
+    std::memcpy(words, &dpid, sizeof(words));
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (auto w : words) {
+      h = (h ^ w) * 0xff51afd7ed558ccdULL;
+      h ^= h >> 32;
+    }
+    return h;
+  }
+
+ private:
+  void rehash(size_t capacity);
+
+  std::vector<DataPointIdentifier> mIds; ///< DPID of each slot
+  std::vector<int> mTable;               ///< slot at each position of the hash table, -1 for empty positions
+  uint64_t mMask = 0;                    ///< size of the hash table - 1
+};
+
+} // namespace dcs
+} // namespace o2
+
+#endif /* O2_DCS_DATAPOINT_IDENTIFIER_INDEX_H */
@@ -0,0 +1,53 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsDCS/DataPointIdentifierIndex.h"
+
+using namespace o2::dcs;
+
+int DataPointIdentifierIndex::add(const DataPointIdentifier& dpid)
+{
+  auto slot = find(dpid);
+  if (slot >= 0) {
+    return slot;
+  }
+  if (2 * (mIds.size() + 1) > mTable.size()) {
+    rehash(mTable.empty() ? 64 : 2 * mTable.size());
+  }
+  slot = mIds.size();
+  mIds.push_back(dpid);
+  auto pos = hash(dpid) & mMask;
+  while (mTable[pos] >= 0) {
+    pos = (pos + 1) & mMask;
+  }
+  mTable[pos] = slot;
+  return slot;
+}
+
+void DataPointIdentifierIndex::rehash(size_t capacity)
+{
+  mTable.assign(capacity, -1);
+  mMask = capacity - 1;
+  for (int slot = 0; slot < int(mIds.size()); slot++) {
+    auto pos = hash(mIds[slot]) & mMask;
+    while (mTable[pos] >= 0) {
+      pos = (pos + 1) & mMask;
+    }
+    mTable[pos] = slot;
+  }
+}
+
+void DataPointIdentifierIndex::clear()
+{
+  mIds.clear();
+  mTable.clear();
+  mMask = 0;
+}
@@ -16,9 +16,11 @@
 
 #include <boost/test/unit_test.hpp>
 #include "DetectorsDCS/DataPointCompositeObject.h"
+#include "DetectorsDCS/DataPointIdentifierIndex.h"
 #include "Framework/TypeTraits.h"
 #include <vector>
 #include <list>
+#include <string>
 #include <gsl/gsl>
 #include <boost/mpl/list.hpp>
 
@@ -38,3 +40,27 @@ BOOST_AUTO_TEST_CASE(DataPointsAreMessageable)
   BOOST_CHECK_EQUAL(o2::framework::is_messageable<o2::dcs::DataPointValue>::value, true);
   BOOST_CHECK_EQUAL(o2::framework::is_messageable<o2::dcs::DataPointCompositeObject>::value, true);
 }
+
+BOOST_AUTO_TEST_CASE(DataPointIdentifierIndexSlots)
+{
+  using o2::dcs::DataPointIdentifier;
+  o2::dcs::DataPointIdentifierIndex index;
+  std::vector<DataPointIdentifier> ids;
+  for (int i = 0; i < 1000; i++) {
+    ids.emplace_back("TST/PT_" + std::to_string(i), i % 2 ? o2::dcs::DeliveryType::RAW_DOUBLE : o2::dcs::DeliveryType::RAW_INT);
+    BOOST_CHECK_EQUAL(index.add(ids.back()), i);
+  }
+  BOOST_CHECK_EQUAL(index.size(), ids.size());
+  // adding again gives back the same slot
+  BOOST_CHECK_EQUAL(index.add(ids[123]), 123);
+  BOOST_CHECK_EQUAL(index.size(), ids.size());
+  for (int i = 0; i < int(ids.size()); i++) {
+    BOOST_CHECK_EQUAL(index.find(ids[i]), i);
+    BOOST_CHECK(index.get(i) == ids[i]);
+  }
+  // the type is part of the identifier
+  BOOST_CHECK_EQUAL(index.find(DataPointIdentifier("TST/PT_0", o2::dcs::DeliveryType::RAW_DOUBLE)), -1);
+  BOOST_CHECK_EQUAL(index.find(DataPointIdentifier("TST/PT_1000", o2::dcs::DeliveryType::RAW_INT)), -1);
+  index.clear();
+  BOOST_CHECK_EQUAL(index.find(ids[0]), -1);
+}
@@ -19,7 +19,10 @@
 #include "DetectorsDCS/DataPointIdentifier.h"
 #include "DetectorsDCS/DataPointValue.h"
 #include "DetectorsDCS/DataPointCompositeObject.h"
+#include "DetectorsDCS/DataPointIdentifierIndex.h"
 #include <unordered_map>
+#include <vector>
+#include <memory>
 #include <functional>
 #include <string_view>
 #include <chrono>
@@ -47,6 +50,36 @@ using DPID = o2::dcs::DataPointIdentifier;
 using DPVAL = o2::dcs::DataPointValue;
 using DPCOM = o2::dcs::DataPointCompositeObject;
 
+/// State of the converter: the DPIDs of interest are interned once, at startup, so that each
+/// received DP is matched to its slot without any map lookup keyed by the full DPID, and only
+/// the latest value of each slot is kept in a flat array for the current 1-second window.
+struct DCStoDPLState {
+  DataPointIdentifierIndex index;             // DPID -> slot
+  std::vector<o2h::DataDescription> groups;   // requested outputs
+  std::vector<int> slot2group;                // output of each slot
+  std::vector<DPCOM> latest;                  // latest value of each slot in the current window
+  std::vector<bool> updated;                  // slot received a value in the current window
+  std::vector<std::vector<int>> updatedSlots; // slots updated in the current window, per output
+  std::chrono::time_point<std::chrono::system_clock> timer;
+
+  DCStoDPLState(const std::unordered_map<DPID, o2h::DataDescription>& dpid2group)
+  {
+    std::unordered_map<o2h::DataDescription, int, std::hash<o2h::DataDescription>> group2id;
+    for (const auto& it : dpid2group) {
+      auto grp = group2id.emplace(it.second, int(groups.size()));
+      if (grp.second) {
+        groups.push_back(it.second);
+      }
+      index.add(it.first);
+      slot2group.push_back(grp.first->second);
+    }
+    latest.resize(index.size());
+    updated.resize(index.size(), false);
+    updatedSlots.resize(groups.size());
+    timer = std::chrono::system_clock::now();
+  }
+};
+
 /// A callback function to retrieve the FairMQChannel name to be used for sending
 /// messages of the specified OutputSpec
 
@@ -54,53 +87,49 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, o2h::DataDescription>& dp
 {
 
   auto timesliceId = std::make_shared<size_t>(startTime);
-  return [dpid2group, timesliceId, step, verbose](FairMQDevice& device, FairMQParts& parts, o2f::ChannelRetriever channelRetriever) {
-    static std::unordered_map<DPID, DPCOM> cache; // will keep only the latest measurement in the 1-second wide window for each DPID
-    static auto timer = std::chrono::system_clock::now();
-
-    LOG(debug) << "In lambda function: ********* Size of unordered_map (--> number of defined groups) = " << dpid2group.size();
+  auto state = std::make_shared<DCStoDPLState>(dpid2group);
+  return [state, timesliceId, step, verbose](FairMQDevice& device, FairMQParts& parts, o2f::ChannelRetriever channelRetriever) {
+    LOG(debug) << "In lambda function: ********* Number of defined groups = " << state->groups.size();
     // We first iterate over the parts of the received message
     for (size_t i = 0; i < parts.Size(); ++i) {             // DCS sends only 1 part, but we should be able to receive more
       auto nDPCOM = parts.At(i)->GetSize() / sizeof(DPCOM); // number of DPCOM in current part
       for (size_t j = 0; j < nDPCOM; j++) {
         const auto& src = *(reinterpret_cast<const DPCOM*>(parts.At(i)->GetData()) + j);
         // do we want to check if this DP was requested ?
-        auto mapEl = dpid2group.find(src.id);
+        auto slot = state->index.find(src.id);
         if (verbose) {
-          LOG(info) << "Received DP " << src.id << " (data = " << src.data << "), matched to output-> " << (mapEl == dpid2group.end() ? "none " : mapEl->second.as<std::string>());
+          LOG(info) << "Received DP " << src.id << " (data = " << src.data << "), matched to output-> " << (slot < 0 ? "none " : state->groups[state->slot2group[slot]].as<std::string>());
         }
-        if (mapEl != dpid2group.end()) {
-          auto& dst = cache[src.id] = src; // this is needed in case in the 1s window we get a new value for the same DP
+        if (slot >= 0) {
+          state->latest[slot] = src; // this is needed in case in the 1s window we get a new value for the same DP
+          if (!state->updated[slot]) {
+            state->updated[slot] = true;
+            state->updatedSlots[state->slot2group[slot]].push_back(slot);
+          }
         }
       }
     }
 
     auto timerNow = std::chrono::system_clock::now();
-    std::chrono::duration<double, std::ratio<1>> duration = timerNow - timer;
+    std::chrono::duration<double, std::ratio<1>> duration = timerNow - state->timer;
     if (duration.count() > 1) { //did we accumulate for 1 sec?
       *timesliceId += step;     // we increment only if we send something
-      std::unordered_map<o2h::DataDescription, pmr::vector<DPCOM>, std::hash<o2h::DataDescription>> outputs;
-      // in the cache we have the final values of the DPs that we should put in the output
-      // distribute DPs over the vectors for each requested output
-      for (auto& it : cache) {
-        auto mapEl = dpid2group.find(it.first);
-        if (mapEl != dpid2group.end()) {
-          outputs[mapEl->second].push_back(it.second);
-        }
-      }
       std::uint64_t creation = std::chrono::time_point_cast<std::chrono::milliseconds>(timerNow).time_since_epoch().count();
-      // create and send output messages
-      for (auto& it : outputs) {
-        o2h::DataHeader hdr(it.first, "DCS", 0);
+      // create and send output messages, the latest values of the DPs of each output are written directly to its payload
+      for (size_t iGroup = 0; iGroup < state->groups.size(); iGroup++) {
+        auto& slots = state->updatedSlots[iGroup];
+        o2h::DataHeader hdr(state->groups[iGroup], "DCS", 0);
         o2f::OutputSpec outsp{hdr.dataOrigin, hdr.dataDescription, hdr.subSpecification};
-        if (it.second.empty()) {
-          LOG(warning) << "No data for OutputSpec " << outsp;
+        if (slots.empty()) { // nothing received for this output in the window
           continue;
         }
         auto channel = channelRetriever(outsp, *timesliceId);
         if (channel.empty()) {
           LOG(warning) << "No output channel found for OutputSpec " << outsp << ", discarding its data";
-          it.second.clear();
+          for (auto slot : slots) {
+            state->updated[slot] = false;
+          }
+          slots.clear();
           continue;
         }
 
@@ -108,26 +137,30 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, o2h::DataDescription>& dp
         hdr.payloadSerializationMethod = o2h::gSerializationMethodNone;
         hdr.splitPayloadParts = 1;
         hdr.splitPayloadIndex = 1;
-        hdr.payloadSize = it.second.size() * sizeof(DPCOM);
+        hdr.payloadSize = slots.size() * sizeof(DPCOM);
         hdr.firstTForbit = 0; // this should be irrelevant for DCS
         o2h::Stack headerStack{hdr, o2::framework::DataProcessingHeader{*timesliceId, 1, creation}};
         auto fmqFactory = device.GetChannel(channel).Transport();
         auto hdMessage = fmqFactory->CreateMessage(headerStack.size(), fair::mq::Alignment{64});
         auto plMessage = fmqFactory->CreateMessage(hdr.payloadSize, fair::mq::Alignment{64});
         memcpy(hdMessage->GetData(), headerStack.data(), headerStack.size());
-        memcpy(plMessage->GetData(), it.second.data(), hdr.payloadSize);
+        auto* dst = reinterpret_cast<char*>(plMessage->GetData());
+        for (auto slot : slots) {
+          memcpy(dst, &state->latest[slot], sizeof(DPCOM));
+          dst += sizeof(DPCOM);
+          state->updated[slot] = false;
+        }
         if (verbose) {
-          LOGP(info, "Pushing {} DPs to {} for TimeSlice {} at {}", it.second.size(), o2f::DataSpecUtils::describe(outsp), *timesliceId, creation);
+          LOGP(info, "Pushing {} DPs to {} for TimeSlice {} at {}", slots.size(), o2f::DataSpecUtils::describe(outsp), *timesliceId, creation);
         }
-        it.second.clear();
+        slots.clear();
         FairMQParts outParts;
         outParts.AddPart(std::move(hdMessage));
         outParts.AddPart(std::move(plMessage));
         o2f::sendOnChannel(device, outParts, channel);
       }
 
-      timer = timerNow;
-      cache.clear();
+      state->timer = timerNow;
     }
   };
 }
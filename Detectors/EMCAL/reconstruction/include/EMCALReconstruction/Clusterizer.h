@@ -15,6 +15,7 @@
 #define ALICEO2_EMCAL_CLUSTERIZER_H
 
 #include <array>
+#include <vector>
 #include <gsl/span>
 #include "Rtypes.h"
 #include "DataFormatsEMCAL/Cluster.h"
@@ -59,7 +60,7 @@ class Clusterizer
   };
 
   struct InputwithIndex {
-    InputType* mInput;
+    const InputType* mInput;
     ClusterIndex mIndex;
   };
 
@@ -87,6 +88,9 @@ class Clusterizer
   std::array<cellWithE, NROWS * NCOLS> mSeedList;                 //!<! seed array
   std::array<std::array<InputwithIndex, NCOLS>, NROWS> mInputMap; //!<! topology arrays
   std::array<std::array<bool, NCOLS>, NROWS> mCellMask;           //!<! topology arrays
+  bool mTopologyDirty = true;                                     //!<! topology arrays need a full reset
+  int mNSeeds = 0;                                                //!<! number of entries of the seed list filled in the last call
+  std::vector<InputwithIndex> mClusterInputs;                     //!<! cells/digits of the cluster being formed
 
   std::vector<Cluster> mFoundClusters;     ///<  vector of cluster objects
   std::vector<ClusterIndex> mInputIndices; ///<  vector of associated cell/digit tower ID, ordered by cluster
@@ -140,11 +140,21 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   // --> Seed cell and all neighbours belonging to cluster will be put in 2D bitmap
 
   // Reset cell/digit maps and cell masks
-  // Loop over one array dim, then reset each array
-  for (auto iArr = 0; iArr < NROWS; iArr++) {
-    mCellMask[iArr].fill(kFALSE);
-    mInputMap[iArr].fill({nullptr, -1});
+  // Only the positions filled in the previous call are reset (they are all in the seed list),
+  // a full reset of the topology arrays is needed only the first time
+  if (mTopologyDirty) {
+    for (auto iArr = 0; iArr < NROWS; iArr++) {
+      mCellMask[iArr].fill(kFALSE);
+      mInputMap[iArr].fill({nullptr, -1});
+    }
+    mTopologyDirty = false;
+  } else {
+    for (int i = 0; i < mNSeeds; i++) {
+      mCellMask[mSeedList[i].row][mSeedList[i].column] = kFALSE;
+      mInputMap[mSeedList[i].row][mSeedList[i].column] = {nullptr, -1};
+    }
   }
+  mNSeeds = 0;
 
   // Calibrate cells/digits and fill the maps/arrays
   int nCells = 0;
@@ -152,7 +162,7 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   //for (auto dig : inputArray) {
   for (int iIndex = 0; iIndex < inputArray.size(); iIndex++) {
 
-    auto dig = inputArray[iIndex];
+    const auto& dig = inputArray[iIndex];
 
     Float_t inputEnergy = dig.getEnergy();
     Float_t time = dig.getTimeStamp();
@@ -175,6 +185,7 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
     mSeedList[nCells].column = column;
     nCells++;
   }
+  mNSeeds = nCells;
 
   // Sort struct arrays with ascending energy
   std::sort(mSeedList.begin(), std::next(std::begin(mSeedList), nCells));
@@ -192,12 +203,12 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
     }
 
     // Seed is found, form cluster recursively
-    std::vector<InputwithIndex> clusterInputs;
-    getClusterFromNeighbours(clusterInputs, row, column);
+    mClusterInputs.clear();
+    getClusterFromNeighbours(mClusterInputs, row, column);
 
     // Add cells/digits for current cluster to cell/digit index vector
     int inputIndexStart = mInputIndices.size();
-    for (auto dig : clusterInputs) {
+    for (auto dig : mClusterInputs) {
       mInputIndices.emplace_back(dig.mIndex);
     }
     int inputIndexSize = mInputIndices.size() - inputIndexStart;
@@ -48,6 +48,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
   auto cells = pc.inputs().get<gsl::span<Cell>>("cells");
 
   auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{"EMC", "CTFDATA", 0, Lifetime::Timeframe});
+  mCTFCoder.updateCodersFromFile<CTF>(o2::ctf::CTFCoderBase::OpType::Encoder);
   mCTFCoder.encode(buffer, triggers, cells);
   auto eeb = CTF::get(buffer.data()); // cast to container pointer
   eeb->compactify();                  // eliminate unnecessary padding
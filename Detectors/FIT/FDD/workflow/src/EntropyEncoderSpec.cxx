@@ -48,6 +48,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
   auto channels = pc.inputs().get<gsl::span<o2::fdd::ChannelData>>("channels");
 
   auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{"FDD", "CTFDATA", 0, Lifetime::Timeframe});
+  mCTFCoder.updateCodersFromFile<CTF>(o2::ctf::CTFCoderBase::OpType::Encoder);
   mCTFCoder.encode(buffer, digits, channels);
   auto eeb = CTF::get(buffer.data()); // cast to container pointer
   eeb->compactify();                  // eliminate unnecessary padding
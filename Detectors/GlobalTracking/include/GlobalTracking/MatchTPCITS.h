@@ -172,6 +172,16 @@ struct MatchRecord {
   }
 };
 
+///< matching candidate found by the sector-wise search, to be registered in the MatchRecords
+struct MatchCandidate {
+  int itsID = MinusOne;     ///< entry in mITSWork
+  int tpcID = MinusOne;     ///< entry in mTPCWork
+  float chi2 = -1.f;        ///< matching chi2
+  int matchedIC = MinusOne; ///< index of eventually matched InteractionCandidate
+  MatchCandidate(int its, int tpc, float chi2match, int candIC) : itsID(its), tpcID(tpc), chi2(chi2match), matchedIC(candIC) {}
+  MatchCandidate() = default;
+};
+
 ///< Link of the AfterBurner track: update at sertain cluster
 ///< original track in the currently loaded TPC reco output
 struct ABTrackLink : public o2::track::TrackParCov {
@@ -418,6 +428,7 @@ class MatchTPCITS
   void flagUsedITSClusters(const o2::its::TrackITS& track);
 
   void doMatching(int sec);
+  void registerMatchCandidates(int sec);
 
   void refitWinners();
   bool refitTrackTPCITS(int iTPC, int& iITS);
@@ -621,6 +632,9 @@ class MatchTPCITS
   ///< indices of 1st entries of ITS tracks starting at given ROframe
   std::array<std::vector<int>, o2::constants::math::NSectors> mITSTimeStart;
 
+  ///< per sector matching candidates, filled in parallel and registered sequentially
+  std::array<std::vector<MatchCandidate>, o2::constants::math::NSectors> mSectorMatchCandidates;
+
   /// mapping for tracks' continuos ROF cycle to actual continuous readout ROFs with eventual gaps
   std::vector<int> mITSTrackROFContMapping;
 
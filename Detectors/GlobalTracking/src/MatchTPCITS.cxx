@@ -87,9 +87,22 @@ void MatchTPCITS::run(const o2::globaltracking::RecoContainer& inp)
     }
 
     mTimer[SWDoMatching].Start(false);
-    for (int sec = o2::constants::math::NSectors; sec--;) {
+    // candidates search is independent for every sector, while their registration must follow the sequential order
+    int nThreadsMatching = mNThreads;
+#ifdef _ALLOW_DEBUG_TREES_
+    if (mDBGOut) {
+      nThreadsMatching = 1; // debug tree filling is not thread-safe
+    }
+#endif
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreadsMatching)
+#endif
+    for (int sec = o2::constants::math::NSectors - 1; sec >= 0; sec--) {
       doMatching(sec);
     }
+    for (int sec = o2::constants::math::NSectors; sec--;) {
+      registerMatchCandidates(sec);
+    }
     mTimer[SWDoMatching].Stop();
     if (0) { // enabling this creates very verbose output
       mTimer[SWTot].Stop();
@@ -160,6 +173,7 @@ void MatchTPCITS::clear()
     mITSTimeStart[sec].clear();
     mTPCSectIndexCache[sec].clear();
     mTPCTimeStart[sec].clear();
+    mSectorMatchCandidates[sec].clear();
   }
 
   if (mMCTruthON) {
@@ -449,7 +463,10 @@ bool MatchTPCITS::prepareTPCData()
   float maxTime = 0;
   int nITSROFs = mITSROFTimes.size();
   // sort tracks in each sector according to their timeMax
-  for (int sec = o2::constants::math::NSectors; sec--;) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) reduction(max : maxTime)
+#endif
+  for (int sec = o2::constants::math::NSectors - 1; sec >= 0; sec--) {
     auto& indexCache = mTPCSectIndexCache[sec];
     if (mParams->verbosity > 0) {
       LOG(info) << "Sorting sector" << sec << " | " << indexCache.size() << " TPC tracks";
@@ -646,7 +663,10 @@ bool MatchTPCITS::prepareITSData()
 
   // sort tracks in each sector according to their min time, then tgl
   // RSTODO: sorting in tgl will be dangerous once the tracks with different time uncertaincies will be added
-  for (int sec = o2::constants::math::NSectors; sec--;) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int sec = o2::constants::math::NSectors - 1; sec >= 0; sec--) {
     auto& indexCache = mITSSectIndexCache[sec];
     if (mParams->verbosity > 0) {
       LOG(info) << "Sorting sector" << sec << " | " << indexCache.size() << " ITS tracks";
@@ -685,7 +705,10 @@ bool MatchTPCITS::prepareFITData()
 //_____________________________________________________
 void MatchTPCITS::doMatching(int sec)
 {
-  ///< run matching for currently cached ITS data for given TPC sector
+  ///< run matching for currently cached ITS data for given TPC sector, the found candidates are stored
+  ///< in the sector's own container, so that different sectors can be processed concurrently
+  auto& candidates = mSectorMatchCandidates[sec];
+  candidates.clear();
   auto& cacheITS = mITSSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& cacheTPC = mTPCSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& timeStartTPC = mTPCTimeStart[sec];    // array of 1st TPC track with timeMax in ITS ROFrame
@@ -821,7 +844,7 @@ void MatchTPCITS::doMatching(int sec)
           continue;
         }
       }
-      registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
+      candidates.emplace_back(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // store matching candidate
       nMatchesControl++;
     }
   }
@@ -832,6 +855,16 @@ void MatchTPCITS::doMatching(int sec)
   }
 }
 
+//______________________________________________
+void MatchTPCITS::registerMatchCandidates(int sec)
+{
+  ///< register matching candidates found for given sector, in the order they were found
+  for (const auto& cand : mSectorMatchCandidates[sec]) {
+    registerMatchRecordTPC(cand.itsID, cand.tpcID, cand.chi2, cand.matchedIC);
+  }
+  mSectorMatchCandidates[sec].clear();
+}
+
 //______________________________________________
 void MatchTPCITS::suppressMatchRecordITS(int itsID, int tpcID)
 {
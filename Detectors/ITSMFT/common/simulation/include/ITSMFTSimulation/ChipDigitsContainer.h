@@ -20,9 +20,11 @@
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "ITSMFTBase/SegmentationAlpide.h"
 #include "ITSMFTSimulation/PreDigit.h"
-#include <map>
+#include <algorithm>
 #include <vector>
 
+class TRandom;
+
 namespace o2
 {
 namespace itsmft
@@ -31,25 +33,39 @@ class DigiParams;
 
 /// @class ChipDigitsContainer
 /// @brief Container for similated points connected to a given chip
+///
+/// The fired pixels are kept in one bucket per readout frame, each made of a flat vector of
+/// pre-digits in arrival order with an open-addressing index on the (row,col) of the pixel.
+/// The pre-digits of a frame are sorted in the column/row order only when they are fetched
+/// for the output, after which the bucket is recycled for the following frames.
 
 class ChipDigitsContainer
 {
  public:
+  using ExtraLabels = std::vector<o2::itsmft::PreDigitLabelRef>; ///< container for extra contributions to PreDigits
+
   /// Default constructor
   ChipDigitsContainer(UShort_t idx = 0) : mChipIndex(idx){};
 
   /// Destructor
   ~ChipDigitsContainer() = default;
 
-  std::map<ULong64_t, o2::itsmft::PreDigit>& getPreDigits() { return mDigits; }
-  bool isEmpty() const { return mDigits.empty(); }
+  bool isEmpty() const { return mROFBuckets.empty(); }
 
   void setChipIndex(UShort_t ind) { mChipIndex = ind; }
   UShort_t getChipIndex() const { return mChipIndex; }
 
   o2::itsmft::PreDigit* findDigit(ULong64_t key);
-  void addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col, int charge, o2::MCCompLabel lbl);
-  void addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmft::DigiParams* params, int maxRows = o2::itsmft::SegmentationAlpide::NRows, int maxCols = o2::itsmft::SegmentationAlpide::NCols);
+  o2::itsmft::PreDigit* addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col, int charge, o2::MCCompLabel lbl);
+  void addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmft::DigiParams* params, int maxRows = o2::itsmft::SegmentationAlpide::NRows, int maxCols = o2::itsmft::SegmentationAlpide::NCols, TRandom* rnd = nullptr);
+
+  /// Extra label contributions for the pre-digits of given ROFrame, referred by PreDigitLabelRef::next
+  ExtraLabels& getExtraLabels(UInt_t roframe) { return getBucket(roframe).extra; }
+
+  /// Sort the pre-digits of given ROFrame in column/row order and return them, nullptr if there are none
+  std::vector<o2::itsmft::PreDigit>* getROFramePreDigits(UInt_t roframe);
+  /// Discard the pre-digits and extra labels of all ROFrames up to roframeMax included
+  void releaseROFrames(UInt_t roframeMax);
 
   /// Get global ordering key made of readout frame, column and row
   static ULong64_t getOrderingKey(UInt_t roframe, UShort_t row, UShort_t col)
@@ -63,30 +79,110 @@ class ChipDigitsContainer
     return static_cast<UInt_t>(key >> (8 * sizeof(UInt_t)));
   }
 
+  /// Get the pixel part (column and row) of the ordering key
+  static UInt_t key2Pixel(ULong64_t key)
+  {
+    return static_cast<UInt_t>(key);
+  }
+
   bool isDisabled() const { return mDisabled; }
   void disable(bool v) { mDisabled = v; }
 
  protected:
-  UShort_t mChipIndex = 0;                           ///< chip index
+  /// fired pixels of a single ROFrame
+  struct ROFBucket {
+    UInt_t roFrame = 0;
+    std::vector<o2::itsmft::PreDigit> digits; ///< pre-digits in arrival order, sorted only when fetched
+    std::vector<ULong64_t> index;             ///< open-addressing table of (pixel << 32) | slot in digits
+    ExtraLabels extra;                        ///< extra label contributions
+    size_t nEntries = 0;                      ///< number of used entries in the index
+
+    void clear()
+    {
+      digits.clear();
+      extra.clear();
+      if (nEntries) {
+        std::fill(index.begin(), index.end(), EmptyEntry);
+        nEntries = 0;
+      }
+    }
+  };
+
+  static constexpr ULong64_t EmptyEntry = 0xffffffffffffffff; ///< pixel 0xffffffff cannot exist
+  static constexpr size_t MinIndexSize = 64;                 ///< must be a power of 2
+
+  static UInt_t hashPixel(UInt_t pixel)
+  {
+    UInt_t h = pixel * 2654435761u;
+    return h ^ (h >> 15);
+  }
+
+  ROFBucket* findBucket(UInt_t roframe);
+  ROFBucket& getBucket(UInt_t roframe);
+  static void growIndex(ROFBucket& bucket);
+
+  UShort_t mChipIndex = 0; ///< chip index
   bool mDisabled = false;
-  std::map<ULong64_t, o2::itsmft::PreDigit> mDigits; ///< Map of fired pixels, possibly in multiple frames
+  std::vector<ROFBucket> mROFBuckets;   //! buckets of the ROFrames with fired pixels, in increasing ROFrame order
+  std::vector<ROFBucket> mSpareBuckets; //! released buckets kept for reuse
 
-  ClassDefNV(ChipDigitsContainer, 1);
+  ClassDefNV(ChipDigitsContainer, 2);
 };
 
+//_______________________________________________________________________
+inline ChipDigitsContainer::ROFBucket* ChipDigitsContainer::findBucket(UInt_t roframe)
+{
+  // there are only few ROFrames alive at any time, the last one being the most likely
+  for (auto it = mROFBuckets.rbegin(); it != mROFBuckets.rend(); ++it) {
+    if (it->roFrame == roframe) {
+      return &(*it);
+    }
+    if (it->roFrame < roframe) {
+      break;
+    }
+  }
+  return nullptr;
+}
+
 //_______________________________________________________________________
 inline o2::itsmft::PreDigit* ChipDigitsContainer::findDigit(ULong64_t key)
 {
   // finds the digit corresponding to global key
-  auto digitentry = mDigits.find(key);
-  return digitentry != mDigits.end() ? &(digitentry->second) : nullptr;
+  auto* bucket = findBucket(key2ROFrame(key));
+  if (!bucket || !bucket->nEntries) {
+    return nullptr;
+  }
+  UInt_t pixel = key2Pixel(key);
+  size_t mask = bucket->index.size() - 1;
+  for (size_t pos = hashPixel(pixel) & mask;; pos = (pos + 1) & mask) {
+    auto entry = bucket->index[pos];
+    if (entry == EmptyEntry) {
+      return nullptr;
+    }
+    if (UInt_t(entry >> 32) == pixel) {
+      return &bucket->digits[UInt_t(entry)];
+    }
+  }
 }
 
 //_______________________________________________________________________
-inline void ChipDigitsContainer::addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col,
-                                          int charge, o2::MCCompLabel lbl)
+inline o2::itsmft::PreDigit* ChipDigitsContainer::addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col,
+                                                           int charge, o2::MCCompLabel lbl)
 {
-  mDigits.emplace(std::make_pair(key, o2::itsmft::PreDigit(roframe, row, col, charge, lbl)));
+  // adds new digit, which must not be present yet
+  auto& bucket = getBucket(roframe);
+  if (2 * (bucket.nEntries + 1) > bucket.index.size()) {
+    growIndex(bucket);
+  }
+  UInt_t pixel = key2Pixel(key);
+  size_t mask = bucket.index.size() - 1;
+  size_t pos = hashPixel(pixel) & mask;
+  while (bucket.index[pos] != EmptyEntry) {
+    pos = (pos + 1) & mask;
+  }
+  bucket.index[pos] = (static_cast<ULong64_t>(pixel) << 32) | bucket.digits.size();
+  bucket.nEntries++;
+  return &bucket.digits.emplace_back(roframe, row, col, charge, lbl);
 }
 } // namespace itsmft
 } // namespace o2
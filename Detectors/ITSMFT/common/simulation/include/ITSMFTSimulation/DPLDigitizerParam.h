@@ -41,6 +41,7 @@ struct DPLDigitizerParam : public o2::conf::ConfigurableParamHelper<DPLDigitizer
   int minChargeToAccount = 15;            ///< minimum charge contribution to account
   int nSimSteps = 7;                      ///< number of steps in response simulation
   float energyToNElectrons = 1. / 3.6e-9; // conversion of eloss to Nelectrons
+  int nThreads = 1;                       ///< number of threads digitizing different chips in parallel
 
   float Vbb = 3.0;   ///< back bias absolute value for MFT (in Volt)
   float IBVbb = 3.0; ///< back bias absolute value for ITS Inner Barrel (in Volt)
@@ -15,11 +15,11 @@
 #define ALICEO2_ITSMFT_DIGITIZER_H
 
 #include <vector>
-#include <deque>
 #include <memory>
 
 #include "Rtypes.h" // for Digitizer::Class
 #include "TObject.h" // for TObject
+#include "TRandom.h"
 
 #include "ITSMFTSimulation/ChipDigitsContainer.h"
 #include "ITSMFTSimulation/AlpideSimResponse.h"
@@ -45,8 +45,6 @@ namespace itsmft
 {
 class Digitizer : public TObject
 {
-  using ExtraDig = std::vector<PreDigitLabelRef>; ///< container for extra contributions to PreDigits
-
  public:
   Digitizer() = default;
   ~Digitizer() override = default;
@@ -91,22 +89,30 @@ class Digitizer : public TObject
     mEventROFrameMax = 0;
   }
 
+  /// Number of threads digitizing different chips in parallel. With more than 1 thread every chip
+  /// uses its own random generator, seeded from gRandom for every event, so that the result does
+  /// not depend on the number of threads (but differs from the single thread one)
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// non-zero seed of the generator of given chip, mixing the full 32 bit seed drawn for the event with the chip ID
+  static UInt_t getChipSeed(UInt_t eventSeed, int chipID);
+
  private:
-  void processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID, int srcID);
-  void registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, float tInROF, int nROF,
+  /// state of the hit processing which is local to a thread
+  struct HitContext {
+    TRandom* rnd = nullptr;
+    uint32_t roFrameMax = 0;               ///< highest RO frame reached by the signal
+    uint32_t eventROFrameMin = 0xffffffff; ///< lowest RO frame with registered digits
+    uint32_t eventROFrameMax = 0;          ///< highest RO frame with registered digits
+  };
+
+  void processHit(const o2::itsmft::Hit& hit, HitContext& ctx, int evID, int srcID);
+  void registerDigits(ChipDigitsContainer& chip, HitContext& ctx, uint32_t roFrame, float tInROF, int nROF,
                       uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl);
-
-  ExtraDig* getExtraDigBuffer(uint32_t roFrame)
-  {
-    if (mROFrameMin > roFrame) {
-      return nullptr; // nothing to do
-    }
-    int ind = roFrame - mROFrameMin;
-    while (ind >= int(mExtraBuff.size())) {
-      mExtraBuff.emplace_back(std::make_unique<ExtraDig>());
-    }
-    return mExtraBuff[ind].get();
-  }
+  void processChipsParallel(const std::vector<Hit>* hits, const std::vector<int>& hitIdx, int evID, int srcID);
+  void prepareThreadRandom();
+  TRandom* getChipRandom(int thread, int chipID);
 
   static constexpr float sec2ns = 1e9;
 
@@ -130,14 +136,18 @@ class Digitizer : public TObject
   const o2::itsmft::GeometryTGeo* mGeometry = nullptr; ///< ITS OR MFT upgrade geometry
 
   std::vector<o2::itsmft::ChipDigitsContainer> mChips; ///< Array of chips digits containers
-  std::deque<std::unique_ptr<ExtraDig>> mExtraBuff;    ///< burrer (per roFrame) for extra digits
+  std::vector<std::vector<PreDigit>*> mChipROFDigits;  //! sorted pre-digits of every chip for the ROFrame being flushed
+
+  int mNThreads = 1;                                ///< number of threads for chip-parallel digitization
+  std::vector<std::unique_ptr<TRandom>> mThreadRnd; //! random generators of the threads, reseeded per chip
+  UInt_t mEventSeed = 0;                            //! seed drawn for the event, mixed with the chip ID for per-chip generators
 
   std::vector<o2::itsmft::Digit>* mDigits = nullptr;                       //! output digits
   std::vector<o2::itsmft::ROFRecord>* mROFRecords = nullptr;               //! output ROF records
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mMCLabels = nullptr; //! output labels
   const o2::itsmft::NoiseMap* mNoiseMap = nullptr;
 
-  ClassDefOverride(Digitizer, 2);
+  ClassDefOverride(Digitizer, 3);
 };
 } // namespace itsmft
 } // namespace o2
@@ -24,8 +24,11 @@ using Segmentation = o2::itsmft::SegmentationAlpide;
 ClassImp(o2::itsmft::ChipDigitsContainer);
 
 //______________________________________________________________________
-void ChipDigitsContainer::addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmft::DigiParams* params, int maxRows, int maxCols)
+void ChipDigitsContainer::addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmft::DigiParams* params, int maxRows, int maxCols, TRandom* rnd)
 {
+  if (!rnd) {
+    rnd = gRandom;
+  }
   UInt_t row = 0;
   UInt_t col = 0;
   Int_t nhits = 0;
@@ -35,10 +38,10 @@ void ChipDigitsContainer::addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmf
   int nel = params->getChargeThreshold() * 1.1; // RS: TODO: need realistic spectrum of noise above the threshold
 
   for (UInt_t rof = rofMin; rof <= rofMax; rof++) {
-    nhits = gRandom->Poisson(mean);
+    nhits = rnd->Poisson(mean);
     for (Int_t i = 0; i < nhits; ++i) {
-      row = gRandom->Integer(maxRows);
-      col = gRandom->Integer(maxCols);
+      row = rnd->Integer(maxRows);
+      col = rnd->Integer(maxCols);
       // RS TODO: why the noise was added with 0 charge? It should be above the threshold!
       auto key = getOrderingKey(rof, row, col);
       if (!findDigit(key)) {
@@ -47,3 +50,71 @@ void ChipDigitsContainer::addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmf
     }
   }
 }
+
+//______________________________________________________________________
+ChipDigitsContainer::ROFBucket& ChipDigitsContainer::getBucket(UInt_t roframe)
+{
+  auto* bucket = findBucket(roframe);
+  if (bucket) {
+    return *bucket;
+  }
+  // keep the buckets ordered in ROFrame, new frames are normally appended
+  auto it = mROFBuckets.end();
+  while (it != mROFBuckets.begin() && (it - 1)->roFrame > roframe) {
+    --it;
+  }
+  if (mSpareBuckets.empty()) {
+    it = mROFBuckets.emplace(it);
+  } else {
+    it = mROFBuckets.emplace(it, std::move(mSpareBuckets.back()));
+    mSpareBuckets.pop_back();
+  }
+  it->roFrame = roframe;
+  return *it;
+}
+
+//______________________________________________________________________
+void ChipDigitsContainer::growIndex(ROFBucket& bucket)
+{
+  size_t newSize = std::max(MinIndexSize, 2 * bucket.index.size());
+  bucket.index.assign(newSize, EmptyEntry);
+  size_t mask = newSize - 1;
+  for (UInt_t slot = 0; slot < bucket.digits.size(); slot++) {
+    const auto& dig = bucket.digits[slot];
+    UInt_t pixel = key2Pixel(getOrderingKey(dig.roFrame, dig.row, dig.col));
+    size_t pos = hashPixel(pixel) & mask;
+    while (bucket.index[pos] != EmptyEntry) {
+      pos = (pos + 1) & mask;
+    }
+    bucket.index[pos] = (static_cast<ULong64_t>(pixel) << 32) | slot;
+  }
+  bucket.nEntries = bucket.digits.size();
+}
+
+//______________________________________________________________________
+std::vector<PreDigit>* ChipDigitsContainer::getROFramePreDigits(UInt_t roframe)
+{
+  auto* bucket = findBucket(roframe);
+  if (!bucket || bucket->digits.empty()) {
+    return nullptr;
+  }
+  // the index is not needed anymore for this frame: new contributions cannot arrive once it is fetched
+  std::sort(bucket->digits.begin(), bucket->digits.end(), [](const PreDigit& a, const PreDigit& b) {
+    return a.col < b.col || (a.col == b.col && a.row < b.row);
+  });
+  return &bucket->digits;
+}
+
+//______________________________________________________________________
+void ChipDigitsContainer::releaseROFrames(UInt_t roframeMax)
+{
+  size_t n = 0;
+  while (n < mROFBuckets.size() && mROFBuckets[n].roFrame <= roframeMax) {
+    mROFBuckets[n].clear();
+    mSpareBuckets.emplace_back(std::move(mROFBuckets[n]));
+    n++;
+  }
+  if (n) {
+    mROFBuckets.erase(mROFBuckets.begin(), mROFBuckets.begin() + n);
+  }
+}
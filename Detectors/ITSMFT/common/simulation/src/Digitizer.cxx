@@ -21,11 +21,17 @@
 #include "DetectorsRaw/HBFUtils.h"
 
 #include <TRandom.h>
+#include <TRandom3.h>
+#include <atomic>
 #include <climits>
 #include <vector>
 #include <numeric>
 #include "FairLogger.h" // for LOG
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using o2::itsmft::Digit;
 using o2::itsmft::Hit;
 using Segmentation = o2::itsmft::SegmentationAlpide;
@@ -115,8 +121,16 @@ void Digitizer::process(const std::vector<Hit>* hits, int evID, int srcID)
             [hits](auto lhs, auto rhs) {
               return (*hits)[lhs].GetDetectorID() < (*hits)[rhs].GetDetectorID();
             });
-  for (int i : hitIdx) {
-    processHit((*hits)[i], mROFrameMax, evID, srcID);
+  if (mNThreads > 1) {
+    processChipsParallel(hits, hitIdx, evID, srcID);
+  } else {
+    HitContext ctx{gRandom, mROFrameMax, mEventROFrameMin, mEventROFrameMax};
+    for (int i : hitIdx) {
+      processHit((*hits)[i], ctx, evID, srcID);
+    }
+    mROFrameMax = ctx.roFrameMax;
+    mEventROFrameMin = ctx.eventROFrameMin;
+    mEventROFrameMax = ctx.eventROFrameMax;
   }
   // in the triggered mode store digits after every MC event
   // TODO: in the real triggered mode this will not be needed, this is actually for the
@@ -126,6 +140,74 @@ void Digitizer::process(const std::vector<Hit>* hits, int evID, int srcID)
   }
 }
 
+//_______________________________________________________________________
+void Digitizer::processChipsParallel(const std::vector<Hit>* hits, const std::vector<int>& hitIdx, int evID, int srcID)
+{
+  // digitize the hits of different chips in parallel, the hits indices are sorted in chip ID
+  std::vector<int> chipHitStart; // position in hitIdx of the 1st hit of every fired chip
+  for (int i = 0; i < (int)hitIdx.size(); i++) {
+    if (!i || (*hits)[hitIdx[i]].GetDetectorID() != (*hits)[hitIdx[i - 1]].GetDetectorID()) {
+      chipHitStart.push_back(i);
+    }
+  }
+  int nFired = chipHitStart.size();
+  chipHitStart.push_back(hitIdx.size());
+  prepareThreadRandom();
+  std::vector<HitContext> contexts(mNThreads, HitContext{nullptr, mROFrameMax, mEventROFrameMin, mEventROFrameMax});
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ic = 0; ic < nFired; ic++) {
+#ifdef WITH_OPENMP
+    int ith = omp_get_thread_num();
+#else
+    int ith = 0;
+#endif
+    auto& ctx = contexts[ith];
+    ctx.rnd = getChipRandom(ith, (*hits)[hitIdx[chipHitStart[ic]]].GetDetectorID());
+    for (int i = chipHitStart[ic]; i < chipHitStart[ic + 1]; i++) {
+      processHit((*hits)[hitIdx[i]], ctx, evID, srcID);
+    }
+  }
+  for (const auto& ctx : contexts) {
+    mROFrameMax = std::max(mROFrameMax, ctx.roFrameMax);
+    mEventROFrameMin = std::min(mEventROFrameMin, ctx.eventROFrameMin);
+    mEventROFrameMax = std::max(mEventROFrameMax, ctx.eventROFrameMax);
+  }
+}
+
+//_______________________________________________________________________
+void Digitizer::prepareThreadRandom()
+{
+  // create the generators of the threads and draw the seed base from the global generator,
+  // to be done before entering the parallel region
+  while ((int)mThreadRnd.size() < mNThreads) {
+    mThreadRnd.emplace_back(std::make_unique<TRandom3>());
+  }
+  mEventSeed = gRandom->Integer(0xffffffff);
+}
+
+//_______________________________________________________________________
+UInt_t Digitizer::getChipSeed(UInt_t eventSeed, int chipID)
+{
+  // splitmix64 finalizer of the (event seed, chip) pair, folded to 32 bits as required by TRandom3::SetSeed
+  ULong64_t z = ((ULong64_t(eventSeed) << 32) | UInt_t(chipID)) + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  UInt_t seed = UInt_t(z ^ (z >> 32));
+  return seed ? seed : 1; // 0 would mean a time-based seed
+}
+
+//_______________________________________________________________________
+TRandom* Digitizer::getChipRandom(int thread, int chipID)
+{
+  // generator of given thread, reseeded for the chip
+  auto* rnd = mThreadRnd[thread].get();
+  rnd->SetSeed(getChipSeed(mEventSeed, chipID));
+  return rnd;
+}
+
 //_______________________________________________________________________
 void Digitizer::setEventTime(const o2::InteractionTimeRecord& irt)
 {
@@ -166,9 +248,6 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
   if (frameLast > mROFrameMax) {
     frameLast = mROFrameMax;
   }
-  // make sure all buffers for extra digits are created up to the maxFrame
-  getExtraDigBuffer(mROFrameMax);
-
   LOG(info) << "Filling " << mGeometry->getName() << " digits output for RO frames " << mROFrameMin << ":"
             << frameLast;
 
@@ -179,24 +258,42 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
     rcROF.setROFrame(mROFrameMin);
     rcROF.setFirstEntry(mDigits->size()); // start of current ROF in digits
 
-    auto& extra = *(mExtraBuff.front().get());
-    for (auto& chip : mChips) {
+    // add the noise and sort the pre-digits of every chip, which is independent for different chips
+    int nChips = mChips.size();
+    mChipROFDigits.resize(nChips);
+    if (mNThreads > 1) {
+      prepareThreadRandom();
+    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads) if (mNThreads > 1)
+#endif
+    for (int ic = 0; ic < nChips; ic++) {
+      auto& chip = mChips[ic];
+      mChipROFDigits[ic] = nullptr;
       if (chip.isDisabled()) {
         continue;
       }
-      chip.addNoise(mROFrameMin, mROFrameMin, &mParams);
-      auto& buffer = chip.getPreDigits();
-      if (buffer.empty()) {
+      TRandom* rnd = gRandom;
+      if (mNThreads > 1) {
+#ifdef WITH_OPENMP
+        rnd = getChipRandom(omp_get_thread_num(), ic);
+#else
+        rnd = getChipRandom(0, ic);
+#endif
+      }
+      chip.addNoise(mROFrameMin, mROFrameMin, &mParams, Segmentation::NRows, Segmentation::NCols, rnd);
+      mChipROFDigits[ic] = chip.getROFramePreDigits(mROFrameMin);
+    }
+
+    // the output is filled sequentially in chip order
+    for (int ic = 0; ic < nChips; ic++) {
+      auto* buffer = mChipROFDigits[ic];
+      if (!buffer) {
         continue;
       }
-      auto itBeg = buffer.begin();
-      auto iter = itBeg;
-      ULong64_t maxKey = chip.getOrderingKey(mROFrameMin + 1, 0, 0) - 1; // fetch digits with key below that
-      for (; iter != buffer.end(); ++iter) {
-        if (iter->first > maxKey) {
-          break; // is the digit ROFrame from the key > the max requested frame
-        }
-        auto& preDig = iter->second; // preDigit
+      auto& chip = mChips[ic];
+      auto& extra = chip.getExtraLabels(mROFrameMin);
+      for (auto& preDig : *buffer) {
         if (preDig.charge >= mParams.getChargeThreshold()) {
           int digID = mDigits->size();
           mDigits->emplace_back(chip.getChipIndex(), preDig.row, preDig.col, preDig.charge);
@@ -208,7 +305,7 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
           }
         }
       }
-      buffer.erase(itBeg, iter);
+      chip.releaseROFrames(mROFrameMin);
     }
     // finalize ROF record
     rcROF.setNEntries(mDigits->size() - rcROF.getFirstEntry()); // number of digits
@@ -220,15 +317,11 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
     if (mROFRecords) {
       mROFRecords->push_back(rcROF);
     }
-    extra.clear(); // clear container for extra digits of the mROFrameMin ROFrame
-    // and move it as a new slot in the end
-    mExtraBuff.emplace_back(mExtraBuff.front().release());
-    mExtraBuff.pop_front();
   }
 }
 
 //_______________________________________________________________________
-void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID, int srcID)
+void Digitizer::processHit(const o2::itsmft::Hit& hit, HitContext& ctx, int evID, int srcID)
 {
   // convert single hit to digits
   int chipID = hit.GetDetectorID();
@@ -240,7 +333,7 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID
   float timeInROF = hit.GetTime() * sec2ns;
   if (timeInROF > 20e3) {
     const int maxWarn = 10;
-    static int warnNo = 0;
+    static std::atomic<int> warnNo{0}; // hits of different chips may be processed in parallel
     if (warnNo < maxWarn) {
       LOG(warning) << "Ignoring hit with time_in_event = " << timeInROF << " ns"
                    << ((++warnNo < maxWarn) ? "" : " (suppressing further warnings)");
@@ -261,8 +354,8 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID
   uint32_t roFrameRelMax = mParams.isContinuous() ? (timeInROF + tTot) * mParams.getROFrameLengthInv() : roFrameRel;
   int nFrames = roFrameRelMax + 1 - roFrameRel;
   uint32_t roFrameMax = mNewROFrame + roFrameRelMax;
-  if (roFrameMax > maxFr) {
-    maxFr = roFrameMax; // if signal extends beyond current maxFrame, increase the latter
+  if (roFrameMax > ctx.roFrameMax) {
+    ctx.roFrameMax = roFrameMax; // if signal extends beyond current maxFrame, increase the latter
   }
 
   // here we start stepping in the depth of the sensor to generate charge diffision
@@ -385,20 +478,20 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID
       if (!nEleResp) {
         continue;
       }
-      int nEle = gRandom->Poisson(nElectrons * nEleResp); // total charge in given pixel
+      int nEle = ctx.rnd->Poisson(nElectrons * nEleResp); // total charge in given pixel
       // ignore charge which have no chance to fire the pixel
       if (nEle < mParams.getMinChargeToAccount()) {
         continue;
       }
       uint16_t colIS = icol + colS;
       //
-      registerDigits(chip, roFrameAbs, timeInROF, nFrames, rowIS, colIS, nEle, lbl);
+      registerDigits(chip, ctx, roFrameAbs, timeInROF, nFrames, rowIS, colIS, nEle, lbl);
     }
   }
 }
 
 //________________________________________________________________________________
-void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, float tInROF, int nROF,
+void Digitizer::registerDigits(ChipDigitsContainer& chip, HitContext& ctx, uint32_t roFrame, float tInROF, int nROF,
                                uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl)
 {
   // Register digits for given pixel, accounting for the possible signal contribution to
@@ -415,11 +508,11 @@ void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, floa
     if (nEleROF < mParams.getMinChargeToAccount()) {
       continue;
     }
-    if (roFr > mEventROFrameMax) {
-      mEventROFrameMax = roFr;
+    if (roFr > ctx.eventROFrameMax) {
+      ctx.eventROFrameMax = roFr;
     }
-    if (roFr < mEventROFrameMin) {
-      mEventROFrameMin = roFr;
+    if (roFr < ctx.eventROFrameMin) {
+      ctx.eventROFrameMin = roFr;
     }
     auto key = chip.getOrderingKey(roFr, row, col);
     PreDigit* pd = chip.findDigit(key);
@@ -430,7 +523,7 @@ void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, floa
       if (pd->labelRef.label == lbl) { // don't store the same label twice
         continue;
       }
-      ExtraDig* extra = getExtraDigBuffer(roFr);
+      auto* extra = &chip.getExtraLabels(roFr);
       int& nxt = pd->labelRef.next;
       bool skip = false;
       while (nxt >= 0) {
@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ITSMFT chip random generators
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <unordered_set>
+#include <TRandom3.h>
+#include "ITSMFTSimulation/Digitizer.h"
+
+using namespace o2::itsmft;
+
+BOOST_AUTO_TEST_CASE(ChipSeeds_test)
+{
+  // event seeds differing only in the upper 16 bits must still give distinct chip seeds
+  const int nEvents = 64, nChips = 512;
+  std::unordered_set<UInt_t> seeds;
+  for (int ev = 0; ev < nEvents; ev++) {
+    UInt_t eventSeed = (UInt_t(ev) << 16) | 0x1234;
+    for (int chip = 0; chip < nChips; chip++) {
+      auto seed = Digitizer::getChipSeed(eventSeed, chip);
+      BOOST_CHECK(seed != 0);
+      seeds.insert(seed);
+    }
+  }
+  BOOST_CHECK_EQUAL(seeds.size(), size_t(nEvents * nChips));
+  // the seed of a chip is reproducible
+  BOOST_CHECK_EQUAL(Digitizer::getChipSeed(0xdeadbeef, 100), Digitizer::getChipSeed(0xdeadbeef, 100));
+}
+
+BOOST_AUTO_TEST_CASE(ChipStreams_test)
+{
+  // the random streams of the same chip in different events must differ
+  const int nEvents = 16, nDraws = 4;
+  TRandom3 evGen(12345), chipGen;
+  for (int chip : {0, 1, 1000, 24119}) {
+    std::vector<std::vector<double>> streams;
+    for (int ev = 0; ev < nEvents; ev++) {
+      chipGen.SetSeed(Digitizer::getChipSeed(evGen.Integer(0xffffffff), chip));
+      auto& stream = streams.emplace_back();
+      for (int i = 0; i < nDraws; i++) {
+        stream.push_back(chipGen.Rndm());
+      }
+    }
+    for (int ev0 = 0; ev0 < nEvents; ev0++) {
+      for (int ev1 = ev0 + 1; ev1 < nEvents; ev1++) {
+        BOOST_CHECK(streams[ev0] != streams[ev1]);
+      }
+    }
+  }
+}
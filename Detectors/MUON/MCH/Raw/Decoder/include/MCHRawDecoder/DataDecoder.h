@@ -20,9 +20,12 @@
 #define O2_MCH_DATADECODER_H_
 
 #include <gsl/span>
+#include <atomic>
+#include <map>
 #include <unordered_set>
 #include <unordered_map>
 #include <fstream>
+#include <vector>
 
 #include "Headers/RDHAny.h"
 #include "DataFormatsMCH/Digit.h"
@@ -160,6 +163,20 @@ class DataDecoder
   /// Decode one TimeFrame buffer and fill the vector of digits
   void decodeBuffer(gsl::span<const std::byte> buf);
 
+  /// Decode a list of CRU pages, e.g. all the pages of one TimeFrame, and fill the vector of digits.
+  /// The pages are grouped by FEE ID and the FEEs are decoded in parallel if more than one thread is
+  /// enabled. The digits of each FEE are then appended in the order in which the FEEs first appear in
+  /// the list, so the output does not depend on the number of threads. If a user channel or RDH handler
+  /// is set, the pages are instead decoded serially in their order and so are the digits stored.
+  /// Pages whose RDH does not have the expected size are skipped. An exception thrown while decoding
+  /// a FEE is rethrown once all the FEEs have been decoded and merged.
+  void decodePages(gsl::span<const Page> pages);
+
+  /// Set the number of threads used to decode the pages of different FEEs.
+  /// The decoding is always serial and in the order of the pages if a user channel or RDH handler is set.
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
   /// Functions to set and get the calibration offset for the SAMPA time computation
   void setSampaBcOffset(uint32_t offset) { mSampaTimeOffset = offset; }
   uint32_t getSampaBcOffset() const { return mSampaTimeOffset; }
@@ -194,15 +211,36 @@ class DataDecoder
   void initElec2DetMapper(std::string filename);
   void initFee2SolarMapper(std::string filename);
   void init();
-  void decodePage(gsl::span<const std::byte> page);
+
+  /// Decoding state of a group of pages: all the pages when user handlers are set, or the pages of a single
+  /// FEE in the per-FEE mode. In the latter case the digits, orbits and errors go to the context's own
+  /// containers, which are merged into the global ones once all the FEEs are decoded.
+  struct DecodingContext {
+    o2::mch::raw::PageDecoder decoder;                      ///< CRU page decoder, keeps the state of the links across pages
+    RawDigitVector* digits{nullptr};                        ///< where the decoded digits are stored
+    std::unordered_set<OrbitInfo, OrbitInfoHash>* orbits{nullptr}; ///< where the orbits are stored
+    std::map<std::string, uint64_t>* errorMap{nullptr};     ///< where the error messages are counted
+    uint32_t orbit{0};                                      ///< orbit of the page being decoded
+    bool local{false};                                      ///< digits are stored in ownDigits, to be merged later
+    std::vector<uint32_t> mergerChannels;                   ///< merger channels pointing to a digit of ownDigits
+    std::vector<Page> pages;                                ///< pages of this FEE in the list being decoded
+    RawDigitVector ownDigits;                               ///< digits of this FEE (per-FEE mode only)
+    std::unordered_set<OrbitInfo, OrbitInfoHash> ownOrbits; ///< orbits of this FEE (per-FEE mode only)
+    std::map<std::string, uint64_t> ownErrorMap;            ///< errors of this FEE (per-FEE mode only)
+  };
+
+  bool checkPage(Page page, bool first) const;
+  void decodePagesByFee(gsl::span<const Page> pages);
+  void decodePage(gsl::span<const std::byte> page, DecodingContext& ctx);
+  void mergeContext(DecodingContext& ctx);
   void dumpDigits();
-  bool getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId);
-  bool addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc);
+  bool getPadMapping(DecodingContext& ctx, const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId);
+  bool addDigit(DecodingContext& ctx, const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc);
   bool getTimeFrameStartRecord(const RawDigit& digit, uint32_t& orbit, uint32_t& bc);
   bool getMergerChannelId(const DsElecId& dsElecId, DualSampaChannelId channel, uint32_t& chId, uint32_t& dsId);
   uint64_t getMergerChannelBitmask(DualSampaChannelId channel);
-  void updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId);
-  bool mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc);
+  void updateMergerRecord(DecodingContext& ctx, uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId);
+  bool mergeDigits(DecodingContext& ctx, uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc);
 
   // structure that stores the index of the last decoded digit for a given readout channel,
   // as well as the time stamp of the last ADC sample of the digit
@@ -212,6 +250,9 @@ class DataDecoder
     uint32_t bcEnd{0xFFFF};
   };
 
+  /// flag set in MergerChannelRecord::digitId when the index refers to the digits of a FEE decoding context
+  static constexpr uint32_t sLocalDigitFlag = 0x80000000;
+
   static constexpr uint32_t sMaxSolarId = 200 * 8 - 1;
   static constexpr uint32_t sReadoutBoardsNum = (sMaxSolarId + 1) * 40;
   static constexpr uint32_t sReadoutChipsNum = sReadoutBoardsNum * 2;
@@ -230,7 +271,11 @@ class DataDecoder
   std::string mMapFECfile;                 ///< optional text file with custom front-end electronics mapping
   std::string mMapCRUfile;                 ///< optional text file with custom CRU mapping
 
-  o2::mch::raw::PageDecoder mDecoder; ///< CRU page decoder
+  DecodingContext mSerialContext;                   ///< decoding state used when user handlers are set
+  std::map<uint16_t, DecodingContext> mFeeContexts; ///< decoding state of each FEE in the per-FEE mode
+  std::vector<DecodingContext*> mActiveContexts;    ///< FEE contexts of the current list of pages, in order of appearance
+  std::vector<Page> mPages;                         ///< pages of the buffer being decoded
+  int mNThreads{1};                                 ///< number of threads for the parallel decoding
 
   RawDigitVector mDigits;                               ///< vector of decoded digits
   std::unordered_set<OrbitInfo, OrbitInfoHash> mOrbits; ///< list of orbits in the processed buffer
@@ -244,9 +289,8 @@ class DataDecoder
   std::function<void(o2::header::RDHAny*)> mRdhHandler; ///< optional user function to be called for each RDH
 
   bool mDebug{false};
-  int mErrorCount{0};
+  std::atomic<int> mErrorCount{0};
   bool mDs2manu{false};
-  uint32_t mOrbit{0};
   bool mUseDummyElecMap{false};
   std::map<std::string, uint64_t> mErrorMap; // counts for error messages
 };
@@ -18,6 +18,7 @@
 
 #include "MCHRawDecoder/DataDecoder.h"
 
+#include <exception>
 #include <fstream>
 #include <FairMQLogger.h>
 #include "Headers/RAWDataHeader.h"
@@ -273,37 +274,155 @@ void DataDecoder::decodeBuffer(gsl::span<const std::byte> buf)
   size_t pageStart = 0;
   while (bufSize > pageStart) {
     RDH* rdh = reinterpret_cast<RDH*>(const_cast<std::byte*>(&(buf[pageStart])));
-    if (mDebug) {
-      if (pageStart == 0) {
-        std::cout << "+++\n[decodeBuffer]" << std::endl;
-      } else {
-        std::cout << "---\n[decodeBuffer]" << std::endl;
-      }
-      o2::raw::RDHUtils::printRDH(rdh);
-    }
-    auto rdhVersion = o2::raw::RDHUtils::getVersion(rdh);
     auto rdhHeaderSize = o2::raw::RDHUtils::getHeaderSize(rdh);
     if (rdhHeaderSize != 64) {
-      break;
+      if (mDebug) {
+        o2::raw::RDHUtils::printRDH(rdh);
+        std::cout << "[decodeBuffer] unexpected RDH header size " << rdhHeaderSize << ", skipping the rest of the buffer" << std::endl;
+      }
+      break; // the offset to the next page cannot be trusted
     }
     auto pageSize = o2::raw::RDHUtils::getOffsetToNext(rdh);
 
     gsl::span<const std::byte> page(reinterpret_cast<const std::byte*>(rdh), pageSize);
-    decodePage(page);
+    mPages.emplace_back(page);
 
     pageStart += pageSize;
   }
 
+  decodePages(mPages);
+  mPages.clear();
+}
+
+//_________________________________________________________________________________________________
+
+bool DataDecoder::checkPage(Page page, bool first) const
+{
+  auto rdh = reinterpret_cast<const RDH*>(page.data());
+  if (mDebug) {
+    std::cout << (first ? "+++" : "---") << "\n[decodePages]" << std::endl;
+    o2::raw::RDHUtils::printRDH(rdh);
+  }
+  auto rdhHeaderSize = o2::raw::RDHUtils::getHeaderSize(rdh);
+  if (rdhHeaderSize != 64) {
+    if (mDebug) {
+      std::cout << "[decodePages] unexpected RDH header size " << rdhHeaderSize << ", skipping the page" << std::endl;
+    }
+    return false;
+  }
+  return true;
+}
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::decodePages(gsl::span<const Page> pages)
+{
+  // the user handlers expect to be called serially and in the order of the pages
+  if (mChannelHandler || mRdhHandler) {
+    for (size_t i = 0; i < pages.size(); i++) {
+      auto page = pages[i];
+      if (!checkPage(page, i == 0)) {
+        continue;
+      }
+      patchPage(page, mDebug);
+      decodePage(page, mSerialContext);
+    }
+  } else {
+    decodePagesByFee(pages);
+  }
+
   if (mDebug) {
-    std::cout << "[decodeBuffer] mOrbits size: " << mOrbits.size() << std::endl;
+    std::cout << "[decodePages] mOrbits size: " << mOrbits.size() << std::endl;
     dumpOrbits(mOrbits);
-    std::cout << "[decodeBuffer] mDigits size: " << mDigits.size() << std::endl;
+    std::cout << "[decodePages] mDigits size: " << mDigits.size() << std::endl;
     dumpDigits();
   }
 }
 
 //_________________________________________________________________________________________________
 
+void DataDecoder::decodePagesByFee(gsl::span<const Page> pages)
+{
+  // group the pages by FEE, keeping the order in which the FEEs first appear
+  for (size_t i = 0; i < pages.size(); i++) {
+    auto page = pages[i];
+    if (!checkPage(page, i == 0)) {
+      continue;
+    }
+    patchPage(page, mDebug);
+    auto feeId = o2::raw::RDHUtils::getFEEID(reinterpret_cast<const void*>(page.data()));
+    auto [it, inserted] = mFeeContexts.try_emplace(feeId);
+    auto& ctx = it->second;
+    if (inserted) {
+      ctx.digits = &ctx.ownDigits;
+      ctx.orbits = &ctx.ownOrbits;
+      ctx.errorMap = &ctx.ownErrorMap;
+      ctx.local = true;
+    }
+    if (ctx.pages.empty()) {
+      mActiveContexts.emplace_back(&ctx);
+    }
+    ctx.pages.emplace_back(page);
+  }
+
+  // each FEE only touches the merger records and TF start records of its own SOLAR boards,
+  // hence the FEEs can be decoded concurrently
+  int nContexts = mActiveContexts.size();
+  std::vector<std::exception_ptr> errors(nContexts); // exceptions must not escape the parallel region
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < nContexts; i++) {
+    auto& ctx = *mActiveContexts[i];
+    try {
+      for (auto page : ctx.pages) {
+        decodePage(page, ctx);
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+
+  // the FEEs decoded so far are merged anyway, to leave the merger records consistent
+  for (auto ctx : mActiveContexts) {
+    mergeContext(*ctx);
+  }
+  mActiveContexts.clear();
+
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::mergeContext(DecodingContext& ctx)
+{
+  uint32_t offset = mDigits.size();
+  mDigits.insert(mDigits.end(), ctx.ownDigits.begin(), ctx.ownDigits.end());
+  // make the merger records point to the digits in their final position
+  for (auto chId : ctx.mergerChannels) {
+    auto& digitId = mMergerRecords[chId].digitId;
+    if (digitId & sLocalDigitFlag) {
+      digitId = offset + (digitId & ~sLocalDigitFlag);
+    }
+  }
+  mOrbits.insert(ctx.ownOrbits.begin(), ctx.ownOrbits.end());
+  for (const auto& [msg, count] : ctx.ownErrorMap) {
+    mErrorMap[msg] += count;
+  }
+
+  ctx.ownDigits.clear();
+  ctx.ownOrbits.clear();
+  ctx.ownErrorMap.clear();
+  ctx.mergerChannels.clear();
+  ctx.pages.clear();
+}
+
+//_________________________________________________________________________________________________
+
 void DataDecoder::dumpDigits()
 {
   for (size_t di = 0; di < mDigits.size(); di++) {
@@ -372,7 +491,7 @@ uint64_t DataDecoder::getMergerChannelBitmask(DualSampaChannelId channel)
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc)
+bool DataDecoder::mergeDigits(DecodingContext& ctx, uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, o2::mch::raw::SampaCluster& sc)
 {
   static constexpr uint32_t BCROLLOVER = (1 << 20);
   static constexpr uint32_t ONEADCCLOCK = 4;
@@ -405,7 +524,8 @@ bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId,
   }
 
   // add total charge and number of samples to existing digit
-  auto& digit = mDigits[mergerCh.digitId].digit;
+  auto& digit = (mergerCh.digitId & sLocalDigitFlag) ? (*ctx.digits)[mergerCh.digitId & ~sLocalDigitFlag].digit
+                                                     : mDigits[mergerCh.digitId].digit;
 
   digit.setADC(digit.getADC() + sc.sum());
   uint32_t newNofSamples = digit.getNofSamples() + sc.nofSamples();
@@ -422,11 +542,16 @@ bool DataDecoder::mergeDigits(uint32_t mergerChannelId, uint32_t mergerBoardId,
 
 //_________________________________________________________________________________________________
 
-void DataDecoder::updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId)
+void DataDecoder::updateMergerRecord(DecodingContext& ctx, uint32_t mergerChannelId, uint32_t mergerBoardId, uint64_t mergerChannelBitmask, uint32_t digitId)
 {
   auto& mergerCh = mMergerRecords[mergerChannelId];
-  auto& digit = mDigits[digitId];
-  mergerCh.digitId = digitId;
+  auto& digit = (*ctx.digits)[digitId];
+  if (ctx.local) {
+    mergerCh.digitId = digitId | sLocalDigitFlag;
+    ctx.mergerChannels.emplace_back(mergerChannelId);
+  } else {
+    mergerCh.digitId = digitId;
+  }
   mergerCh.bcEnd = digit.info.bunchCrossing + (digit.info.sampaTime + digit.digit.getNofSamples() - 1) * 4;
   mMergerRecordsReady[mergerBoardId] |= mergerChannelBitmask;
   if (mDebug) {
@@ -439,7 +564,7 @@ void DataDecoder::updateMergerRecord(uint32_t mergerChannelId, uint32_t mergerBo
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId)
+bool DataDecoder::getPadMapping(DecodingContext& ctx, const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId)
 {
   deId = -1;
   dsIddet = -1;
@@ -459,7 +584,7 @@ bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId cha
 
   if (deId < 0 || dsIddet < 0 || !isValidDeID(deId)) {
     auto msg = fmt::format("got invalid DsDetId from dsElecId={}", asString(dsElecId));
-    mErrorMap[msg]++;
+    (*ctx.errorMap)[msg]++;
     return false;
   }
 
@@ -474,10 +599,10 @@ bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId cha
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc)
+bool DataDecoder::addDigit(DecodingContext& ctx, const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc)
 {
   int deId, dsIddet, padId;
-  if (!getPadMapping(dsElecId, channel, deId, dsIddet, padId)) {
+  if (!getPadMapping(ctx, dsElecId, channel, deId, dsIddet, padId)) {
     return false;
   }
 
@@ -488,7 +613,7 @@ bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel,
     auto ch = fmt::format("{}-CH{:02d}", s, channel);
     LOG(info) << ch << "  "
               << fmt::format("PAD ({:04d} {:04d} {:04d})\tADC {:06d}  TIME ({} {} {:02d})  SIZE {}  END {}",
-                             deId, dsIddet, padId, digitadc, mOrbit, sc.bunchCrossing, sc.sampaTime, sc.nofSamples(), (sc.sampaTime + sc.nofSamples() - 1))
+                             deId, dsIddet, padId, digitadc, ctx.orbit, sc.bunchCrossing, sc.sampaTime, sc.nofSamples(), (sc.sampaTime + sc.nofSamples() - 1))
               << (((sc.sampaTime + sc.nofSamples() - 1) >= 98) ? " *" : "");
   }
 
@@ -505,14 +630,14 @@ bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel,
   digit.info.solar = dsElecId.solarId();
   digit.info.sampaTime = sc.sampaTime;
   digit.info.bunchCrossing = sc.bunchCrossing;
-  digit.info.orbit = mOrbit;
+  digit.info.orbit = ctx.orbit;
 
-  mDigits.emplace_back(digit);
+  ctx.digits->emplace_back(digit);
 
   if (mDebug) {
-    RawDigit& lastDigit = mDigits.back();
+    RawDigit& lastDigit = ctx.digits->back();
     LOGP(info, "DIGIT STORED: ORBIT {} ADC {} DE {} PADID {} TIME {} BXCOUNT {}",
-         mOrbit, lastDigit.getADC(), lastDigit.getDetID(), lastDigit.getPadID(),
+         ctx.orbit, lastDigit.getADC(), lastDigit.getDetID(), lastDigit.getPadID(),
          lastDigit.getSampaTime(), lastDigit.getBunchCrossing());
   }
   return true;
@@ -548,7 +673,7 @@ void DataDecoder::updateTimeFrameStartRecord(uint64_t chipId, uint32_t mFirstOrb
 
 //_________________________________________________________________________________________________
 
-void DataDecoder::decodePage(gsl::span<const std::byte> page)
+void DataDecoder::decodePage(gsl::span<const std::byte> page, DecodingContext& ctx)
 {
   uint8_t isStopRDH = 0;
   uint32_t orbit;
@@ -582,8 +707,9 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
     }
   };
 
-  auto channelHandler = [&](DsElecId dsElecId, DualSampaChannelId channel,
-                            o2::mch::raw::SampaCluster sc) {
+  // the handlers are kept by the page decoder of the context, hence they refer to the context itself
+  auto channelHandler = [this, &ctx = ctx](DsElecId dsElecId, DualSampaChannelId channel,
+                                           o2::mch::raw::SampaCluster sc) {
     if (mChannelHandler) {
       mChannelHandler(dsElecId, channel, sc);
     }
@@ -601,30 +727,28 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
     }
     uint64_t mergerChannelBitmask = getMergerChannelBitmask(channel);
 
-    if (mergeDigits(mergerChannelId, mergerBoardId, mergerChannelBitmask, sc)) {
+    if (mergeDigits(ctx, mergerChannelId, mergerBoardId, mergerChannelBitmask, sc)) {
       return;
     }
 
-    if (!addDigit(dsElecId, channel, sc)) {
+    if (!addDigit(ctx, dsElecId, channel, sc)) {
       return;
     }
 
-    updateMergerRecord(mergerChannelId, mergerBoardId, mergerChannelBitmask, mDigits.size() - 1);
+    updateMergerRecord(ctx, mergerChannelId, mergerBoardId, mergerChannelBitmask, ctx.digits->size() - 1);
   };
 
-  auto errorHandler = [&](DsElecId dsId,
-                          int8_t chip,
-                          uint32_t error) {
+  auto errorHandler = [&ctx = ctx](DsElecId dsId,
+                                  int8_t chip,
+                                  uint32_t error) {
     std::string msg = fmt::format("{} chip {:2d} error {:4d} ({})", asString(dsId), chip, error, errorCodeAsString(error));
-    mErrorMap[msg]++;
+    (*ctx.errorMap)[msg]++;
   };
 
-  patchPage(page, mDebug);
-
   auto& rdhAny = *reinterpret_cast<RDH*>(const_cast<std::byte*>(&(page[0])));
-  mOrbit = o2::raw::RDHUtils::getHeartBeatOrbit(rdhAny);
+  ctx.orbit = o2::raw::RDHUtils::getHeartBeatOrbit(rdhAny);
   if (mDebug) {
-    LOGP(info, "[decodeBuffer] mOrbit set to {}", mOrbit);
+    LOGP(info, "[decodeBuffer] orbit set to {}", ctx.orbit);
   }
 
   if (mRdhHandler) {
@@ -632,18 +756,18 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
   }
 
   // add orbit to vector if not present yet
-  mOrbits.emplace(page);
+  ctx.orbits->emplace(page);
 
-  if (!mDecoder) {
+  if (!ctx.decoder) {
     DecodedDataHandlers handlers;
     handlers.sampaChannelHandler = channelHandler;
     handlers.sampaHeartBeatHandler = heartBeatHandler;
     handlers.sampaErrorHandler = errorHandler;
-    mDecoder = mFee2Solar ? o2::mch::raw::createPageDecoder(page, handlers, mFee2Solar)
-                          : o2::mch::raw::createPageDecoder(page, handlers);
+    ctx.decoder = mFee2Solar ? o2::mch::raw::createPageDecoder(page, handlers, mFee2Solar)
+                             : o2::mch::raw::createPageDecoder(page, handlers);
   }
 
-  mDecoder(page);
+  ctx.decoder(page);
 };
 
 //_________________________________________________________________________________________________
@@ -911,6 +1035,10 @@ void DataDecoder::init()
   mMergerRecords.resize(sReadoutChannelsNum);
   mMergerRecordsReady.resize(sReadoutBoardsNum);
 
+  mSerialContext.digits = &mDigits;
+  mSerialContext.orbits = &mOrbits;
+  mSerialContext.errorMap = &mErrorMap;
+
   reset();
 };
 
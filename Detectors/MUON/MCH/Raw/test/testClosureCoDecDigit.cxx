@@ -22,9 +22,11 @@
 #include "Framework/Logger.h"
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/data/monomorphic.hpp>
+#include <algorithm>
 #include <array>
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHRawCommon/CoDecParam.h"
+#include "DetectorsRaw/RDHUtils.h"
 
 using namespace o2::mch::raw;
 
@@ -198,3 +200,77 @@ BOOST_AUTO_TEST_CASE(WrittenAndReadBackDigitsShouldBeTheSame)
     }
   }
 }
+
+std::vector<std::string> digitsAsStrings(const DataDecoder& dd)
+{
+  std::vector<std::string> result;
+  for (const auto& d : dd.getDigits()) {
+    result.emplace_back(fmt::format("DE {} PADID {} ADC {} ORBIT {} BX {}", d.getDetID(), d.getPadID(), d.getADC(), d.getOrbit(), d.getBunchCrossing()));
+  }
+  return result;
+}
+
+std::vector<std::string> readRawDigits(int nThreads)
+{
+  DataDecoder dd(nullptr, nullptr, 0, "", "", false, false, useDummyElecMap);
+  dd.setNThreads(nThreads);
+
+  auto buffer = getBuffer("MCH.raw");
+  dd.decodeBuffer(buffer);
+  return digitsAsStrings(dd);
+}
+
+// a user RDH handler makes the decoder process the pages serially and in their order
+std::vector<std::string> readRawDigitsPageOrder(gsl::span<const Page> pages)
+{
+  DataDecoder dd(nullptr, [](o2::header::RDHAny*) {}, 0, "", "", false, false, useDummyElecMap);
+  dd.decodePages(pages);
+  return digitsAsStrings(dd);
+}
+
+// serial decoding of the pages, optionally regrouped by FEE in the order in which the FEEs first appear,
+// which is the order in which the decoding by FEE merges the digits of the FEEs
+std::vector<std::string> readRawDigitsSerial(bool byFee)
+{
+  auto buffer = getBuffer("MCH.raw");
+  std::vector<Page> pages;
+  for (size_t pos = 0; pos < buffer.size();) {
+    auto pageSize = o2::raw::RDHUtils::getOffsetToNext(&buffer[pos]);
+    pages.emplace_back(&buffer[pos], pageSize);
+    pos += pageSize;
+  }
+  if (!byFee) {
+    return readRawDigitsPageOrder(pages);
+  }
+  std::vector<uint16_t> feeIds;
+  for (auto page : pages) {
+    auto feeId = o2::raw::RDHUtils::getFEEID(page.data());
+    if (std::find(feeIds.begin(), feeIds.end(), feeId) == feeIds.end()) {
+      feeIds.push_back(feeId);
+    }
+  }
+  std::vector<Page> pagesByFee;
+  for (auto feeId : feeIds) {
+    for (auto page : pages) {
+      if (o2::raw::RDHUtils::getFEEID(page.data()) == feeId) {
+        pagesByFee.push_back(page);
+      }
+    }
+  }
+  return readRawDigitsPageOrder(pagesByFee);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelDecodingShouldGiveTheSameDigits)
+{
+  o2::conf::ConfigurableParam::setValue("MCHCoDecParam", "sampaBcOffset", 0);
+  writeDigits();
+  auto serial = readRawDigitsSerial(false);
+  BOOST_CHECK_EQUAL(serial.size(), 3u);
+  auto serialByFee = readRawDigitsSerial(true);
+  BOOST_CHECK(std::is_permutation(begin(serialByFee), end(serialByFee), begin(serial), end(serial)));
+  // whatever the number of threads, the decoding gives exactly the digits, in the same order, of the serial decoding of the FEEs one after the other
+  for (int nThreads : {1, 2, 4, 8}) {
+    auto parallel = readRawDigits(nThreads);
+    BOOST_TEST(parallel == serialByFee, boost::test_tools::per_element());
+  }
+}
@@ -69,6 +69,9 @@ class DEDigitizer
   /** Clear resets our internal lists of digits and labels. */
   void clear();
 
+  /** Use a dedicated random generator for the response instead of gRandom. */
+  void setRandom(TRandom* random) { mResponse.setRandom(random); }
+
  private:
   int mDeId;                                         // detection element id
   Response mResponse;                                // response function (Mathieson parameters, ...)
@@ -43,7 +43,7 @@ class Digitizer
   void startCollision(o2::InteractionRecord collisionTime);
 
   // @see DEDigitizer::processHit
-  void processHits(gsl::span<Hit> hits, int evID, int srcID);
+  void processHits(gsl::span<const Hit> hits, int evID, int srcID);
 
   // @see DEDigitizer::extractDigitsAndLabels
   void extractDigitsAndLabels(std::vector<Digit>& digits,
@@ -52,6 +52,9 @@ class Digitizer
   // @see DEDigitizer:clear
   void clear();
 
+  // @see DEDigitizer::setRandom
+  void setRandom(TRandom* random);
+
  private:
   std::map<int, std::unique_ptr<DEDigitizer>> mDEDigitizers; // list of workers
 };
@@ -22,6 +22,7 @@ struct DigitizerParam : public o2::conf::ConfigurableParamHelper<DigitizerParam>
 
   bool continuous = true;           // whether we assume continuous mode or not
   float noiseProba = 3.1671242e-05; // by default = proba to be above 4*sigma of a gaussian noise
+  int nThreads = 1;                 // number of threads digitizing the collisions (each with its own Digitizer)
 
   O2ParamDef(DigitizerParam, "MCHDigitizerParam")
 };
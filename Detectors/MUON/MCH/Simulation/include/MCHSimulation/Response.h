@@ -16,6 +16,8 @@
 #include "MCHSimulation/Detector.h"
 #include "MCHSimulation/Hit.h"
 
+class TRandom;
+
 namespace o2
 {
 namespace mch
@@ -46,6 +48,8 @@ class Response
   float getSigmaIntegration() const { return mSigmaIntegration; };
   bool getIsSampa() { return mSampa; };
   void setIsSampa(bool isSampa = true) { mSampa = isSampa; };
+  /// use a dedicated random generator instead of gRandom (nullptr to go back to gRandom)
+  void setRandom(TRandom* random) { mRandom = random; }
 
  private:
   //setter to get Aliroot-readout-chain or Run 3 (Sampa) one
@@ -96,6 +100,8 @@ class Response
   float mPitch;
   //maximal bit number
   int mMaxADC = (1 << 12) - 1;
+
+  TRandom* mRandom = nullptr; //! random generator, gRandom if not set
 };
 } // namespace mch
 } // namespace o2
@@ -40,7 +40,7 @@ void Digitizer::startCollision(o2::InteractionRecord collisionTime)
   }
 }
 
-void Digitizer::processHits(gsl::span<Hit> hits, int evID, int srcID)
+void Digitizer::processHits(gsl::span<const Hit> hits, int evID, int srcID)
 {
   for (const auto& hit : hits) {
     mDEDigitizers[hit.detElemId()]->process(hit, evID, srcID);
@@ -62,6 +62,13 @@ void Digitizer::clear()
   }
 }
 
+void Digitizer::setRandom(TRandom* random)
+{
+  for (auto& d : mDEDigitizers) {
+    d.second->setRandom(random);
+  }
+}
+
 std::map<o2::InteractionRecord, std::vector<int>> groupIR(gsl::span<const o2::InteractionTimeRecord> records, uint32_t width)
 {
   std::vector<o2::InteractionRecord> irs;
@@ -73,10 +73,11 @@ float Response::etocharge(float edepos)
   if (nel == 0) {
     nel = 1;
   }
+  auto random = mRandom ? mRandom : gRandom;
   for (int i = 1; i <= nel; i++) {
     float arg = 0.;
     while (!arg) {
-      arg = gRandom->Rndm();
+      arg = random->Rndm();
     }
     charge -= mChargeSlope * TMath::Log(arg);
   }
@@ -140,5 +141,5 @@ float Response::chargeCorr()
 {
   //taken from AliMUONResponseV0
   //conceptually not at all understood why this should make sense
-  return TMath::Exp(gRandom->Gaus(0.0, mChargeCorr / 2.0));
+  return TMath::Exp((mRandom ? mRandom : gRandom)->Gaus(0.0, mChargeCorr / 2.0));
 }
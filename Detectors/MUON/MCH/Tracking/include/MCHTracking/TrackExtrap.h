@@ -19,15 +19,13 @@
 
 #include <cstddef>
 
-#include <TMatrixD.h>
+#include "MCHTracking/TrackParam.h"
 
 namespace o2
 {
 namespace mch
 {
 
-class TrackParam;
-
 /// Class holding tools for track extrapolation
 class TrackExtrap
 {
@@ -107,8 +105,8 @@ class TrackExtrap
                                          double absZBeg, double pathLength, double f0, double f1, double f2);
   static void correctELossEffectInAbsorber(TrackParam& param, double eLoss, double sigmaELoss2);
 
-  static void cov2CovP(const TMatrixD& param, TMatrixD& cov);
-  static void covP2Cov(const TMatrixD& param, TMatrixD& covP);
+  static void cov2CovP(const SMatrix5& param, SMatrix55Sym& cov);
+  static void covP2Cov(const SMatrix5& param, SMatrix55Sym& covP);
 
   static void convertTrackParamForExtrap(TrackParam& trackParam, double forwardBackward, double* v3);
   static void recoverTrackParam(double* v3, double Charge, TrackParam& trackParam);
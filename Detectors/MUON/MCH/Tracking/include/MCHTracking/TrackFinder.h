@@ -19,8 +19,8 @@
 
 #include <chrono>
 #include <unordered_map>
-#include <unordered_set>
 #include <list>
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <utility>
@@ -57,6 +57,10 @@ class TrackFinder
   void printTimers() const;
 
  private:
+  /// list of cluster uids (which encode the DE) excluded from the search of compatible clusters.
+  /// They are few per track candidate so a flat array searched linearly is faster than a hash set
+  using ClusterIds = std::vector<uint32_t>;
+
   void findTrackCandidates();
   void findTrackCandidatesInSt5();
   void findTrackCandidatesInSt4();
@@ -66,13 +70,13 @@ class TrackFinder
   std::list<Track>::iterator followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane);
   std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
                                                   int chamber, int lastChamber, bool canSkip,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                  ClusterIds& excludedClusters);
   std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
                                                   int plane1, int plane2, int lastChamber,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                  ClusterIds& excludedClusters);
   std::list<Track>::iterator addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
                                                        const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                       std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                       ClusterIds& excludedClusters);
 
   void improveTracks();
 
@@ -93,9 +97,21 @@ class TrackFinder
 
   bool areUsed(const Cluster& cl1, const Cluster& cl2, const std::vector<std::array<uint32_t, 4>>& usedClusters);
   void excludeClustersFromIdenticalTracks(const std::list<Track>::iterator& itTrack,
-                                          std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters,
+                                          ClusterIds& excludedClusters,
                                           const std::list<Track>::iterator& itEndTrack);
-  void moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination);
+  void moveClusters(ClusterIds& source, ClusterIds& destination);
+  /// return true if the cluster uid is in the list
+  static bool isExcluded(uint32_t uid, const ClusterIds& clusters)
+  {
+    return std::find(clusters.begin(), clusters.end(), uid) != clusters.end();
+  }
+  /// add the cluster uid to the list if not already there
+  static void exclude(uint32_t uid, ClusterIds& clusters)
+  {
+    if (!isExcluded(uid, clusters)) {
+      clusters.push_back(uid);
+    }
+  }
 
   bool isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
   bool tryOneClusterFast(const TrackParam& param, const Cluster& cluster);
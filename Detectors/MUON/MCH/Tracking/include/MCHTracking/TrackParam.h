@@ -17,8 +17,9 @@
 #ifndef O2_MCH_TRACKPARAM_H_
 #define O2_MCH_TRACKPARAM_H_
 
-#include <memory> // for std::unique_ptr
-#include <TMatrixD.h>
+#include <TMath.h>
+#include <Math/SMatrix.h>
+#include <Math/SVector.h>
 
 #include "MCHBase/TrackBlock.h"
 
@@ -29,6 +30,10 @@ namespace mch
 
 struct Cluster;
 
+using SMatrix5 = ROOT::Math::SVector<double, 5>;
+using SMatrix55Sym = ROOT::Math::SMatrix<double, 5, 5, ROOT::Math::MatRepSym<double, 5>>;
+using SMatrix55Std = ROOT::Math::SMatrix<double, 5>;
+
 /// track parameters for internal use
 class TrackParam
 {
@@ -38,8 +43,8 @@ class TrackParam
   TrackParam(Double_t z, const Double_t param[5], const Double_t cov[15]);
   ~TrackParam() = default;
 
-  TrackParam(const TrackParam& tp);
-  TrackParam& operator=(const TrackParam& tp);
+  TrackParam(const TrackParam& tp) = default;
+  TrackParam& operator=(const TrackParam& tp) = default;
   TrackParam(TrackParam&&) = delete;
   TrackParam& operator=(TrackParam&&) = delete;
 
@@ -48,43 +53,43 @@ class TrackParam
   /// set Z coordinate (cm)
   void setZ(Double_t z) { mZ = z; }
   /// return non bending coordinate (cm)
-  Double_t getNonBendingCoor() const { return mParameters(0, 0); }
+  Double_t getNonBendingCoor() const { return mParameters(0); }
   /// set non bending coordinate (cm)
-  void setNonBendingCoor(Double_t nonBendingCoor) { mParameters(0, 0) = nonBendingCoor; }
+  void setNonBendingCoor(Double_t nonBendingCoor) { mParameters(0) = nonBendingCoor; }
   /// return non bending slope (cm ** -1)
-  Double_t getNonBendingSlope() const { return mParameters(1, 0); }
+  Double_t getNonBendingSlope() const { return mParameters(1); }
   /// set non bending slope (cm ** -1)
-  void setNonBendingSlope(Double_t nonBendingSlope) { mParameters(1, 0) = nonBendingSlope; }
+  void setNonBendingSlope(Double_t nonBendingSlope) { mParameters(1) = nonBendingSlope; }
   /// return bending coordinate (cm)
-  Double_t getBendingCoor() const { return mParameters(2, 0); }
+  Double_t getBendingCoor() const { return mParameters(2); }
   /// set bending coordinate (cm)
-  void setBendingCoor(Double_t bendingCoor) { mParameters(2, 0) = bendingCoor; }
+  void setBendingCoor(Double_t bendingCoor) { mParameters(2) = bendingCoor; }
   /// return bending slope (cm ** -1)
-  Double_t getBendingSlope() const { return mParameters(3, 0); }
+  Double_t getBendingSlope() const { return mParameters(3); }
   /// set bending slope (cm ** -1)
-  void setBendingSlope(Double_t bendingSlope) { mParameters(3, 0) = bendingSlope; }
+  void setBendingSlope(Double_t bendingSlope) { mParameters(3) = bendingSlope; }
   /// return inverse bending momentum (GeV/c ** -1) times the charge (assumed forward motion)
-  Double_t getInverseBendingMomentum() const { return mParameters(4, 0); }
+  Double_t getInverseBendingMomentum() const { return mParameters(4); }
   /// set inverse bending momentum (GeV/c ** -1) times the charge (assumed forward motion)
-  void setInverseBendingMomentum(Double_t inverseBendingMomentum) { mParameters(4, 0) = inverseBendingMomentum; }
+  void setInverseBendingMomentum(Double_t inverseBendingMomentum) { mParameters(4) = inverseBendingMomentum; }
   /// return the charge (assumed forward motion)
-  Double_t getCharge() const { return TMath::Sign(1., mParameters(4, 0)); }
+  Double_t getCharge() const { return TMath::Sign(1., mParameters(4)); }
   /// set the charge (assumed forward motion)
   void setCharge(Double_t charge)
   {
-    if (charge * mParameters(4, 0) < 0.) {
-      mParameters(4, 0) *= -1.;
+    if (charge * mParameters(4) < 0.) {
+      mParameters(4) *= -1.;
     }
   }
 
   /// return track parameters
-  const TMatrixD& getParameters() const { return mParameters; }
+  const SMatrix5& getParameters() const { return mParameters; }
   /// set track parameters
-  void setParameters(const TMatrixD& parameters) { mParameters = parameters; }
+  void setParameters(const SMatrix5& parameters) { mParameters = parameters; }
   /// set track parameters from the array
-  void setParameters(const Double_t parameters[5]) { mParameters.SetMatrixArray(parameters); }
+  void setParameters(const Double_t parameters[5]) { mParameters.SetElements(parameters, parameters + 5); }
   /// add track parameters
-  void addParameters(const TMatrixD& parameters) { mParameters += parameters; }
+  void addParameters(const SMatrix5& parameters) { mParameters += parameters; }
 
   Double_t px() const; // return px
   Double_t py() const; // return py
@@ -92,29 +97,29 @@ class TrackParam
   Double_t p() const;  // return total momentum
 
   /// return kTRUE if the covariance matrix exist, kFALSE if not
-  Bool_t hasCovariances() const { return (mCovariances) ? kTRUE : kFALSE; }
+  Bool_t hasCovariances() const { return mHasCovariances; }
 
-  const TMatrixD& getCovariances() const;
-  void setCovariances(const TMatrixD& covariances);
+  const SMatrix55Sym& getCovariances() const;
+  void setCovariances(const SMatrix55Sym& covariances);
   void setCovariances(const Double_t covariances[15]);
   void setVariances(const Double_t covariances[15]);
   void deleteCovariances();
 
-  const TMatrixD& getPropagator() const;
+  const SMatrix55Std& getPropagator() const;
   void resetPropagator();
-  void updatePropagator(const TMatrixD& propagator);
+  void updatePropagator(const SMatrix55Std& propagator);
 
-  const TMatrixD& getExtrapParameters() const;
-  void setExtrapParameters(const TMatrixD& parameters);
+  const SMatrix5& getExtrapParameters() const;
+  void setExtrapParameters(const SMatrix5& parameters);
 
-  const TMatrixD& getExtrapCovariances() const;
-  void setExtrapCovariances(const TMatrixD& covariances);
+  const SMatrix55Sym& getExtrapCovariances() const;
+  void setExtrapCovariances(const SMatrix55Sym& covariances);
 
-  const TMatrixD& getSmoothParameters() const;
-  void setSmoothParameters(const TMatrixD& parameters);
+  const SMatrix5& getSmoothParameters() const;
+  void setSmoothParameters(const SMatrix5& parameters);
 
-  const TMatrixD& getSmoothCovariances() const;
-  void setSmoothCovariances(const TMatrixD& covariances);
+  const SMatrix55Sym& getSmoothCovariances() const;
+  void setSmoothCovariances(const SMatrix55Sym& covariances);
 
   /// get pointer to associated cluster
   const Cluster* getClusterPtr() const { return mClusterPtr; }
@@ -152,7 +157,7 @@ class TrackParam
   /// Y       = Bending coordinate       (cm)
   /// SlopeY  = Bending slope            (cm ** -1)
   /// InvP_yz = Inverse bending momentum (GeV/c ** -1) times the charge (assumed forward motion)  </pre>
-  TMatrixD mParameters{5, 1}; ///< \brief Track parameters
+  SMatrix5 mParameters{}; ///< \brief Track parameters
 
   /// Covariance matrix of track parameters, ordered as follow:      <pre>
   ///    <X,X>      <X,SlopeX>        <X,Y>      <X,SlopeY>       <X,InvP_yz>
@@ -160,17 +165,26 @@ class TrackParam
   ///    <X,Y>      <Y,SlopeX>        <Y,Y>      <Y,SlopeY>       <Y,InvP_yz>
   /// <X,SlopeY>  <SlopeX,SlopeY>  <Y,SlopeY>  <SlopeY,SlopeY>  <SlopeY,InvP_yz>
   /// <X,InvP_yz> <SlopeX,InvP_yz> <Y,InvP_yz> <SlopeY,InvP_yz> <InvP_yz,InvP_yz>  </pre>
-  mutable std::unique_ptr<TMatrixD> mCovariances{}; ///< \brief Covariance matrix of track parameters
+  mutable SMatrix55Sym mCovariances{}; ///< \brief Covariance matrix of track parameters
 
   /// Jacobian used to extrapolate the track parameters and covariances to the actual z position
-  mutable std::unique_ptr<TMatrixD> mPropagator{};
+  mutable SMatrix55Std mPropagator{};
   /// Track parameters extrapolated to the actual z position (not filtered by Kalman)
-  mutable std::unique_ptr<TMatrixD> mExtrapParameters{};
+  mutable SMatrix5 mExtrapParameters{};
   /// Covariance matrix extrapolated to the actual z position (not filtered by Kalman)
-  mutable std::unique_ptr<TMatrixD> mExtrapCovariances{};
-
-  mutable std::unique_ptr<TMatrixD> mSmoothParameters{};  ///< Track parameters obtained using smoother
-  mutable std::unique_ptr<TMatrixD> mSmoothCovariances{}; ///< Covariance matrix obtained using smoother
+  mutable SMatrix55Sym mExtrapCovariances{};
+
+  mutable SMatrix5 mSmoothParameters{};      ///< Track parameters obtained using smoother
+  mutable SMatrix55Sym mSmoothCovariances{}; ///< Covariance matrix obtained using smoother
+
+  /// The matrices above are stored in place, so that the track parameters can be copied and
+  /// propagated without any memory allocation. These flags tell which ones are actually set.
+  mutable bool mHasCovariances = false;       ///< kTRUE if the covariance matrix is set
+  mutable bool mHasPropagator = false;        ///< kTRUE if the propagator is set
+  mutable bool mHasExtrapParameters = false;  ///< kTRUE if the extrapolated parameters are set
+  mutable bool mHasExtrapCovariances = false; ///< kTRUE if the extrapolated covariance matrix is set
+  mutable bool mHasSmoothParameters = false;  ///< kTRUE if the smoothed parameters are set
+  mutable bool mHasSmoothCovariances = false; ///< kTRUE if the smoothed covariance matrix is set
 
   const Cluster* mClusterPtr = nullptr; ///< Pointer to the associated cluster if any
 
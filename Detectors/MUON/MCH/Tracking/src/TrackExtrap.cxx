@@ -125,15 +125,12 @@ void TrackExtrap::linearExtrapToZCov(TrackParam& trackParam, double zEnd, bool u
   trackParam.setZ(zEnd);
 
   // Calculate the jacobian related to the track parameters linear extrapolation to "zEnd"
-  TMatrixD jacob(5, 5);
-  jacob.UnitMatrix();
+  SMatrix55Std jacob = ROOT::Math::SMatrixIdentity();
   jacob(0, 1) = dZ;
   jacob(2, 3) = dZ;
 
   // Extrapolate track parameter covariances to "zEnd"
-  TMatrixD tmp(trackParam.getCovariances(), TMatrixD::kMultTranspose, jacob);
-  TMatrixD tmp2(jacob, TMatrixD::kMult, tmp);
-  trackParam.setCovariances(tmp2);
+  trackParam.setCovariances(ROOT::Math::Similarity(jacob, trackParam.getCovariances()));
 
   // Update the propagator if required
   if (updatePropagator) {
@@ -182,11 +179,11 @@ bool TrackExtrap::extrapToZCov(TrackParam& trackParam, double zEnd, bool updateP
 
   // Save the actual track parameters
   TrackParam trackParamSave(trackParam);
-  TMatrixD paramSave(trackParamSave.getParameters());
+  SMatrix5 paramSave(trackParamSave.getParameters());
   double zBegin = trackParamSave.getZ();
 
   // Get reference to the parameter covariance matrix
-  const TMatrixD& kParamCov = trackParam.getCovariances();
+  const SMatrix55Sym& kParamCov = trackParam.getCovariances();
 
   // Extrapolate track parameters to "zEnd"
   // Do not update the covariance matrix if the extrapolation failed
@@ -195,12 +192,11 @@ bool TrackExtrap::extrapToZCov(TrackParam& trackParam, double zEnd, bool updateP
   }
 
   // Get reference to the extrapolated parameters
-  const TMatrixD& extrapParam = trackParam.getParameters();
+  const SMatrix5& extrapParam = trackParam.getParameters();
 
   // Calculate the jacobian related to the track parameters extrapolation to "zEnd"
-  TMatrixD jacob(5, 5);
-  jacob.Zero();
-  TMatrixD dParam(5, 1);
+  SMatrix55Std jacob;
+  SMatrix5 dParam;
   double direction[5] = {-1., -1., 1., 1., -1.};
   for (int i = 0; i < 5; i++) {
     // Skip jacobian calculation for parameters with no associated error
@@ -211,10 +207,10 @@ bool TrackExtrap::extrapToZCov(TrackParam& trackParam, double zEnd, bool updateP
     // Small variation of parameter i only
     for (int j = 0; j < 5; j++) {
       if (j == i) {
-        dParam(j, 0) = TMath::Sqrt(kParamCov(i, i));
-        dParam(j, 0) *= TMath::Sign(1., direction[j] * paramSave(j, 0)); // variation always in the same direction
+        dParam(j) = TMath::Sqrt(kParamCov(i, i));
+        dParam(j) *= TMath::Sign(1., direction[j] * paramSave(j)); // variation always in the same direction
       } else {
-        dParam(j, 0) = 0.;
+        dParam(j) = 0.;
       }
     }
 
@@ -230,15 +226,12 @@ bool TrackExtrap::extrapToZCov(TrackParam& trackParam, double zEnd, bool updateP
     }
 
     // Calculate the jacobian
-    TMatrixD jacobji(trackParamSave.getParameters(), TMatrixD::kMinus, extrapParam);
-    jacobji *= 1. / dParam(i, 0);
-    jacob.SetSub(0, i, jacobji);
+    SMatrix5 jacobji = (trackParamSave.getParameters() - extrapParam) * (1. / dParam(i));
+    jacob.Place_in_col(jacobji, 0, i);
   }
 
   // Extrapolate track parameter covariances to "zEnd"
-  TMatrixD tmp(kParamCov, TMatrixD::kMultTranspose, jacob);
-  TMatrixD tmp2(jacob, TMatrixD::kMult, tmp);
-  trackParam.setCovariances(tmp2);
+  trackParam.setCovariances(ROOT::Math::Similarity(jacob, kParamCov));
 
   // Update the propagator if required
   if (updatePropagator) {
@@ -537,16 +530,14 @@ void TrackExtrap::addMCSEffect(TrackParam& trackParam, double dZ, double x0)
   double covCorrSlope = (x0 > 0.) ? signedPathLength * theta02 / 2. : 0.;
 
   // Set MCS covariance matrix
-  TMatrixD newParamCov(trackParam.getCovariances());
+  SMatrix55Sym newParamCov(trackParam.getCovariances());
   // Non bending plane
   newParamCov(0, 0) += varCoor;
   newParamCov(0, 1) += covCorrSlope;
-  newParamCov(1, 0) += covCorrSlope;
   newParamCov(1, 1) += varSlop;
   // Bending plane
   newParamCov(2, 2) += varCoor;
   newParamCov(2, 3) += covCorrSlope;
-  newParamCov(3, 2) += covCorrSlope;
   newParamCov(3, 3) += varSlop;
 
   // Set momentum related covariances if B!=0
@@ -559,13 +550,9 @@ void TrackExtrap::addMCSEffect(TrackParam& trackParam, double dZ, double x0)
                           (1. + nonBendingSlope * nonBendingSlope + bendingSlope * bendingSlope);
     // Inverse bending momentum (due to dependences with bending and non bending slopes)
     newParamCov(4, 0) += dqPxydSlopeX * covCorrSlope;
-    newParamCov(0, 4) += dqPxydSlopeX * covCorrSlope;
     newParamCov(4, 1) += dqPxydSlopeX * varSlop;
-    newParamCov(1, 4) += dqPxydSlopeX * varSlop;
     newParamCov(4, 2) += dqPxydSlopeY * covCorrSlope;
-    newParamCov(2, 4) += dqPxydSlopeY * covCorrSlope;
     newParamCov(4, 3) += dqPxydSlopeY * varSlop;
-    newParamCov(3, 4) += dqPxydSlopeY * varSlop;
     newParamCov(4, 4) += (dqPxydSlopeX * dqPxydSlopeX + dqPxydSlopeY * dqPxydSlopeY) * varSlop;
   }
 
@@ -591,16 +578,14 @@ void TrackExtrap::addMCSEffectInAbsorber(TrackParam& param, double signedPathLen
   double varSlop = alpha2 * f0;
 
   // Set MCS covariance matrix
-  TMatrixD newParamCov(param.getCovariances());
+  SMatrix55Sym newParamCov(param.getCovariances());
   // Non bending plane
   newParamCov(0, 0) += varCoor;
   newParamCov(0, 1) += covCorrSlope;
-  newParamCov(1, 0) += covCorrSlope;
   newParamCov(1, 1) += varSlop;
   // Bending plane
   newParamCov(2, 2) += varCoor;
   newParamCov(2, 3) += covCorrSlope;
-  newParamCov(3, 2) += covCorrSlope;
   newParamCov(3, 3) += varSlop;
 
   // Set momentum related covariances if B!=0
@@ -611,13 +596,9 @@ void TrackExtrap::addMCSEffectInAbsorber(TrackParam& param, double signedPathLen
                           (1. + bendingSlope * bendingSlope) / (1. + nonBendingSlope * nonBendingSlope + bendingSlope * bendingSlope);
     // Inverse bending momentum (due to dependences with bending and non bending slopes)
     newParamCov(4, 0) += dqPxydSlopeX * covCorrSlope;
-    newParamCov(0, 4) += dqPxydSlopeX * covCorrSlope;
     newParamCov(4, 1) += dqPxydSlopeX * varSlop;
-    newParamCov(1, 4) += dqPxydSlopeX * varSlop;
     newParamCov(4, 2) += dqPxydSlopeY * covCorrSlope;
-    newParamCov(2, 4) += dqPxydSlopeY * covCorrSlope;
     newParamCov(4, 3) += dqPxydSlopeY * varSlop;
-    newParamCov(3, 4) += dqPxydSlopeY * varSlop;
     newParamCov(4, 4) += (dqPxydSlopeX * dqPxydSlopeX + dqPxydSlopeY * dqPxydSlopeY) * varSlop;
   }
 
@@ -696,45 +677,39 @@ bool TrackExtrap::correctMCSEffectInAbsorber(TrackParam& param, double xVtx, dou
   linearExtrapToZCov(param, zB);
 
   // compute track parameters at vertex
-  TMatrixD newParam(5, 1);
-  newParam(0, 0) = xVtx;
-  newParam(1, 0) = (param.getNonBendingCoor() - xVtx) / (zB - zVtx);
-  newParam(2, 0) = yVtx;
-  newParam(3, 0) = (param.getBendingCoor() - yVtx) / (zB - zVtx);
-  newParam(4, 0) = param.getCharge() / param.p() *
-                   TMath::Sqrt(1.0 + newParam(1, 0) * newParam(1, 0) + newParam(3, 0) * newParam(3, 0)) /
-                   TMath::Sqrt(1.0 + newParam(3, 0) * newParam(3, 0));
+  SMatrix5 newParam;
+  newParam(0) = xVtx;
+  newParam(1) = (param.getNonBendingCoor() - xVtx) / (zB - zVtx);
+  newParam(2) = yVtx;
+  newParam(3) = (param.getBendingCoor() - yVtx) / (zB - zVtx);
+  newParam(4) = param.getCharge() / param.p() *
+                TMath::Sqrt(1.0 + newParam(1) * newParam(1) + newParam(3) * newParam(3)) /
+                TMath::Sqrt(1.0 + newParam(3) * newParam(3));
 
   // Get covariances in (X, SlopeX, Y, SlopeY, q*PTot) coordinate system
-  TMatrixD paramCovP(param.getCovariances());
+  SMatrix55Sym paramCovP(param.getCovariances());
   cov2CovP(param.getParameters(), paramCovP);
 
   // Get the covariance matrix in the (XVtx, X, YVtx, Y, q*PTot) coordinate system
-  TMatrixD paramCovVtx(5, 5);
-  paramCovVtx.Zero();
+  SMatrix55Sym paramCovVtx;
   paramCovVtx(0, 0) = errXVtx * errXVtx;
   paramCovVtx(1, 1) = paramCovP(0, 0);
   paramCovVtx(2, 2) = errYVtx * errYVtx;
   paramCovVtx(3, 3) = paramCovP(2, 2);
   paramCovVtx(4, 4) = paramCovP(4, 4);
   paramCovVtx(1, 3) = paramCovP(0, 2);
-  paramCovVtx(3, 1) = paramCovP(2, 0);
   paramCovVtx(1, 4) = paramCovP(0, 4);
-  paramCovVtx(4, 1) = paramCovP(4, 0);
   paramCovVtx(3, 4) = paramCovP(2, 4);
-  paramCovVtx(4, 3) = paramCovP(4, 2);
 
   // Jacobian of the transformation (XVtx, X, YVtx, Y, q*PTot) -> (XVtx, SlopeXVtx, YVtx, SlopeYVtx, q*PTotVtx)
-  TMatrixD jacob(5, 5);
-  jacob.UnitMatrix();
+  SMatrix55Std jacob = ROOT::Math::SMatrixIdentity();
   jacob(1, 0) = -1. / (zB - zVtx);
   jacob(1, 1) = 1. / (zB - zVtx);
   jacob(3, 2) = -1. / (zB - zVtx);
   jacob(3, 3) = 1. / (zB - zVtx);
 
   // Compute covariances at vertex in the (XVtx, SlopeXVtx, YVtx, SlopeYVtx, q*PTotVtx) coordinate system
-  TMatrixD tmp(paramCovVtx, TMatrixD::kMultTranspose, jacob);
-  TMatrixD newParamCov(jacob, TMatrixD::kMult, tmp);
+  SMatrix55Sym newParamCov = ROOT::Math::Similarity(jacob, paramCovVtx);
 
   // Compute covariances at vertex in the (XVtx, SlopeXVtx, YVtx, SlopeYVtx, q/PyzVtx) coordinate system
   covP2Cov(newParam, newParamCov);
@@ -753,7 +728,7 @@ void TrackExtrap::correctELossEffectInAbsorber(TrackParam& param, double eLoss,
   /// Correct parameters for energy loss and add energy loss fluctuation effect to covariances
 
   // Get parameter covariances in (X, SlopeX, Y, SlopeY, q*PTot) coordinate system
-  TMatrixD newParamCov(param.getCovariances());
+  SMatrix55Sym newParamCov(param.getCovariances());
   cov2CovP(param.getParameters(), newParamCov);
 
   // Compute new parameters corrected for energy loss
@@ -778,49 +753,45 @@ void TrackExtrap::correctELossEffectInAbsorber(TrackParam& param, double eLoss,
 }
 
 //__________________________________________________________________________
-void TrackExtrap::cov2CovP(const TMatrixD& param, TMatrixD& cov)
+void TrackExtrap::cov2CovP(const SMatrix5& param, SMatrix55Sym& cov)
 {
   /// change coordinate system: (X, SlopeX, Y, SlopeY, q/Pyz) -> (X, SlopeX, Y, SlopeY, q*PTot)
   /// parameters (param) are given in the (X, SlopeX, Y, SlopeY, q/Pyz) coordinate system
 
   // charge * total momentum
-  double qPTot = TMath::Sqrt(1. + param(1, 0) * param(1, 0) + param(3, 0) * param(3, 0)) /
-                 TMath::Sqrt(1. + param(3, 0) * param(3, 0)) / param(4, 0);
+  double qPTot = TMath::Sqrt(1. + param(1) * param(1) + param(3) * param(3)) /
+                 TMath::Sqrt(1. + param(3) * param(3)) / param(4);
 
   // Jacobian of the opposite transformation
-  TMatrixD jacob(5, 5);
-  jacob.UnitMatrix();
-  jacob(4, 1) = qPTot * param(1, 0) / (1. + param(1, 0) * param(1, 0) + param(3, 0) * param(3, 0));
-  jacob(4, 3) = -qPTot * param(1, 0) * param(1, 0) * param(3, 0) /
-                (1. + param(3, 0) * param(3, 0)) / (1. + param(1, 0) * param(1, 0) + param(3, 0) * param(3, 0));
-  jacob(4, 4) = -qPTot / param(4, 0);
+  SMatrix55Std jacob = ROOT::Math::SMatrixIdentity();
+  jacob(4, 1) = qPTot * param(1) / (1. + param(1) * param(1) + param(3) * param(3));
+  jacob(4, 3) = -qPTot * param(1) * param(1) * param(3) /
+                (1. + param(3) * param(3)) / (1. + param(1) * param(1) + param(3) * param(3));
+  jacob(4, 4) = -qPTot / param(4);
 
   // compute covariances in new coordinate system
-  TMatrixD tmp(cov, TMatrixD::kMultTranspose, jacob);
-  cov.Mult(jacob, tmp);
+  cov = ROOT::Math::Similarity(jacob, cov);
 }
 
 //__________________________________________________________________________
-void TrackExtrap::covP2Cov(const TMatrixD& param, TMatrixD& covP)
+void TrackExtrap::covP2Cov(const SMatrix5& param, SMatrix55Sym& covP)
 {
   /// change coordinate system: (X, SlopeX, Y, SlopeY, q*PTot) -> (X, SlopeX, Y, SlopeY, q/Pyz)
   /// parameters (param) are given in the (X, SlopeX, Y, SlopeY, q/Pyz) coordinate system
 
   // charge * total momentum
-  double qPTot = TMath::Sqrt(1. + param(1, 0) * param(1, 0) + param(3, 0) * param(3, 0)) /
-                 TMath::Sqrt(1. + param(3, 0) * param(3, 0)) / param(4, 0);
+  double qPTot = TMath::Sqrt(1. + param(1) * param(1) + param(3) * param(3)) /
+                 TMath::Sqrt(1. + param(3) * param(3)) / param(4);
 
   // Jacobian of the transformation
-  TMatrixD jacob(5, 5);
-  jacob.UnitMatrix();
-  jacob(4, 1) = param(4, 0) * param(1, 0) / (1. + param(1, 0) * param(1, 0) + param(3, 0) * param(3, 0));
-  jacob(4, 3) = -param(4, 0) * param(1, 0) * param(1, 0) * param(3, 0) /
-                (1. + param(3, 0) * param(3, 0)) / (1. + param(1, 0) * param(1, 0) + param(3, 0) * param(3, 0));
-  jacob(4, 4) = -param(4, 0) / qPTot;
+  SMatrix55Std jacob = ROOT::Math::SMatrixIdentity();
+  jacob(4, 1) = param(4) * param(1) / (1. + param(1) * param(1) + param(3) * param(3));
+  jacob(4, 3) = -param(4) * param(1) * param(1) * param(3) /
+                (1. + param(3) * param(3)) / (1. + param(1) * param(1) + param(3) * param(3));
+  jacob(4, 4) = -param(4) / qPTot;
 
   // compute covariances in new coordinate system
-  TMatrixD tmp(covP, TMatrixD::kMultTranspose, jacob);
-  covP.Mult(jacob, tmp);
+  covP = ROOT::Math::Similarity(jacob, covP);
 }
 
 //__________________________________________________________________________
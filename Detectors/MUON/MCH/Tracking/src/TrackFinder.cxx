@@ -21,7 +21,6 @@
 #include <stdexcept>
 
 #include <TGeoGlobalMagField.h>
-#include <TMatrixD.h>
 #include <TMath.h>
 
 #include "Field/MagneticField.h"
@@ -179,7 +178,7 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
   // track each candidate down to chamber 1 and remove it
   tStart = std::chrono::high_resolution_clock::now();
   for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
-    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+    ClusterIds excludedClusters{};
     followTrackInChamber(itTrack, 5, 0, false, excludedClusters);
     print("findTracks: removing candidate at position #", getTrackIndex(itTrack));
     itTrack = mTracks.erase(itTrack);
@@ -233,7 +232,7 @@ void TrackFinder::findTrackCandidates()
     }
 
     // look for compatible clusters on station 4
-    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+    ClusterIds excludedClusters{};
     auto itNewTrack = followTrackInChamber(itTrack, 7, 6, false, excludedClusters);
 
     // keep the current candidate only if no compatible cluster is found and the station is not requested
@@ -271,7 +270,7 @@ void TrackFinder::findTrackCandidates()
     // look for compatible clusters on each chamber of station 5 separately,
     // exluding those already attached to an identical candidate on station 4
     // (cases where both chambers of station 5 are fired should have been found in the first step)
-    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+    ClusterIds excludedClusters{};
     if (itLastCandidateFromSt5 != mTracks.end()) {
       excludeClustersFromIdenticalTracks(itTrack, excludedClusters, std::next(itLastCandidateFromSt5));
     }
@@ -763,7 +762,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
                                                              int chamber, int lastChamber, bool canSkip,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                             ClusterIds& excludedClusters)
 {
   /// Follow the track candidate pointed to by "itTrack" to the given "chamber"
   /// The tracking starts from the current parameters, which must have already been set
@@ -858,7 +857,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
                                                              int plane1, int plane2, int lastChamber,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                             ClusterIds& excludedClusters)
 {
   /// Follow the track candidate pointed to by "itTrack" to the (half)chamber formed by "plane1" and "plane2"
   /// The tracking starts from the current parameters, which must have already been set
@@ -909,7 +908,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   TrackParam paramAtCluster1{};
   TrackParam currentParamAtCluster1{};
   TrackParam paramAtCluster2{};
-  std::unordered_map<int, std::unordered_set<uint32_t>> newExcludedClusters{};
+  ClusterIds newExcludedClusters{};
   for (auto& de1 : mClusters[plane1]) {
 
     // skip DE without cluster
@@ -917,15 +916,11 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       continue;
     }
 
-    // get the list of excluded clusters for the DE
-    auto itExcludedClusters = excludedClusters.find(de1.first);
-    bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
-
     // look for cluster candidate in this DE
     for (const auto cluster1 : *de1.second) {
 
       // skip excluded clusters
-      if (hasExcludedClusters && itExcludedClusters->second.count(cluster1->uid) > 0) {
+      if (isExcluded(cluster1->uid, excludedClusters)) {
         continue;
       }
 
@@ -935,7 +930,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       }
 
       // add it to the list of excluded clusters for this candidate
-      excludedClusters[de1.first].emplace(cluster1->uid);
+      exclude(cluster1->uid, excludedClusters);
 
       // skip tracks out of limits, but after checking for overlaps
       bool isAcceptableAtCluster1 = isAcceptable(paramAtCluster1);
@@ -970,7 +965,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
           cluster2Found = true;
 
           // add it to the list of excluded clusters for this candidate
-          excludedClusters[de2.first].emplace(cluster2->uid);
+          exclude(cluster2->uid, excludedClusters);
 
           // skip tracks out of limits
           if (!isAcceptableAtCluster1 || !isAcceptable(paramAtCluster2)) {
@@ -1010,15 +1005,11 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       continue;
     }
 
-    // get the list of excluded clusters for the DE
-    auto itExcludedClusters = excludedClusters.find(de2.first);
-    bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
-
     // look for cluster candidate in this DE
     for (const auto cluster2 : *de2.second) {
 
       // skip excluded clusters (in particular the ones already attached together with a cluster on plane1)
-      if (hasExcludedClusters && itExcludedClusters->second.count(cluster2->uid) > 0) {
+      if (isExcluded(cluster2->uid, excludedClusters)) {
         continue;
       }
 
@@ -1028,7 +1019,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       }
 
       // add it to the list of excluded clusters for this candidate
-      excludedClusters[de2.first].emplace(cluster2->uid);
+      exclude(cluster2->uid, excludedClusters);
 
       // skip tracks out of limits
       if (!isAcceptable(paramAtCluster2)) {
@@ -1057,7 +1048,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
                                                                   const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                                  ClusterIds& excludedClusters)
 {
   /// If "nextChamber" >= 0: continue the tracking of "itTrack" up to "lastChamber", attach the two clusters
   /// to every new tracks found and return an iterator to the first of them (or mTracks.end() if none is found)
@@ -1340,7 +1331,7 @@ bool TrackFinder::isAcceptable(const TrackParam& param) const
   }
 
   const auto& trackerParam = TrackerParam::Instance();
-  const TMatrixD& paramCov = param.getCovariances();
+  const SMatrix55Sym& paramCov = param.getCovariances();
   double z = param.getZ();
 
   // check if non bending impact parameter is within tolerances
@@ -1461,7 +1452,7 @@ bool TrackFinder::areUsed(const Cluster& cl1, const Cluster& cl2, const std::vec
 
 //_________________________________________________________________________________________________
 void TrackFinder::excludeClustersFromIdenticalTracks(const std::list<Track>::iterator& itTrack,
-                                                     std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters,
+                                                     ClusterIds& excludedClusters,
                                                      const std::list<Track>::iterator& itEndTrack)
 {
   /// Find tracks in the range [mTracks.begin(), itEndTrack[ that contain all the clusters of itTrack
@@ -1471,7 +1462,7 @@ void TrackFinder::excludeClustersFromIdenticalTracks(const std::list<Track>::ite
       for (auto itParam = itTrack2->rbegin(); itParam != itTrack2->rend(); ++itParam) {
         const Cluster* cluster = itParam->getClusterPtr();
         if (cluster->getChamberId() > 7) {
-          excludedClusters[cluster->getDEId()].emplace(cluster->uid);
+          exclude(cluster->uid, excludedClusters);
         } else {
           break;
         }
@@ -1481,11 +1472,11 @@ void TrackFinder::excludeClustersFromIdenticalTracks(const std::list<Track>::ite
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination)
+void TrackFinder::moveClusters(ClusterIds& source, ClusterIds& destination)
 {
   /// Move cluster Ids listed in source into destination then clear source
-  for (auto& sourceDE : source) {
-    destination[sourceDE.first].insert(sourceDE.second.begin(), sourceDE.second.end());
+  for (auto uid : source) {
+    exclude(uid, destination);
   }
   source.clear();
 }
@@ -1533,7 +1524,7 @@ bool TrackFinder::tryOneClusterFast(const TrackParam& param, const Cluster& clus
   double dZ = cluster.getZ() - param.getZ();
   double dX = cluster.getX() - (param.getNonBendingCoor() + param.getNonBendingSlope() * dZ);
   double dY = cluster.getY() - (param.getBendingCoor() + param.getBendingSlope() * dZ);
-  const TMatrixD& paramCov = param.getCovariances();
+  const SMatrix55Sym& paramCov = param.getCovariances();
   double errX2 = paramCov(0, 0) + dZ * dZ * paramCov(1, 1) + 2. * dZ * paramCov(0, 1) + mChamberResolutionX2;
   double errY2 = paramCov(2, 2) + dZ * dZ * paramCov(3, 3) + 2. * dZ * paramCov(2, 3) + mChamberResolutionY2;
 
@@ -1568,7 +1559,7 @@ double TrackFinder::tryOneCluster(const TrackParam& param, const Cluster& cluste
   double dY = cluster.getY() - paramAtCluster.getBendingCoor();
 
   // Combine the cluster and track resolutions and covariances
-  const TMatrixD& paramCov = paramAtCluster.getCovariances();
+  const SMatrix55Sym& paramCov = paramAtCluster.getCovariances();
   double sigmaX2 = paramCov(0, 0) + mChamberResolutionX2;
   double sigmaY2 = paramCov(2, 2) + mChamberResolutionY2;
   double covXY = paramCov(0, 2);
@@ -20,7 +20,6 @@
 #include <stdexcept>
 
 #include <TGeoGlobalMagField.h>
-#include <TMatrixD.h>
 #include <TMath.h>
 
 #include "Field/MagneticField.h"
@@ -418,21 +417,18 @@ void TrackFinderOriginal::createTrack(const Cluster& cl1, const Cluster& cl2)
   param2.setInverseBendingMomentum(inverseBendingMomentum);
 
   // Compute and set track parameters covariances at first cluster
-  TMatrixD paramCov(5, 5);
-  paramCov.Zero();
+  SMatrix55Sym paramCov;
   // Non bending plane
   double cl1Ex2 = mChamberResolutionX2;
   double cl2Ex2 = mChamberResolutionX2;
   paramCov(0, 0) = cl1Ex2;
   paramCov(0, 1) = cl1Ex2 / dZ;
-  paramCov(1, 0) = paramCov(0, 1);
   paramCov(1, 1) = (cl1Ex2 + cl2Ex2) / dZ / dZ;
   // Bending plane
   double cl1Ey2 = mChamberResolutionY2;
   double cl2Ey2 = mChamberResolutionY2;
   paramCov(2, 2) = cl1Ey2;
   paramCov(2, 3) = cl1Ey2 / dZ;
-  paramCov(3, 2) = paramCov(2, 3);
   paramCov(3, 3) = (cl1Ey2 + cl2Ey2) / dZ / dZ;
   // Inverse bending momentum (vertex resolution + bending slope resolution + 10% error on dipole parameters+field)
   if (TrackExtrap::isFieldON()) {
@@ -442,9 +438,7 @@ void TrackFinderOriginal::createTrack(const Cluster& cl1, const Cluster& cl2)
                       0.1 * 0.1) *
                      inverseBendingMomentum * inverseBendingMomentum;
     paramCov(2, 4) = -cl2.getZ() * cl1Ey2 * inverseBendingMomentum / bendingImpact / dZ;
-    paramCov(4, 2) = paramCov(2, 4);
     paramCov(3, 4) = -(cl1.getZ() * cl2Ey2 + cl2.getZ() * cl1Ey2) * inverseBendingMomentum / bendingImpact / dZ / dZ;
-    paramCov(4, 3) = paramCov(3, 4);
   } else {
     paramCov(4, 4) = inverseBendingMomentum * inverseBendingMomentum;
   }
@@ -454,15 +448,12 @@ void TrackFinderOriginal::createTrack(const Cluster& cl1, const Cluster& cl2)
   // Non bending plane
   paramCov(0, 0) = cl2Ex2;
   paramCov(0, 1) = -cl2Ex2 / dZ;
-  paramCov(1, 0) = paramCov(0, 1);
   // Bending plane
   paramCov(2, 2) = cl2Ey2;
   paramCov(2, 3) = -cl2Ey2 / dZ;
-  paramCov(3, 2) = paramCov(2, 3);
   // Inverse bending momentum (vertex resolution + bending slope resolution + 10% error on dipole parameters+field)
   if (TrackExtrap::isFieldON()) {
     paramCov(2, 4) = cl1.getZ() * cl2Ey2 * inverseBendingMomentum / bendingImpact / dZ;
-    paramCov(4, 2) = paramCov(2, 4);
   }
   param2.setCovariances(paramCov);
 
@@ -475,7 +466,7 @@ bool TrackFinderOriginal::isAcceptable(const TrackParam& param) const
   /// Return true if the track is within given limits on momentum/angle/origin
 
   const auto& trackerParam = TrackerParam::Instance();
-  const TMatrixD& paramCov = param.getCovariances();
+  const SMatrix55Sym& paramCov = param.getCovariances();
   int chamber = param.getClusterPtr()->getChamberId();
   double z = param.getZ();
 
@@ -926,7 +917,7 @@ bool TrackFinderOriginal::tryOneClusterFast(const TrackParam& param, const Clust
   double dZ = cluster.getZ() - param.getZ();
   double dX = cluster.getX() - (param.getNonBendingCoor() + param.getNonBendingSlope() * dZ);
   double dY = cluster.getY() - (param.getBendingCoor() + param.getBendingSlope() * dZ);
-  const TMatrixD& paramCov = param.getCovariances();
+  const SMatrix55Sym& paramCov = param.getCovariances();
   double errX2 = paramCov(0, 0) + dZ * dZ * paramCov(1, 1) + 2. * dZ * paramCov(0, 1) + mChamberResolutionX2;
   double errY2 = paramCov(2, 2) + dZ * dZ * paramCov(3, 3) + 2. * dZ * paramCov(2, 3) + mChamberResolutionY2;
 
@@ -962,7 +953,7 @@ double TrackFinderOriginal::tryOneCluster(const TrackParam& param, const Cluster
   double dY = cluster.getY() - paramAtCluster.getBendingCoor();
 
   // Combine the cluster and track resolutions and covariances
-  const TMatrixD& paramCov = paramAtCluster.getCovariances();
+  const SMatrix55Sym& paramCov = paramAtCluster.getCovariances();
   double sigmaX2 = paramCov(0, 0) + mChamberResolutionX2;
   double sigmaY2 = paramCov(2, 2) + mChamberResolutionY2;
   double covXY = paramCov(0, 2);
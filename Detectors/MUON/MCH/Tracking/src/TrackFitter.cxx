@@ -19,7 +19,6 @@
 #include <stdexcept>
 
 #include <TGeoGlobalMagField.h>
-#include <TMatrixD.h>
 
 #include "Field/MagneticField.h"
 #include "MCHTracking/TrackExtrap.h"
@@ -116,8 +115,7 @@ void TrackFitter::initTrack(const Cluster& cl1, const Cluster& cl2, TrackParam&
   param.setInverseBendingMomentum(inverseBendingMomentum);
 
   // compute the track parameter covariances at the last cluster (as if the other clusters did not exist)
-  TMatrixD lastParamCov(5, 5);
-  lastParamCov.Zero();
+  SMatrix55Sym lastParamCov;
   double cl1Ey2(0.);
   if (mUseChamberResolution) {
     // Non bending plane
@@ -136,10 +134,8 @@ void TrackFitter::initTrack(const Cluster& cl1, const Cluster& cl2, TrackParam&
   }
   // Non bending plane
   lastParamCov(0, 1) = -lastParamCov(0, 0) / dZ;
-  lastParamCov(1, 0) = lastParamCov(0, 1);
   // Bending plane
   lastParamCov(2, 3) = -lastParamCov(2, 2) / dZ;
-  lastParamCov(3, 2) = lastParamCov(2, 3);
   lastParamCov(3, 3) = (1000. * cl1Ey2 + lastParamCov(2, 2)) / dZ / dZ;
   // Inverse bending momentum (vertex resolution + bending slope resolution + 10% error on dipole parameters+field)
   if (TrackExtrap::isFieldON()) {
@@ -150,10 +146,8 @@ void TrackFitter::initTrack(const Cluster& cl1, const Cluster& cl2, TrackParam&
        0.1 * 0.1) *
       inverseBendingMomentum * inverseBendingMomentum;
     lastParamCov(2, 4) = cl1.getZ() * lastParamCov(2, 2) * inverseBendingMomentum / bendingImpact / dZ;
-    lastParamCov(4, 2) = lastParamCov(2, 4);
     lastParamCov(3, 4) = -(cl1.getZ() * lastParamCov(2, 2) + cl2.getZ() * 1000. * cl1Ey2) * inverseBendingMomentum /
                          bendingImpact / dZ / dZ;
-    lastParamCov(4, 3) = lastParamCov(3, 4);
   } else {
     lastParamCov(4, 4) = inverseBendingMomentum * inverseBendingMomentum;
   }
@@ -260,26 +254,22 @@ void TrackFitter::runKalmanFilter(TrackParam& trackParam)
   /// Throw an exception in case of failure
 
   // get actual track parameters (p)
-  TMatrixD param(trackParam.getParameters());
+  SMatrix5 param(trackParam.getParameters());
 
   // get new cluster parameters (m)
   const Cluster* cluster = trackParam.getClusterPtr();
-  TMatrixD clusterParam(5, 1);
-  clusterParam.Zero();
-  clusterParam(0, 0) = cluster->getX();
-  clusterParam(2, 0) = cluster->getY();
+  SMatrix5 clusterParam;
+  clusterParam(0) = cluster->getX();
+  clusterParam(2) = cluster->getY();
 
   // compute the actual parameter weight (W)
-  TMatrixD paramWeight(trackParam.getCovariances());
-  if (paramWeight.Determinant() != 0) {
-    paramWeight.Invert();
-  } else {
+  SMatrix55Sym paramWeight(trackParam.getCovariances());
+  if (!paramWeight.Invert()) {
     throw runtime_error("Determinant = 0");
   }
 
   // compute the new cluster weight (U)
-  TMatrixD clusterWeight(5, 5);
-  clusterWeight.Zero();
+  SMatrix55Sym clusterWeight;
   if (mUseChamberResolution) {
     clusterWeight(0, 0) = 1. / mChamberResolutionX2;
     clusterWeight(2, 2) = 1. / mChamberResolutionY2;
@@ -289,31 +279,21 @@ void TrackFitter::runKalmanFilter(TrackParam& trackParam)
   }
 
   // compute the new parameters covariance matrix ((W+U)^-1)
-  TMatrixD newParamCov(paramWeight, TMatrixD::kPlus, clusterWeight);
-  if (newParamCov.Determinant() != 0) {
-    newParamCov.Invert();
-  } else {
+  SMatrix55Sym newParamCov(paramWeight + clusterWeight);
+  if (!newParamCov.Invert()) {
     throw runtime_error("Determinant = 0");
   }
   trackParam.setCovariances(newParamCov);
 
   // compute the new parameters (p' = ((W+U)^-1)U(m-p) + p)
-  TMatrixD tmp(clusterParam, TMatrixD::kMinus, param);   // m-p
-  TMatrixD tmp2(clusterWeight, TMatrixD::kMult, tmp);    // U(m-p)
-  TMatrixD newParam(newParamCov, TMatrixD::kMult, tmp2); // ((W+U)^-1)U(m-p)
-  newParam += param;                                     // ((W+U)^-1)U(m-p) + p
+  SMatrix5 newParam = newParamCov * (clusterWeight * (clusterParam - param)) + param;
   trackParam.setParameters(newParam);
 
   // compute the additional chi2 (= ((p'-p)^-1)W(p'-p) + ((p'-m)^-1)U(p'-m))
-  tmp = newParam;                                                // p'
-  tmp -= param;                                                  // (p'-p)
-  TMatrixD tmp3(paramWeight, TMatrixD::kMult, tmp);              // W(p'-p)
-  TMatrixD addChi2Track(tmp, TMatrixD::kTransposeMult, tmp3);    // ((p'-p)^-1)W(p'-p)
-  tmp = newParam;                                                // p'
-  tmp -= clusterParam;                                           // (p'-m)
-  TMatrixD tmp4(clusterWeight, TMatrixD::kMult, tmp);            // U(p'-m)
-  addChi2Track += TMatrixD(tmp, TMatrixD::kTransposeMult, tmp4); // ((p'-p)^-1)W(p'-p) + ((p'-m)^-1)U(p'-m)
-  trackParam.setTrackChi2(trackParam.getTrackChi2() + addChi2Track(0, 0));
+  SMatrix5 deltaParam = newParam - param;          // (p'-p)
+  SMatrix5 deltaCluster = newParam - clusterParam; // (p'-m)
+  double addChi2Track = ROOT::Math::Similarity(deltaParam, paramWeight) + ROOT::Math::Similarity(deltaCluster, clusterWeight);
+  trackParam.setTrackChi2(trackParam.getTrackChi2() + addChi2Track);
 }
 
 //_________________________________________________________________________________________________
@@ -323,46 +303,36 @@ void TrackFitter::runSmoother(const TrackParam& previousParam, TrackParam& param
   /// Throw an exception in case of failure
 
   // get variables
-  const TMatrixD& extrapParameters = previousParam.getExtrapParameters();           // X(k+1 k)
-  const TMatrixD& filteredParameters = param.getParameters();                       // X(k k)
-  const TMatrixD& previousSmoothParameters = previousParam.getSmoothParameters();   // X(k+1 n)
-  const TMatrixD& propagator = previousParam.getPropagator();                       // F(k)
-  const TMatrixD& extrapCovariances = previousParam.getExtrapCovariances();         // C(k+1 k)
-  const TMatrixD& filteredCovariances = param.getCovariances();                     // C(k k)
-  const TMatrixD& previousSmoothCovariances = previousParam.getSmoothCovariances(); // C(k+1 n)
+  const SMatrix5& extrapParameters = previousParam.getExtrapParameters();               // X(k+1 k)
+  const SMatrix5& filteredParameters = param.getParameters();                           // X(k k)
+  const SMatrix5& previousSmoothParameters = previousParam.getSmoothParameters();       // X(k+1 n)
+  const SMatrix55Std& propagator = previousParam.getPropagator();                       // F(k)
+  const SMatrix55Sym& extrapCovariances = previousParam.getExtrapCovariances();         // C(k+1 k)
+  const SMatrix55Sym& filteredCovariances = param.getCovariances();                     // C(k k)
+  const SMatrix55Sym& previousSmoothCovariances = previousParam.getSmoothCovariances(); // C(k+1 n)
 
   // compute smoother gain: A(k) = C(kk) * F(k)^t * (C(k+1 k))^-1
-  TMatrixD extrapWeight(extrapCovariances);
-  if (extrapWeight.Determinant() != 0) {
-    extrapWeight.Invert(); // (C(k+1 k))^-1
-  } else {
+  SMatrix55Sym extrapWeight(extrapCovariances);
+  if (!extrapWeight.Invert()) { // (C(k+1 k))^-1
     throw runtime_error("Determinant = 0");
   }
-  TMatrixD smootherGain(filteredCovariances, TMatrixD::kMultTranspose, propagator); // C(kk) * F(k)^t
-  smootherGain *= extrapWeight;                                                     // C(kk) * F(k)^t * (C(k+1 k))^-1
+  SMatrix55Std smootherGain = filteredCovariances * ROOT::Math::Transpose(propagator) * extrapWeight; // C(kk) * F(k)^t * (C(k+1 k))^-1
 
   // compute smoothed parameters: X(k n) = X(k k) + A(k) * (X(k+1 n) - X(k+1 k))
-  TMatrixD tmpParam(previousSmoothParameters, TMatrixD::kMinus, extrapParameters); // X(k+1 n) - X(k+1 k)
-  TMatrixD smoothParameters(smootherGain, TMatrixD::kMult, tmpParam);              // A(k) * (X(k+1 n) - X(k+1 k))
-  smoothParameters += filteredParameters;                                          // X(k k) + A(k) * (X(k+1 n) - X(k+1 k))
+  SMatrix5 smoothParameters = smootherGain * (previousSmoothParameters - extrapParameters) + filteredParameters;
   param.setSmoothParameters(smoothParameters);
 
   // compute smoothed covariances: C(k n) = C(k k) + A(k) * (C(k+1 n) - C(k+1 k)) * (A(k))^t
-  TMatrixD tmpCov(previousSmoothCovariances, TMatrixD::kMinus, extrapCovariances); // C(k+1 n) - C(k+1 k)
-  TMatrixD tmpCov2(tmpCov, TMatrixD::kMultTranspose, smootherGain);                // (C(k+1 n) - C(k+1 k)) * (A(k))^t
-  TMatrixD smoothCovariances(smootherGain, TMatrixD::kMult, tmpCov2);              // A(k) * (C(k+1 n) - C(k+1 k)) * (A(k))^t
-  smoothCovariances += filteredCovariances;                                        // C(k k) + A(k) * (C(k+1 n) - C(k+1 k)) * (A(k))^t
+  SMatrix55Sym tmpCov(previousSmoothCovariances - extrapCovariances); // C(k+1 n) - C(k+1 k)
+  SMatrix55Sym smoothCovariances = ROOT::Math::Similarity(smootherGain, tmpCov) + filteredCovariances;
   param.setSmoothCovariances(smoothCovariances);
 
   // compute smoothed residual: r(k n) = cluster - X(k n)
   const Cluster* cluster = param.getClusterPtr();
-  TMatrixD smoothResidual(2, 1);
-  smoothResidual.Zero();
-  smoothResidual(0, 0) = cluster->getX() - smoothParameters(0, 0);
-  smoothResidual(1, 0) = cluster->getY() - smoothParameters(2, 0);
+  ROOT::Math::SVector<double, 2> smoothResidual(cluster->getX() - smoothParameters(0), cluster->getY() - smoothParameters(2));
 
   // compute weight of smoothed residual: W(k n) = (clusterCov - C(k n))^-1
-  TMatrixD smoothResidualWeight(2, 2);
+  ROOT::Math::SMatrix<double, 2, 2, ROOT::Math::MatRepSym<double, 2>> smoothResidualWeight;
   if (mUseChamberResolution) {
     smoothResidualWeight(0, 0) = mChamberResolutionX2 - smoothCovariances(0, 0);
     smoothResidualWeight(1, 1) = mChamberResolutionY2 - smoothCovariances(2, 2);
@@ -371,17 +341,12 @@ void TrackFitter::runSmoother(const TrackParam& previousParam, TrackParam& param
     smoothResidualWeight(1, 1) = cluster->getEy2() - smoothCovariances(2, 2);
   }
   smoothResidualWeight(0, 1) = -smoothCovariances(0, 2);
-  smoothResidualWeight(1, 0) = -smoothCovariances(2, 0);
-  if (smoothResidualWeight.Determinant() != 0) {
-    smoothResidualWeight.Invert();
-  } else {
+  if (!smoothResidualWeight.Invert()) {
     throw runtime_error("Determinant = 0");
   }
 
   // compute local chi2 = (r(k n))^t * W(k n) * r(k n)
-  TMatrixD tmpChi2(smoothResidual, TMatrixD::kTransposeMult, smoothResidualWeight); // (r(k n))^t * W(k n)
-  TMatrixD localChi2(tmpChi2, TMatrixD::kMult, smoothResidual);                     // (r(k n))^t * W(k n) * r(k n)
-  param.setLocalChi2(localChi2(0, 0));
+  param.setLocalChi2(ROOT::Math::Similarity(smoothResidual, smoothResidualWeight));
 }
 
 } // namespace mch
@@ -47,128 +47,16 @@ TrackParam::TrackParam(Double_t z, const Double_t param[5], const Double_t cov[1
   setCovariances(cov);
 }
 
-//_________________________________________________________________________
-TrackParam::TrackParam(const TrackParam& tp)
-  : mZ(tp.mZ),
-    mParameters(tp.mParameters),
-    mClusterPtr(tp.mClusterPtr),
-    mRemovable(tp.mRemovable),
-    mTrackChi2(tp.mTrackChi2),
-    mLocalChi2(tp.mLocalChi2)
-{
-  /// Copy constructor
-  if (tp.mCovariances) {
-    mCovariances = std::make_unique<TMatrixD>(*(tp.mCovariances));
-  }
-  if (tp.mPropagator) {
-    mPropagator = std::make_unique<TMatrixD>(*(tp.mPropagator));
-  }
-  if (tp.mExtrapParameters) {
-    mExtrapParameters = std::make_unique<TMatrixD>(*(tp.mExtrapParameters));
-  }
-  if (tp.mExtrapCovariances) {
-    mExtrapCovariances = std::make_unique<TMatrixD>(*(tp.mExtrapCovariances));
-  }
-  if (tp.mSmoothParameters) {
-    mSmoothParameters = std::make_unique<TMatrixD>(*(tp.mSmoothParameters));
-  }
-  if (tp.mSmoothCovariances) {
-    mSmoothCovariances = std::make_unique<TMatrixD>(*(tp.mSmoothCovariances));
-  }
-}
-
-//_________________________________________________________________________
-TrackParam& TrackParam::operator=(const TrackParam& tp)
-{
-  /// Assignment operator
-  if (this == &tp) {
-    return *this;
-  }
-
-  mZ = tp.mZ;
-
-  mParameters = tp.mParameters;
-
-  if (tp.mCovariances) {
-    if (mCovariances) {
-      *mCovariances = *(tp.mCovariances);
-    } else {
-      mCovariances = std::make_unique<TMatrixD>(*(tp.mCovariances));
-    }
-  } else {
-    mCovariances.reset();
-  }
-
-  if (tp.mPropagator) {
-    if (mPropagator) {
-      *mPropagator = *(tp.mPropagator);
-    } else {
-      mPropagator = std::make_unique<TMatrixD>(*(tp.mPropagator));
-    }
-  } else {
-    mPropagator.reset();
-  }
-
-  if (tp.mExtrapParameters) {
-    if (mExtrapParameters) {
-      *mExtrapParameters = *(tp.mExtrapParameters);
-    } else {
-      mExtrapParameters = std::make_unique<TMatrixD>(*(tp.mExtrapParameters));
-    }
-  } else {
-    mExtrapParameters.reset();
-  }
-
-  if (tp.mExtrapCovariances) {
-    if (mExtrapCovariances) {
-      *mExtrapCovariances = *(tp.mExtrapCovariances);
-    } else {
-      mExtrapCovariances = std::make_unique<TMatrixD>(*(tp.mExtrapCovariances));
-    }
-  } else {
-    mExtrapCovariances.reset();
-  }
-
-  if (tp.mSmoothParameters) {
-    if (mSmoothParameters) {
-      *mSmoothParameters = *(tp.mSmoothParameters);
-    } else {
-      mSmoothParameters = std::make_unique<TMatrixD>(*(tp.mSmoothParameters));
-    }
-  } else {
-    mSmoothParameters.reset();
-  }
-
-  if (tp.mSmoothCovariances) {
-    if (mSmoothCovariances) {
-      *mSmoothCovariances = *(tp.mSmoothCovariances);
-    } else {
-      mSmoothCovariances = std::make_unique<TMatrixD>(*(tp.mSmoothCovariances));
-    }
-  } else {
-    mSmoothCovariances.reset();
-  }
-
-  mClusterPtr = tp.mClusterPtr;
-
-  mRemovable = tp.mRemovable;
-
-  mTrackChi2 = tp.mTrackChi2;
-  mLocalChi2 = tp.mLocalChi2;
-
-  return *this;
-}
-
 //__________________________________________________________________________
 void TrackParam::clear()
 {
-  /// clear memory
+  /// clear the covariances and the matrices used by the smoother
   deleteCovariances();
-  mPropagator.reset();
-  mExtrapParameters.reset();
-  mExtrapCovariances.reset();
-  mSmoothParameters.reset();
-  mSmoothCovariances.reset();
+  mHasPropagator = false;
+  mHasExtrapParameters = false;
+  mHasExtrapCovariances = false;
+  mHasSmoothParameters = false;
+  mHasSmoothCovariances = false;
 }
 
 //__________________________________________________________________________
@@ -176,13 +64,13 @@ Double_t TrackParam::px() const
 {
   /// return p_x from track parameters
   Double_t pZ;
-  if (TMath::Abs(mParameters(4, 0)) > 0) {
-    Double_t pYZ = TMath::Abs(1.0 / mParameters(4, 0));
-    pZ = -pYZ / (TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0))); // spectro. (z<0)
+  if (TMath::Abs(mParameters(4)) > 0) {
+    Double_t pYZ = TMath::Abs(1.0 / mParameters(4));
+    pZ = -pYZ / (TMath::Sqrt(1.0 + mParameters(3) * mParameters(3))); // spectro. (z<0)
   } else {
-    pZ = -FLT_MAX / TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0) + mParameters(1, 0) * mParameters(1, 0));
+    pZ = -FLT_MAX / TMath::Sqrt(1.0 + mParameters(3) * mParameters(3) + mParameters(1) * mParameters(1));
   }
-  return pZ * mParameters(1, 0);
+  return pZ * mParameters(1);
 }
 
 //__________________________________________________________________________
@@ -190,24 +78,24 @@ Double_t TrackParam::py() const
 {
   /// return p_y from track parameters
   Double_t pZ;
-  if (TMath::Abs(mParameters(4, 0)) > 0) {
-    Double_t pYZ = TMath::Abs(1.0 / mParameters(4, 0));
-    pZ = -pYZ / (TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0))); // spectro. (z<0)
+  if (TMath::Abs(mParameters(4)) > 0) {
+    Double_t pYZ = TMath::Abs(1.0 / mParameters(4));
+    pZ = -pYZ / (TMath::Sqrt(1.0 + mParameters(3) * mParameters(3))); // spectro. (z<0)
   } else {
-    pZ = -FLT_MAX / TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0) + mParameters(1, 0) * mParameters(1, 0));
+    pZ = -FLT_MAX / TMath::Sqrt(1.0 + mParameters(3) * mParameters(3) + mParameters(1) * mParameters(1));
   }
-  return pZ * mParameters(3, 0);
+  return pZ * mParameters(3);
 }
 
 //__________________________________________________________________________
 Double_t TrackParam::pz() const
 {
   /// return p_z from track parameters
-  if (TMath::Abs(mParameters(4, 0)) > 0) {
-    Double_t pYZ = TMath::Abs(1.0 / mParameters(4, 0));
-    return -pYZ / (TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0))); // spectro. (z<0)
+  if (TMath::Abs(mParameters(4)) > 0) {
+    Double_t pYZ = TMath::Abs(1.0 / mParameters(4));
+    return -pYZ / (TMath::Sqrt(1.0 + mParameters(3) * mParameters(3))); // spectro. (z<0)
   } else {
-    return -FLT_MAX / TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0) + mParameters(1, 0) * mParameters(1, 0));
+    return -FLT_MAX / TMath::Sqrt(1.0 + mParameters(3) * mParameters(3) + mParameters(1) * mParameters(1));
   }
 }
 
@@ -215,35 +103,32 @@ Double_t TrackParam::pz() const
 Double_t TrackParam::p() const
 {
   /// return p from track parameters
-  if (TMath::Abs(mParameters(4, 0)) > 0) {
-    Double_t pYZ = TMath::Abs(1.0 / mParameters(4, 0));
-    Double_t pZ = -pYZ / (TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0))); // spectro. (z<0)
-    return -pZ * TMath::Sqrt(1.0 + mParameters(3, 0) * mParameters(3, 0) + mParameters(1, 0) * mParameters(1, 0));
+  if (TMath::Abs(mParameters(4)) > 0) {
+    Double_t pYZ = TMath::Abs(1.0 / mParameters(4));
+    Double_t pZ = -pYZ / (TMath::Sqrt(1.0 + mParameters(3) * mParameters(3))); // spectro. (z<0)
+    return -pZ * TMath::Sqrt(1.0 + mParameters(3) * mParameters(3) + mParameters(1) * mParameters(1));
   } else {
     return FLT_MAX;
   }
 }
 
 //__________________________________________________________________________
-const TMatrixD& TrackParam::getCovariances() const
+const SMatrix55Sym& TrackParam::getCovariances() const
 {
   /// Return the covariance matrix (create it before if needed)
-  if (!mCovariances) {
-    mCovariances = std::make_unique<TMatrixD>(5, 5);
-    mCovariances->Zero();
+  if (!mHasCovariances) {
+    mCovariances = SMatrix55Sym();
+    mHasCovariances = true;
   }
-  return *mCovariances;
+  return mCovariances;
 }
 
 //__________________________________________________________________________
-void TrackParam::setCovariances(const TMatrixD& covariances)
+void TrackParam::setCovariances(const SMatrix55Sym& covariances)
 {
   /// Set the covariance matrix
-  if (mCovariances) {
-    *mCovariances = covariances;
-  } else {
-    mCovariances = std::make_unique<TMatrixD>(covariances);
-  }
+  mCovariances = covariances;
+  mHasCovariances = true;
 }
 
 //__________________________________________________________________________
@@ -255,14 +140,12 @@ void TrackParam::setCovariances(const Double_t covariances[15])
   /// [3] = <Y,X>       [4] = <Y,SlopeX>       [5] = <Y,Y>
   /// [6] = <SlopeY,X>  [7] = <SlopeY,SlopeX>  [8] = <SlopeY,Y>  [9] = <SlopeY,SlopeY>
   /// [10]= <q/pYZ,X>   [11]= <q/pYZ,SlopeX>   [12]= <q/pYZ,Y>   [13]= <q/pYZ,SlopeY>   [14]= <q/pYZ,q/pYZ> </pre>
-  if (!mCovariances) {
-    mCovariances = std::make_unique<TMatrixD>(5, 5);
-  }
   for (Int_t i = 0; i < 5; i++) {
     for (Int_t j = 0; j <= i; j++) {
-      (*mCovariances)(i, j) = (*mCovariances)(j, i) = covariances[i * (i + 1) / 2 + j];
+      mCovariances(i, j) = covariances[i * (i + 1) / 2 + j];
     }
   }
+  mHasCovariances = true;
 }
 
 //__________________________________________________________________________
@@ -275,139 +158,126 @@ void TrackParam::setVariances(const Double_t covariances[15])
   /// [6] = <SlopeY,X>  [7] = <SlopeY,SlopeX>  [8] = <SlopeY,Y>  [9] = <SlopeY,SlopeY>
   /// [10]= <q/pYZ,X>   [11]= <q/pYZ,SlopeX>   [12]= <q/pYZ,Y>   [13]= <q/pYZ,SlopeY>   [14]= <q/pYZ,q/pYZ> </pre>
   static constexpr int varIdx[5] = {0, 2, 5, 9, 14};
-  if (!mCovariances) {
-    mCovariances = std::make_unique<TMatrixD>(5, 5);
-  }
-  mCovariances->Zero();
+  mCovariances = SMatrix55Sym();
   for (Int_t i = 0; i < 5; i++) {
-    (*mCovariances)(i, i) = covariances[varIdx[i]];
+    mCovariances(i, i) = covariances[varIdx[i]];
   }
+  mHasCovariances = true;
 }
 
 //__________________________________________________________________________
 void TrackParam::deleteCovariances()
 {
   /// Delete the covariance matrix
-  mCovariances.reset();
+  mHasCovariances = false;
 }
 
 //__________________________________________________________________________
-const TMatrixD& TrackParam::getPropagator() const
+const SMatrix55Std& TrackParam::getPropagator() const
 {
   /// Return the propagator (create it before if needed)
-  if (!mPropagator) {
-    mPropagator = std::make_unique<TMatrixD>(5, 5);
-    mPropagator->UnitMatrix();
+  if (!mHasPropagator) {
+    mPropagator = ROOT::Math::SMatrixIdentity();
+    mHasPropagator = true;
   }
-  return *mPropagator;
+  return mPropagator;
 }
 
 //__________________________________________________________________________
 void TrackParam::resetPropagator()
 {
   /// Reset the propagator
-  if (mPropagator) {
-    mPropagator->UnitMatrix();
+  if (mHasPropagator) {
+    mPropagator = ROOT::Math::SMatrixIdentity();
   }
 }
 
 //__________________________________________________________________________
-void TrackParam::updatePropagator(const TMatrixD& propagator)
+void TrackParam::updatePropagator(const SMatrix55Std& propagator)
 {
   /// Update the propagator
-  if (mPropagator) {
-    *mPropagator = TMatrixD(propagator, TMatrixD::kMult, *mPropagator);
+  if (mHasPropagator) {
+    mPropagator = propagator * mPropagator;
   } else {
-    mPropagator = std::make_unique<TMatrixD>(propagator);
+    mPropagator = propagator;
+    mHasPropagator = true;
   }
 }
 
 //__________________________________________________________________________
-const TMatrixD& TrackParam::getExtrapParameters() const
+const SMatrix5& TrackParam::getExtrapParameters() const
 {
   /// Return extrapolated parameters (create it before if needed)
-  if (!mExtrapParameters) {
-    mExtrapParameters = std::make_unique<TMatrixD>(5, 1);
-    mExtrapParameters->Zero();
+  if (!mHasExtrapParameters) {
+    mExtrapParameters = SMatrix5();
+    mHasExtrapParameters = true;
   }
-  return *mExtrapParameters;
+  return mExtrapParameters;
 }
 
 //__________________________________________________________________________
-void TrackParam::setExtrapParameters(const TMatrixD& extrapParameters)
+void TrackParam::setExtrapParameters(const SMatrix5& extrapParameters)
 {
   /// Set extrapolated parameters
-  if (mExtrapParameters) {
-    *mExtrapParameters = extrapParameters;
-  } else {
-    mExtrapParameters = std::make_unique<TMatrixD>(extrapParameters);
-  }
+  mExtrapParameters = extrapParameters;
+  mHasExtrapParameters = true;
 }
 
 //__________________________________________________________________________
-const TMatrixD& TrackParam::getExtrapCovariances() const
+const SMatrix55Sym& TrackParam::getExtrapCovariances() const
 {
   /// Return the extrapolated covariance matrix (create it before if needed)
-  if (!mExtrapCovariances) {
-    mExtrapCovariances = std::make_unique<TMatrixD>(5, 5);
-    mExtrapCovariances->Zero();
+  if (!mHasExtrapCovariances) {
+    mExtrapCovariances = SMatrix55Sym();
+    mHasExtrapCovariances = true;
   }
-  return *mExtrapCovariances;
+  return mExtrapCovariances;
 }
 
 //__________________________________________________________________________
-void TrackParam::setExtrapCovariances(const TMatrixD& extrapCovariances)
+void TrackParam::setExtrapCovariances(const SMatrix55Sym& extrapCovariances)
 {
   /// Set the extrapolated covariance matrix
-  if (mExtrapCovariances) {
-    *mExtrapCovariances = extrapCovariances;
-  } else {
-    mExtrapCovariances = std::make_unique<TMatrixD>(extrapCovariances);
-  }
+  mExtrapCovariances = extrapCovariances;
+  mHasExtrapCovariances = true;
 }
 
 //__________________________________________________________________________
-const TMatrixD& TrackParam::getSmoothParameters() const
+const SMatrix5& TrackParam::getSmoothParameters() const
 {
   /// Return the smoothed parameters (create it before if needed)
-  if (!mSmoothParameters) {
-    mSmoothParameters = std::make_unique<TMatrixD>(5, 1);
-    mSmoothParameters->Zero();
+  if (!mHasSmoothParameters) {
+    mSmoothParameters = SMatrix5();
+    mHasSmoothParameters = true;
   }
-  return *mSmoothParameters;
+  return mSmoothParameters;
 }
 
 //__________________________________________________________________________
-void TrackParam::setSmoothParameters(const TMatrixD& smoothParameters)
+void TrackParam::setSmoothParameters(const SMatrix5& smoothParameters)
 {
   /// Set the smoothed parameters
-  if (mSmoothParameters) {
-    *mSmoothParameters = smoothParameters;
-  } else {
-    mSmoothParameters = std::make_unique<TMatrixD>(smoothParameters);
-  }
+  mSmoothParameters = smoothParameters;
+  mHasSmoothParameters = true;
 }
 
 //__________________________________________________________________________
-const TMatrixD& TrackParam::getSmoothCovariances() const
+const SMatrix55Sym& TrackParam::getSmoothCovariances() const
 {
   /// Return the smoothed covariance matrix (create it before if needed)
-  if (!mSmoothCovariances) {
-    mSmoothCovariances = std::make_unique<TMatrixD>(5, 5);
-    mSmoothCovariances->Zero();
+  if (!mHasSmoothCovariances) {
+    mSmoothCovariances = SMatrix55Sym();
+    mHasSmoothCovariances = true;
   }
-  return *mSmoothCovariances;
+  return mSmoothCovariances;
 }
 
 //__________________________________________________________________________
-void TrackParam::setSmoothCovariances(const TMatrixD& smoothCovariances)
+void TrackParam::setSmoothCovariances(const SMatrix55Sym& smoothCovariances)
 {
   /// Set the smoothed covariance matrix
-  if (mSmoothCovariances) {
-    *mSmoothCovariances = smoothCovariances;
-  } else {
-    mSmoothCovariances = std::make_unique<TMatrixD>(smoothCovariances);
-  }
+  mSmoothCovariances = smoothCovariances;
+  mHasSmoothCovariances = true;
 }
 
 //__________________________________________________________________________
@@ -422,7 +292,7 @@ Bool_t TrackParam::isCompatibleTrackParam(const TrackParam& trackParam, Double_t
   chi2 = 0.;
 
   // ckeck covariance matrices
-  if (!mCovariances && !trackParam.mCovariances) {
+  if (!mHasCovariances && !trackParam.mHasCovariances) {
     LOG(error) << "Covariance matrix must exist for at least one set of parameters";
     return kFALSE;
   }
@@ -436,30 +306,25 @@ Bool_t TrackParam::isCompatibleTrackParam(const TrackParam& trackParam, Double_t
   }
 
   // compute the parameter residuals
-  TMatrixD deltaParam(mParameters, TMatrixD::kMinus, trackParam.mParameters);
+  SMatrix5 deltaParam = mParameters - trackParam.mParameters;
 
   // build the error matrix
-  TMatrixD weight(5, 5);
-  if (mCovariances) {
-    weight += *mCovariances;
+  SMatrix55Sym weight;
+  if (mHasCovariances) {
+    weight += mCovariances;
   }
-  if (trackParam.mCovariances) {
-    weight += *(trackParam.mCovariances);
+  if (trackParam.mHasCovariances) {
+    weight += trackParam.mCovariances;
   }
 
   // invert the error matrix to get the parameter weights if possible
-  if (weight.Determinant() == 0) {
+  if (!weight.Invert()) {
     LOG(error) << "Cannot compute the compatibility chi2";
     return kFALSE;
   }
-  weight.Invert();
 
   // compute the compatibility chi2
-  TMatrixD tmp(deltaParam, TMatrixD::kTransposeMult, weight);
-  TMatrixD mChi2(tmp, TMatrixD::kMult, deltaParam);
-
-  // set chi2 value
-  chi2 = mChi2(0, 0);
+  chi2 = ROOT::Math::Similarity(deltaParam, weight);
 
   // check compatibility
   if (chi2 > maxChi2) {
@@ -491,10 +356,10 @@ TrackParamStruct TrackParam::getTrackParamStruct() const
 void TrackParam::print() const
 {
   /// Printing TrackParam informations
-  cout << "<TrackParam> Bending P=" << setw(5) << setprecision(3) << 1. / mParameters(4, 0)
-       << ", NonBendSlope=" << setw(5) << setprecision(3) << mParameters(1, 0) * 180. / TMath::Pi()
-       << ", BendSlope=" << setw(5) << setprecision(3) << mParameters(3, 0) * 180. / TMath::Pi() << ", (x,y,z)_IP=("
-       << setw(5) << setprecision(3) << mParameters(0, 0) << "," << setw(5) << setprecision(3) << mParameters(2, 0)
+  cout << "<TrackParam> Bending P=" << setw(5) << setprecision(3) << 1. / mParameters(4)
+       << ", NonBendSlope=" << setw(5) << setprecision(3) << mParameters(1) * 180. / TMath::Pi()
+       << ", BendSlope=" << setw(5) << setprecision(3) << mParameters(3) * 180. / TMath::Pi() << ", (x,y,z)_IP=("
+       << setw(5) << setprecision(3) << mParameters(0) << "," << setw(5) << setprecision(3) << mParameters(2)
        << "," << setw(5) << setprecision(3) << mZ << ") cm, (px,py,pz)=(" << setw(5) << setprecision(3) << px() << ","
        << setw(5) << setprecision(3) << py() << "," << setw(5) << setprecision(3) << pz() << ") GeV/c, "
        << "local chi2=" << getLocalChi2() << endl;
@@ -0,0 +1,348 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTrackFitter.cxx
+/// \brief this task tests that the track extrapolation, the Kalman filter and the smoother computed with the fixed-size
+/// SMatrix give the same parameters, covariances and chi2 as the former computation with TMatrixD, on fixed clusters
+
+#define BOOST_TEST_MODULE Test MCH TrackFitter
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include <TMath.h>
+#include <TMatrixD.h>
+#include "DataFormatsMCH/Cluster.h"
+#include "MCHTracking/Track.h"
+#include "MCHTracking/TrackExtrap.h"
+#include "MCHTracking/TrackFitter.h"
+
+namespace o2::mch
+{
+
+/// tolerance on the differences, relative to the parameter errors for the parameters and covariances
+static constexpr double Tolerance = 1.e-8;
+
+/// z position and thickness in X0 of the chambers, as in TrackFitter
+static constexpr double ChamberZ[10] = {-526.16, -545.24, -676.4, -695.4, -967.5,
+                                        -998.5, -1276.5, -1307.5, -1406.6, -1437.6};
+static constexpr double ChamberThicknessInX0[10] = {0.065, 0.065, 0.075, 0.075, 0.035,
+                                                    0.035, 0.035, 0.035, 0.035, 0.035};
+
+/// track parameters at a cluster, as stored by TrackParam before the move to SMatrix
+struct RefParam {
+  const Cluster* cluster = nullptr;
+  double z = 0.;
+  TMatrixD parameters{5, 1};
+  TMatrixD covariances{5, 5};
+  TMatrixD propagator{5, 5};
+  TMatrixD extrapParameters{5, 1};
+  TMatrixD extrapCovariances{5, 5};
+  TMatrixD smoothParameters{5, 1};
+  TMatrixD smoothCovariances{5, 5};
+  double trackChi2 = 0.;
+  double localChi2 = 0.;
+};
+
+/// clusters along a straight track, one per chamber except chamber 4, shifted by fixed residuals
+std::vector<Cluster> makeClusters()
+{
+  static constexpr double Residuals[10][2] = {{0.03, -0.01}, {-0.05, 0.02}, {0.01, 0.015}, {0.04, -0.02}, {0., 0.},
+                                              {-0.02, -0.005}, {0.06, 0.01}, {-0.03, 0.025}, {0.02, -0.015}, {-0.01, 0.005}};
+  std::vector<Cluster> clusters{};
+  for (int iCh = 0; iCh < 10; ++iCh) {
+    if (iCh == 4) {
+      continue;
+    }
+    double z = ChamberZ[iCh];
+    float x = 5. + 0.02 * z + Residuals[iCh][0];
+    float y = -3. + 0.05 * z + Residuals[iCh][1];
+    float ex = 0.1 + 0.02 * iCh;
+    float ey = 0.05 + 0.01 * iCh;
+    clusters.push_back({x, y, static_cast<float>(z), ex, ey, Cluster::buildUniqueId(iCh, 100 * (iCh + 1), iCh), 0, 0});
+  }
+  return clusters;
+}
+
+/// former TrackFitter::initTrack, without magnetic field
+void refInitTrack(const Cluster& cl1, const Cluster& cl2, RefParam& param)
+{
+  double dZ = cl1.getZ() - cl2.getZ();
+  double bendingSlope = (cl1.getY() - cl2.getY()) / dZ;
+  double bendingImpact = cl2.getY() - cl2.getZ() * bendingSlope;
+  double inverseBendingMomentum = 1. / TrackExtrap::getBendingMomentumFromImpactParam(bendingImpact);
+  param.z = cl2.getZ();
+  param.parameters(0, 0) = cl2.getX();
+  param.parameters(1, 0) = (cl1.getX() - cl2.getX()) / dZ;
+  param.parameters(2, 0) = cl2.getY();
+  param.parameters(3, 0) = bendingSlope;
+  param.parameters(4, 0) = inverseBendingMomentum;
+
+  TMatrixD& cov = param.covariances;
+  cov.Zero();
+  cov(0, 0) = cl2.getEx2();
+  cov(1, 1) = (1000. * cl1.getEx2() + cov(0, 0)) / dZ / dZ;
+  cov(2, 2) = cl2.getEy2();
+  cov(0, 1) = -cov(0, 0) / dZ;
+  cov(1, 0) = cov(0, 1);
+  cov(2, 3) = -cov(2, 2) / dZ;
+  cov(3, 2) = cov(2, 3);
+  cov(3, 3) = (1000. * cl1.getEy2() + cov(2, 2)) / dZ / dZ;
+  cov(4, 4) = inverseBendingMomentum * inverseBendingMomentum;
+
+  param.cluster = &cl2;
+  param.trackChi2 = 0.;
+}
+
+/// former TrackExtrap::addMCSEffect, without magnetic field
+void refAddMCSEffect(RefParam& param, double dZ, double x0)
+{
+  double nonBendingSlope = param.parameters(1, 0);
+  double bendingSlope = param.parameters(3, 0);
+  double inverseBendingMomentum = param.parameters(4, 0);
+  double inverseTotalMomentum2 = inverseBendingMomentum * inverseBendingMomentum * (1.0 + bendingSlope * bendingSlope) /
+                                 (1.0 + bendingSlope * bendingSlope + nonBendingSlope * nonBendingSlope);
+  double signedPathLength = dZ * TMath::Sqrt(1.0 + bendingSlope * bendingSlope + nonBendingSlope * nonBendingSlope);
+  double pathLengthOverX0 = (x0 > 0.) ? TMath::Abs(signedPathLength) / x0 : TMath::Abs(signedPathLength);
+  double theta02 = 0.0136 * (1 + 0.038 * TMath::Log(pathLengthOverX0));
+  theta02 *= theta02 * inverseTotalMomentum2 * pathLengthOverX0;
+  double varCoor = (x0 > 0.) ? signedPathLength * signedPathLength * theta02 / 3. : 0.;
+  double varSlop = theta02;
+  double covCorrSlope = (x0 > 0.) ? signedPathLength * theta02 / 2. : 0.;
+
+  TMatrixD& cov = param.covariances;
+  cov(0, 0) += varCoor;
+  cov(0, 1) += covCorrSlope;
+  cov(1, 0) += covCorrSlope;
+  cov(1, 1) += varSlop;
+  cov(2, 2) += varCoor;
+  cov(2, 3) += covCorrSlope;
+  cov(3, 2) += covCorrSlope;
+  cov(3, 3) += varSlop;
+}
+
+/// former TrackExtrap::linearExtrapToZCov, updating the propagator
+void refLinearExtrapToZCov(RefParam& param, double zEnd)
+{
+  double dZ = zEnd - param.z;
+  param.parameters(0, 0) += param.parameters(1, 0) * dZ;
+  param.parameters(2, 0) += param.parameters(3, 0) * dZ;
+  param.z = zEnd;
+
+  TMatrixD jacob(5, 5);
+  jacob.UnitMatrix();
+  jacob(0, 1) = dZ;
+  jacob(2, 3) = dZ;
+
+  TMatrixD tmp(param.covariances, TMatrixD::kMultTranspose, jacob);
+  param.covariances.Mult(jacob, tmp);
+
+  TMatrixD propagator(jacob, TMatrixD::kMult, param.propagator);
+  param.propagator = propagator;
+}
+
+/// former TrackFitter::runKalmanFilter, with the cluster resolution
+void refRunKalmanFilter(RefParam& trackParam)
+{
+  TMatrixD param(trackParam.parameters);
+
+  const Cluster* cluster = trackParam.cluster;
+  TMatrixD clusterParam(5, 1);
+  clusterParam.Zero();
+  clusterParam(0, 0) = cluster->getX();
+  clusterParam(2, 0) = cluster->getY();
+
+  TMatrixD paramWeight(trackParam.covariances);
+  BOOST_REQUIRE(paramWeight.Determinant() != 0);
+  paramWeight.Invert();
+
+  TMatrixD clusterWeight(5, 5);
+  clusterWeight.Zero();
+  clusterWeight(0, 0) = 1. / cluster->getEx2();
+  clusterWeight(2, 2) = 1. / cluster->getEy2();
+
+  TMatrixD newParamCov(paramWeight, TMatrixD::kPlus, clusterWeight);
+  BOOST_REQUIRE(newParamCov.Determinant() != 0);
+  newParamCov.Invert();
+  trackParam.covariances = newParamCov;
+
+  TMatrixD tmp(clusterParam, TMatrixD::kMinus, param);
+  TMatrixD tmp2(clusterWeight, TMatrixD::kMult, tmp);
+  TMatrixD newParam(newParamCov, TMatrixD::kMult, tmp2);
+  newParam += param;
+  trackParam.parameters = newParam;
+
+  tmp = newParam;
+  tmp -= param;
+  TMatrixD tmp3(paramWeight, TMatrixD::kMult, tmp);
+  TMatrixD addChi2Track(tmp, TMatrixD::kTransposeMult, tmp3);
+  tmp = newParam;
+  tmp -= clusterParam;
+  TMatrixD tmp4(clusterWeight, TMatrixD::kMult, tmp);
+  addChi2Track += TMatrixD(tmp, TMatrixD::kTransposeMult, tmp4);
+  trackParam.trackChi2 += addChi2Track(0, 0);
+}
+
+/// former TrackFitter::addCluster, with the smoother enabled
+void refAddCluster(const RefParam& startingParam, const Cluster& cl, RefParam& param)
+{
+  param.parameters = startingParam.parameters;
+  param.z = startingParam.z;
+  param.covariances = startingParam.covariances;
+  param.trackChi2 = startingParam.trackChi2;
+
+  int currentChamber(startingParam.cluster->getChamberId());
+  refAddMCSEffect(param, ChamberThicknessInX0[currentChamber], -1.);
+
+  param.propagator.UnitMatrix();
+
+  int expectedChamber(currentChamber - 1);
+  currentChamber = cl.getChamberId();
+  while (currentChamber < expectedChamber) {
+    refLinearExtrapToZCov(param, ChamberZ[expectedChamber]);
+    refAddMCSEffect(param, ChamberThicknessInX0[expectedChamber], -1.);
+    expectedChamber--;
+  }
+
+  refLinearExtrapToZCov(param, cl.getZ());
+
+  param.extrapParameters = param.parameters;
+  param.extrapCovariances = param.covariances;
+
+  param.cluster = &cl;
+  refRunKalmanFilter(param);
+}
+
+/// former TrackFitter::runSmoother, with the cluster resolution
+void refRunSmoother(const RefParam& previousParam, RefParam& param)
+{
+  const TMatrixD& extrapParameters = previousParam.extrapParameters;
+  const TMatrixD& filteredParameters = param.parameters;
+  const TMatrixD& previousSmoothParameters = previousParam.smoothParameters;
+  const TMatrixD& propagator = previousParam.propagator;
+  const TMatrixD& extrapCovariances = previousParam.extrapCovariances;
+  const TMatrixD& filteredCovariances = param.covariances;
+  const TMatrixD& previousSmoothCovariances = previousParam.smoothCovariances;
+
+  TMatrixD extrapWeight(extrapCovariances);
+  BOOST_REQUIRE(extrapWeight.Determinant() != 0);
+  extrapWeight.Invert();
+  TMatrixD smootherGain(filteredCovariances, TMatrixD::kMultTranspose, propagator);
+  smootherGain *= extrapWeight;
+
+  TMatrixD tmpParam(previousSmoothParameters, TMatrixD::kMinus, extrapParameters);
+  TMatrixD smoothParameters(smootherGain, TMatrixD::kMult, tmpParam);
+  smoothParameters += filteredParameters;
+  param.smoothParameters = smoothParameters;
+
+  TMatrixD tmpCov(previousSmoothCovariances, TMatrixD::kMinus, extrapCovariances);
+  TMatrixD tmpCov2(tmpCov, TMatrixD::kMultTranspose, smootherGain);
+  TMatrixD smoothCovariances(smootherGain, TMatrixD::kMult, tmpCov2);
+  smoothCovariances += filteredCovariances;
+  param.smoothCovariances = smoothCovariances;
+
+  const Cluster* cluster = param.cluster;
+  TMatrixD smoothResidual(2, 1);
+  smoothResidual(0, 0) = cluster->getX() - smoothParameters(0, 0);
+  smoothResidual(1, 0) = cluster->getY() - smoothParameters(2, 0);
+
+  TMatrixD smoothResidualWeight(2, 2);
+  smoothResidualWeight(0, 0) = cluster->getEx2() - smoothCovariances(0, 0);
+  smoothResidualWeight(1, 1) = cluster->getEy2() - smoothCovariances(2, 2);
+  smoothResidualWeight(0, 1) = -smoothCovariances(0, 2);
+  smoothResidualWeight(1, 0) = -smoothCovariances(2, 0);
+  BOOST_REQUIRE(smoothResidualWeight.Determinant() != 0);
+  smoothResidualWeight.Invert();
+
+  TMatrixD tmpChi2(smoothResidual, TMatrixD::kTransposeMult, smoothResidualWeight);
+  TMatrixD localChi2(tmpChi2, TMatrixD::kMult, smoothResidual);
+  param.localChi2 = localChi2(0, 0);
+}
+
+/// former TrackFitter::fit of the whole track followed by the smoother, the clusters being ordered upstream first
+std::vector<RefParam> refFit(const std::vector<Cluster>& clusters)
+{
+  std::vector<RefParam> params(clusters.size());
+  int last = clusters.size() - 1;
+  refInitTrack(clusters[last - 1], clusters[last], params[last]);
+  for (int i = last - 1; i >= 0; --i) {
+    refAddCluster(params[i + 1], clusters[i], params[i]);
+  }
+
+  params[0].smoothParameters = params[0].parameters;
+  params[0].smoothCovariances = params[0].covariances;
+  params[0].localChi2 = params[0].trackChi2 - params[1].trackChi2;
+  for (int i = 1; i <= last; ++i) {
+    refRunSmoother(params[i - 1], params[i]);
+  }
+  return params;
+}
+
+/// check the parameters, each within the tolerance times its error
+void checkParameters(const SMatrix5& param, const TMatrixD& refParam, const TMatrixD& refCov)
+{
+  for (int i = 0; i < 5; ++i) {
+    BOOST_TEST_INFO("parameter " << i);
+    BOOST_CHECK_LE(std::abs(param(i) - refParam(i, 0)), Tolerance * std::sqrt(refCov(i, i)));
+  }
+}
+
+/// check the covariances, each within the tolerance times the product of the corresponding errors
+void checkCovariances(const SMatrix55Sym& cov, const TMatrixD& refCov)
+{
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      BOOST_TEST_INFO("covariance " << i << " " << j);
+      BOOST_CHECK_LE(std::abs(cov(i, j) - refCov(i, j)), Tolerance * std::sqrt(refCov(i, i) * refCov(j, j)));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TrackFitterMatchesTMatrixD)
+{
+  BOOST_REQUIRE(!TrackExtrap::isFieldON());
+
+  const auto clusters = makeClusters();
+  const auto ref = refFit(clusters);
+
+  Track track;
+  for (const auto& cluster : clusters) {
+    track.createParamAtCluster(cluster);
+  }
+  TrackFitter fitter;
+  fitter.smoothTracks(true);
+  fitter.fit(track, true, false);
+
+  const int last = ref.size() - 1;
+  BOOST_REQUIRE_EQUAL(track.getNClusters(), last + 1);
+  int i = 0;
+  for (const auto& param : track) {
+    BOOST_TEST_CONTEXT("cluster on chamber " << clusters[i].getChamberId())
+    {
+      BOOST_REQUIRE(param.getClusterPtr() == &clusters[i]);
+      BOOST_CHECK_EQUAL(param.getZ(), ref[i].z);
+      checkParameters(param.getParameters(), ref[i].parameters, ref[i].covariances);
+      checkCovariances(param.getCovariances(), ref[i].covariances);
+      BOOST_CHECK_CLOSE_FRACTION(param.getTrackChi2(), ref[i].trackChi2, Tolerance);
+      if (i < last) {
+        checkParameters(param.getExtrapParameters(), ref[i].extrapParameters, ref[i].extrapCovariances);
+        checkCovariances(param.getExtrapCovariances(), ref[i].extrapCovariances);
+      }
+      checkParameters(param.getSmoothParameters(), ref[i].smoothParameters, ref[i].smoothCovariances);
+      checkCovariances(param.getSmoothCovariances(), ref[i].smoothCovariances);
+      BOOST_CHECK_CLOSE_FRACTION(param.getLocalChi2(), ref[i].localChi2, Tolerance);
+    }
+    ++i;
+  }
+}
+
+} // namespace o2::mch
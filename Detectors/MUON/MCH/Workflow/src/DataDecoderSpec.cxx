@@ -98,6 +98,7 @@ class DataDecoderTask
 
     mDecoder = new DataDecoder(channelHandler, rdhHandler, sampaBcOffset, mapCRUfile, mapFECfile, ds2manu, mDebug,
                                useDummyElecMap, timeRecoMode);
+    mDecoder->setNThreads(ic.options().get<int>("nthreads"));
 
     auto stop = [this]() {
       LOG(info) << "mch-data-decoder: decoding duration = " << mTimeDecoding.count() * 1000 / mTFcount << " us / TF";
@@ -129,9 +130,12 @@ class DataDecoderTask
       }
       size_t payloadSize = it.size();
 
-      gsl::span<const std::byte> buffer(reinterpret_cast<const std::byte*>(raw), sizeof(RDH) + payloadSize);
-      mDecoder->decodeBuffer(buffer);
+      mPages.emplace_back(reinterpret_cast<const std::byte*>(raw), sizeof(RDH) + payloadSize);
     }
+    // all the pages of the TF are decoded at once, such that the links can be decoded in parallel;
+    // as in decodeBuffer, the pages with an unexpected RDH size are skipped and the debug dumps are printed
+    mDecoder->decodePages(mPages);
+    mPages.clear();
   }
 
   //_________________________________________________________________________________________________
@@ -309,6 +313,7 @@ class DataDecoderTask
   bool mDummyROFs = {false};         /// flag to disable the ROFs finding
   uint32_t mFirstTForbit{0};         /// first orbit of the time frame being processed
   DataDecoder* mDecoder = {nullptr}; /// pointer to the data decoder instance
+  std::vector<Page> mPages;          /// pages of the time frame being processed
 
   uint32_t mTFcount{0};
   uint32_t mErrorLogFrequency; /// error map is logged at that frequency (use 0 to disable) (in TF unit)
@@ -348,7 +353,8 @@ o2::framework::DataProcessorSpec getDecodingSpec(const char* specName, std::stri
             {"time-reco-mode", VariantType::String, "hbpackets", {"digit time reconstruction method [hbpackets, bcreset]"}},
             {"check-rofs", VariantType::Bool, false, {"perform consistency checks on the output ROFs"}},
             {"dummy-rofs", VariantType::Bool, false, {"disable the ROFs finding algorithm"}},
-            {"error-log-frequency", VariantType::Int, 6000, {"log the error map at this frequency (in TF unit) (first TF is always logged, unless frequency is zero)"}}}};
+            {"error-log-frequency", VariantType::Int, 6000, {"log the error map at this frequency (in TF unit) (first TF is always logged, unless frequency is zero)"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads used to decode the links of a TF in parallel"}}}};
 }
 
 } // namespace raw
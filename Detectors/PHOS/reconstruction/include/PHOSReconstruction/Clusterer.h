@@ -21,6 +21,9 @@
 #include "DataFormatsPHOS/MCLabel.h"
 #include "DataFormatsPHOS/TriggerRecord.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
+#include <gsl/span>
+#include <memory>
+#include <vector>
 
 namespace o2
 {
@@ -49,9 +52,14 @@ class Clusterer
   void setBadMap(std::unique_ptr<BadChannelsMap>& m) { mBadMap = std::move(m); }
   void setCalibration(std::unique_ptr<CalibParams>& c) { mCalibParams = std::move(c); }
 
+  /// Number of threads used to process the trigger records of a TF in parallel (only with OpenMP).
+  /// The clusters are the same as with a single thread.
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
  protected:
   //Calibrate energy
-  inline float calibrate(float amp, short absId, bool isHighGain)
+  inline float calibrate(float amp, short absId, bool isHighGain) const
   {
     if (isHighGain) {
       return amp * mCalibParams->getGain(absId);
@@ -60,7 +68,7 @@ class Clusterer
     }
   }
   //Calibrate time
-  inline float calibrateT(float time, short absId, bool isHighGain)
+  inline float calibrateT(float time, short absId, bool isHighGain) const
   {
     //Calibrate time
     if (isHighGain) {
@@ -70,7 +78,14 @@ class Clusterer
     }
   }
   //Test Bad map
-  inline bool isBadChannel(short absId) { return (!mBadMap->isChannelGood(absId)); }
+  inline bool isBadChannel(short absId) const { return (!mBadMap->isChannelGood(absId)); }
+
+  // Fill the cluster elements and trigger digits of one trigger record into the internal vectors of worker
+  void fillCluElements(gsl::span<const Digit> digits, const TriggerRecord& tr, Clusterer& worker) const;
+  void fillCluElements(gsl::span<const Cell> cells, const TriggerRecord& tr, Clusterer& worker) const;
+  template <class InputType>
+  void processTriggerRecords(gsl::span<const InputType> inputs, gsl::span<const TriggerRecord> itr,
+                             std::vector<Cluster>& clusters, std::vector<CluElement>& cluel, std::vector<TriggerRecord>& trigRec);
 
   char getNumberOfLocalMax(Cluster& clu, std::vector<CluElement>& cluel);
   void evalAll(Cluster& clu, std::vector<CluElement>& cluel) const;
@@ -116,6 +131,11 @@ class Clusterer
   std::array<double, NLOCMAX> mfij;     ///< transient variable for derivative calculation
   std::vector<bool> mIsLocalMax;        ///< transient array for local max finding
   std::array<int, NLOCMAX> mMaxAt;      ///< indexes of local maxima
+
+  int mNThreads = 1;                                   ///< number of threads for the trigger records
+  std::vector<std::unique_ptr<Clusterer>> mWorkers;    ///! per-thread clusterers, keeping their internal buffers between TFs
+  std::vector<std::vector<Cluster>> mTRClusters;       ///! clusters of each trigger record, before merging
+  std::vector<std::vector<CluElement>> mTRCluElements; ///! cluster elements of each trigger record, before merging
 };
 } // namespace phos
 } // namespace o2
@@ -22,6 +22,10 @@
 
 #include "FairLogger.h" // for LOG
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::phos;
 
 ClassImp(Clusterer);
@@ -48,43 +52,8 @@ void Clusterer::process(gsl::span<const Digit> digits, gsl::span<const TriggerRe
   cluMC.clear();
   mProcessMC = (dmc != nullptr);
 
-  for (const auto& tr : dtr) {
-    int indexStart = clusters.size(); //final out list of clusters
-
-    LOG(debug) << "Starting clusteriztion digits from " << mFirstElememtInEvent << " to " << mLastElementInEvent;
-    //Convert digits to cluelements
-    int firstDigitInEvent = tr.getFirstEntry();
-    int lastDigitInEvent = firstDigitInEvent + tr.getNumberOfObjects();
-    mFirstElememtInEvent = cluelements.size();
-    mCluEl.clear();
-    mTrigger.clear();
-    for (int i = firstDigitInEvent; i < lastDigitInEvent; i++) {
-      const Digit& digitSeed = digits[i];
-      short absId = digitSeed.getAbsId();
-      if (digitSeed.isTRU()) {
-        mTrigger.emplace_back(digitSeed);
-        continue;
-      }
-      if (isBadChannel(absId)) {
-        continue;
-      }
-      float energy = calibrate(digitSeed.getAmplitude(), absId, digitSeed.isHighGain());
-      if (energy < o2::phos::PHOSSimParams::Instance().mDigitMinEnergy) {
-        continue;
-      }
-      float x = 0., z = 0.;
-      Geometry::absIdToRelPosInModule(digits[i].getAbsId(), x, z);
-      mCluEl.emplace_back(absId, digitSeed.isHighGain(), energy, calibrateT(digitSeed.getTime(), absId, digitSeed.isHighGain()),
-                          x, z, digitSeed.getLabel(), 1.);
-    }
-    mLastElementInEvent = cluelements.size();
-
-    // Collect digits to clusters
-    makeClusters(clusters, cluelements);
+  processTriggerRecords(digits, dtr, clusters, cluelements, trigRec);
 
-    LOG(debug) << "Found clusters from " << indexStart << " to " << clusters.size();
-    trigRec.emplace_back(tr.getBCData(), indexStart, clusters.size() - indexStart);
-  }
   if (mProcessMC) {
     evalLabels(clusters, cluelements, dmc, cluMC);
   }
@@ -97,51 +66,136 @@ void Clusterer::processCells(gsl::span<const Cell> cells, gsl::span<const Trigge
 {
   // Transform input Cells to digits and run standard recontruction
   clusters.clear(); //final out list of clusters
-  trigRec.clear();
+  cluelements.clear();
   cluelements.reserve(cells.size());
+  trigRec.clear();
   cluMC.clear();
   mProcessMC = (dmc != nullptr);
   miCellLabel = 0;
-  for (const auto& tr : ctr) {
-    int firstCellInEvent = tr.getFirstEntry();
-    int lastCellInEvent = firstCellInEvent + tr.getNumberOfObjects();
-    int indexStart = clusters.size(); //final out list of clusters
-    LOG(debug) << "Starting clusteriztion cells from " << firstCellInEvent << " to " << lastCellInEvent;
-    //convert cells to cluelements
-    mFirstElememtInEvent = cluelements.size();
-    mCluEl.clear();
-    mTrigger.clear();
-    for (int i = firstCellInEvent; i < lastCellInEvent; i++) {
-      const Cell c = cells[i];
-      short absId = c.getAbsId();
-      if (c.getTRU()) {
-        mTrigger.emplace_back(c.getTRUId(), c.getEnergy(), c.getTime(), 0);
-        continue;
-      }
-      if (isBadChannel(absId)) {
-        continue;
-      }
-      float energy = calibrate(c.getEnergy(), absId, c.getHighGain());
-      if (energy < o2::phos::PHOSSimParams::Instance().mDigitMinEnergy) {
-        continue;
-      }
-      float x = 0., z = 0.;
-      Geometry::absIdToRelPosInModule(absId, x, z);
-      mCluEl.emplace_back(absId, c.getHighGain(), energy, calibrateT(c.getTime(), absId, c.getHighGain()),
-                          x, z, i, 1.);
-    }
-    mLastElementInEvent = cluelements.size();
 
-    makeClusters(clusters, cluelements);
+  processTriggerRecords(cells, ctr, clusters, cluelements, trigRec);
 
-    LOG(debug) << "Found clusters from " << indexStart << " to " << clusters.size();
-    trigRec.emplace_back(tr.getBCData(), indexStart, clusters.size() - indexStart);
-  }
   if (mProcessMC) {
     evalLabels(clusters, cluelements, dmc, cluMC);
   }
 }
 //____________________________________________________________________________
+template <class InputType>
+void Clusterer::processTriggerRecords(gsl::span<const InputType> inputs, gsl::span<const TriggerRecord> itr,
+                                      std::vector<Cluster>& clusters, std::vector<CluElement>& cluelements, std::vector<TriggerRecord>& trigRec)
+{
+  int ntr = itr.size();
+  if (mNThreads < 2 || ntr < 2) {
+    for (const auto& tr : itr) {
+      int indexStart = clusters.size(); //final out list of clusters
+      LOG(debug) << "Starting clusteriztion from " << tr.getFirstEntry() << " to " << tr.getFirstEntry() + tr.getNumberOfObjects();
+      mFirstElememtInEvent = cluelements.size();
+      fillCluElements(inputs, tr, *this);
+      mLastElementInEvent = cluelements.size();
+
+      // Collect digits to clusters
+      makeClusters(clusters, cluelements);
+
+      LOG(debug) << "Found clusters from " << indexStart << " to " << clusters.size();
+      trigRec.emplace_back(tr.getBCData(), indexStart, clusters.size() - indexStart);
+    }
+    return;
+  }
+
+  // Trigger records are independent: each thread clusterizes whole trigger records with its own
+  // clusterer (i.e. its own transient buffers) into per-record vectors, which are then merged in order.
+  while (int(mWorkers.size()) < mNThreads) {
+    mWorkers.emplace_back(std::make_unique<Clusterer>());
+    mWorkers.back()->mPHOSGeom = mPHOSGeom;
+  }
+  if (int(mTRClusters.size()) < ntr) {
+    mTRClusters.resize(ntr);
+    mTRCluElements.resize(ntr);
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < ntr; i++) {
+    int iThread = 0;
+#ifdef WITH_OPENMP
+    iThread = omp_get_thread_num();
+#endif
+    auto& worker = *mWorkers[iThread];
+    mTRClusters[i].clear();
+    mTRCluElements[i].clear();
+    fillCluElements(inputs, itr[i], worker);
+    worker.makeClusters(mTRClusters[i], mTRCluElements[i]);
+  }
+  for (int i = 0; i < ntr; i++) {
+    int indexStart = clusters.size();
+    uint32_t offset = cluelements.size();
+    for (auto& clu : mTRClusters[i]) {
+      clu.setFirstCluEl(clu.getFirstCluEl() + offset);
+      clu.setLastCluEl(clu.getLastCluEl() + offset);
+    }
+    clusters.insert(clusters.end(), mTRClusters[i].begin(), mTRClusters[i].end());
+    cluelements.insert(cluelements.end(), mTRCluElements[i].begin(), mTRCluElements[i].end());
+    LOG(debug) << "Found clusters from " << indexStart << " to " << clusters.size();
+    trigRec.emplace_back(itr[i].getBCData(), indexStart, clusters.size() - indexStart);
+  }
+}
+//____________________________________________________________________________
+void Clusterer::fillCluElements(gsl::span<const Digit> digits, const TriggerRecord& tr, Clusterer& worker) const
+{
+  //Convert digits to cluelements
+  int firstDigitInEvent = tr.getFirstEntry();
+  int lastDigitInEvent = firstDigitInEvent + tr.getNumberOfObjects();
+  worker.mCluEl.clear();
+  worker.mTrigger.clear();
+  for (int i = firstDigitInEvent; i < lastDigitInEvent; i++) {
+    const Digit& digitSeed = digits[i];
+    short absId = digitSeed.getAbsId();
+    if (digitSeed.isTRU()) {
+      worker.mTrigger.emplace_back(digitSeed);
+      continue;
+    }
+    if (isBadChannel(absId)) {
+      continue;
+    }
+    float energy = calibrate(digitSeed.getAmplitude(), absId, digitSeed.isHighGain());
+    if (energy < o2::phos::PHOSSimParams::Instance().mDigitMinEnergy) {
+      continue;
+    }
+    float x = 0., z = 0.;
+    Geometry::absIdToRelPosInModule(digits[i].getAbsId(), x, z);
+    worker.mCluEl.emplace_back(absId, digitSeed.isHighGain(), energy, calibrateT(digitSeed.getTime(), absId, digitSeed.isHighGain()),
+                               x, z, digitSeed.getLabel(), 1.);
+  }
+}
+//____________________________________________________________________________
+void Clusterer::fillCluElements(gsl::span<const Cell> cells, const TriggerRecord& tr, Clusterer& worker) const
+{
+  //convert cells to cluelements
+  int firstCellInEvent = tr.getFirstEntry();
+  int lastCellInEvent = firstCellInEvent + tr.getNumberOfObjects();
+  worker.mCluEl.clear();
+  worker.mTrigger.clear();
+  for (int i = firstCellInEvent; i < lastCellInEvent; i++) {
+    const Cell c = cells[i];
+    short absId = c.getAbsId();
+    if (c.getTRU()) {
+      worker.mTrigger.emplace_back(c.getTRUId(), c.getEnergy(), c.getTime(), 0);
+      continue;
+    }
+    if (isBadChannel(absId)) {
+      continue;
+    }
+    float energy = calibrate(c.getEnergy(), absId, c.getHighGain());
+    if (energy < o2::phos::PHOSSimParams::Instance().mDigitMinEnergy) {
+      continue;
+    }
+    float x = 0., z = 0.;
+    Geometry::absIdToRelPosInModule(absId, x, z);
+    worker.mCluEl.emplace_back(absId, c.getHighGain(), energy, calibrateT(c.getTime(), absId, c.getHighGain()),
+                               x, z, i, 1.);
+  }
+}
+//____________________________________________________________________________
 void Clusterer::makeClusters(std::vector<Cluster>& clusters, std::vector<CluElement>& cluelements)
 {
   // A cluster is defined as a list of neighbour digits (as defined in Geometry::areNeighbours)
@@ -253,11 +307,10 @@ void Clusterer::unfoldOneCluster(Cluster& iniClu, char nMax, std::vector<Cluster
   // Take initial cluster and calculate local coordinates of digits
   // To avoid multiple re-calculation of same parameters
   short mult = iniClu.getMultiplicity();
-  std::vector<std::vector<float>> eInClusters(mult, std::vector<float>(nMax));
   uint32_t firstCE = iniClu.getFirstCluEl();
   uint32_t lastCE = iniClu.getLastCluEl();
 
-  mProp.reserve(mult * nMax);
+  mProp.resize(mult * nMax);
 
   for (int iclu = nMax; iclu--;) {
     CluElement& ce = cluelements[mMaxAt[iclu]];
@@ -266,6 +319,10 @@ void Clusterer::unfoldOneCluster(Cluster& iniClu, char nMax, std::vector<Cluster
     meMax[iclu] = ce.energy;
     mxMaxPrev[iclu] = mxMax[iclu];
     mzMaxPrev[iclu] = mzMax[iclu];
+    mdx[iclu] = 0.;
+    mdz[iclu] = 0.;
+    mdxprev[iclu] = 0.; // each minimization starts without memory of the previous cluster
+    mdzprev[iclu] = 0.;
   }
 
   TMatrixDSym B(nMax);
@@ -281,7 +338,6 @@ void Clusterer::unfoldOneCluster(Cluster& iniClu, char nMax, std::vector<Cluster
     insuficientAccuracy = false; // will be true if at least one parameter changed too much
     B.Zero();
     C.Zero();
-    mProp.clear();
     double chi2 = 0.;
     for (int iclu = nMax; iclu--;) {
       mA[iclu] = 0;
@@ -379,7 +435,6 @@ void Clusterer::unfoldOneCluster(Cluster& iniClu, char nMax, std::vector<Cluster
     int start = cluelements.size();
     int nce = 0;
     for (int idig = firstCE; idig < lastCE; idig++) {
-      float eDigit = eInClusters[idig - firstCE][iclu];
       CluElement& el = cluelements[idig];
       float ei = el.energy * mProp[(idig - firstCE) * nMax + iclu];
       if (ei > o2::phos::PHOSSimParams::Instance().mDigitMinEnergy) {
@@ -0,0 +1,129 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PHOS Clusterer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+#include "PHOSReconstruction/Clusterer.h"
+#include "PHOSBase/Geometry.h"
+#include "DataFormatsPHOS/Cluster.h"
+#include "DataFormatsPHOS/Digit.h"
+
+using namespace o2::phos;
+
+namespace
+{
+struct Output {
+  std::vector<Cluster> clusters;
+  std::vector<CluElement> cluElements;
+  std::vector<TriggerRecord> trigRecs;
+  o2::dataformats::MCTruthContainer<MCLabel> mc;
+};
+
+/// overlapping electromagnetic-like showers in several modules for each trigger record
+void makeDigits(int nTR, std::vector<Digit>& digits, std::vector<TriggerRecord>& trigRecs)
+{
+  std::mt19937 eng(42);
+  std::uniform_int_distribution<int> module(2, 4), ix(3, 62), iz(3, 54), nShowers(0, 12);
+  std::uniform_real_distribution<float> ampl(40., 2000.), time(-20.e-9, 20.e-9);
+  for (int itr = 0; itr < nTR; itr++) {
+    std::map<short, float> cells; // sorted by absId, as the clusterer expects
+    for (int is = nShowers(eng); is--;) {
+      char relId[3] = {char(module(eng)), char(ix(eng)), char(iz(eng))};
+      float a = ampl(eng);
+      for (int dx = -2; dx <= 2; dx++) {
+        for (int dz = -2; dz <= 2; dz++) {
+          char cellId[3] = {relId[0], char(relId[1] + dx), char(relId[2] + dz)};
+          short absId;
+          Geometry::relToAbsNumbering(cellId, absId);
+          cells[absId] += a * std::exp(-0.8f * (dx * dx + dz * dz));
+        }
+      }
+    }
+    int first = digits.size();
+    for (const auto& [absId, a] : cells) {
+      digits.emplace_back(absId, a, time(eng), -1);
+    }
+    trigRecs.emplace_back(o2::InteractionRecord(100, itr + 1), first, digits.size() - first);
+  }
+}
+
+Output runClusterer(int nThreads, const std::vector<Digit>& digits, const std::vector<TriggerRecord>& trigRecs)
+{
+  Clusterer clusterer;
+  std::unique_ptr<BadChannelsMap> badMap = std::make_unique<BadChannelsMap>(1);
+  std::unique_ptr<CalibParams> calib = std::make_unique<CalibParams>(1);
+  clusterer.setBadMap(badMap);
+  clusterer.setCalibration(calib);
+  clusterer.setNThreads(nThreads);
+  clusterer.initialize();
+  Output out;
+  // twice, to check also the buffers kept between TFs
+  for (int i = 0; i < 2; i++) {
+    clusterer.process(digits, trigRecs, nullptr, out.clusters, out.cluElements, out.trigRecs, out.mc);
+  }
+  return out;
+}
+
+void checkSame(const Output& ref, const Output& res)
+{
+  BOOST_REQUIRE_EQUAL(ref.trigRecs.size(), res.trigRecs.size());
+  for (size_t i = 0; i < ref.trigRecs.size(); i++) {
+    BOOST_CHECK(ref.trigRecs[i].getBCData() == res.trigRecs[i].getBCData());
+    BOOST_CHECK_EQUAL(ref.trigRecs[i].getFirstEntry(), res.trigRecs[i].getFirstEntry());
+    BOOST_CHECK_EQUAL(ref.trigRecs[i].getNumberOfObjects(), res.trigRecs[i].getNumberOfObjects());
+  }
+  BOOST_REQUIRE_EQUAL(ref.clusters.size(), res.clusters.size());
+  for (size_t i = 0; i < ref.clusters.size(); i++) {
+    const auto &c1 = ref.clusters[i], &c2 = res.clusters[i];
+    float x1, z1, x2, z2;
+    c1.getLocalPosition(x1, z1);
+    c2.getLocalPosition(x2, z2);
+    BOOST_CHECK_EQUAL(c1.getEnergy(), c2.getEnergy());
+    BOOST_CHECK_EQUAL(c1.getCoreEnergy(), c2.getCoreEnergy());
+    BOOST_CHECK_EQUAL(c1.getDispersion(), c2.getDispersion());
+    BOOST_CHECK_EQUAL(c1.getTime(), c2.getTime());
+    BOOST_CHECK_EQUAL(x1, x2);
+    BOOST_CHECK_EQUAL(z1, z2);
+    BOOST_CHECK_EQUAL(int(c1.getNExMax()), int(c2.getNExMax()));
+    BOOST_CHECK_EQUAL(c1.getFirstCluEl(), c2.getFirstCluEl());
+    BOOST_CHECK_EQUAL(c1.getLastCluEl(), c2.getLastCluEl());
+  }
+  BOOST_REQUIRE_EQUAL(ref.cluElements.size(), res.cluElements.size());
+  for (size_t i = 0; i < ref.cluElements.size(); i++) {
+    const auto &e1 = ref.cluElements[i], &e2 = res.cluElements[i];
+    BOOST_CHECK_EQUAL(e1.absId, e2.absId);
+    BOOST_CHECK_EQUAL(e1.energy, e2.energy);
+    BOOST_CHECK_EQUAL(e1.time, e2.time);
+    BOOST_CHECK_EQUAL(e1.fraction, e2.fraction);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(Clusterer_NThreads)
+{
+  Geometry::GetInstance("Run3");
+  std::vector<Digit> digits;
+  std::vector<TriggerRecord> trigRecs;
+  makeDigits(50, digits, trigRecs);
+
+  const auto ref = runClusterer(1, digits, trigRecs);
+  BOOST_REQUIRE(!ref.clusters.empty());
+  for (int nThreads : {2, 4, 7}) {
+    const auto res = runClusterer(nThreads, digits, trigRecs);
+    checkSame(ref, res);
+  }
+}
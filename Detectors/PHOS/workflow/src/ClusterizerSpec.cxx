@@ -15,6 +15,7 @@
 #include "DataFormatsPHOS/PHOSBlockHeader.h"
 #include "PHOSWorkflow/ClusterizerSpec.h"
 #include "Framework/ControlService.h"
+#include "Framework/ConfigParamRegistry.h"
 
 using namespace o2::phos::reco_workflow;
 
@@ -49,6 +50,7 @@ void ClusterizerSpec::init(framework::InitContext& ctx)
   mClusterizer.initialize();
   mClusterizer.setBadMap(badMap);
   mClusterizer.setCalibration(calibParams);
+  mClusterizer.setNThreads(ctx.options().get<int>("nthreads"));
 }
 
 void ClusterizerSpec::run(framework::ProcessingContext& ctx)
@@ -139,7 +141,8 @@ o2::framework::DataProcessorSpec o2::phos::reco_workflow::getClusterizerSpec(boo
   return o2::framework::DataProcessorSpec{"PHOSClusterizerSpec",
                                           inputs,
                                           outputs,
-                                          o2::framework::adaptFromTask<o2::phos::reco_workflow::ClusterizerSpec>(propagateMC, true, fullClu)};
+                                          o2::framework::adaptFromTask<o2::phos::reco_workflow::ClusterizerSpec>(propagateMC, true, fullClu),
+                                          o2::framework::Options{{"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads to process the trigger records of a TF"}}}};
 }
 
 o2::framework::DataProcessorSpec o2::phos::reco_workflow::getCellClusterizerSpec(bool propagateMC, bool fullClu)
@@ -164,5 +167,6 @@ o2::framework::DataProcessorSpec o2::phos::reco_workflow::getCellClusterizerSpec
   return o2::framework::DataProcessorSpec{"PHOSClusterizerSpec",
                                           inputs,
                                           outputs,
-                                          o2::framework::adaptFromTask<o2::phos::reco_workflow::ClusterizerSpec>(propagateMC, false, fullClu)};
+                                          o2::framework::adaptFromTask<o2::phos::reco_workflow::ClusterizerSpec>(propagateMC, false, fullClu),
+                                          o2::framework::Options{{"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads to process the trigger records of a TF"}}}};
 }
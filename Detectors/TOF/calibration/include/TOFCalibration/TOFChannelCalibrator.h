@@ -20,6 +20,7 @@
 #include "TOFBase/Geo.h"
 #include "CCDB/CcdbObjectInfo.h"
 #include "TOFBase/CalibTOFapi.h"
+#include "TOFCalibration/TOFChannelFitter.h"
 
 #include <array>
 #include <boost/histogram.hpp>
@@ -98,6 +99,7 @@ class TOFChannelData
   float integral(int ch, float binmin, float binmax) const;
   float integral(int ch, int binxmin, int binxmax) const;
   float integral(int ch) const;
+  void getChannelContent(int isect, int chInSect, float* dst) const;
   bool hasEnoughData(int minEntries) const;
 
   float getRange() const { return mRange; }
@@ -322,6 +324,8 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
 
   TLinearFitter mLinFitters[NMAXTHREADS]; // fitters for OpenMP for fitGaus
 
+  std::array<TOFChannelFitter, NMAXTHREADS> mChannelFitters; //! gaussian fitters, one per thread
+
   ClassDefOverride(TOFChannelCalibrator, 1);
 };
 
@@ -0,0 +1,55 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef TOF_CHANNEL_FITTER_H_
+#define TOF_CHANNEL_FITTER_H_
+
+#include <array>
+#include <vector>
+
+namespace o2
+{
+namespace tof
+{
+
+/// Gaussian fit of the t-texp distribution of a single channel (or pair of channels).
+/// It gives the same results as o2::math_utils::fitGaus with the MAD pre-selection
+/// (log-normal least squares of the bins with at least minVal entries, within
+/// median +- 2 MAD), but the bin contents and bin centres are kept in buffers reused
+/// from one channel to the next and the sums are accumulated in a single branch-free
+/// loop over the bins. One instance is meant to be used by each thread.
+class TOFChannelFitter
+{
+ public:
+  /// Buffer of nBins elements to be filled with the content of the channel to fit
+  float* getBuffer(int nBins, float xMin, float xMax);
+
+  /// Fit the content of the buffer: the return value and the parameters
+  /// (amplitude, mean, sigma) follow the o2::math_utils::fitGaus conventions
+  double fit(std::array<double, 3>& param, int minVal = 2);
+
+  /// Sum of the buffer content in [binMin, binMax]
+  float integral(int binMin, int binMax) const;
+
+ private:
+  static constexpr float NSigmaMAD = 2.;
+
+  int mNBins = 0;
+  float mXMin = 0.;
+  float mXMax = 0.;
+  std::vector<float> mBins;    // content of the channel being fitted
+  std::vector<double> mCentres; // bin centres
+};
+
+} // namespace tof
+} // namespace o2
+
+#endif
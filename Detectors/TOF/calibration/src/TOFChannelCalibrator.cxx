@@ -403,6 +403,22 @@ float TOFChannelData::integral(int ch) const
   return mEntries.at(ch);
 }
 
+//_____________________________________________
+void TOFChannelData::getChannelContent(int isect, int chInSect, float* dst) const
+{
+  // copy the t-texp distribution of one channel of the sector: the bins of a given channel
+  // are contiguous in the histogram storage, so we read them directly from there
+
+  const auto& histo = mHisto[isect];
+  const auto& storage = boost::histogram::unsafe_access::storage(histo);
+  int shift0 = histo.axis(0).options() & boost::histogram::axis::option::underflow ? 1 : 0;
+  int shift1 = histo.axis(1).options() & boost::histogram::axis::option::underflow ? 1 : 0;
+  size_t offset = (chInSect + shift1) * boost::histogram::axis::traits::extent(histo.axis(0)) + shift0;
+  for (int i = 0; i < mNBins; i++) {
+    dst[i] = storage[offset + i];
+  }
+}
+
 //-------------------------------------------------------------------
 // TOF Channel Calibrator
 //-------------------------------------------------------------------
@@ -444,9 +460,7 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
     double xp[NCOMBINSTRIP], exp[NCOMBINSTRIP], deltat[NCOMBINSTRIP], edeltat[NCOMBINSTRIP];
 
     std::array<double, 3> fitValues;
-    std::vector<float> histoValues;
-
-    auto& histo = c->getHisto(sector);
+    auto& fitter = mChannelFitters[ithread];
 
     int offsetPairInSector = sector * Geo::NSTRIPXSECTOR * NCOMBINSTRIP;
     int offsetsector = sector * Geo::NSTRIPXSECTOR * Geo::NPADS;
@@ -482,17 +496,10 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
           continue;
         }
         fitValues.fill(-99999999);
-        histoValues.clear();
-
-        // make the slice of the 2D histogram so that we have the 1D of the current channel
-        for (unsigned i = 0; i < nbins; ++i) {
-          const auto& v = histo.at(i, chinsector);
-          LOG(debug) << "channel = " << ich << ", in sector = " << sector << " (where it is channel = " << chinsector << ") bin = " << i << " value = " << v;
-          histoValues.push_back(v);
-        }
 
-        double fitres = entriesInPair - 1;
-        fitres = fitGaus(nbins, histoValues.data(), -range, range, fitValues, nullptr, 2., true);
+        // make the slice of the 2D histogram so that we have the 1D of the current pair
+        c->getChannelContent(sector, chinsector, fitter.getBuffer(nbins, -range, range));
+        double fitres = fitter.fit(fitValues);
         if (fitres >= 0) {
           LOG(debug) << "Pair " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
         } else {
@@ -525,7 +532,7 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
         xp[allpoints] = ipair + 0.5;      // pair index
         exp[allpoints] = 0.0;             // error on pair index (dummy since it is on the pair index)
         deltat[allpoints] = fitValues[1]; // delta between offsets from channels in pair (from the fit) - in ps
-        float integral = c->integral(ich, intmin, intmax);
+        float integral = fitter.integral(c->findBin(intmin), c->findBin(intmax));
         edeltat[allpoints] = 20 + fitValues[2] / sqrt(integral); // TODO: for now put by default to 20 ps since it was seen to be reasonable; but it should come from the fit: who gives us the error from the fit ??????
         localFitter.AddPoint(&(xp[allpoints]), deltat[allpoints], edeltat[allpoints]);
         goodpoints++;
@@ -637,94 +644,88 @@ void TOFChannelCalibrator<T>::finalizeSlotWithTracks(Slot& slot)
   TimeSlewing& ts = mCalibTOFapi->getSlewParamObj(); // we take the current CCDB object, since we want to simply update the offset
   //  ts.bind();
 
+  // the channels are distributed dynamically over the threads, each one using its own fitter
+  int nFitted = 0, nFailed = 0;
+  TStopwatch timer;
 #ifdef WITH_OPENMP
   if (mNThreads < 1) {
     mNThreads = std::min(omp_get_max_threads(), NMAXTHREADS);
   }
   LOG(debug) << "Number of threads that will be used = " << mNThreads;
-#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads) reduction(+ : nFitted, nFailed)
 #else
   mNThreads = 1;
 #endif
-  for (int sector = 0; sector < Geo::NSECTORS; sector++) {
-    TMatrixD mat(3, 3);
+  for (int ich = 0; ich < Geo::NSECTORS * Geo::NPADSXSECTOR; ich++) {
     int ithread = 0;
 #ifdef WITH_OPENMP
     ithread = omp_get_thread_num();
 #endif
-    LOG(info) << "Processing sector " << sector << " with thread " << ithread;
-    auto& histo = c->getHisto(sector);
-
-    std::array<double, 3> fitValues;
-    std::vector<float> histoValues;
-    for (int chinsector = 0; chinsector < Geo::NPADSXSECTOR; chinsector++) {
-      // make the slice of the 2D histogram so that we have the 1D of the current channel
-      int ich = chinsector + sector * Geo::NPADSXSECTOR;
-      auto entriesInChannel = entriesPerChannel.at(ich);
-      if (entriesInChannel == 0) {
-        continue; // skip always since a channel with 0 entries is normal, it will be flagged as problematic
-      }
-
-      if (entriesInChannel < mMinEntries) {
-        LOG(debug) << "channel " << ich << " will not be calibrated since it has only " << entriesInChannel << " entries (min = " << mMinEntries << ")";
-        continue;
-      }
+    int sector = ich / Geo::NPADSXSECTOR;
+    int chinsector = ich % Geo::NPADSXSECTOR;
+    auto entriesInChannel = entriesPerChannel[ich];
+    if (entriesInChannel == 0) {
+      continue; // skip always since a channel with 0 entries is normal, it will be flagged as problematic
+    }
 
-      LOG(debug) << "channel " << ich << " will be calibrated since it has " << entriesInChannel << " entries (min = " << mMinEntries << ")";
-      fitValues.fill(-99999999);
-      histoValues.clear();
-      // more efficient way
-      for (unsigned j = chinsector; j <= chinsector; ++j) {
-        for (unsigned i = 0; i < nbins; ++i) {
-          const auto& v = histo.at(i, j);
-          LOG(debug) << "channel = " << ich << ", in sector = " << sector << " (where it is channel = " << chinsector << ") bin = " << i << " value = " << v;
-          histoValues.push_back(v);
-        }
-      }
+    if (entriesInChannel < mMinEntries) {
+      LOG(debug) << "channel " << ich << " will not be calibrated since it has only " << entriesInChannel << " entries (min = " << mMinEntries << ")";
+      continue;
+    }
 
-      double fitres = fitGaus(nbins, histoValues.data(), -range, range, fitValues, nullptr, 2., true);
-      LOG(info) << "channel = " << ich << " fitted by thread = " << ithread;
-      if (fitres >= 0) {
-        LOG(info) << "Channel " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-      } else {
-        LOG(info) << "Channel " << ich << " :: Fit failed with result = " << fitres;
-        ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, -1);
-        ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, 99999);
-        continue;
-      }
+    LOG(debug) << "channel " << ich << " will be calibrated since it has " << entriesInChannel << " entries (min = " << mMinEntries << ")";
+    std::array<double, 3> fitValues;
+    fitValues.fill(-99999999);
+    // make the slice of the 2D histogram so that we have the 1D of the current channel
+    auto& fitter = mChannelFitters[ithread];
+    c->getChannelContent(sector, chinsector, fitter.getBuffer(nbins, -range, range));
+
+    double fitres = fitter.fit(fitValues);
+    LOG(debug) << "channel = " << ich << " fitted by thread = " << ithread;
+    if (fitres >= 0) {
+      LOG(debug) << "Channel " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
+    } else {
+      LOG(debug) << "Channel " << ich << " :: Fit failed with result = " << fitres;
+      ts.setFractionUnderPeak(sector, chinsector, -1);
+      ts.setSigmaPeak(sector, chinsector, 99999);
+      nFailed++;
+      continue;
+    }
 
-      if (fitValues[2] < 0) {
-        fitValues[2] = -fitValues[2];
-      }
+    if (fitValues[2] < 0) {
+      fitValues[2] = -fitValues[2];
+    }
 
-      float fractionUnderPeak;
-      float intmin = fitValues[1] - 5 * fitValues[2]; // mean - 5*sigma
-      float intmax = fitValues[1] + 5 * fitValues[2]; // mean + 5*sigma
+    float fractionUnderPeak;
+    float intmin = fitValues[1] - 5 * fitValues[2]; // mean - 5*sigma
+    float intmax = fitValues[1] + 5 * fitValues[2]; // mean + 5*sigma
 
-      if (intmin < -mRange) {
-        intmin = -mRange;
-      }
-      if (intmax < -mRange) {
-        intmax = -mRange;
-      }
-      if (intmin > mRange) {
-        intmin = mRange;
-      }
-      if (intmax > mRange) {
-        intmax = mRange;
-      }
+    if (intmin < -mRange) {
+      intmin = -mRange;
+    }
+    if (intmax < -mRange) {
+      intmax = -mRange;
+    }
+    if (intmin > mRange) {
+      intmin = mRange;
+    }
+    if (intmax > mRange) {
+      intmax = mRange;
+    }
 
-      fractionUnderPeak = entriesInChannel > 0 ? c->integral(ich, intmin, intmax) / entriesInChannel : 0;
-      // now we need to store the results in the TimeSlewingObject
-      ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fractionUnderPeak);
-      ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, abs(fitValues[2]));
-      ts.updateOffsetInfo(ich, fitValues[1]);
+    fractionUnderPeak = entriesInChannel > 0 ? fitter.integral(c->findBin(intmin), c->findBin(intmax)) / entriesInChannel : 0;
+    // now we need to store the results in the TimeSlewingObject
+    ts.setFractionUnderPeak(sector, chinsector, fractionUnderPeak);
+    ts.setSigmaPeak(sector, chinsector, abs(fitValues[2]));
+    ts.updateOffsetInfo(ich, fitValues[1]);
 #ifdef DEBUGGING
-      mFitCal->Fill(ich, fitValues[1]);
+    mFitCal->Fill(ich, fitValues[1]);
 #endif
-      LOG(debug) << "udpdate channel " << ich << " with " << fitValues[1] << " offset in ps";
-    } // end loop channels in sector
-  }   // end loop over sectors
+    nFitted++;
+    LOG(debug) << "udpdate channel " << ich << " with " << fitValues[1] << " offset in ps";
+  } // end loop over channels
+  timer.Stop();
+  LOG(info) << "Fitted " << nFitted << " channels (" << nFailed << " failed fits) with " << mNThreads << " threads in " << timer.RealTime() << " s";
   auto clName = o2::utils::MemFileHelper::getClassName(ts);
   auto flName = o2::ccdb::CcdbApi::generateFileName(clName);
   mInfoVector.emplace_back("TOF/Calib/ChannelCalib", clName, flName, md, slot.getTFStart(), 99999999999999);
@@ -0,0 +1,129 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "TOFCalibration/TOFChannelFitter.h"
+#include "MathUtils/fit.h"
+#include <algorithm>
+#include <cmath>
+
+namespace o2
+{
+namespace tof
+{
+
+//_____________________________________________
+float* TOFChannelFitter::getBuffer(int nBins, float xMin, float xMax)
+{
+  if (nBins != mNBins || xMin != mXMin || xMax != mXMax) {
+    mNBins = nBins;
+    mXMin = xMin;
+    mXMax = xMax;
+    mBins.resize(nBins);
+    mCentres.resize(nBins);
+    double binW = double(xMax - xMin) / nBins;
+    for (int i = 0; i < nBins; i++) {
+      mCentres[i] = xMin + (i + 0.5) * binW;
+    }
+  }
+  return mBins.data();
+}
+
+//_____________________________________________
+double TOFChannelFitter::fit(std::array<double, 3>& param, int minVal)
+{
+  double binW = double(mXMax - mXMin) / mNBins;
+  std::array<double, 3> madPar;
+  if (!o2::math_utils::medmadGaus(size_t(mNBins), mBins.data(), mXMin, mXMax, madPar)) {
+    return -10;
+  }
+  int bStart = std::max(0, int((madPar[1] - NSigmaMAD * madPar[2] - mXMin) / binW));
+  int bEnd = std::min(mNBins, 1 + int((madPar[1] + NSigmaMAD * madPar[2] - mXMin) / binW));
+
+  // the abscissa is taken relative to the median, which keeps the normal equations well conditioned
+  const double x0 = madPar[1];
+  const float* bins = mBins.data();
+  const double* centres = mCentres.data();
+  double s0 = 0, s1 = 0, s2 = 0, s3 = 0, s4 = 0, sy0 = 0, sy1 = 0, sy2 = 0, syy = 0;
+  int np = 0;
+  for (int i = bStart; i < bEnd; i++) {
+    float v = bins[i];
+    bool use = v >= minVal;
+    double w = use ? v : 0.; // bins below threshold enter with 0 weight, so that the loop has no branch
+    double y = std::log(use ? v : 1.f);
+    double x = centres[i] - x0;
+    double wx = w * x, wx2 = wx * x, wy = w * y, wxy = wx * y;
+    s0 += w;
+    s1 += wx;
+    s2 += wx2;
+    s3 += wx2 * x;
+    s4 += wx2 * x * x;
+    sy0 += wy;
+    sy1 += wxy;
+    sy2 += wxy * x;
+    syy += wy * y;
+    np += use;
+  }
+  if (np < 1) {
+    return -10;
+  }
+  auto recover = [&param, binW, np, s0, s1, s2, sy0, x0]() {
+    double mean = s1 / s0;
+    param[0] = std::exp(sy0 / s0); // recover center of gravity
+    param[1] = mean + x0;          // mean x;
+    param[2] = np == 1 ? binW / std::sqrt(12) : std::sqrt(std::abs(mean * mean - s2 / s0));
+  };
+  if (np < 3) {
+    recover();
+    return -np;
+  }
+
+  // solve the 3x3 symmetric normal equations via the adjugate
+  double c00 = s2 * s4 - s3 * s3, c01 = s2 * s3 - s1 * s4, c02 = s1 * s3 - s2 * s2;
+  double det = s0 * c00 + s1 * c01 + s2 * c02;
+  if (!(std::abs(det) > 0.) || !std::isfinite(det)) {
+    recover();
+    return -10;
+  }
+  double c11 = s0 * s4 - s2 * s2, c12 = s1 * s2 - s0 * s3, c22 = s0 * s2 - s1 * s1;
+  double v0 = (c00 * sy0 + c01 * sy1 + c02 * sy2) / det;
+  double v1 = (c01 * sy0 + c11 * sy1 + c12 * sy2) / det;
+  double v2 = (c02 * sy0 + c12 * sy1 + c22 * sy2) / det;
+  if (v2 >= 0.) { // fit failed, use mean amd RMS
+    recover();
+    return -3;
+  }
+  double chi2 = v0 * v0 * s0 + v1 * v1 * s2 + v2 * v2 * s4 + syy +
+                2. * (v0 * v1 * s1 + v0 * v2 * s2 + v1 * v2 * s3 - v0 * sy0 - v1 * sy1 - v2 * sy2);
+  double mean = -0.5 * v1 / v2;
+  param[1] = mean + x0;
+  param[2] = 1. / std::sqrt(-2. * v2);
+  param[0] = std::exp(v0 - mean * mean * v2);
+  if (std::isnan(param[0]) || std::isnan(param[1]) || std::isnan(param[2])) {
+    recover();
+    return -3;
+  }
+  return np > 3 ? chi2 / (np - 3.) : 0.;
+}
+
+//_____________________________________________
+float TOFChannelFitter::integral(int binMin, int binMax) const
+{
+  binMin = std::max(binMin, 0);
+  binMax = std::min(binMax, mNBins - 1);
+  float sum = 0;
+  for (int i = binMin; i <= binMax; i++) {
+    sum += mBins[i];
+  }
+  return sum;
+}
+
+} // namespace tof
+} // namespace o2
@@ -0,0 +1,63 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TOFChannelFitter
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TOFCalibration/TOFChannelCalibrator.h"
+#include "TOFCalibration/TOFChannelFitter.h"
+#include "MathUtils/fit.h"
+#include <TRandom.h>
+#include <algorithm>
+#include <vector>
+
+using namespace o2::tof;
+
+BOOST_AUTO_TEST_CASE(TOFChannelFitter_test)
+{
+  // compare the fits of the channels of a sector with those of o2::math_utils::fitGaus
+  const int nBins = 1000, nChannels = 200;
+  const float range = 24400;
+  TOFChannelData data(nBins, range, nullptr);
+  gRandom->SetSeed(1234);
+  for (int ch = 0; ch < nChannels; ch++) {
+    double mean = gRandom->Uniform(-3000, 3000), sigma = gRandom->Uniform(60, 400);
+    int nEntries = ch * 20;
+    for (int i = 0; i < nEntries; i++) {
+      data.getHisto(3)(i % 10 ? gRandom->Gaus(mean, sigma) : gRandom->Uniform(-range, range), ch); // with 10% of background
+    }
+  }
+
+  TOFChannelFitter fitter;
+  std::vector<float> values(nBins);
+  for (int ch = 0; ch < nChannels; ch++) {
+    for (int i = 0; i < nBins; i++) {
+      values[i] = data.getHisto(3).at(i, ch);
+    }
+    float* buffer = fitter.getBuffer(nBins, -range, range);
+    data.getChannelContent(3, ch, buffer);
+    BOOST_TEST(std::equal(values.begin(), values.end(), buffer));
+
+    std::array<double, 3> ref, res;
+    double refStatus = o2::math_utils::fitGaus(nBins, values.data(), -range, range, ref, nullptr, 2, true);
+    double status = fitter.fit(res);
+    BOOST_CHECK((status >= 0) == (refStatus >= 0));
+    if (refStatus < 0) {
+      continue;
+    }
+    BOOST_CHECK_SMALL(res[1] - ref[1], 0.01);    // mean, in ps
+    BOOST_CHECK_CLOSE(res[2], ref[2], 1e-3);     // sigma, in %
+    BOOST_CHECK_CLOSE(res[0], ref[0], 1e-3);     // amplitude, in %
+    BOOST_CHECK_SMALL(status - refStatus, 1e-3); // chi2/ndf
+    BOOST_CHECK(fitter.integral(0, nBins - 1) == data.integral(3 * Geo::NPADSXSECTOR + ch, 0, nBins - 1));
+  }
+}
@@ -156,6 +156,9 @@ class CalibRawBase
   /// get skipping of incomplete events
   bool getSkipIncompleteEvents() const { return mSkipIncomplete; }
 
+  /// set number of threads used by the CRU raw readers for file indexing and link decoding
+  void setNThreads(int nThreads) { mRawReaderCRUManager.setNThreads(nThreads); }
+
   /// set external digits
   void setDigits(std::array<std::vector<Digit>, Sector::MAXSECTOR>* digits) { mExternalDigits = digits; }
 
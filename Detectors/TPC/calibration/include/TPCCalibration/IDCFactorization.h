@@ -160,6 +160,10 @@ class IDCFactorization : public IDCGroupHelperSector
   /// \param timeframe time frame of the IDCs
   void setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe) { mIDCs[cru][timeframe] = std::move(idcs); }
 
+  /// swap the IDC data with an external buffer, e.g. to aggregate the IDCs of the next interval while the present one is factorized
+  /// \param idcs IDCs for each CRU and time frame, with the same layout as the stored IDCs
+  void swapIDCs(std::array<std::vector<std::vector<float>>, CRU::MaxCRU>& idcs) { mIDCs.swap(idcs); }
+
   /// set the number of threads used for some of the calculations
   /// \param nThreads number of threads
   static void setNThreads(const int nThreads) { sNThreads = nThreads; }
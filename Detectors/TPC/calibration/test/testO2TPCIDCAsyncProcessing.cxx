@@ -0,0 +1,154 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testO2TPCIDCAsyncProcessing.cxx
+/// \brief this task tests that the factorization and fourier transform of an aggregation interval in a background thread,
+/// while the IDCs of the next interval are aggregated as in the TPCFactorizeIDCSpec and TPCFourierTransformAggregatorSpec,
+/// give the same IDC0, IDC1, IDCDelta and fourier coefficients as the synchronous processing
+
+#define BOOST_TEST_MODULE Test TPC O2TPCIDCAsyncProcessing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCCalibration/IDCFactorization.h"
+#include "TPCCalibration/IDCFourierTransform.h"
+#include "TPCBase/CRU.h"
+#include <future>
+#include <numeric>
+#include <random>
+
+namespace o2::tpc
+{
+
+static constexpr unsigned int NINTERVALS = 4;      // number of aggregation intervals
+static constexpr unsigned int TIMEFRAMES = 6;      // number of TFs per aggregation interval
+static constexpr unsigned int TIMEFRAMESDELTA = 4; // number of TFs per IDCDelta chunk
+static constexpr unsigned int RANGEIDC = 30;       // number of 1D-IDCs used for the fourier transform
+static constexpr unsigned int NFOURIERCOEFF = 10;  // number of stored fourier coefficients
+
+using FtType = IDCFourierTransform<IDCFourierTransformBaseAggregator>;
+using IDCBuffer = std::array<std::vector<std::vector<float>>, CRU::MaxCRU>;
+
+/// results of one aggregation interval
+struct IntervalResult {
+  IDCZero idcZero;
+  IDCOne idcOne;
+  std::vector<IDCDelta<float>> idcDelta;
+  FourierCoeff fourier;
+};
+
+std::vector<uint32_t> getCRUs()
+{
+  std::vector<uint32_t> crus(CRU::MaxCRU);
+  std::iota(crus.begin(), crus.end(), 0);
+  return crus;
+}
+
+IDCFactorization makeFactorization()
+{
+  const std::array<unsigned char, Mapper::NREGIONS> groupPads{7, 7, 7, 7, 6, 6, 6, 6, 5, 5};
+  const std::array<unsigned char, Mapper::NREGIONS> groupRows{5, 5, 5, 5, 4, 4, 4, 4, 3, 3};
+  const std::array<unsigned char, Mapper::NREGIONS> groupLastRowsThreshold{2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+  const std::array<unsigned char, Mapper::NREGIONS> groupLastPadsThreshold{2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+  return IDCFactorization(groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, 0, TIMEFRAMES, TIMEFRAMESDELTA, getCRUs());
+}
+
+/// number of integration intervals of a TF, either 10 or 11 as for 128 orbits per TF and 12 orbits integration length
+unsigned int getIntegrationIntervals(const unsigned int tf) { return 10 + ((tf % 3) ? 1 : 0); }
+
+/// aggregate the grouped IDCs of all CRUs of an interval into the buffer
+void aggregateIDCs(const IDCFactorization& factorization, const unsigned int interval, IDCBuffer& idcs)
+{
+  std::mt19937 eng(interval + 1);
+  std::uniform_real_distribution<float> val(1, 100);
+  for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+    idcs[cru].resize(TIMEFRAMES);
+    for (unsigned int tf = 0; tf < TIMEFRAMES; ++tf) {
+      std::vector<float> idcsTF(factorization.getNIDCs(CRU(cru).region()) * getIntegrationIntervals(tf));
+      for (auto& idc : idcsTF) {
+        idc = val(eng);
+      }
+      idcs[cru][tf] = std::move(idcsTF);
+    }
+  }
+}
+
+/// factorize the swapped in IDCs and perform the fourier transform of the 1D-IDCs
+void processInterval(IDCFactorization& factorization, FtType& fourierTransform, std::vector<IntervalResult>& results)
+{
+  factorization.factorizeIDCs(false);
+  IntervalResult result{factorization.getIDCZero(), factorization.getIDCOne(), {}, {}};
+  for (unsigned int iChunk = 0; iChunk < factorization.getNChunks(); ++iChunk) {
+    result.idcDelta.emplace_back(factorization.getIDCDeltaUncompressed(iChunk));
+  }
+
+  OneDIDC oneDIDC;
+  oneDIDC.mOneDIDC = result.idcOne.mIDCOne;
+  std::vector<unsigned int> intervalsPerTF(TIMEFRAMES);
+  for (unsigned int tf = 0; tf < TIMEFRAMES; ++tf) {
+    intervalsPerTF[tf] = getIntegrationIntervals(tf);
+  }
+  fourierTransform.setIDCs(std::move(oneDIDC), std::move(intervalsPerTF));
+  fourierTransform.calcFourierCoefficients();
+  result.fourier = fourierTransform.getFourierCoefficients();
+  results.emplace_back(std::move(result));
+}
+
+std::vector<IntervalResult> runProcessing(const bool async)
+{
+  auto factorization = makeFactorization();
+  FtType fourierTransform{RANGEIDC, TIMEFRAMES, NFOURIERCOEFF};
+  IDCBuffer aggregation;
+  std::future<void> processing;
+  std::vector<IntervalResult> results;
+
+  for (unsigned int interval = 0; interval < NINTERVALS; ++interval) {
+    // overlaps with the processing of the previous interval when running asynchronously
+    aggregateIDCs(factorization, interval, aggregation);
+    if (processing.valid()) {
+      processing.get();
+    }
+    factorization.swapIDCs(aggregation);
+    if (async) {
+      processing = std::async(std::launch::async, [&]() { processInterval(factorization, fourierTransform, results); });
+    } else {
+      processInterval(factorization, fourierTransform, results);
+    }
+  }
+  if (processing.valid()) {
+    processing.get();
+  }
+  return results;
+}
+
+BOOST_AUTO_TEST_CASE(IDCAsyncProcessing_test)
+{
+  IDCFactorization::setNThreads(2);
+  FtType::setNThreads(2);
+  const auto ref = runProcessing(false);
+  const auto res = runProcessing(true);
+
+  BOOST_REQUIRE_EQUAL(ref.size(), NINTERVALS);
+  BOOST_REQUIRE_EQUAL(res.size(), NINTERVALS);
+  for (unsigned int interval = 0; interval < NINTERVALS; ++interval) {
+    for (const auto side : {Side::A, Side::C}) {
+      BOOST_CHECK(ref[interval].idcZero.mIDCZero[side] == res[interval].idcZero.mIDCZero[side]);
+      BOOST_CHECK(ref[interval].idcOne.mIDCOne[side] == res[interval].idcOne.mIDCOne[side]);
+      BOOST_REQUIRE_EQUAL(ref[interval].idcDelta.size(), res[interval].idcDelta.size());
+      for (unsigned int iChunk = 0; iChunk < ref[interval].idcDelta.size(); ++iChunk) {
+        BOOST_CHECK(ref[interval].idcDelta[iChunk].getIDCDelta(side) == res[interval].idcDelta[iChunk].getIDCDelta(side));
+      }
+      BOOST_CHECK(ref[interval].fourier.getFourierCoefficients(side) == res[interval].fourier.getFourierCoefficients(side));
+    }
+  }
+}
+
+} // namespace o2::tpc
@@ -221,6 +221,32 @@ class SyncPosition
 using SyncArray = std::array<SyncPosition, 5>;
 
 // ===========================================================================
+/// \struct GBTHalfWordTable
+/// \brief lookup tables to extract the 4 5-bit half words of a data stream from a GBT frame
+///
+/// The 20 bits of a stream form a contiguous window in the frame, with bit n of the window
+/// being bit n / 4 of half word 3 - n % 4. Each table transposes 10 bits of the window into
+/// their contribution to the half words, packed by 5 bits with half word j at bits 5j to 5j + 4.
+struct GBTHalfWordTable {
+  std::array<uint32_t, 1024> low{};  ///< contribution of the bits 0 to 9 of the window
+  std::array<uint32_t, 1024> high{}; ///< contribution of the bits 10 to 19 of the window
+
+  constexpr GBTHalfWordTable()
+  {
+    for (uint32_t value = 0; value < 1024; ++value) {
+      for (uint32_t b = 0; b < 10; ++b) {
+        if ((value >> b) & 1) {
+          low[value] |= 1u << (5 * (3 - b % 4) + b / 4);
+          const uint32_t n = b + 10;
+          high[value] |= 1u << (5 * (3 - n % 4) + n / 4);
+        }
+      }
+    }
+  }
+};
+
+inline constexpr GBTHalfWordTable gbtHalfWordTable{};
+
 /// \class GBTFrame
 /// \brief helper to encapsulate a GBTFrame
 class GBTFrame
@@ -250,6 +276,11 @@ class GBTFrame
   /// extract the 4 5b halfwords for the 5 data streams from one GBT frame
   void getFrameHalfWords();
 
+  /// half word of the last frame processed by getFrameHalfWords
+  /// \param stream data stream
+  /// \param halfWord half word position in the frame
+  adc_t getFrameHalfWord(int stream, int halfWord) const { return mFrameHalfWords[stream][halfWord + (mPrevHWpos ^ 4)]; }
+
   /// store the half words of the current frame in the previous frame data structure. Both
   /// frame information is needed to reconstruct the ADC stream since it can spread across
   /// 2 frames, depending on the position of the SYNC pattern.
@@ -261,6 +292,9 @@ class GBTFrame
   /// read from memory
   void readFromMemory(gsl::span<const std::byte> data);
 
+  /// read the next frame at position filePos of the (memory mapped) input file
+  void readFromFile(gsl::span<const std::byte> fileData, size_t filePos);
+
   /// read from istream
   void streamFrom(std::istream& input);
 
@@ -570,6 +604,12 @@ class RawReaderCRU
     }
   }
 
+  ~RawReaderCRU() { unmapFile(); }
+
+  // the reader owns the memory mapping of the input file, which must be unmapped only once
+  RawReaderCRU(const RawReaderCRU&) = delete;
+  RawReaderCRU& operator=(const RawReaderCRU&) = delete;
+
   /**
    * Exception class for decoder error
    */
@@ -587,6 +627,11 @@ class RawReaderCRU
   /// the mLinkPresent variable to indicate which links are present in the data file.
   int scanFile();
 
+  /// first part of scanFile: build the packet index of the links in a single pass over the file.
+  /// It does not touch the event synchronisation of the manager, such that the files of
+  /// several readers can be indexed concurrently.
+  int indexFile();
+
   /// set the present (global) link to be processed
   /// \param link present link
   ///
@@ -626,15 +671,16 @@ class RawReaderCRU
   /// process data in case of Link based zero suppression
   void processLinkZS();
 
-  /// Collect data to memory and process data
+  /// Process the data of the present link directly from the mapped input file
   void processDataMemory();
 
   /// process single packet
   int processPacket(GBTFrame& gFrame, uint32_t startPos, uint32_t size, ADCRawData& rawData);
 
-  /// Process data from memory for a single link
-  /// The data must be collected before, merged over 8k packets
-  int processMemory(const std::vector<std::byte>& data, ADCRawData& rawData);
+  /// Process the GBT data of a single link in the present event from the mapped input file.
+  /// The packets are decoded in place, one after the other.
+  /// Only reads the state of the reader, so different links can be processed concurrently.
+  int processMemory(uint32_t link, ADCRawData& rawData);
 
   /// process links
   void processLinks(const uint32_t linkMask = 0);
@@ -696,18 +742,8 @@ class RawReaderCRU
   /// get packet descriptor map array
   const PacketDescriptorMapArray& getPacketDescriptorMaps() const { return mPacketDescriptorMaps; }
 
-  /// file handling
-  std::ifstream& getFileHandle()
-  {
-    if (!mFileHandle.is_open()) {
-      mFileHandle.open(mInputFileName, std::ios::binary);
-      if (!mFileHandle.good()) {
-        throw std::runtime_error("Unable to open or access file " + mInputFileName);
-      }
-    }
-
-    return mFileHandle;
-  }
+  /// file handling: read-only memory mapping of the full input file, created on first use
+  gsl::span<const std::byte> getFileData();
 
   //===========================================================================
   //===| Nested helper classes |===============================================
@@ -819,10 +855,26 @@ class RawReaderCRU
   std::map<PadPos, std::vector<uint16_t>> mADCdata; ///< decoded ADC data
   RawReaderCRUManager* mManager{nullptr};           ///< event synchronization information
 
-  std::ifstream mFileHandle; ///< file handle for input file
+  /// packet information kept from indexFile to fill the event synchronisation in scanFile
+  struct ScannedPacket {
+    RDH rdh;                      ///< RDH of the packet, with fixed FEE and CRU ids
+    uint32_t heartbeatOrbitEvent; ///< orbit identifying the event
+    uint32_t globalLinkID;        ///< global link of the packet
+    CRU cru;                      ///< CRU of the packet
+    int32_t packetNumber;         ///< position in the packet descriptor map of the link, -1 for packets without payload
+    bool validHeader;             ///< if the header word was correct, the scan stops otherwise
+  };
+
+  const std::byte* mFileData{nullptr};                //! start of the memory mapped input file
+  bool mFileIsIndexed = false;                        //! if the packet index was built
+  std::vector<ScannedPacket> mScannedPackets;         //! packets seen by indexFile
+  std::array<ADCRawData, MaxNumberOfLinks> mLinkData; //! decoded data of each link in the present event
+
+  /// release the memory mapping of the input file
+  void unmapFile();
 
-  /// collect raw GBT data
-  void collectGBTData(std::vector<std::byte>& data);
+  /// fill the event synchronisation of the manager from the indexed packets
+  void fillEventSync();
 
   /// fill adc data to output map
   void fillADCdataMap(const ADCRawData& rawData);
@@ -901,19 +953,23 @@ inline void GBTFrame::updateSyncCheck(bool verbose)
 /// extract the 4 5b halfwords for the 5 data streams from one GBT frame
 /// the 4 5b halfwords of the previous frame are stored in the same structure
 /// the position of the previous frame is indicated by mPrevHWpos
+///
+/// The bits of halfword j of stream i are the frame bits P[i][j], P[i][j] - 4, ..., P[i][j] - 16, with
+/// P = {{19, 18, 17, 16}, {39, 38, 37, 36}, {63, 62, 61, 60}, {83, 82, 81, 80}, {107, 106, 105, 104}},
+/// i.e. each stream occupies a 20 bit window which is transposed with the GBTHalfWordTable
 inline void GBTFrame::getFrameHalfWords()
 {
-  constexpr adc_t P[5][4] = {{19, 18, 17, 16}, {39, 38, 37, 36}, {63, 62, 61, 60}, {83, 82, 81, 80}, {107, 106, 105, 104}};
+  const uint64_t low = (uint64_t(mData[1]) << 32) | mData[0];
+  const uint64_t high = (uint64_t(mData[3]) << 32) | mData[2];
+  // windows of the 5 streams start at the frame bits 0, 20, 44, 64 and 88
+  const uint32_t windows[5] = {uint32_t(low), uint32_t(low >> 20), uint32_t(low >> 44), uint32_t(high), uint32_t(high >> 24)};
   // i = Stream, j = Halfword
   for (int i = 0; i < 5; i++) {
+    const uint32_t window = windows[i] & 0xFFFFF;
+    const uint32_t halfWords = gbtHalfWordTable.low[window & 0x3FF] | gbtHalfWordTable.high[window >> 10];
     for (int j = 0; j < 4; j++) {
-      mFrameHalfWords[i][j + mPrevHWpos] = bit(P[i][j], adc_t(4)) |
-                                           bit(adc_t(P[i][j] - 4), adc_t(3)) |
-                                           bit(adc_t(P[i][j] - 8), adc_t(2)) |
-                                           bit(adc_t(P[i][j] - 12), adc_t(1)) |
-                                           bit(adc_t(P[i][j] - 16), adc_t(0));
-      // std::cout << " S : " << i << " H : " << j << " : " << std::hex << res << std::endl;
-    };
+      mFrameHalfWords[i][j + mPrevHWpos] = (halfWords >> (5 * j)) & 0x1F;
+    }
   }
   mPrevHWpos ^= 4; // toggle position of previous HW position
 }
@@ -945,6 +1001,13 @@ inline void GBTFrame::readFromMemory(gsl::span<const std::byte> data)
   memcpy(mData.data(), data.data(), data.size_bytes());
 }
 
+inline void GBTFrame::readFromFile(gsl::span<const std::byte> fileData, size_t filePos)
+{
+  mFilePos = filePos;
+  mFrameNum++;
+  readFromMemory(fileData.subspan(filePos, sizeof(mData)));
+}
+
 // =============================================================================
 // =============================================================================
 // =============================================================================
@@ -1075,6 +1138,12 @@ class RawReaderCRUManager
   /// process event calling mADCDataCallback to process values
   void processEvent(uint32_t eventNumber, EndReaderCallback endReader = nullptr);
 
+  /// set the number of threads used to index the files of the readers and to decode the links of a CRU
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+
+  /// get the number of threads
+  int getNThreads() const { return mNThreads; }
+
  private:
   std::vector<std::unique_ptr<RawReaderCRU>> mRawReadersCRU{}; ///< cru type raw readers
   RawReaderCRUEventSync mEventSync{};                          ///< event synchronisation
@@ -1085,6 +1154,7 @@ class RawReaderCRUManager
   bool mIsInitialized{false};                                  ///< if init was called already
   ADCDataCallback mADCDataCallback{nullptr};                   ///< callback function for filling the ADC data
   LinkZSCallback mLinkZSCallback{nullptr};                     ///< callback for decoded linkZS data
+  int mNThreads{1};                                            ///< number of threads for indexing and decoding
 
   friend class RawReaderCRU;
 
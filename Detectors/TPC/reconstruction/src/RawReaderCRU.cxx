@@ -15,6 +15,10 @@
 
 #include <fmt/format.h>
 #include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "TSystem.h"
 #include "TObjArray.h"
 
@@ -203,6 +207,41 @@ void RawReaderCRUEventSync::streamTo(std::ostream& output) const
   }
 }
 
+//==============================================================================
+gsl::span<const std::byte> RawReaderCRU::getFileData()
+{
+  if (mFileSize == size_t(-1)) {
+    const int fd = ::open(mInputFileName.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      throw std::runtime_error("Unable to open or access file " + mInputFileName);
+    }
+    void* mapping = nullptr;
+    if (st.st_size > 0) {
+      mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      throw std::runtime_error("Unable to map file " + mInputFileName);
+    }
+    mFileData = static_cast<const std::byte*>(mapping);
+    mFileSize = st.st_size;
+  }
+  return {mFileData, mFileSize};
+}
+
+void RawReaderCRU::unmapFile()
+{
+  if (mFileData) {
+    munmap(const_cast<std::byte*>(mFileData), mFileSize);
+  }
+  mFileData = nullptr;
+  mFileSize = size_t(-1);
+}
+
 //==============================================================================
 int RawReaderCRU::scanFile()
 {
@@ -210,62 +249,119 @@ int RawReaderCRU::scanFile()
     return 0;
   }
 
+  indexFile();
+  fillEventSync();
+
+  // go through events and set the status if links were seen
+  if (mManager) {
+    // in case of triggered mode, we use the first heartbeat orbit as event identifier
+    mManager->mEventSync.setLinksSeen(mCRU, mLinkPresent);
+  }
+
+  if (mVerbosity) {
+    // the file is supposed to contain N x 8kB packets. So the number of packets
+    // can be determined by the file-size. Ideally, this is not required but the
+    // information is derived directly from the header size and payload size.
+    // *** to be adapted to header info ***
+    const uint32_t numPackets = mFileSize / (8 * 1024);
+
+    // show the mLinkPresent map
+    std::cout << "Links present" << std::endl;
+    for (int i = 0; i < MaxNumberOfLinks; i++) {
+      mLinkPresent[i] == true ? std::cout << "1 " : std::cout << "0 ";
+    };
+    std::cout << '\n';
+
+    std::cout << std::dec
+              << "File Name         : " << mInputFileName << "\n"
+              << "File size [bytes] : " << mFileSize << "\n"
+              << "Packets           : " << numPackets << "\n"
+              << "\n";
+
+    if (mVerbosity > 1) {
+      // ===| display packet statistics |===
+      for (int i = 0; i < MaxNumberOfLinks; i++) {
+        if (mLinkPresent[i]) {
+          std::cout << "Packets for link " << i << ": " << mPacketsPerLink[i] << "\n";
+          //
+          // ===| display the packet descriptor map |===
+          for (const auto& pd : mPacketDescriptorMaps[i]) {
+            std::cout << pd << "\n";
+          }
+        }
+      }
+      std::cout << "\n";
+    }
+  }
+
+  mFileIsScanned = true;
+
+  return 0;
+}
+
+int RawReaderCRU::indexFile()
+{
+  if (mFileIsIndexed) {
+    return 0;
+  }
+
   // std::vector<PacketDescriptor> mPacketDescriptorMap;
   //const uint64_t RDH_HEADERWORD0 = 0x1ea04003;
   //const uint64_t RDH_HEADERWORD0 = 0x00004003;
   const uint64_t RDH_HEADERWORD0 = 0x00004000; // + RDHUtils::getVersion<o2::header::RAWDataHeader>();
 
-  auto& file = getFileHandle();
+  const auto data = getFileData();
 
   LOGP(info, "scanning file {}", mInputFileName);
-  // get length of file in bytes
-  file.seekg(0, file.end);
-  mFileSize = file.tellg();
-  file.seekg(0, file.beg);
 
   const bool isTFfile = (mInputFileName.rfind(".tf") == mInputFileName.size() - 3);
 
-  // the file is supposed to contain N x 8kB packets. So the number of packets
-  // can be determined by the file-size. Ideally, this is not required but the
-  // information is derived directly from the header size and payload size.
-  // *** to be adapted to header info ***
-  const uint32_t numPackets = mFileSize / (8 * 1024);
+  // copy a header from the current position, false if it would exceed the file size
+  auto readHeader = [&data](auto& header, size_t pos) {
+    if (pos + sizeof(header) > data.size()) {
+      return false;
+    }
+    memcpy(&header, data.data() + pos, sizeof(header));
+    return true;
+  };
 
   // read in the RDH, then jump to the next RDH position
   RDH rdh;
   o2::header::DataHeader dh;
-  uint32_t currentPacket = 0;
-  uint32_t lastHeartbeatOrbit = 0;
+  size_t currentPos = 0;
 
   if (isTFfile) {
     // skip the StfBuilder meta data information
-    file >> dh;
-    file.seekg(dh.payloadSize, std::ios::cur);
-    file >> dh;
-    file.seekg(dh.payloadSize, std::ios::cur);
+    for (int i = 0; i < 2 && readHeader(dh, currentPos); ++i) {
+      currentPos += sizeof(dh) + dh.payloadSize;
+    }
   }
 
-  size_t currentPos = file.tellg();
   size_t dhPayloadSize{};
   size_t dhPayloadSizeSeen{};
 
-  while ((currentPos < mFileSize) && !file.eof()) {
+  while (currentPos < mFileSize) {
     // ===| in case of TF data file read data header |===
     if (isTFfile && (!dhPayloadSize || (dhPayloadSizeSeen == dhPayloadSize))) {
-      file >> dh;
+      if (!readHeader(dh, currentPos)) {
+        LOGP(error, "File truncated at {}, data header would exceed file size of {}", currentPos, mFileSize);
+        break;
+      }
+      currentPos += sizeof(dh);
       dhPayloadSize = dh.payloadSize;
       if (dh.dataOrigin != o2::header::gDataOriginTPC) {
-        file.seekg(dhPayloadSize, file.cur);
-        currentPos = file.tellg();
+        currentPos += dhPayloadSize;
         dhPayloadSize = 0;
         continue;
       }
       dhPayloadSizeSeen = 0;
-      currentPos = file.tellg();
     }
 
     // ===| read in the RawDataHeader at the current position |=================
-    file >> rdh;
+    if (!readHeader(rdh, currentPos)) {
+      LOGP(error, "File truncated at {}, RDH would exceed file size of {}", currentPos, mFileSize);
+      break;
+    }
 
     const size_t packetSize = RDHUtils::getOffsetToNext(rdh);
     const size_t offset = packetSize - RDHUtils::getHeaderSize(rdh);
@@ -274,21 +370,81 @@ int RawReaderCRU::scanFile()
     dhPayloadSizeSeen += packetSize;
 
     // ===| check for truncated file |==========================================
-    const size_t curPos = file.tellg();
+    const size_t curPos = currentPos + sizeof(rdh);
     if ((curPos + offset) > mFileSize) {
       LOGP(error, "File truncated at {}, offset {} would exceed file size of {}", curPos, offset, mFileSize);
       break;
     }
+    const size_t nextPos = curPos + offset;
 
     // ===| skip IDC data |=====================================================
     const auto detField = o2::raw::RDHUtils::getDetectorField(rdh);
     if (((detField != 0xdeadbeef) && (detField > 1)) || (payloadSize == 0)) {
-      file.seekg(offset, file.cur);
-      ++currentPacket;
-      currentPos = file.tellg();
+      currentPos = nextPos;
       continue;
     }
 
+    // ===| get relavant data information |=====================================
+    auto feeId = RDHUtils::getFEEID(rdh);
+    // treat old RDH where feeId was not set properly
+    if (feeId == 4844) {
+      const rdh_utils::FEEIDType cru = RDHUtils::getCRUID(rdh);
+      const rdh_utils::FEEIDType link = RDHUtils::getLinkID(rdh);
+      const rdh_utils::FEEIDType endPoint = RDHUtils::getEndPointID(rdh);
+      feeId = rdh_utils::getFEEID(cru, endPoint, link);
+
+      RDHUtils::setFEEID(rdh, feeId);
+    }
+    const auto heartbeatOrbit = RDHUtils::getHeartBeatOrbit(rdh);
+    const auto heartbeatOrbitEvent = isTFfile ? dh.firstTForbit : RDHUtils::getHeartBeatOrbit(rdh);
+    const auto endPoint = rdh_utils::getEndPoint(feeId);
+    const auto linkID = rdh_utils::getLink(feeId);
+    const auto globalLinkID = linkID + endPoint * 12;
+
+    // ===| check if cru should be forced |=====================================
+    if (!mForceCRU) {
+      mCRU = rdh_utils::getCRU(feeId);
+      //mCRU = RDHUtils::getCRUID(rdh); // work-around for MW2 data
+    } else {
+      //overwrite cru id in rdh for further processing
+      RDHUtils::setCRUID(rdh, mCRU);
+    }
+
+    // ===| set up packet descriptor map for GBT frames |=======================
+    //
+    // * check Header for Header ID
+    // * create the packet descriptor
+    // * set the mLinkPresent flag
+    //
+    ScannedPacket packet{rdh, heartbeatOrbitEvent, uint32_t(globalLinkID), mCRU, -1, (rdh.word0 & 0x0000FFF0) == RDH_HEADERWORD0};
+    if (packet.validHeader && payloadSize) {
+      // non 0 stop bit means data with payload
+      mPacketDescriptorMaps[globalLinkID].emplace_back(currentPos, mCRU, linkID, endPoint, memorySize, packetSize, heartbeatOrbit);
+      mLinkPresent[globalLinkID] = true;
+      packet.packetNumber = mPacketsPerLink[globalLinkID]++;
+    }
+    mScannedPackets.emplace_back(packet);
+
+    if (!packet.validHeader) {
+      O2ERROR("Found header word %x and required header word %x don't match, at %zu, stopping file scan", rdh.word0, RDH_HEADERWORD0, currentPos);
+      break;
+    }
+
+    currentPos = nextPos;
+  }
+
+  mFileIsIndexed = true;
+
+  return 0;
+}
+
+void RawReaderCRU::fillEventSync()
+{
+  uint32_t lastHeartbeatOrbit = 0;
+
+  for (const auto& packet : mScannedPackets) {
+    const auto& rdh = packet.rdh;
+
     // ===| try to detect data type if not already set |========================
     //
     // for now we assume only HB scaling and triggered mode
@@ -296,12 +452,14 @@ int RawReaderCRU::scanFile()
     // in case of triggered data we assume that that the for pageCnt == 1 we have
     //   triggerType == 0x10 in the firt packet
     //
+    RawReaderCRUEventSync::LinkInfo* linkInfo = nullptr;
     if (mManager) {
       if (mManager->mDetectDataType) {
         const uint64_t triggerTypeForTriggeredData = 0x10;
         const uint64_t triggerType = RDHUtils::getTriggerType(rdh);
         const uint64_t pageCnt = RDHUtils::getPageCounter(rdh);
         const uint64_t linkID = RDHUtils::getLinkID(rdh);
+        const auto detField = o2::raw::RDHUtils::getDetectorField(rdh);
 
         //if (pageCnt == 0) {
         if ((linkID == 15) || (detField == 0x1)) {
@@ -322,74 +480,32 @@ int RawReaderCRU::scanFile()
           mManager->mDetectDataType = false;
         }
       }
-    }
-
-    // ===| get relavant data information |=====================================
-    auto feeId = RDHUtils::getFEEID(rdh);
-    // treat old RDH where feeId was not set properly
-    if (feeId == 4844) {
-      const rdh_utils::FEEIDType cru = RDHUtils::getCRUID(rdh);
-      const rdh_utils::FEEIDType link = RDHUtils::getLinkID(rdh);
-      const rdh_utils::FEEIDType endPoint = RDHUtils::getEndPointID(rdh);
-      feeId = rdh_utils::getFEEID(cru, endPoint, link);
-
-      RDHUtils::setFEEID(rdh, feeId);
-    }
-    const auto heartbeatOrbit = RDHUtils::getHeartBeatOrbit(rdh);
-    const auto heartbeatOrbitEvent = isTFfile ? dh.firstTForbit : RDHUtils::getHeartBeatOrbit(rdh);
-    const auto endPoint = rdh_utils::getEndPoint(feeId);
-    const auto linkID = rdh_utils::getLink(feeId);
-    const auto globalLinkID = linkID + endPoint * 12;
 
-    // ===| check if cru should be forced |=====================================
-    if (!mForceCRU) {
-      mCRU = rdh_utils::getCRU(feeId);
-      //mCRU = RDHUtils::getCRUID(rdh); // work-around for MW2 data
-    } else {
-      //overwrite cru id in rdh for further processing
-      RDHUtils::setCRUID(rdh, mCRU);
-    }
-
-    // ===| find evnet info or create a new one |===============================
-    RawReaderCRUEventSync::LinkInfo* linkInfo = nullptr;
-    if (mManager) {
+      // ===| find evnet info or create a new one |===============================
       // in case of triggered mode, we use the first heartbeat orbit as event identifier
-      if ((lastHeartbeatOrbit == 0) || (heartbeatOrbitEvent != lastHeartbeatOrbit)) {
-        mManager->mEventSync.createEvent(heartbeatOrbitEvent, mManager->getDataType());
-        lastHeartbeatOrbit = heartbeatOrbitEvent;
+      if ((lastHeartbeatOrbit == 0) || (packet.heartbeatOrbitEvent != lastHeartbeatOrbit)) {
+        mManager->mEventSync.createEvent(packet.heartbeatOrbitEvent, mManager->getDataType());
+        lastHeartbeatOrbit = packet.heartbeatOrbitEvent;
       }
       linkInfo = &mManager->mEventSync.getLinkInfo(rdh, mManager->getDataType());
-      mManager->mEventSync.setCRUSeen(mCRU, mReaderNumber);
+      mManager->mEventSync.setCRUSeen(packet.cru, mReaderNumber);
     }
 
-    // ===| set up packet descriptor map for GBT frames |=======================
-    //
-    // * check Header for Header ID
-    // * create the packet descriptor
-    // * set the mLinkPresent flag
-    //
-    if ((rdh.word0 & 0x0000FFF0) == RDH_HEADERWORD0) {
-      // non 0 stop bit means data with payload
-      if (payloadSize) {
-        mPacketDescriptorMaps[globalLinkID].emplace_back(currentPos, mCRU, linkID, endPoint, memorySize, packetSize, heartbeatOrbit);
-        mLinkPresent[globalLinkID] = true;
-        mPacketsPerLink[globalLinkID]++;
-        if (linkInfo) {
-          linkInfo->PacketPositions.emplace_back(mPacketsPerLink[globalLinkID] - 1);
-          linkInfo->IsPresent = true;
-          linkInfo->PayloadSize += payloadSize;
-        }
+    if (!packet.validHeader) {
+      break;
+    }
+
+    if (linkInfo) {
+      if (packet.packetNumber >= 0) {
+        linkInfo->PacketPositions.emplace_back(packet.packetNumber);
+        linkInfo->IsPresent = true;
+        linkInfo->PayloadSize += RDHUtils::getMemorySize(rdh) - RDHUtils::getHeaderSize(rdh);
       }
       if (RDHUtils::getStop(rdh) == 1) {
         // stop bit 1 means we hit the HB end frame without payload.
         // This marks the end of an "event" in HB scaling mode.
-        if (linkInfo) {
-          linkInfo->HBEndSeen = true;
-        }
+        linkInfo->HBEndSeen = true;
       }
-    } else {
-      O2ERROR("Found header word %x and required header word %x don't match, at %zu, stopping file scan", rdh.word0, RDH_HEADERWORD0, currentPos);
-      break;
     }
 
     // debug output
@@ -400,59 +516,15 @@ int RawReaderCRU::scanFile()
         printHeader();
       }
     }
-
-    file.seekg(offset, file.cur);
-    ++currentPacket;
-    currentPos = file.tellg();
-  }
-
-  // close the File
-  file.close();
-
-  // go through events and set the status if links were seen
-  if (mManager) {
-    // in case of triggered mode, we use the first heartbeat orbit as event identifier
-    mManager->mEventSync.setLinksSeen(mCRU, mLinkPresent);
   }
 
-  if (mVerbosity) {
-    // show the mLinkPresent map
-    std::cout << "Links present" << std::endl;
-    for (int i = 0; i < MaxNumberOfLinks; i++) {
-      mLinkPresent[i] == true ? std::cout << "1 " : std::cout << "0 ";
-    };
-    std::cout << '\n';
-
-    std::cout << std::dec
-              << "File Name         : " << mInputFileName << "\n"
-              << "File size [bytes] : " << mFileSize << "\n"
-              << "Packets           : " << numPackets << "\n"
-              << "\n";
-
-    if (mVerbosity > 1) {
-      // ===| display packet statistics |===
-      for (int i = 0; i < MaxNumberOfLinks; i++) {
-        if (mLinkPresent[i]) {
-          std::cout << "Packets for link " << i << ": " << mPacketsPerLink[i] << "\n";
-          //
-          // ===| display the packet descriptor map |===
-          for (const auto& pd : mPacketDescriptorMaps[i]) {
-            std::cout << pd << "\n";
-          }
-        }
-      }
-      std::cout << "\n";
-    }
-  }
-
-  mFileIsScanned = true;
-
-  return 0;
+  // only needed once
+  std::vector<ScannedPacket>().swap(mScannedPackets);
 }
 
 void RawReaderCRU::findSyncPositions()
 {
-  auto& file = getFileHandle();
+  const auto data = getFileData();
 
   // loop over the MaxNumberOfLinks potential links in the data
   // only if data from the link is present and selected
@@ -475,13 +547,11 @@ void RawReaderCRU::findSyncPositions()
     for (auto packet : mPacketDescriptorMaps[link]) {
       gFrame.setPacketNumber(packetID);
 
-      file.seekg(packet.getPayloadOffset(), file.beg);
-
       // read in the data frame by frame, extract the 5-bit halfwords for
       // the two data streams and store them in the corresponding half-word
       // vectors
       for (int frames = 0; frames < packet.getPayloadSize() / 16; frames++) {
-        file >> gFrame;
+        gFrame.readFromFile(data, packet.getPayloadOffset() + frames * 16);
         // extract the half words from the 4 32-bit words
         gFrame.getFrameHalfWords();
         gFrame.updateSyncCheck(mSyncPositions[link]);
@@ -508,17 +578,14 @@ void RawReaderCRU::findSyncPositions()
 
 int RawReaderCRU::processPacket(GBTFrame& gFrame, uint32_t startPos, uint32_t size, ADCRawData& rawData)
 {
-  // open the data file
-  auto& file = getFileHandle();
+  // the mapped data file
+  const auto data = getFileData();
 
-  // jump to the start position of the packet
-  file.seekg(startPos, file.beg);
-
-  // read in the data frame by frame, extract the 5-bit halfwords for
-  // the two data streams and store them in the corresponding half-word
-  // vectors
+  // read in the data frame by frame, starting at the start position of the packet,
+  // extract the 5-bit halfwords for the two data streams and store them in the
+  // corresponding half-word vectors
   for (int frames = 0; frames < size / 16; frames++) {
-    file >> gFrame;
+    gFrame.readFromFile(data, startPos + frames * 16);
 
     // extract the half words from the 4 32-bit words
     gFrame.getFrameHalfWords();
@@ -537,38 +604,54 @@ int RawReaderCRU::processPacket(GBTFrame& gFrame, uint32_t startPos, uint32_t si
   return 0;
 }
 
-int RawReaderCRU::processMemory(const std::vector<std::byte>& data, ADCRawData& rawData)
+int RawReaderCRU::processMemory(uint32_t link, ADCRawData& rawData)
 {
   GBTFrame gFrame;
 
   const bool dumpSyncPositoins = CHECK_BIT(mDebugLevel, DebugLevel::SyncPositions);
 
-  // 16 bytes is the size of a GBT frame
-  for (int iFrame = 0; iFrame < data.size() / 16; ++iFrame) {
-    gFrame.setFrameNumber(iFrame);
-    gFrame.setPacketNumber(iFrame / 508);
+  // the payloads of the link are decoded in place from the mapped file,
+  // this method is const apart from the output, such that links can be decoded concurrently
+  const auto data = getFileData();
+  const auto& linkInfoArray = mManager->mEventSync.getLinkInfoArrayForEvent(mEventNumber, mCRU);
 
-    // in readFromMemory a simple memcopy to the internal data structure is done
-    // I tried using the memory block directly, storing in an internal data member
-    // reinterpret_cast<const uint32_t*>(data.data() + iFrame * 16), so it could be accessed the
-    // same way as the mData array.
-    // however, this was ~5% slower in execution time. I suspect due to cache misses
-    gFrame.readFromMemory(gsl::span<const std::byte>(data.data() + iFrame * 16, 16));
+  int iFrame = 0;
+  bool done = false;
+  for (auto packetNumber : linkInfoArray[link].PacketPositions) {
+    const auto& packet = mPacketDescriptorMaps[link][packetNumber];
+    const size_t payloadOffset = packet.getPayloadOffset();
 
-    // extract the half words from the 4 32-bit words
-    gFrame.getFrameHalfWords();
+    // 16 bytes is the size of a GBT frame
+    for (int frame = 0; frame < packet.getPayloadSize() / 16; ++frame, ++iFrame) {
+      gFrame.setFrameNumber(iFrame);
+      gFrame.setPacketNumber(iFrame / 508);
 
-    // debug output
-    if (mVerbosity && CHECK_BIT(mDebugLevel, DebugLevel::GBTFrames)) {
-      std::cout << gFrame;
-    }
+      // in readFromMemory a simple memcopy to the internal data structure is done
+      // I tried using the memory block directly, storing in an internal data member
+      // reinterpret_cast<const uint32_t*>(data.data() + iFrame * 16), so it could be accessed the
+      // same way as the mData array.
+      // however, this was ~5% slower in execution time. I suspect due to cache misses
+      gFrame.readFromMemory(data.subspan(payloadOffset + frame * 16, 16));
 
-    gFrame.getAdcValues(rawData);
-    gFrame.updateSyncCheck(mVerbosity && dumpSyncPositoins);
-    if (!(rawData.getNumTimebins() % 16) && (rawData.getNumTimebins() >= mNumTimeBins * 16)) {
+      // extract the half words from the 4 32-bit words
+      gFrame.getFrameHalfWords();
+
+      // debug output
+      if (mVerbosity && CHECK_BIT(mDebugLevel, DebugLevel::GBTFrames)) {
+        std::cout << gFrame;
+      }
+
+      gFrame.getAdcValues(rawData);
+      gFrame.updateSyncCheck(mVerbosity && dumpSyncPositoins);
+      if (!(rawData.getNumTimebins() % 16) && (rawData.getNumTimebins() >= mNumTimeBins * 16)) {
+        done = true;
+        break;
+      }
+    }
+    if (done) {
       break;
     }
-  };
+  }
 
   if (mDumpTextFiles && dumpSyncPositoins) {
     const auto fileName = mOutputFilePrefix + "/LinkPositions.txt";
@@ -580,7 +663,7 @@ int RawReaderCRU::processMemory(const std::vector<std::byte>& data, ADCRawData&
       if (syncPos.synched()) {
         file << mEventNumber << "\t"
              << mCRU.number() << "\t"
-             << mLink << "\t"
+             << link << "\t"
              << s << "\t"
              << syncPos.getPacketNumber() << "\t"
              << syncPos.getFrameNumber() << "\t"
@@ -739,21 +822,9 @@ void RawReaderCRU::processDataMemory()
     std::cout << "Num packets : " << mPacketsPerLink[mLink] << std::endl;
   }
 
-  size_t dataSize = 4000 * 16;
-  //if (mDataType == DataType::HBScaling) {
-  //dataSize =
-  //} else if (mDataType == DataType::Triggered) {
-  //// in triggered mode 4000 GBT frames are read out
-  //// 16 is the size of a GBT frame in byte
-  //dataSize = 4000 * 16;
-  //}
-
-  std::vector<std::byte> data;
-  data.reserve(dataSize);
-  collectGBTData(data);
-
-  ADCRawData rawData;
-  processMemory(data, rawData);
+  auto& rawData = mLinkData[mLink];
+  rawData.reset();
+  processMemory(mLink, rawData);
 
   // ===| fill ADC data to the output structure |===
   if (mFillADCdataMap) {
@@ -764,40 +835,13 @@ void RawReaderCRU::processDataMemory()
   }
 }
 
-void RawReaderCRU::collectGBTData(std::vector<std::byte>& data)
-{
-  const auto& linkInfoArray = mManager->mEventSync.getLinkInfoArrayForEvent(mEventNumber, mCRU);
-  auto& file = getFileHandle();
-
-  size_t presentDataPosition = 0;
-
-  // loop over the packets for each link and process them
-  //for (const auto& packet : mPacketDescriptorMaps[link]) {
-  for (auto packetNumber : linkInfoArray[mLink].PacketPositions) {
-    const auto& packet = mPacketDescriptorMaps[mLink][packetNumber];
-
-    const auto payloadStart = packet.getPayloadOffset();
-    const auto payloadSize = size_t(packet.getPayloadSize());
-    data.insert(data.end(), payloadSize, (std::byte)0);
-    // jump to the start position of the packet
-    file.seekg(payloadStart, std::ios::beg);
-
-    // read data
-    file.read(((char*)data.data()) + presentDataPosition, payloadSize);
-
-    presentDataPosition += payloadSize;
-  }
-}
-
 void RawReaderCRU::processLinkZS()
 {
   const auto& eventInfo = mManager->mEventSync.getEventInfo(mEventNumber);
   const auto& linkInfoArray = eventInfo.CRUInfoArray[mCRU].LinkInformation;
   const auto firstOrbitInEvent = eventInfo.getFirstOrbit();
 
-  auto& file = getFileHandle();
-
-  char buffer[8192];
+  const auto data = getFileData();
 
   // loop over the packets for each link and process them
   for (const auto packetNumber : linkInfoArray[mLink].PacketPositions) {
@@ -808,10 +852,9 @@ void RawReaderCRU::processLinkZS()
       LOGP(error, "File truncated at {}, size {} would exceed file size of {}", payloadOffset, payloadSize, mFileSize);
       break;
     }
-    file.seekg(payloadOffset, file.beg);
-    file.read(buffer, payloadSize);
-    const uint32_t syncOffsetReference = 144;                                                                                                                                                     // <<< TODO: fix value as max offset over all links
-    o2::tpc::raw_processing_helpers::processZSdata(buffer, payloadSize, packet.getFEEID(), packet.getHeartBeatOrbit(), firstOrbitInEvent, syncOffsetReference, mManager->mLinkZSCallback, false); // last parameter should be true for MW2 data
+    const auto payload = reinterpret_cast<const char*>(data.data() + payloadOffset);
+    const uint32_t syncOffsetReference = 144;                                                                                                                                                      // <<< TODO: fix value as max offset over all links
+    o2::tpc::raw_processing_helpers::processZSdata(payload, payloadSize, packet.getFEEID(), packet.getHeartBeatOrbit(), firstOrbitInEvent, syncOffsetReference, mManager->mLinkZSCallback, false); // last parameter should be true for MW2 data
   }
 }
 
@@ -836,9 +879,42 @@ void RawReaderCRU::processLinks(const uint32_t linkMask)
     // loop over the MaxNumberOfLinks potential links in the data
     // only if data from the link is present and selected
     // for decoding it will be decoded.
+    std::vector<uint32_t> links;
     for (int lnk = 0; lnk < MaxNumberOfLinks; lnk++) {
       // all links have been selected
       if (((linkMask == 0) || ((linkMask >> lnk) & 1)) && checkLinkPresent(lnk) == true) {
+        links.emplace_back(lnk);
+      }
+    }
+
+    if (mManager->mRawDataType == RAWDataType::GBT && !mDumpTextFiles) {
+      // ===| decode the links concurrently |===
+      // the output and the callbacks are processed afterwards in link order
+#ifdef WITH_OPENMP
+      const int nThreads = mVerbosity ? 1 : mManager->mNThreads;
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+      for (size_t i = 0; i < links.size(); ++i) {
+        auto& rawData = mLinkData[links[i]];
+        rawData.reset();
+        processMemory(links[i], rawData);
+      }
+
+      for (const auto lnk : links) {
+        if (mDebugLevel) {
+          fmt::print("Processing link {}\n", lnk);
+        }
+        setLink(lnk);
+        const auto& rawData = mLinkData[lnk];
+        if (mFillADCdataMap) {
+          fillADCdataMap(rawData);
+        }
+        if (mManager->mADCDataCallback) {
+          runADCDataCallback(rawData);
+        }
+      }
+    } else {
+      for (const auto lnk : links) {
         // set the active link variable and process the data
         if (mDebugLevel) {
           fmt::print("Processing link {}\n", lnk);
@@ -919,11 +995,8 @@ void RawReaderCRU::copyEvents(const std::vector<uint32_t>& eventNumbers, std::st
 
   std::ofstream outputFile(outputFileName, std::ios_base::binary | mode);
 
-  // open the input file
-  auto& file = getFileHandle();
-
-  // data buffer. Maximum size is 8k
-  char buffer[8192];
+  // the mapped input file
+  const auto data = getFileData();
 
   // loop over events
   for (const auto eventNumber : eventNumbers) {
@@ -937,9 +1010,7 @@ void RawReaderCRU::copyEvents(const std::vector<uint32_t>& eventNumbers, std::st
       }
       for (auto packetNumber : linkInfo.PacketPositions) {
         const auto& packet = mPacketDescriptorMaps[iLink][packetNumber];
-        file.seekg(packet.getHeaderOffset(), file.beg);
-        file.read(buffer, packet.getPacketSize());
-        outputFile.write(buffer, packet.getPacketSize());
+        outputFile.write(reinterpret_cast<const char*>(data.data() + packet.getHeaderOffset()), packet.getPacketSize());
       }
     }
   }
@@ -947,11 +1018,8 @@ void RawReaderCRU::copyEvents(const std::vector<uint32_t>& eventNumbers, std::st
 
 void RawReaderCRU::writeGBTDataPerLink(std::string_view outputDirectory, int maxEvents)
 {
-  // open the input file
-  auto& file = getFileHandle();
-
-  // data buffer. Maximum size is 8k
-  char buffer[8192];
+  // the mapped input file
+  const auto data = getFileData();
 
   // loop over events
   for (int eventNumber = 0; eventNumber < getNumberOfEvents(); ++eventNumber) {
@@ -975,9 +1043,7 @@ void RawReaderCRU::writeGBTDataPerLink(std::string_view outputDirectory, int max
 
       for (auto packetNumber : linkInfo.PacketPositions) {
         const auto& packet = mPacketDescriptorMaps[iLink][packetNumber];
-        file.seekg(packet.getPayloadOffset(), file.beg);
-        file.read(buffer, packet.getPayloadSize());
-        outputFile.write(buffer, packet.getPayloadSize());
+        outputFile.write(reinterpret_cast<const char*>(data.data() + packet.getPayloadOffset()), packet.getPayloadSize());
       }
     }
   }
@@ -1144,6 +1210,20 @@ void RawReaderCRUManager::init()
     return;
   }
 
+  // map all files first, such that errors are raised outside of the parallel section
+  for (auto& reader : mRawReadersCRU) {
+    reader->getFileData();
+  }
+
+  // the packet index of each file is independent of the others and can be built concurrently,
+  // the event information is then filled in reader order
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+#endif
+  for (size_t i = 0; i < mRawReadersCRU.size(); ++i) {
+    mRawReadersCRU[i]->indexFile();
+  }
+
   for (auto& reader : mRawReadersCRU) {
     reader->scanFile();
   }
@@ -0,0 +1,67 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCGBTFrame.cxx
+/// \brief This task tests the table driven half word extraction of the GBT frames in the CRU raw reader
+
+#define BOOST_TEST_MODULE Test TPC GBTFrame
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCReconstruction/RawReaderCRU.h"
+
+#include <array>
+#include <random>
+
+namespace o2
+{
+namespace tpc
+{
+
+using namespace rawreader;
+
+/// bit s of the frame
+uint32_t frameBit(const std::array<uint32_t, 4>& frame, int s)
+{
+  return (frame[s / 32] >> (s % 32)) & 1;
+}
+
+/// reference extraction, bit by bit, of half word j of stream i
+uint32_t halfWordReference(const std::array<uint32_t, 4>& frame, int i, int j)
+{
+  constexpr int P[5][4] = {{19, 18, 17, 16}, {39, 38, 37, 36}, {63, 62, 61, 60}, {83, 82, 81, 80}, {107, 106, 105, 104}};
+  uint32_t halfWord = 0;
+  for (int b = 0; b < 5; ++b) {
+    halfWord |= frameBit(frame, P[i][j] - 4 * (4 - b)) << b;
+  }
+  return halfWord;
+}
+
+/// @brief compare the table driven extraction of GBTFrame with the bitwise extraction
+BOOST_AUTO_TEST_CASE(GBTFrame_halfWords)
+{
+  std::mt19937 eng(42);
+  GBTFrame gFrame;
+
+  for (int iFrame = 0; iFrame < 10000; ++iFrame) {
+    const std::array<uint32_t, 4> frame{uint32_t(eng()), uint32_t(eng()), uint32_t(eng()), uint32_t(eng())};
+    gFrame.readFromMemory(gsl::as_bytes(gsl::span<const uint32_t>(frame)));
+    gFrame.getFrameHalfWords();
+    for (int i = 0; i < 5; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        BOOST_CHECK_EQUAL(gFrame.getFrameHalfWord(i, j), halfWordReference(frame, i, j));
+      }
+    }
+  }
+}
+
+} // namespace tpc
+} // namespace o2
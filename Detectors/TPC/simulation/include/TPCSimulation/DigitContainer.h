@@ -17,6 +17,7 @@
 #define ALICEO2_TPC_DigitContainer_H_
 
 #include <deque>
+#include <vector>
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
 #include "TPCSimulation/DigitTime.h"
@@ -80,11 +81,12 @@ class DigitContainer
   size_t size() const { return mTimeBins.size(); }
 
  private:
-  TimeBin mFirstTimeBin = 0;       ///< First time bin to consider
-  TimeBin mEffectiveTimeBin = 0;   ///< Effective time bin of that digit
-  TimeBin mTmaxTriggered = 0;      ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
-  TimeBin mOffset;                 ///< Size of the container for one event
-  std::deque<DigitTime> mTimeBins; ///< Time bin Container for the ADC value
+  TimeBin mFirstTimeBin = 0;                ///< First time bin to consider
+  TimeBin mEffectiveTimeBin = 0;            ///< Effective time bin of that digit
+  TimeBin mTmaxTriggered = 0;               ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
+  TimeBin mOffset;                          ///< Size of the container for one event
+  std::deque<DigitTime> mTimeBins;          ///< Time bin Container for the ADC value
+  std::vector<DigitTime> mRecycledTimeBins; ///< Flushed time bins, kept to reuse their memory
 };
 
 inline DigitContainer::DigitContainer()
@@ -110,8 +112,13 @@ inline void DigitContainer::reset()
 
 inline void DigitContainer::reserve(TimeBin eventTimeBin)
 {
-  if (mTimeBins.size() < mOffset + eventTimeBin - mFirstTimeBin) {
-    mTimeBins.resize(mOffset + eventTimeBin - mFirstTimeBin);
+  const size_t requiredSize = mOffset + eventTimeBin - mFirstTimeBin;
+  while (mTimeBins.size() < requiredSize && !mRecycledTimeBins.empty()) {
+    mTimeBins.emplace_back(std::move(mRecycledTimeBins.back()));
+    mRecycledTimeBins.pop_back();
+  }
+  if (mTimeBins.size() < requiredSize) {
+    mTimeBins.resize(requiredSize);
   }
 }
 
@@ -21,6 +21,9 @@
 #include "SimulationDataFormat/LabelContainer.h"
 #include "TPCSimulation/CommonMode.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace o2
 {
 namespace tpc
@@ -33,6 +36,9 @@ class Digit;
 /// sorted into after amplification
 /// The structure assures proper sorting of the Digits when later on written out for further processing.
 /// This class holds the individual Pad Row containers and is contained within the CRU Container.
+/// Only the pads which received a signal are stored: the pad slots are allocated in order of arrival and found
+/// by an open addressing index, so that memory and processing time scale with the occupancy and not with the number
+/// of pads in the sector. The capacity of the containers is kept on reset, such that the objects can be recycled.
 
 class DigitTime
 {
@@ -43,6 +49,11 @@ class DigitTime
   /// Destructor
   ~DigitTime() = default;
 
+  DigitTime(const DigitTime&) = default;
+  DigitTime(DigitTime&&) = default;
+  DigitTime& operator=(const DigitTime&) = default;
+  DigitTime& operator=(DigitTime&&) = default;
+
   /// Resets the container
   void reset();
 
@@ -75,38 +86,78 @@ class DigitTime
   void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth,
                            std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin timeBin, float commonMode = 0.f);
 
+  /// Get the number of pads with a signal in this time bin
+  size_t getNumberOfOccupiedPads() const { return mPads.size(); }
+
  private:
-  std::array<float, GEMSTACKSPERSECTOR> mCommonMode;                 ///< Common mode container - 4 GEM ROCs per sector
-  std::array<DigitGlobalPad, Mapper::getPadsInSector()> mGlobalPads; ///< Pad Container for the ADC value
-  int mDigitCounter = 0;                                             ///< counts the number of digits in this timebin
+  /// Entries of the index pack the global pad number (upper 16 bits) and the pad slot (lower 16 bits)
+  static constexpr uint32_t EmptyEntry = 0xFFFFFFFF;
+  static constexpr size_t MinIndexSize = 64;
+
+  /// Find the slot of a pad, creating it if needed
+  int getPadSlot(GlobalPadNumber globalPad);
+
+  /// Double the size of the index and re-insert the occupied pads
+  void growIndex();
+
+  static uint32_t hashPad(GlobalPadNumber globalPad)
+  {
+    const uint32_t hash = uint32_t(globalPad) * 2654435761u;
+    return hash ^ (hash >> 15);
+  }
+
+  std::array<float, GEMSTACKSPERSECTOR> mCommonMode; ///< Common mode container - 4 GEM ROCs per sector
+  std::vector<DigitGlobalPad> mPads;                 ///< Pad slots for the ADC value, in order of arrival
+  std::vector<GlobalPadNumber> mOccupiedPads;        ///< Global pad number of each pad slot
+  std::vector<uint32_t> mPadIndex;                   ///< Open addressing index global pad -> slot
+  std::vector<uint32_t> mSortedPads;                 //!< Workspace for ordering the pad slots in global pad number
+  int mDigitCounter = 0;                             ///< counts the number of digits in this timebin
 
   o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false> mLabels;
-  // std::deque<int> mOccupiedPads; // iterable container of occupied pads
 };
 
-inline DigitTime::DigitTime() : mCommonMode(), mGlobalPads()
+inline DigitTime::DigitTime() : mCommonMode(), mPadIndex(MinIndexSize, EmptyEntry)
 {
   mCommonMode.fill(0.f);
-  mLabels.reserve(Mapper::getPadsInSector() / 3);
 }
 
-inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
+inline int DigitTime::getPadSlot(GlobalPadNumber globalPad)
 {
-  auto& paddigit = mGlobalPads[globalPad];
-  if (paddigit.getID() == -1) {
-    // this means we have a new digit
-    paddigit.setID(mDigitCounter++);
-    // could also register this pad in a vector of digits
+  const uint32_t mask = mPadIndex.size() - 1;
+  for (uint32_t pos = hashPad(globalPad) & mask;; pos = (pos + 1) & mask) {
+    const auto entry = mPadIndex[pos];
+    if (entry == EmptyEntry) {
+      // this means we have a new digit
+      const int slot = mDigitCounter++;
+      mPadIndex[pos] = (uint32_t(globalPad) << 16) | uint32_t(slot);
+      mPads.emplace_back();
+      mPads.back().setID(slot);
+      mOccupiedPads.emplace_back(globalPad);
+      if (2 * mPads.size() > mPadIndex.size()) {
+        growIndex();
+      }
+      return slot;
+    }
+    if ((entry >> 16) == globalPad) {
+      return entry & 0xFFFF;
+    }
   }
+}
+
+inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
+{
+  auto& paddigit = mPads[getPadSlot(globalPad)];
   paddigit.addDigit(label, signal, mLabels);
   mCommonMode[cru.gemStack()] += signal;
 }
 
 inline void DigitTime::reset()
 {
-  for (auto& pad : mGlobalPads) {
-    pad.reset();
-  }
+  mPads.clear();
+  mOccupiedPads.clear();
+  std::fill(mPadIndex.begin(), mPadIndex.end(), EmptyEntry);
+  mLabels.clear();
+  mDigitCounter = 0;
   mCommonMode.fill(0.f);
 }
 
@@ -124,19 +175,25 @@ inline void DigitTime::fillOutputContainer(std::vector<Digit>& output, dataforma
                                            float commonMode)
 {
   static Mapper& mapper = Mapper::instance();
-  GlobalPadNumber globalPad = 0;
   for (size_t i = 0; i < mCommonMode.size(); ++i) {
     const float cm = getCommonMode(GEMstack(i));
     if (cm > 0.) {
       commonModeOutput.push_back({cm, timeBin, static_cast<unsigned char>(i)});
     }
   }
-  for (auto& pad : mGlobalPads) {
+  /// the digits are written out ordered in global pad number, as if looping over all pads of the sector
+  mSortedPads.clear();
+  for (size_t slot = 0; slot < mPads.size(); ++slot) {
+    mSortedPads.emplace_back((uint32_t(mOccupiedPads[slot]) << 16) | uint32_t(slot));
+  }
+  std::sort(mSortedPads.begin(), mSortedPads.end());
+  for (const auto entry : mSortedPads) {
+    auto& pad = mPads[entry & 0xFFFF];
     if (pad.getChargePad() > 0.) {
+      const GlobalPadNumber globalPad = entry >> 16;
       const CRU cru = mapper.getCRU(sector, globalPad);
       pad.fillOutputContainer<MODE>(output, mcTruth, cru, timeBin, globalPad, mLabels, getCommonMode(cru));
     }
-    ++globalPad;
   }
 }
 } // namespace tpc
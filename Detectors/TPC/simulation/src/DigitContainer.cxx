@@ -63,6 +63,8 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   if (nProcessedTimeBins > 0) {
     mFirstTimeBin += nProcessedTimeBins;
     while (nProcessedTimeBins--) {
+      mTimeBins.front().reset();
+      mRecycledTimeBins.emplace_back(std::move(mTimeBins.front()));
       mTimeBins.pop_front();
     }
   }
@@ -16,3 +16,17 @@
 #include "TPCSimulation/DigitTime.h"
 
 using namespace o2::tpc;
+
+void DigitTime::growIndex()
+{
+  mPadIndex.assign(2 * mPadIndex.size(), EmptyEntry);
+  const uint32_t mask = mPadIndex.size() - 1;
+  for (size_t slot = 0; slot < mOccupiedPads.size(); ++slot) {
+    const auto globalPad = mOccupiedPads[slot];
+    auto pos = hashPad(globalPad) & mask;
+    while (mPadIndex[pos] != EmptyEntry) {
+      pos = (pos + 1) & mask;
+    }
+    mPadIndex[pos] = (uint32_t(globalPad) << 16) | uint32_t(slot);
+  }
+}
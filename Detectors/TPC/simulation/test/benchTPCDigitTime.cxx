@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchTPCDigitTime.cxx
+/// \brief Benchmark of the filling and flushing of the TPC digitization time bin container
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsTPC/Digit.h"
+#include "TPCSimulation/DigitTime.h"
+#include "TPCBase/CDBInterface.h"
+#include "TPCBase/Mapper.h"
+#include <random>
+#include <vector>
+
+using namespace o2::tpc;
+
+// The signals of one time bin are generated for a given occupancy (in per mille of the pads of a sector),
+// with a few electrons per occupied pad: ~1% corresponds to pp, ~20% to central Pb-Pb collisions.
+static std::vector<GlobalPadNumber> createPads(int occupancyPerMille)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> padDist(0, Mapper::getPadsInSector() - 1);
+  std::uniform_int_distribution<int> electronsDist(1, 8);
+  std::vector<GlobalPadNumber> pads;
+  const int nOccupied = Mapper::getPadsInSector() * occupancyPerMille / 1000;
+  for (int i = 0; i < nOccupied; ++i) {
+    const auto pad = padDist(gen);
+    for (int iele = electronsDist(gen); iele--;) {
+      pads.emplace_back(pad);
+    }
+  }
+  return pads;
+}
+
+static void benchDigitTime(benchmark::State& state)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  const Mapper& mapper = Mapper::instance();
+  const auto pads = createPads(state.range(0));
+  std::vector<CRU> crus;
+  for (auto pad : pads) {
+    crus.emplace_back(mapper.getCRU(Sector(0), pad));
+  }
+  DigitTime digitTime;
+  std::vector<Digit> digits;
+  std::vector<CommonMode> commonMode;
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel> mcTruth;
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < pads.size(); ++i) {
+      digitTime.addDigit(o2::MCCompLabel(i % 100, 0, 0, false), crus[i], pads[i], 10.f);
+    }
+    digitTime.fillOutputContainer<DigitzationMode::PropagateADC>(digits, mcTruth, commonMode, Sector(0), 0);
+    digitTime.reset();
+    digits.clear();
+    commonMode.clear();
+    mcTruth.clear();
+  }
+  state.counters["signals"] = pads.size();
+}
+
+// occupancy in per mille: pp-like and Pb-Pb-like time bins
+BENCHMARK(benchDigitTime)->Arg(10)->Arg(50)->Arg(200);
+
+BENCHMARK_MAIN();
@@ -166,5 +166,51 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the DigitTime
+/// Many pads of one time bin are filled in random order, several times, such that the pad index has to grow,
+/// and we check that the digits are written out ordered in pad number with the accumulated charge, also after
+/// the time bin has been reset for reuse
+BOOST_AUTO_TEST_CASE(DigitTime_test1)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString("TPCEleParam.DigiMode=3"); // propagate the ADC values, otherwise the computation get complicated
+  const Mapper& mapper = Mapper::instance();
+  DigitTime digitTime;
+
+  const int nPads = 500;
+  const int step = 29; // scatter the pads over the sector
+  for (int iter = 0; iter < 2; ++iter) {
+    for (int repetition = 0; repetition < 3; ++repetition) {
+      for (int i = nPads; i--;) {
+        const GlobalPadNumber globalPad = i * step;
+        const CRU cru = mapper.getCRU(Sector(0), globalPad);
+        digitTime.addDigit(MCCompLabel(i, iter, 0, false), cru, globalPad, 1.f + (i % 7));
+      }
+    }
+    BOOST_CHECK(digitTime.getNumberOfOccupiedPads() == nPads);
+
+    std::vector<Digit> digits;
+    std::vector<o2::tpc::CommonMode> commonMode;
+    dataformats::MCTruthContainer<MCCompLabel> mcTruth;
+    digitTime.fillOutputContainer<DigitzationMode::PropagateADC>(digits, mcTruth, commonMode, Sector(0), 10);
+
+    BOOST_REQUIRE(digits.size() == nPads);
+    for (int i = 0; i < nPads; ++i) {
+      const GlobalPadNumber globalPad = i * step;
+      const auto padPos = mapper.padPos(globalPad);
+      BOOST_CHECK(digits[i].getRow() == padPos.getRow());
+      BOOST_CHECK(digits[i].getPad() == padPos.getPad());
+      BOOST_CHECK_CLOSE(digits[i].getChargeFloat(), 3.f * (1.f + (i % 7)), 1E-6);
+      const auto& mcArray = mcTruth.getLabels(i);
+      BOOST_REQUIRE(mcArray.size() == 1);
+      BOOST_CHECK(mcArray[0].getTrackID() == i);
+      BOOST_CHECK(mcArray[0].getEventID() == iter);
+    }
+    digitTime.reset();
+    BOOST_CHECK(digitTime.getNumberOfOccupiedPads() == 0);
+  }
+}
 } // namespace tpc
 } // namespace o2
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <fmt/format.h>
+#include <future>
 #include <limits>
 #include "Framework/Task.h"
 #include "Framework/ControlService.h"
@@ -26,6 +27,7 @@
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/DeviceSpec.h"
 #include "Headers/DataHeader.h"
+#include "TROOT.h"
 #include "TPCCalibration/IDCFactorization.h"
 #include "TPCCalibration/IDCAverageGroup.h"
 #include "CCDB/CcdbApi.h"
@@ -95,10 +97,22 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
 
     mTFRangeIDCDelta.resize(mIDCFactorization.getNChunks());
     mTimeStampRangeIDCDelta.resize(mIDCFactorization.getNChunks());
+
+    // the IDCs of an interval are aggregated in a separate buffer, such that the previous interval can be processed meanwhile
+    for (auto& idcs : mIDCsAggregation) {
+      idcs.resize(mIDCFactorization.getNTimeframes());
+    }
+    mProcessAsync = !ic.options().get<bool>("sync-processing") && !mSendOutDebug;
+    if (mProcessAsync) {
+      ROOT::EnableThreadSafety(); // the objects are streamed for the CCDB upload in the background thread
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
   {
+    // report errors of the background processing without waiting for the end of the next interval
+    checkProcessing();
+
     // set the min range of TFs for first TF
     if (mProcessedTFs == 0) {
       mTFFirst = processing_helpers::getCurrentTF(pc);
@@ -116,7 +130,7 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
       }
 
       for (unsigned int iChunk = 0; iChunk < mIDCFactorization.getNChunks(); ++iChunk) {
-        mTFRangeIDCDelta[iChunk] = getFirstTFDeltaIDC(iChunk);
+        mTFRangeIDCDelta[iChunk] = getFirstTFDeltaIDC(iChunk, mTFFirst);
       }
     }
 
@@ -129,7 +143,7 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
       const auto descr = tpcCRUHeader->dataDescription;
       if (TPCDistributeIDCSpec::getDataDescriptionIDC() == descr) {
         const int cru = tpcCRUHeader->subSpecification - mLaneId * CRU::MaxCRU;
-        mIDCFactorization.setIDCs(pc.inputs().get<std::vector<float>>(ref), cru, mProcessedTFs); // aggregate IDCs
+        mIDCsAggregation[cru][mProcessedTFs] = pc.inputs().get<std::vector<float>>(ref); // aggregate IDCs
       }
     }
     ++mProcessedTFs;
@@ -138,25 +152,24 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
 
     if (mProcessedTFs == mIDCFactorization.getNTimeframes()) {
       mProcessedTFs = 0; // reset processed TFs for next aggregation interval
-      if constexpr (std::is_same_v<Type, TPCFactorizeIDCSpecGroup>) {
-        mIDCFactorization.factorizeIDCs(true); // calculate DeltaIDC, 0D-IDC, 1D-IDC
-      } else {
-        mIDCFactorization.factorizeIDCs(false); // calculate DeltaIDC, 0D-IDC, 1D-IDC
-      }
 
-      if (mDebug) {
-        LOGP(info, "dumping aggregated and factorized IDCs to file");
-        mIDCFactorization.dumpToFile(fmt::format("IDCFactorized_{:02}.root", processing_helpers::getCurrentTF(pc)).data());
-        mIDCFactorization.dumpPadFlagMap("padstatusmap.root", "PadStatus");
-      }
+      // at most one interval is processed at a time: wait for the previous one before handing over the new IDCs
+      waitForProcessing();
+      mIDCFactorization.swapIDCs(mIDCsAggregation);
 
-      // storing to CCDB
-      sendOutput(pc.outputs());
+      // the range of the interval is taken now, as the members are updated by the next interval
+      AggregationInterval interval{mTFFirst, mTimeStampFirst, mTimeStampRangeIDCDelta, processing_helpers::getCurrentTF(pc)};
+      if (mProcessAsync) {
+        mProcessing = std::async(std::launch::async, [this, interval = std::move(interval)]() { processInterval(interval, nullptr); });
+      } else {
+        processInterval(interval, &pc.outputs());
+      }
     }
   }
 
   void endOfStream(o2::framework::EndOfStreamContext& ec) final
   {
+    waitForProcessing();
     ec.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   }
 
@@ -183,17 +196,62 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
   int mLaneId{0};                                   ///< the id of the current process within the parallel pipeline
   std::unique_ptr<CalDet<PadFlags>> mPadFlagsMap;   ///< status flag for each pad (i.e. if the pad is dead). This map is buffered to check if something changed, when a new map is created
 
-  /// \return returns first TF for validity range when storing to CCDB
-  uint32_t getFirstTF() const { return mTFFirst; }
+  std::array<std::vector<std::vector<float>>, CRU::MaxCRU> mIDCsAggregation{}; ///< IDCs of the present aggregation interval: CRU -> time frame -> IDCs
+  bool mProcessAsync{true};                                                    ///< process the aggregation intervals in a background thread, overlapping with the aggregation of the next interval
+  std::future<void> mProcessing;                                               ///< processing of the previous aggregation interval
+
+  /// time range of an aggregation interval, fixed when the interval is handed over for processing
+  struct AggregationInterval {
+    uint32_t tfFirst{};                             ///< first TF of the interval
+    uint64_t timeStampFirst{};                      ///< first time stamp of the interval
+    std::vector<uint64_t> timeStampRangeIDCDelta{}; ///< first time stamp of each IDCDelta chunk
+    uint32_t tfLast{};                              ///< last TF of the interval
+  };
 
   /// \return returns first TF for validity range when storing to IDCDelta CCDB
-  unsigned int getFirstTFDeltaIDC(const unsigned int iChunk) const { return getFirstTF() + iChunk * mIDCFactorization.getTimeFramesDeltaIDC(); }
+  unsigned int getFirstTFDeltaIDC(const unsigned int iChunk, const uint32_t tfFirst) const { return tfFirst + iChunk * mIDCFactorization.getTimeFramesDeltaIDC(); }
 
   /// \return returns last TF for validity range when storing to IDCDelta CCDB
-  unsigned int getLastTFDeltaIDC(const unsigned int iChunk) const { return (iChunk == mIDCFactorization.getNChunks() - 1) ? (mIDCFactorization.getNTimeframes() + getFirstTF()) : (getFirstTFDeltaIDC(iChunk) + mIDCFactorization.getTimeFramesDeltaIDC()); }
+  unsigned int getLastTFDeltaIDC(const unsigned int iChunk, const uint32_t tfFirst) const { return (iChunk == mIDCFactorization.getNChunks() - 1) ? (mIDCFactorization.getNTimeframes() + tfFirst) : (getFirstTFDeltaIDC(iChunk, tfFirst) + mIDCFactorization.getTimeFramesDeltaIDC()); }
 
-  /// \return returns first time stamp for validity range when storing to IDCDelta CCDB
-  auto getFirstTimeStampDeltaIDC(const unsigned int iChunk) const { return mTimeStampRangeIDCDelta[iChunk]; }
+  /// rethrow the exceptions of the processing of the previous aggregation interval if it is done already
+  void checkProcessing()
+  {
+    if (mProcessing.valid() && mProcessing.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      mProcessing.get();
+    }
+  }
+
+  /// wait until the processing of the previous aggregation interval is done, rethrowing its exceptions
+  void waitForProcessing()
+  {
+    if (mProcessing.valid()) {
+      if (mProcessing.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        LOGP(info, "waiting for the processing of the previous aggregation interval");
+      }
+      mProcessing.get();
+    }
+  }
+
+  /// factorize the IDCs of an aggregation interval and store the results
+  /// \param output output for sending the results for debugging, only available when processing synchronously
+  void processInterval(const AggregationInterval& interval, DataAllocator* output)
+  {
+    if constexpr (std::is_same_v<Type, TPCFactorizeIDCSpecGroup>) {
+      mIDCFactorization.factorizeIDCs(true); // calculate DeltaIDC, 0D-IDC, 1D-IDC
+    } else {
+      mIDCFactorization.factorizeIDCs(false); // calculate DeltaIDC, 0D-IDC, 1D-IDC
+    }
+
+    if (mDebug) {
+      LOGP(info, "dumping aggregated and factorized IDCs to file");
+      mIDCFactorization.dumpToFile(fmt::format("IDCFactorized_{:02}.root", interval.tfLast).data());
+      mIDCFactorization.dumpPadFlagMap("padstatusmap.root", "PadStatus");
+    }
+
+    // storing to CCDB
+    sendOutput(interval, output);
+  }
 
   /// check if current tf will be used to set the time stamp range
   bool findTimeStamp(o2::framework::ProcessingContext& pc)
@@ -224,14 +282,14 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
     }
   }
 
-  void sendOutput(DataAllocator& output)
+  void sendOutput(const AggregationInterval& interval, DataAllocator* output)
   {
-    if (mSendOutDebug) {
-      sendOutputDebug(output);
+    if (mSendOutDebug && output) {
+      sendOutputDebug(*output);
     }
 
     if (mWriteToDB) {
-      const auto timeStampStart = mTimeStampFirst;
+      const auto timeStampStart = interval.timeStampFirst;
       const auto timeStampEnd = 99999999999999;
 
       LOGP(info, "Writing IDCs to CCDB");
@@ -261,10 +319,10 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
         if constexpr (std::is_same_v<Type, TPCFactorizeIDCSpecGroup>) {
           // perform grouping of IDC Delta if necessary
           mIDCStruct.mIDCs.setIDCs(std::move(mIDCFactorization).getIDCDeltaUncompressed(iChunk));
-          LOGP(info, "averaging and grouping DeltaIDCs for TFs {} - {} for CRUs {} to {} using {} threads", getFirstTFDeltaIDC(iChunk), getLastTFDeltaIDC(iChunk), mCRUs.front(), mCRUs.back(), mIDCStruct.mIDCs.getNThreads());
+          LOGP(info, "averaging and grouping DeltaIDCs for TFs {} - {} for CRUs {} to {} using {} threads", getFirstTFDeltaIDC(iChunk, interval.tfFirst), getLastTFDeltaIDC(iChunk, interval.tfFirst), mCRUs.front(), mCRUs.back(), mIDCStruct.mIDCs.getNThreads());
           mIDCStruct.mIDCs.processIDCs(mPadFlagsMap.get());
           if (mDebug) {
-            mIDCStruct.mIDCs.dumpToFile(fmt::format("IDCDeltaAveraged_chunk{:02}_{:02}.root", iChunk, getFirstTFDeltaIDC(iChunk)).data());
+            mIDCStruct.mIDCs.dumpToFile(fmt::format("IDCDeltaAveraged_chunk{:02}_{:02}.root", iChunk, getFirstTFDeltaIDC(iChunk, interval.tfFirst)).data());
           }
         }
 
@@ -274,10 +332,10 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
             using compType = unsigned short;
             if constexpr (std::is_same_v<Type, TPCFactorizeIDCSpecGroup>) {
               auto idcDeltaMediumCompressed = IDCDeltaCompressionHelper<compType>::getCompressedIDCs(mIDCStruct.mIDCs.getIDCGroupData());
-              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTimeStampDeltaIDC(iChunk), timeStampEnd);
+              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, interval.timeStampRangeIDCDelta[iChunk], timeStampEnd);
             } else {
               auto idcDeltaMediumCompressed = mIDCFactorization.getIDCDeltaMediumCompressed(iChunk);
-              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTimeStampDeltaIDC(iChunk), timeStampEnd);
+              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, interval.timeStampRangeIDCDelta[iChunk], timeStampEnd);
             }
 
             break;
@@ -286,18 +344,18 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
             using compType = unsigned char;
             if constexpr (std::is_same_v<Type, TPCFactorizeIDCSpecGroup>) {
               auto idcDeltaMediumCompressed = IDCDeltaCompressionHelper<compType>::getCompressedIDCs(mIDCStruct.mIDCs.getIDCGroupData());
-              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTimeStampDeltaIDC(iChunk), timeStampEnd);
+              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, interval.timeStampRangeIDCDelta[iChunk], timeStampEnd);
             } else {
               auto idcDeltaHighCompressed = mIDCFactorization.getIDCDeltaHighCompressed(iChunk);
-              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaHighCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTimeStampDeltaIDC(iChunk), timeStampEnd);
+              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<compType>>(&idcDeltaHighCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, interval.timeStampRangeIDCDelta[iChunk], timeStampEnd);
             }
             break;
           }
           case IDCDeltaCompression::NO:
             if constexpr (std::is_same_v<Type, TPCFactorizeIDCSpecGroup>) {
-              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<float>>(&mIDCStruct.mIDCs.getIDCGroupData(), "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTimeStampDeltaIDC(iChunk), timeStampEnd);
+              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<float>>(&mIDCStruct.mIDCs.getIDCGroupData(), "TPC/Calib/IDC/IDCDELTA", mMetadata, interval.timeStampRangeIDCDelta[iChunk], timeStampEnd);
             } else {
-              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<float>>(&mIDCFactorization.getIDCDeltaUncompressed(iChunk), "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTimeStampDeltaIDC(iChunk), timeStampEnd);
+              mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<float>>(&mIDCFactorization.getIDCDeltaUncompressed(iChunk), "TPC/Calib/IDC/IDCDELTA", mMetadata, interval.timeStampRangeIDCDelta[iChunk], timeStampEnd);
             }
             break;
         }
@@ -343,7 +401,8 @@ DataProcessorSpec getTPCFactorizeIDCSpec(const int lane, const std::vector<uint3
     AlgorithmSpec{adaptFromTask<TPCFactorizeIDCSpec<Type>>(crus, timeframes, timeframesDeltaIDC, groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, groupPadsSectorEdges, compression, debug, senddebug)},
     Options{{"ccdb-uri", VariantType::String, o2::base::NameConf::getCCDBServer(), {"URI for the CCDB access."}},
             {"gainMapFile", VariantType::String, "", {"file to reference gain map, which will be used for correcting the cluster charge"}},
-            {"update-not-grouping-parameter", VariantType::Bool, false, {"Do NOT Update/Writing grouping parameters to CCDB."}}}}; // end DataProcessorSpec
+            {"update-not-grouping-parameter", VariantType::Bool, false, {"Do NOT Update/Writing grouping parameters to CCDB."}},
+            {"sync-processing", VariantType::Bool, false, {"Factorize the IDCs of an aggregation interval before aggregating the next one, instead of in the background."}}}}; // end DataProcessorSpec
   spec.rank = lane;
   return spec;
 }
@@ -19,11 +19,13 @@
 
 #include <vector>
 #include <fmt/format.h>
+#include <future>
 #include "Framework/Task.h"
 #include "Framework/ControlService.h"
 #include "Framework/Logger.h"
 #include "Framework/DataProcessorSpec.h"
 #include "Headers/DataHeader.h"
+#include "TROOT.h"
 #include "CCDB/CcdbApi.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "TPCCalibration/IDCFourierTransform.h"
@@ -52,10 +54,17 @@ class TPCFourierTransformAggregatorSpec : public o2::framework::Task
   {
     mDBapi.init(ic.options().get<std::string>("ccdb-uri")); // or http://localhost:8080 for a local installation
     mWriteToDB = mDBapi.isHostReachable() ? true : false;
+    mProcessAsync = !ic.options().get<bool>("sync-processing") && !mSendOutDebug;
+    if (mProcessAsync) {
+      ROOT::EnableThreadSafety(); // the objects are streamed for the CCDB upload in the background thread
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
   {
+    // report errors of the background fourier transform without waiting for the end of the next interval
+    checkProcessing();
+
     // set the min range of TFs for first TF
     if (mProcessedTFs == 0) {
       mTimeStampRange[0] = getCurrentTimeStamp(pc);
@@ -75,23 +84,26 @@ class TPCFourierTransformAggregatorSpec : public o2::framework::Task
       mTimeStampRange[1] = getCurrentTimeStamp(pc);
       mProcessedTFs = 0; // reset processed TFs for next aggregation interval
 
+      // the fourier transform of the previous interval has to be finished before its 1D-IDCs are replaced
+      waitForProcessing();
+
       // perform fourier transform of 1D-IDCs
       auto intervals = mOneDIDCAggregator.getIntegrationIntervalsPerTF();
       mIDCFourierTransform.setIDCs(std::move(mOneDIDCAggregator).getAggregated1DIDCs(), std::move(intervals));
-      mIDCFourierTransform.calcFourierCoefficients();
 
-      if (mDebug) {
-        LOGP(info, "dumping FT to file");
-        mIDCFourierTransform.dumpToFile(fmt::format("FourierAGG_{:02}.root", getCurrentTF(pc)).data());
+      const auto timeStampRange = mTimeStampRange;
+      const auto tf = getCurrentTF(pc);
+      if (mProcessAsync) {
+        mProcessing = std::async(std::launch::async, [this, timeStampRange, tf]() { processInterval(timeStampRange, tf, nullptr); });
+      } else {
+        processInterval(timeStampRange, tf, &pc.outputs());
       }
-
-      // storing to CCDB
-      sendOutput(pc.outputs());
     }
   }
 
   void endOfStream(o2::framework::EndOfStreamContext& ec) final
   {
+    waitForProcessing();
     ec.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   }
 
@@ -109,20 +121,58 @@ class TPCFourierTransformAggregatorSpec : public o2::framework::Task
   bool mWriteToDB{};                            ///< flag if writing to CCDB will be done
   std::array<uint64_t, 2> mTimeStampRange{};    ///< storing of first and last time stamp used when setting the validity of the objects when writing to CCDB
   int mProcessedTFs{0};                         ///< number of processed time frames to keep track of when the writing to CCDB will be done
+  bool mProcessAsync{true};                     ///< perform the fourier transform in a background thread, overlapping with the aggregation of the next interval
+  std::future<void> mProcessing;                ///< fourier transform of the previous aggregation interval
 
   /// \return returns TF of current processed data
   uint32_t getCurrentTF(o2::framework::ProcessingContext& pc) const { return o2::framework::DataRefUtils::getHeader<o2::header::DataHeader*>(pc.inputs().getFirstValid(true))->tfCounter; }
 
   uint64_t getCurrentTimeStamp(o2::framework::ProcessingContext& pc) const { return DataRefUtils::getHeader<DataProcessingHeader*>(pc.inputs().getFirstValid(true))->creation; }
 
-  void sendOutput(DataAllocator& output)
+  /// rethrow the exceptions of the fourier transform of the previous aggregation interval if it is done already
+  void checkProcessing()
+  {
+    if (mProcessing.valid() && mProcessing.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      mProcessing.get();
+    }
+  }
+
+  /// wait until the fourier transform of the previous aggregation interval is done, rethrowing its exceptions
+  void waitForProcessing()
+  {
+    if (mProcessing.valid()) {
+      if (mProcessing.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        LOGP(info, "waiting for the fourier transform of the previous aggregation interval");
+      }
+      mProcessing.get();
+    }
+  }
+
+  /// perform the fourier transform of the aggregated 1D-IDCs and store the coefficients
+  /// \param timeStampRange first and last time stamp of the aggregation interval
+  /// \param tf last TF of the aggregation interval
+  /// \param output output for sending the coefficients for debugging, only available when processing synchronously
+  void processInterval(const std::array<uint64_t, 2> timeStampRange, const uint32_t tf, DataAllocator* output)
+  {
+    mIDCFourierTransform.calcFourierCoefficients();
+
+    if (mDebug) {
+      LOGP(info, "dumping FT to file");
+      mIDCFourierTransform.dumpToFile(fmt::format("FourierAGG_{:02}.root", tf).data());
+    }
+
+    // storing to CCDB
+    sendOutput(timeStampRange, output);
+  }
+
+  void sendOutput(const std::array<uint64_t, 2>& timeStampRange, DataAllocator* output)
   {
-    if (mSendOutDebug) {
-      output.snapshot(Output{gDataOriginTPC, TPCFourierTransformAggregatorSpec::getDataDescriptionFourier()}, mIDCFourierTransform.getFourierCoefficients());
+    if (mSendOutDebug && output) {
+      output->snapshot(Output{gDataOriginTPC, TPCFourierTransformAggregatorSpec::getDataDescriptionFourier()}, mIDCFourierTransform.getFourierCoefficients());
     }
 
     if (mWriteToDB) {
-      mDBapi.storeAsTFileAny<o2::tpc::FourierCoeff>(&mIDCFourierTransform.getFourierCoefficients(), "TPC/Calib/IDC/FOURIER", mMetadata, mTimeStampRange[0], mTimeStampRange[1]);
+      mDBapi.storeAsTFileAny<o2::tpc::FourierCoeff>(&mIDCFourierTransform.getFourierCoefficients(), "TPC/Calib/IDC/FOURIER", mMetadata, timeStampRange[0], timeStampRange[1]);
     }
   }
 };
@@ -145,7 +195,8 @@ DataProcessorSpec getTPCFourierTransformAggregatorSpec(const std::vector<uint32_
     inputSpecs,
     outputSpecs,
     AlgorithmSpec{adaptFromTask<TPCFourierTransformAggregatorSpec>(crus, timeframes, nFourierCoefficientsStore, rangeIDC, debug, senddebug)},
-    Options{{"ccdb-uri", VariantType::String, o2::base::NameConf::getCCDBServer(), {"URI for the CCDB access."}}}}; // end DataProcessorSpec
+    Options{{"ccdb-uri", VariantType::String, o2::base::NameConf::getCCDBServer(), {"URI for the CCDB access."}},
+            {"sync-processing", VariantType::Bool, false, {"Perform the fourier transform of an aggregation interval before aggregating the next one, instead of in the background."}}}}; // end DataProcessorSpec
 }
 
 } // namespace o2::tpc
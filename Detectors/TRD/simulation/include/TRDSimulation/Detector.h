@@ -61,6 +61,9 @@ class Detector : public o2::base::DetImpl<Detector>
   // defines/sets-up the sensitive volumes
   void defineSensitiveVolumes();
 
+  // fills the per-volume lookup tables used in ProcessHits
+  void fillVolumeLookup();
+
   // addHit
   template <typename T>
   void addHit(T x, T y, T z, T locC, T locR, T locT, T tof, int charge, int trackId, int detId, bool drift = false);
@@ -83,6 +86,11 @@ class Detector : public o2::base::DetImpl<Detector>
 
   Geometry* mGeom = nullptr;
 
+  // lookup tables indexed by the MC volume ID, such that no volume name has to be parsed in the stepping
+  std::vector<char> mVolRegion; ///!< region ('J' drift, 'K' amplification) of the sensitive volumes
+  std::vector<int> mVolChamber; ///!< chamber number of the sensitive volumes, -1 for other volumes
+  std::vector<int> mVolSector;  ///!< sector of the BTRD volumes, -1 for other volumes
+
   template <typename Det>
   friend class o2::base::DetImpl;
   ClassDefOverride(Detector, 1);
@@ -45,7 +45,10 @@ Detector::Detector(const Detector& rhs)
     mFoilDensity(rhs.mFoilDensity),
     mGasNobleFraction(rhs.mGasNobleFraction),
     mGasDensity(rhs.mGasDensity),
-    mGeom(rhs.mGeom)
+    mGeom(rhs.mGeom),
+    mVolRegion(rhs.mVolRegion),
+    mVolChamber(rhs.mVolChamber),
+    mVolSector(rhs.mVolSector)
 {
   InitializeParams();
 }
@@ -59,6 +62,7 @@ void Detector::InitializeO2Detector()
 {
   // register the sensitive volumes with FairRoot
   defineSensitiveVolumes();
+  fillVolumeLookup();
 }
 
 void Detector::InitializeParams()
@@ -91,12 +95,12 @@ bool Detector::ProcessHits(FairVolume* v)
   // Inside sensitive volume ?
   bool drRegion = false;
   bool amRegion = false;
-  char idRegion;
-  int cIdChamber;
-  int r1 = std::sscanf(fMC->CurrentVolName(), "U%c%d", &idRegion, &cIdChamber);
-  if (r1 != 2) {
+  int volID = v->getMCid();
+  if (volID < 0 || volID >= int(mVolChamber.size()) || mVolChamber[volID] < 0) {
     LOG(fatal) << "Something went wrong with the geometry volume name " << fMC->CurrentVolName();
   }
+  char idRegion = mVolRegion[volID];
+  int cIdChamber = mVolChamber[volID];
   if (idRegion == 'J') {
     drRegion = true;
   } else if (idRegion == 'K') {
@@ -110,11 +114,12 @@ bool Detector::ProcessHits(FairVolume* v)
     LOG(fatal) << "Chamber ID out of bounds";
   }
 
-  int sector;
-  int r2 = std::sscanf(fMC->CurrentVolOffName(7), "BTRD%d", &sector);
-  if (r2 != 1) {
+  int copy;
+  int sectorVolID = fMC->CurrentVolOffID(7, copy);
+  if (sectorVolID < 0 || sectorVolID >= int(mVolSector.size()) || mVolSector[sectorVolID] < 0) {
     LOG(fatal) << "Something went wrong with the geometry volume name " << fMC->CurrentVolOffName(7);
   }
+  int sector = mVolSector[sectorVolID];
   if (sector < 0 || sector >= NSECTOR) {
     LOG(fatal) << "Sector out of bounds";
   }
@@ -520,6 +525,38 @@ void Detector::defineSensitiveVolumes()
   }
 }
 
+void Detector::fillVolumeLookup()
+{
+  // the region and chamber of a sensitive volume are encoded in its name (e.g. UJ123),
+  // the sector in the name of its BTRD mother volume: they are decoded once here
+  auto mc = TVirtualMC::GetMC();
+  auto setVol = [](auto& table, int volID, auto value) {
+    if (volID >= int(table.size())) {
+      table.resize(volID + 1, -1);
+    }
+    table[volID] = value;
+  };
+  mVolRegion.clear();
+  mVolChamber.clear();
+  mVolSector.clear();
+  for (auto& name : mGeom->getSensitiveTRDVolumes()) {
+    char idRegion;
+    int cIdChamber;
+    int volID = mc->VolId(name.c_str());
+    if (volID < 0 || std::sscanf(name.c_str(), "U%c%d", &idRegion, &cIdChamber) != 2) {
+      continue; // will fail in ProcessHits, as before
+    }
+    setVol(mVolRegion, volID, idRegion);
+    setVol(mVolChamber, volID, cIdChamber);
+  }
+  for (int isector = 0; isector < NSECTOR; isector++) {
+    int volID = mc->VolId(Form("BTRD%d", isector));
+    if (volID >= 0) {
+      setVol(mVolSector, volID, isector);
+    }
+  }
+}
+
 void Detector::addAlignableVolumes() const
 {
   mGeom->addAlignableVolumes();
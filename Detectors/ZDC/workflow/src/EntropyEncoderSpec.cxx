@@ -51,6 +51,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
   auto peds = pc.inputs().get<gsl::span<o2::zdc::OrbitData>>("peds");
 
   auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{"ZDC", "CTFDATA", 0, Lifetime::Timeframe});
+  mCTFCoder.updateCodersFromFile<CTF>(o2::ctf::CTFCoderBase::OpType::Encoder);
   mCTFCoder.encode(buffer, bcdata, chans, peds);
   auto eeb = CTF::get(buffer.data()); // cast to container pointer
   eeb->compactify();                  // eliminate unnecessary padding
@@ -249,6 +249,74 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
+        // tables written in the Arrow format are read as they are
+        if (didir->isArrowFile(dh, fcnt)) {
+          auto table = didir->getArrowTable(dh, fcnt, ntf);
+          if (!table) {
+            if (first) {
+              // dump metrics of file which is done for reading
+              dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
+              currentFile = nullptr;
+              currentFileStartedAt = uv_hrtime();
+              currentFileIOTime = 0;
+
+              // check if there is a next file to read
+              fcnt += device.maxInputTimeslices;
+              if (didir->atEnd(fcnt)) {
+                LOGP(info, "No input files left to read for reader {}!", device.inputTimesliceId);
+                didir->closeInputFiles();
+                control.endOfStream();
+                control.readyToQuit(QuitRequest::Me);
+                return;
+              }
+              // get first folder of next file
+              ntf = 0;
+              table = didir->getArrowTable(dh, fcnt, ntf);
+            }
+            if (!table) {
+              LOGP(fatal, "Can not retrieve table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
+              throw std::runtime_error("Processing is stopped!");
+            }
+          }
+
+          if (first) {
+            timeFrameNumber = didir->getTimeFrameNumber(dh, fcnt, ntf);
+            auto o = Output(TFNumberHeader);
+            outputs.make<uint64_t>(o) = timeFrameNumber;
+          }
+
+          auto colnames = getColumnNames(dh);
+          if (colnames.size() != 0) {
+            std::vector<int> indices;
+            for (auto& colname : colnames) {
+              auto idx = table->schema()->GetFieldIndex(colname);
+              if (idx != -1) {
+                indices.emplace_back(idx);
+              }
+            }
+            auto selected = table->SelectColumns(indices);
+            if (!selected.ok()) {
+              LOGP(fatal, "Can not select the columns of table {}: {}", concrete.origin, selected.status().ToString());
+              throw std::runtime_error("Processing is stopped!");
+            }
+            table = selected.ValueOrDie();
+          }
+          for (auto& column : table->columns()) {
+            for (auto& chunk : column->chunks()) {
+              for (auto& buffer : chunk->data()->buffers) {
+                if (buffer) {
+                  totalSizeCompressed += buffer->size();
+                  totalSizeUncompressed += buffer->size();
+                }
+              }
+            }
+          }
+          outputs.adopt(Output(dh), table);
+
+          first = false;
+          continue;
+        }
+
         // create a TreeToTable object
         TTree* tr = didir->getDataTree(dh, fcnt, ntf);
         if (!tr) {
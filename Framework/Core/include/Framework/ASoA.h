@@ -21,6 +21,7 @@
 #include "Framework/ArrowTypes.h"
 #include "Framework/RuntimeError.h"
 #include "Framework/Kernels.h"
+#include "Framework/SliceIndexCache.h"
 #include <arrow/table.h>
 #include <arrow/array.h>
 #include <arrow/util/variant.h>
@@ -1250,34 +1251,24 @@ class Table
   unfiltered_iterator mBegin;
   /// Cached end iterator for this table.
   RowViewSentinel mEnd;
-  std::string mCurrentKey;
-  std::shared_ptr<arrow::NumericArray<arrow::Int32Type>> mValues = nullptr;
-  std::shared_ptr<arrow::NumericArray<arrow::Int64Type>> mCounts = nullptr;
-
-  arrow::Status initializeSliceCaches(char const* key)
-  {
-    mCurrentKey = key;
-    return o2::framework::getSlices(key, mTable, mValues, mCounts);
-  }
+  /// Slice indices used so far, per key column (shared with the other users of the same data)
+  std::vector<std::pair<std::string, std::shared_ptr<o2::framework::SliceIndex const>>> mSliceIndices;
 
  public:
   arrow::Status getSliceFor(int value, const char* key, std::shared_ptr<arrow::Table>& output, uint64_t& offset)
   {
-    arrow::Status status;
-    if (mCurrentKey != key) {
-      status = initializeSliceCaches(key);
-    }
-    if (!status.ok()) {
-      return status;
-    }
-    for (auto slice = 0; slice < mValues->length(); ++slice) {
-      if (mValues->Value(slice) == value) {
-        output = mTable->Slice(offset, mCounts->Value(slice));
-        return arrow::Status::OK();
+    auto it = std::find_if(mSliceIndices.begin(), mSliceIndices.end(), [key](auto const& p) { return p.first == key; });
+    if (it == mSliceIndices.end()) {
+      std::shared_ptr<o2::framework::SliceIndex const> index;
+      auto status = o2::framework::SliceIndexCache::instance().get(mTable, key, index);
+      if (!status.ok()) {
+        return status;
       }
-      offset += mCounts->Value(slice);
+      it = mSliceIndices.emplace(mSliceIndices.end(), key, std::move(index));
     }
-    output = mTable->Slice(offset, 0);
+    auto [start, count] = it->second->getSliceFor(value);
+    offset += start;
+    output = mTable->Slice(start, count);
     return arrow::Status::OK();
   }
 };
@@ -22,6 +22,8 @@ struct CommonMessageBackends {
   static ServiceSpec fairMQBackendSpec();
   static ServiceSpec stringBackendSpec();
   static ServiceSpec rawBufferBackendSpec();
+  /// Recycling of the output message memory, enabled with --shm-message-pool-size
+  static ServiceSpec messagePoolSpec();
 };
 
 } // namespace o2::framework
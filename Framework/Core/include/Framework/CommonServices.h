@@ -65,6 +65,7 @@ struct CommonServices {
   static ServiceSpec dataRelayer();
   static ServiceSpec dataSender();
   static ServiceSpec tracingSpec();
+  static ServiceSpec processingTraceSpec();
   static ServiceSpec threadPool(int numWorkers);
   static ServiceSpec dataProcessingStats();
   static ServiceSpec objectCache();
@@ -16,9 +16,15 @@
 
 #include "Framework/DataDescriptorMatcher.h"
 
+#include <memory>
 #include <regex>
 #include "rapidjson/fwd.h"
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
@@ -72,6 +78,11 @@ struct DataInputDescriptor {
   FileAndFolder getFileFolder(int counter, int numTF);
   int getTimeFramesInFile(int counter);
 
+  // input written with the Arrow output format of the DataOutputDirector,
+  // i.e. a directory with folders DF_x of Arrow IPC files
+  bool isArrowFile(int counter);
+  std::shared_ptr<arrow::Table> getArrowTable(int counter, int numTF, std::string const& treename);
+
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
 
@@ -114,6 +125,8 @@ struct DataInputDirector {
 
   std::unique_ptr<TTreeReader> getTreeReader(header::DataHeader dh, int counter, int numTF, std::string treeName);
   TTree* getDataTree(header::DataHeader dh, int counter, int numTF);
+  bool isArrowFile(header::DataHeader dh, int counter);
+  std::shared_ptr<arrow::Table> getArrowTable(header::DataHeader dh, int counter, int numTF);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
@@ -19,8 +19,23 @@
 
 #include "rapidjson/fwd.h"
 
+#include <unordered_map>
+
 class TFile;
 
+namespace arrow
+{
+class Table;
+namespace io
+{
+class FileOutputStream;
+}
+namespace ipc
+{
+class RecordBatchWriter;
+}
+} // namespace arrow
+
 namespace o2::framework
 {
 using namespace rapidjson;
@@ -75,6 +90,10 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  // output format, "root" (TTrees, default) or "arrow" (Arrow IPC files)
+  std::string getFileFormat() { return mfileFormat; }
+  void setFileFormat(std::string fileformat);
+  bool isArrowFormat() { return mfileFormat == "arrow"; }
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -83,6 +102,10 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
 
+  // write the selected columns of table to the Arrow IPC file of dodesc in
+  // folder DF_folderNumber, appending to it if it is already open
+  bool writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table);
+
   void closeDataFiles();
 
   void setFilenameBase(std::string dfn);
@@ -99,6 +122,21 @@ struct DataOutputDirector {
   bool mdebugmode = false;
   int mnumberTimeFramesToMerge = 1;
   std::string mfileMode = "RECREATE";
+  std::string mfileFormat = "root";
+
+  // Arrow IPC output: one directory <filename base>.arrow per file name base,
+  // with a sub directory DF_<n> per folder and a file <treename>.arrow per table
+  struct ArrowOutputFile {
+    std::string filenameBase;
+    std::string folderName;
+    std::string treename;
+    std::shared_ptr<arrow::io::FileOutputStream> stream;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  };
+  std::vector<ArrowOutputFile> marrowFiles;
+  std::vector<std::string> marrowDirectories;           // output directories which have been prepared
+  std::unordered_map<std::string, int> marrowFileParts; // number of parts written to each file
+  void closeArrowFiles(std::string const& filenameBase, std::string const& keepFolder);
 
   std::tuple<std::string, std::string, int> readJsonDocument(Document* doc);
   const std::tuple<std::string, std::string, int> memptyanswer = std::make_tuple(std::string(""), std::string(""), -1);
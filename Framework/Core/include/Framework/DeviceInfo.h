@@ -16,6 +16,7 @@
 #include "Framework/DeviceState.h"
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 // For pid_t
@@ -26,6 +27,8 @@
 namespace o2::framework
 {
 
+class MetricsRing;
+
 struct DeviceInfo {
   /// The pid of the device associated to this device
   pid_t pid;
@@ -80,6 +83,8 @@ struct DeviceInfo {
   short tracyPort;
   /// Timestamp of the last signal received
   size_t lastSignal;
+  /// Shared memory channel for the numeric metrics of the device, if enabled
+  std::shared_ptr<MetricsRing> metricsRing;
 };
 
 } // namespace o2::framework
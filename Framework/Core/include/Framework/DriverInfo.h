@@ -163,6 +163,9 @@ struct DriverInfo {
   DeviceMetricsInfo metrics;
   /// Skip shared memory cleanup if set
   bool noSHMCleanup;
+  /// Number of records of the shared memory metrics ring of each device,
+  /// 0 means the metrics are sent as text only.
+  size_t metricsRingCapacity = 0;
   /// Default value for the --driver-client-backend. Notice that if we start from
   /// the driver, the default backend will be the websocket one.  On the other hand,
   /// if the device is started standalone, the default becomes the old stdout:// so
@@ -64,6 +64,47 @@ struct HistFiller {
   static int getBaseElementSize(T* ptr);
 };
 
+//**************************************************************************************************
+/**
+ * Buffer collecting the fills of a TH1, TH2 or TH3 in flat per-coordinate arrays, which are flushed to the histogram in batches.
+ * For fixed-binning axes the bin indices are computed in a vectorizable loop and the bin contents and statistics are updated directly,
+ * giving the same result as the corresponding sequence of TH1::Fill calls.
+ */
+//**************************************************************************************************
+class HistFillBuffer
+{
+ public:
+  HistFillBuffer(std::shared_ptr<TH1> hist, uint32_t capacity);
+  ~HistFillBuffer() = default;
+
+  // add values to the buffer (if weight was requested it must be the last argument), flush if the buffer is full
+  template <typename... Ts>
+  void fill(const Ts&... positionAndWeight);
+
+  // add all buffered values to the histogram
+  void flush();
+
+  uint32_t size() const { return mSize; }
+
+ private:
+  static constexpr int MaxDim = 3;
+
+  // check if bin contents and statistics can be updated directly, otherwise TH1::Fill is used
+  bool canFillDirectly() const;
+  void fillDirectly();
+  void fillStandard();
+
+  std::shared_ptr<TH1> mHist{};
+  TArrayD* mArrayD{nullptr}; // direct access to the bin contents of TH*D
+  TArrayF* mArrayF{nullptr}; // direct access to the bin contents of TH*F
+  int mDim{};
+  uint32_t mCapacity{};
+  uint32_t mSize{};
+  std::array<std::vector<double>, MaxDim> mCoordinates{};
+  std::vector<double> mWeights{};
+  std::array<std::vector<int>, MaxDim> mBins{};
+};
+
 //**************************************************************************************************
 /**
  * HistogramRegistry for storing and filling histograms of any type.
@@ -128,6 +169,12 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // buffer the fills of TH1, TH2 and TH3 histograms and flush them in batches of bufferSize entries
+  void enableFillBuffering(uint32_t bufferSize = 4096);
+
+  // add all buffered fills to the histograms
+  void flush();
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -155,6 +202,9 @@ class HistogramRegistry
   template <typename T>
   uint32_t getHistIndex(const T& histName);
 
+  // create the fill buffer for the histogram at given position if buffering is enabled and supported for its type
+  void createFillBuffer(uint32_t idx);
+
   constexpr uint32_t imask(uint32_t i) const
   {
     return i & REGISTRY_BITMASK;
@@ -182,6 +232,10 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+
+  // optional fill buffers, placed at the same positions as the histograms
+  uint32_t mFillBufferSize{0};
+  std::array<std::shared_ptr<HistFillBuffer>, MAX_REGISTRY_SIZE> mFillBuffers{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -320,6 +374,33 @@ int HistFiller::getBaseElementSize(T* ptr)
   return 0;
 }
 
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+// Implementation of HistFillBuffer template functions.
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+template <typename... Ts>
+void HistFillBuffer::fill(const Ts&... positionAndWeight)
+{
+  constexpr int nArgs = sizeof...(Ts);
+  if constexpr (nArgs == 0 || nArgs > MaxDim + 1) {
+    LOGF(fatal, "The number of arguments in fill function called for histogram %s is incompatible with histogram dimensions.", mHist->GetName());
+  } else {
+    if (nArgs != mDim && nArgs != mDim + 1) {
+      LOGF(fatal, "The number of arguments in fill function called for histogram %s is incompatible with histogram dimensions.", mHist->GetName());
+    }
+    const double values[] = {static_cast<double>(positionAndWeight)...};
+    for (int d = 0; d < mDim; ++d) {
+      mCoordinates[d][mSize] = values[d];
+    }
+    mWeights[mSize] = (nArgs > mDim) ? values[nArgs - 1] : 1.;
+    if (++mSize == mCapacity) {
+      flush();
+    }
+  }
+}
+
 //--------------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------------
 // Implementation of HistogramRegistry template functions.
@@ -359,7 +440,11 @@ std::shared_ptr<T> HistogramRegistry::add(char const* const name, char const* co
 template <typename T>
 std::shared_ptr<T> HistogramRegistry::get(const HistName& histName)
 {
-  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[getHistIndex(histName)])) {
+  const uint32_t idx = getHistIndex(histName);
+  if (mFillBuffers[idx]) {
+    mFillBuffers[idx]->flush();
+  }
+  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[idx])) {
     return *histPtr;
   } else {
     throw runtime_error_f(R"(Histogram type specified in get<>(HIST("%s")) does not match the actual type of the histogram!)", histName.str);
@@ -383,6 +468,7 @@ HistPtr HistogramRegistry::insertClone(const HistName& histName, const std::shar
       registerName(histName.str);
       mRegistryKey[imask(histName.idx + i)] = histName.hash;
       mRegistryValue[imask(histName.idx + i)] = std::shared_ptr<T>(static_cast<T*>(originalHist->Clone(histName.str)));
+      createFillBuffer(imask(histName.idx + i));
       lookup += i;
       return mRegistryValue[imask(histName.idx + i)];
     }
@@ -408,13 +494,24 @@ uint32_t HistogramRegistry::getHistIndex(const T& histName)
 template <typename... Ts>
 void HistogramRegistry::fill(const HistName& histName, Ts&&... positionAndWeight)
 {
-  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  if constexpr ((std::is_arithmetic_v<std::decay_t<Ts>> && ...)) {
+    if (mFillBuffers[idx]) {
+      mFillBuffers[idx]->fill(positionAndWeight...);
+      return;
+    }
+  }
+  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[idx]);
 }
 
 template <typename... Cs, typename T>
 void HistogramRegistry::fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  if (mFillBuffers[idx]) {
+    mFillBuffers[idx]->flush();
+  }
+  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[idx]);
 }
 
 } // namespace o2::framework
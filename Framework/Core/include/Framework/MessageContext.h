@@ -38,6 +38,7 @@ namespace o2::framework
 {
 
 class Output;
+class MessagePool;
 
 class MessageContext
 {
@@ -551,6 +552,17 @@ class MessageContext
     return mProxy;
   }
 
+  /// Use the given pool to allocate the payload messages, nullptr to disable pooling
+  void setMessagePool(MessagePool* pool)
+  {
+    mMessagePool = pool;
+  }
+
+  bool hasMessagePool() const
+  {
+    return mMessagePool != nullptr;
+  }
+
   // Add a message to cache and returns a unique identifier for
   // such cached message.
   int64_t addToCache(std::unique_ptr<FairMQMessage>& message);
@@ -577,6 +589,7 @@ class MessageContext
   Messages mMessages;
   Messages mScheduledMessages;
   DispatchControl mDispatchControl;
+  MessagePool* mMessagePool = nullptr;
   std::unordered_map<std::string, std::unique_ptr<std::string>> mChannelRefs;
   /// Cached messages, in case we want to reuse them.
   std::unordered_map<int64_t, std::unique_ptr<FairMQMessage>> mMessageCache;
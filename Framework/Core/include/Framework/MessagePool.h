@@ -0,0 +1,126 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_MESSAGEPOOL_H_
+#define O2_FRAMEWORK_MESSAGEPOOL_H_
+
+#include "Framework/ServiceHandle.h"
+
+#include <fairmq/FwdDecls.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Pool of recyclable memory blocks for the output messages of a device.
+///
+/// Every output channel gets its own unmanaged region, which is carved on
+/// demand in blocks of power-of-two size classes. When the last consumer
+/// releases a message built on top of one of those blocks, the region callback
+/// puts the block back in the free list of its size class, so that the next
+/// output of similar size does not need a new shared memory allocation.
+/// Messages larger than the biggest size class, or which do not fit anymore in
+/// the region, are allocated as usual.
+class MessagePool
+{
+ public:
+  constexpr static ServiceKind service_kind = ServiceKind::Global;
+
+  static constexpr int MinSizeClassLog2 = 8;  ///< smallest block: 256 B
+  static constexpr int MaxSizeClassLog2 = 20; ///< largest block: 1 MB
+  static constexpr int NSizeClasses = MaxSizeClassLog2 - MinSizeClassLog2 + 1;
+
+  struct Stats {
+    uint64_t requests = 0;       ///< requests for a poolable size
+    uint64_t reused = 0;         ///< requests served by a recycled block, i.e. shm allocations avoided
+    uint64_t carved = 0;         ///< requests served by a new block carved from a region
+    uint64_t fallbacks = 0;      ///< poolable requests which had to use the standard allocation
+    uint64_t regionBytes = 0;    ///< total size of the regions
+    uint64_t carvedBytes = 0;    ///< bytes of the regions already split in blocks
+    uint64_t freeBytes = 0;      ///< bytes of the blocks currently waiting in the free lists
+    uint64_t blockBytes = 0;     ///< cumulative size of the blocks handed out
+    uint64_t requestedBytes = 0; ///< cumulative size requested for those blocks
+
+    /// fraction of the handed out block memory not used by the payloads
+    float internalFragmentation() const { return blockBytes ? 1.f - float(requestedBytes) / float(blockBytes) : 0.f; }
+    /// fraction of the carved region memory sitting idle in the free lists
+    float idleFraction() const { return carvedBytes ? float(freeBytes) / float(carvedBytes) : 0.f; }
+  };
+
+  /// transport used for the given output channel and sub channel index
+  using TransportGetter = std::function<FairMQTransportFactory*(std::string const& channel, int index)>;
+
+  /// @a regionSize is the size of the region allocated for each output channel, 0 disables the pool
+  MessagePool(FairMQDevice* device, size_t regionSize);
+  MessagePool(TransportGetter transport, size_t regionSize);
+  ~MessagePool();
+
+  bool active() const { return mRegionSize != 0; }
+
+  /// Create a message of @a size bytes for the given channel, recycling a block when possible
+  std::unique_ptr<FairMQMessage> createMessage(std::string const& channel, int index, size_t size);
+
+  /// Snapshot of the counters
+  Stats getStats() const;
+
+  /// true if the counters were not reported during the last @a interval, in which case they are
+  /// considered as reported now
+  bool reportDue(std::chrono::steady_clock::duration interval);
+
+  /// Size class (index in the free lists) for a given message size, -1 if the size is not poolable
+  static int sizeClass(size_t size)
+  {
+    if (size == 0 || size > (size_t(1) << MaxSizeClassLog2)) {
+      return -1;
+    }
+    int log2 = MinSizeClassLog2;
+    while ((size_t(1) << log2) < size) {
+      log2++;
+    }
+    return log2 - MinSizeClassLog2;
+  }
+
+  /// Size of the blocks of a given size class
+  static size_t sizeClassBytes(int cls) { return size_t(1) << (cls + MinSizeClassLog2); }
+
+ private:
+  struct ChannelPool {
+    std::unique_ptr<FairMQUnmanagedRegion> region;
+    char* base = nullptr;
+    size_t size = 0;
+    size_t used = 0; ///< bytes carved so far, blocks are carved sequentially
+    std::array<std::vector<void*>, NSizeClasses> freeBlocks;
+  };
+
+  ChannelPool& getChannelPool(std::string const& channel, int index);
+  void release(ChannelPool& pool, void* data, int cls);
+
+  TransportGetter mTransport;
+  size_t mRegionSize = 0;
+  std::chrono::steady_clock::time_point mLastReport = std::chrono::steady_clock::now();
+  /// blocks are released from the transport threads, so all the bookkeeping is protected
+  mutable std::mutex mMutex;
+  std::unordered_map<std::string, std::unique_ptr<ChannelPool>> mPools;
+  Stats mStats;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_MESSAGEPOOL_H_
@@ -0,0 +1,134 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_METRICSRING_H_
+#define O2_FRAMEWORK_METRICSRING_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace o2::framework
+{
+
+/// A single numeric metric, as exchanged via the MetricsRing
+struct MetricRecord {
+  static constexpr size_t MAX_NAME_SIZE = 110;
+
+  uint64_t timestamp = 0; ///< in ms since epoch, like for the text metrics
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value = 0;
+  };
+  uint8_t type = 0; ///< a MetricType
+  uint8_t nameSize = 0;
+  char name[MAX_NAME_SIZE];
+};
+static_assert(sizeof(MetricRecord) == 128, "MetricRecord must span two cache lines");
+
+/// Single producer, single consumer ring of fixed size metric records,
+/// living in a shared memory segment. It is used to pass the numeric metrics
+/// of a device to the driver without formatting and parsing them as text.
+/// When the ring is full, push() fails and the caller is expected to fall
+/// back to the text metrics on stdout, so that no metric is lost.
+/// Since the consumer handles the two channels separately, the producer
+/// should keep using the text metrics after an overflow until caughtUp(),
+/// otherwise newer values could overtake the ones still in the text channel.
+class MetricsRing
+{
+ public:
+  /// Name of the environment variable used to pass the segment to a device
+  static constexpr char const* ENV_VARIABLE = "DPL_METRICS_SHM";
+
+  struct Header {
+    uint32_t magic;
+    uint32_t capacity; ///< number of records, a power of 2
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    std::atomic<uint64_t> overflows; ///< records which did not fit
+    alignas(64) std::atomic<uint64_t> textSent; ///< text metrics announced by the producer
+    alignas(64) std::atomic<uint64_t> textProcessed; ///< text metrics processed by the consumer
+  };
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "the ring requires address free atomics");
+
+  /// Build a ring on top of @a memory, of at least memorySize(@a capacity) bytes.
+  /// If @a init is true, the ring is (re)initialised, otherwise an initialised
+  /// ring is expected.
+  MetricsRing(void* memory, size_t capacity, bool init);
+  ~MetricsRing();
+
+  /// Name of the segment of a given device for a given driver
+  static std::string segmentName(int driverPid, std::string const& deviceId);
+  /// Bytes needed for a ring with @a capacity records
+  static size_t memorySize(size_t capacity) { return sizeof(Header) + capacity * sizeof(MetricRecord); }
+
+  /// Create a new segment (owned by the driver), nullptr on failure.
+  /// @a capacity is rounded to the next power of 2.
+  static std::unique_ptr<MetricsRing> create(std::string const& name, size_t capacity);
+  /// Attach to the segment created by the driver, nullptr on failure.
+  /// The name is removed once attached, the memory goes away with the last user.
+  static std::unique_ptr<MetricsRing> attach(std::string const& name);
+
+  bool valid() const { return mHeader != nullptr; }
+  size_t capacity() const { return mHeader->capacity; }
+  uint64_t overflows() const { return mHeader->overflows.load(std::memory_order_relaxed); }
+
+  /// Producer side, @return false if the metric could not be stored
+  bool push(std::string_view name, MetricType type, int intValue, float floatValue, uint64_t uint64Value, uint64_t timestamp);
+
+  /// Producer side, to be called before a metric is sent via the text channel
+  void textMetricSent() { mHeader->textSent.fetch_add(1, std::memory_order_relaxed); }
+  /// Consumer side, to be called after a text metric of the producer has been processed
+  void textMetricProcessed() { mHeader->textProcessed.fetch_add(1, std::memory_order_release); }
+  /// Producer side, @return true if the consumer has processed all the records
+  /// and all the text metrics sent so far
+  bool caughtUp() const
+  {
+    return mHeader->tail.load(std::memory_order_acquire) == mHeader->head.load(std::memory_order_relaxed) &&
+           mHeader->textProcessed.load(std::memory_order_acquire) >= mHeader->textSent.load(std::memory_order_relaxed);
+  }
+
+  /// Consumer side, invoke @a callback for all the available records
+  /// @return the number of records consumed
+  template <typename F>
+  size_t drain(F&& callback)
+  {
+    auto tail = mHeader->tail.load(std::memory_order_relaxed);
+    auto head = mHeader->head.load(std::memory_order_acquire);
+    auto mask = mHeader->capacity - 1;
+    for (auto pos = tail; pos != head; ++pos) {
+      callback(mRecords[pos & mask]);
+    }
+    mHeader->tail.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+  /// Fill the same structure used for the text metrics from a record,
+  /// so that it can be handed to DeviceMetricsHelper::processMetric.
+  /// @return false if the record is not valid
+  static bool toParsedMetric(MetricRecord const& record, ParsedMetricMatch& match);
+
+ private:
+  Header* mHeader = nullptr;
+  MetricRecord* mRecords = nullptr;
+  void* mMapping = nullptr; ///< when owning the mapping
+  size_t mMappingSize = 0;
+  std::string mName; ///< when created by us, unlinked on destruction
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_METRICSRING_H_
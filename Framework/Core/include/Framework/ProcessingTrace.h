@@ -0,0 +1,145 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_PROCESSINGTRACE_H_
+#define O2_FRAMEWORK_PROCESSINGTRACE_H_
+
+#include "Framework/ServiceHandle.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// The stages of the processing of a timeslice which are traced
+enum struct TraceStage : uint8_t {
+  Relay,      ///< an input message is relayed to the cache
+  Dispatch,   ///< a complete set of inputs is prepared for processing
+  Processing, ///< the user processing callback
+  Send,       ///< the post processing callbacks, i.e. sending of the outputs
+  CCDBFetch,  ///< retrieval of a condition object
+  Count
+};
+
+/// A completed span, times are in ns of the monotonic clock, which
+/// is shared by all the processes on a given node.
+struct TraceSpan {
+  uint64_t start = 0;
+  uint64_t end = 0;
+  uint64_t timeslice = 0;
+  TraceStage stage = TraceStage::Relay;
+};
+
+/// Fixed size ring buffer of spans, written by a single thread. When full,
+/// the oldest spans are overwritten. Reading while the owner thread is
+/// still writing may return a few spans being overwritten, which is
+/// acceptable for the purpose of post-mortem inspection.
+class TraceRingBuffer
+{
+ public:
+  explicit TraceRingBuffer(size_t capacityLog2, int threadIndex);
+
+  void push(TraceSpan const& span)
+  {
+    auto head = mHead.load(std::memory_order_relaxed);
+    mSpans[head & mMask] = span;
+    mHead.store(head + 1, std::memory_order_release);
+  }
+
+  /// Append the spans currently in the buffer, oldest first
+  void collect(std::vector<TraceSpan>& spans) const;
+
+  int threadIndex() const { return mThreadIndex; }
+
+ private:
+  std::vector<TraceSpan> mSpans;
+  uint64_t mMask;
+  std::atomic<uint64_t> mHead = 0;
+  int mThreadIndex;
+};
+
+/// Service collecting the processing spans of a device in per-thread ring
+/// buffers, which can be exported in the Chrome trace event format (also
+/// understood by Perfetto). The files of different devices can be loaded
+/// together to inspect a full topology.
+class ProcessingTrace
+{
+ public:
+  constexpr static ServiceKind service_kind = ServiceKind::Global;
+
+  /// @a filename empty disables the tracing
+  ProcessingTrace(std::string filename, std::string deviceName, size_t capacityLog2 = 16);
+
+  bool enabled() const { return mFilename.empty() == false; }
+
+  static uint64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  void record(TraceStage stage, uint64_t timeslice, uint64_t start, uint64_t end)
+  {
+    threadBuffer().push(TraceSpan{start, end, timeslice, stage});
+  }
+
+  /// Write the spans collected so far to the configured file
+  void exportTrace() const;
+  /// Write the spans collected so far in the Chrome trace event format
+  void exportTrace(std::ostream& out) const;
+
+  static char const* stageName(TraceStage stage);
+
+ private:
+  TraceRingBuffer& threadBuffer();
+
+  std::string mFilename;
+  std::string mDeviceName;
+  size_t mCapacityLog2;
+  uint64_t mId; ///< unique id of the instance, to match the thread local buffers
+  mutable std::mutex mBuffersMutex; ///< only taken when a thread records its first span and on export
+  std::vector<std::unique_ptr<TraceRingBuffer>> mBuffers;
+};
+
+/// Records a span for the lifetime of the scope, if tracing is enabled
+class TraceScope
+{
+ public:
+  TraceScope(ProcessingTrace& trace, TraceStage stage, uint64_t timeslice)
+    : mTrace{trace.enabled() ? &trace : nullptr}, mStage{stage}, mTimeslice{timeslice}, mStart{mTrace ? ProcessingTrace::now() : 0}
+  {
+  }
+
+  ~TraceScope()
+  {
+    if (mTrace) {
+      mTrace->record(mStage, mTimeslice, mStart, ProcessingTrace::now());
+    }
+  }
+
+  /// The timeslice might be known only once the scope has started
+  void setTimeslice(uint64_t timeslice) { mTimeslice = timeslice; }
+
+ private:
+  ProcessingTrace* mTrace;
+  TraceStage mStage;
+  uint64_t mTimeslice;
+  uint64_t mStart;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_PROCESSINGTRACE_H_
@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_SLICEINDEXCACHE_H_
+#define O2_FRAMEWORK_SLICEINDEXCACHE_H_
+
+#include <arrow/table.h>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Dense value -> (offset, count) index of a table grouped by an integer
+/// column (e.g. the collision index of the tracks), so that the slice for
+/// any value is found in O(1).
+struct SliceIndex {
+  std::vector<int64_t> offsets;                  ///< first row of each value >= 0
+  std::vector<int64_t> counts;                   ///< number of rows of each value >= 0, 0 if absent
+  std::vector<std::array<int64_t, 3>> negatives; ///< (value, offset, count) for the negative (unassigned) values
+  int64_t nRows = 0;
+
+  /// @return the (offset, count) of the slice for @a value. A value which is
+  /// not present gives an empty slice at the end of the table.
+  std::pair<int64_t, int64_t> getSliceFor(int value) const
+  {
+    if (value >= 0) {
+      if (size_t(value) < counts.size() && counts[value] != 0) {
+        return {offsets[value], counts[value]};
+      }
+    } else {
+      for (auto& n : negatives) {
+        if (n[0] == value) {
+          return {n[1], n[2]};
+        }
+      }
+    }
+    return {nRows, 0};
+  }
+
+  /// Build the index for column @a key of @a table, which must be an int32 column
+  static arrow::Status build(std::shared_ptr<arrow::Table> const& table, char const* key, SliceIndex& index);
+};
+
+/// Slice indices shared by all the users of the same table data in the process
+/// (i.e. all the tasks of a device). An index is built once for each table
+/// and key column, the first time it is requested, and stays valid as long as
+/// the data of the table is alive: the entries are tied to the arrow buffer of
+/// the key column and dropped once it has been released, so that nothing has
+/// to be reset at the end of a timeframe.
+class SliceIndexCache
+{
+ public:
+  static SliceIndexCache& instance();
+
+  /// Get (building it if needed) the index of @a table for column @a key
+  arrow::Status get(std::shared_ptr<arrow::Table> const& table, char const* key, std::shared_ptr<SliceIndex const>& index);
+
+  /// Number of cached indices
+  size_t size() const;
+  void clear();
+
+ private:
+  struct Entry {
+    std::string key;
+    void const* data = nullptr; ///< start of the values of the first chunk of the key column
+    int64_t nRows = 0;
+    int nChunks = 0;
+    std::weak_ptr<arrow::Buffer> buffer; ///< to know when the data is gone
+    std::shared_ptr<SliceIndex const> index;
+  };
+
+  mutable std::mutex mMutex;
+  std::vector<Entry> mEntries;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SLICEINDEXCACHE_H_
@@ -15,6 +15,7 @@
 #include "Framework/TimingInfo.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/DataTakingContext.h"
+#include "Framework/ProcessingTrace.h"
 #include "Framework/RawDeviceService.h"
 #include "CCDB/CcdbApi.h"
 #include "CommonConstants/LHCConstants.h"
@@ -157,7 +158,8 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
                        int64_t timestamp,
                        TimingInfo& timingInfo,
                        DataTakingContext& dtc,
-                       DataAllocator& allocator) -> void
+                       DataAllocator& allocator,
+                       ProcessingTrace& trace) -> void
 {
   // For Giulio: the dtc.orbitResetTime is wrong, it is assigned from the dph->creation, why?
   std::string ccdbMetadataPrefix = "ccdb-metadata-";
@@ -190,7 +192,10 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
     }
     const auto& api = helper->getAPI(path);
     if (!api.isSnapshotMode() || etag.empty()) { // in the snapshot mode the object needs to be fetched only once
-      api.loadFileToMemory(v, path, metadata, timestamp, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+      {
+        TraceScope fetchScope(trace, TraceStage::CCDBFetch, timingInfo.timeslice);
+        api.loadFileToMemory(v, path, metadata, timestamp, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+      }
       if ((headers.count("Error") != 0) || (etag.empty() && v.empty())) {
         LOGP(debug, "Unable to find object {}/{}", path, timingInfo.timeslice);
         // FIXME: I should send a dummy message.
@@ -260,7 +265,7 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
         }
       }
 
-      return adaptStateless([helper](DataTakingContext& dtc, DataAllocator& allocator, TimingInfo& timingInfo) {
+      return adaptStateless([helper](DataTakingContext& dtc, DataAllocator& allocator, TimingInfo& timingInfo, ProcessingTrace& trace) {
         static Long64_t orbitResetTime = -1;
         // Fetch the CCDB object for the CTP
         {
@@ -280,7 +285,10 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
           auto&& v = allocator.makeVector<char>(output);
           const auto& api = helper->getAPI(path);
           if (!api.isSnapshotMode() || etag.empty()) { // in the snapshot mode the object needs to be fetched only once
-            api.loadFileToMemory(v, path, metadata, timingInfo.creation, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+            {
+              TraceScope fetchScope(trace, TraceStage::CCDBFetch, timingInfo.timeslice);
+              api.loadFileToMemory(v, path, metadata, timingInfo.creation, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+            }
             if ((headers.count("Error") != 0) || (etag.empty() && v.empty())) {
               LOGP(error, "Unable to find object {}/{}", path, timingInfo.creation);
               // FIXME: I should send a dummy message.
@@ -323,7 +331,7 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
         LOGP(info, "Fetching objects. Run: {}. OrbitResetTime: {}, Creation: {}, Timestamp: {}, firstTFOrbit: {}",
              dtc.runNumber, orbitResetTime, timingInfo.creation, timestamp, timingInfo.firstTFOrbit);
 
-        populateCacheWith(helper, timestamp, timingInfo, dtc, allocator);
+        populateCacheWith(helper, timestamp, timingInfo, dtc, allocator, trace);
       }); });
 }
 
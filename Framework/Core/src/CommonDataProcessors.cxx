@@ -365,6 +365,11 @@ DataProcessorSpec
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
         for (auto d : ds) {
+          // Arrow output: the table is written as it is, without conversion to a TTree
+          if (dod->isArrowFormat()) {
+            dod->writeArrowTable(d, tfNumber, table);
+            continue;
+          }
           auto fileAndFolder = dod->getFileFolder(d, tfNumber);
           auto treename = fileAndFolder.folderName + d->treename;
           TableToTree ta2tr(table,
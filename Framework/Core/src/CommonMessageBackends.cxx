@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 #include "Framework/CommonMessageBackends.h"
 #include "Framework/MessageContext.h"
+#include "Framework/MessagePool.h"
 #include "Framework/ArrowContext.h"
 #include "Framework/StringContext.h"
 #include "Framework/RawBufferContext.h"
@@ -18,6 +19,7 @@
 #include "Framework/RawDeviceService.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/EndOfStreamContext.h"
+#include "Framework/DanglingContext.h"
 #include "Framework/Tracing.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceInfo.h"
@@ -32,6 +34,7 @@
 
 #include <uv.h>
 #include <boost/program_options/variables_map.hpp>
+#include <chrono>
 #include <csignal>
 
 // This is to allow C++20 aggregate initialisation
@@ -103,6 +106,50 @@ o2::framework::ServiceSpec CommonMessageBackends::rawBufferBackendSpec()
     .kind = ServiceKind::Serial};
 }
 
+namespace
+{
+/// Report the message pool counters, at most once per second
+void sendMessagePoolMetrics(ServiceRegistry& registry, MessagePool& pool)
+{
+  if (pool.active() == false || pool.reportDue(std::chrono::seconds(1)) == false) {
+    return;
+  }
+  using namespace o2::monitoring;
+  auto& monitoring = registry.get<Monitoring>();
+  auto stats = pool.getStats();
+  monitoring.send(Metric{stats.requests, "message_pool/requests"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.reused, "message_pool/allocations_avoided"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.fallbacks, "message_pool/fallbacks"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.carvedBytes, "message_pool/carved_bytes"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.freeBytes, "message_pool/free_bytes"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.internalFragmentation(), "message_pool/internal_fragmentation"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.idleFraction(), "message_pool/idle_fraction"}.addTag(Key::Subsystem, Value::DPL));
+}
+} // namespace
+
+o2::framework::ServiceSpec CommonMessageBackends::messagePoolSpec()
+{
+  return ServiceSpec{
+    .name = "message-pool",
+    .init = [](ServiceRegistry& services, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
+      auto& device = services.get<RawDeviceService>();
+      size_t regionSize = 0;
+      if (options.Count("shm-message-pool-size")) {
+        regionSize = std::stoull(options.GetPropertyAsString("shm-message-pool-size"));
+      }
+      auto pool = new MessagePool(device.device(), regionSize);
+      if (pool->active()) {
+        LOGP(info, "Output messages are allocated from a pool of {} bytes per channel", regionSize);
+        services.get<MessageContext>().setMessagePool(pool);
+      }
+      return ServiceHandle{TypeIdHelpers::uniqueId<MessagePool>(), pool, ServiceKind::Global};
+    },
+    .configure = CommonServices::noConfiguration(),
+    .preDangling = [](DanglingContext& context, void* service) { sendMessagePoolMetrics(context.services(), *reinterpret_cast<MessagePool*>(service)); },
+    .preEOS = [](EndOfStreamContext& context, void* service) { sendMessagePoolMetrics(context.services(), *reinterpret_cast<MessagePool*>(service)); },
+    .kind = ServiceKind::Global};
+}
+
 } // namespace o2::framework
 
 #pragma GCC diagnostic pop
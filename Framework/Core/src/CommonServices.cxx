@@ -30,6 +30,7 @@
 #include "Framework/RawDeviceService.h"
 #include "Framework/RunningWorkflowInfo.h"
 #include "Framework/Tracing.h"
+#include "Framework/ProcessingTrace.h"
 #include "Framework/Monitoring.h"
 #include "TextDriverClient.h"
 #include "WSDriverClient.h"
@@ -466,6 +467,25 @@ o2::framework::ServiceSpec CommonServices::tracingSpec()
     .kind = ServiceKind::Serial};
 }
 
+o2::framework::ServiceSpec CommonServices::processingTraceSpec()
+{
+  return ServiceSpec{
+    .name = "processing-trace",
+    .init = [](ServiceRegistry& services, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
+      auto& spec = services.get<DeviceSpec const>();
+      std::string filename;
+      if (options.Count("processing-trace") && options.GetPropertyAsString("processing-trace").empty() == false) {
+        filename = options.GetPropertyAsString("processing-trace") + spec.id + ".json";
+        LOGP(info, "Processing trace will be written to {} on exit or on SIGUSR2", filename);
+      }
+      return ServiceHandle{TypeIdHelpers::uniqueId<ProcessingTrace>(), new ProcessingTrace(filename, spec.id), ServiceKind::Global};
+    },
+    .configure = noConfiguration(),
+    .exit = [](ServiceRegistry&, void* service) {
+      reinterpret_cast<ProcessingTrace*>(service)->exportTrace(); },
+    .kind = ServiceKind::Global};
+}
+
 // FIXME: allow configuring the default number of threads per device
 //        This should probably be done by overriding the preFork
 //        callback and using the boost program options there to
@@ -685,6 +705,7 @@ std::vector<ServiceSpec> CommonServices::defaultServices(int numThreads)
     controlSpec(),
     rootFileSpec(),
     parallelSpec(),
+    processingTraceSpec(),
     callbacksSpec(),
     dataRelayer(),
     dataSender(),
@@ -693,7 +714,8 @@ std::vector<ServiceSpec> CommonServices::defaultServices(int numThreads)
     CommonMessageBackends::fairMQBackendSpec(),
     ArrowSupport::arrowBackendSpec(),
     CommonMessageBackends::stringBackendSpec(),
-    CommonMessageBackends::rawBufferBackendSpec()};
+    CommonMessageBackends::rawBufferBackendSpec(),
+    CommonMessageBackends::messagePoolSpec()};
   if (numThreads) {
     specs.push_back(threadPool(numThreads));
   }
@@ -11,8 +11,10 @@
 
 #include "DPLMonitoringBackend.h"
 #include "Framework/DriverClient.h"
+#include "Framework/MetricsRing.h"
 #include "Framework/ServiceRegistry.h"
 #include <fmt/format.h>
+#include <cstdlib>
 #include <sstream>
 
 namespace o2::framework
@@ -29,8 +31,14 @@ overloaded(Ts...) -> overloaded<Ts...>;
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistry& registry)
   : mRegistry{registry}
 {
+  char const* segment = getenv(MetricsRing::ENV_VARIABLE);
+  if (segment != nullptr) {
+    mRing = MetricsRing::attach(segment);
+  }
 }
 
+DPLMonitoringBackend::~DPLMonitoringBackend() = default;
+
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
 {
   // FIXME: tags are ignored by DPL in any case...
@@ -53,6 +61,32 @@ inline unsigned long convertTimestamp(const std::chrono::time_point<std::chrono:
 
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  if (mRing && metric.getValuesSize() == 1) {
+    // String metrics keep using the text format
+    auto pushToRing = overloaded{
+      [](const std::string&) { return false; },
+      [this, &metric](auto value) {
+        using T = decltype(value);
+        auto timestamp = convertTimestamp(metric.getTimestamp());
+        std::lock_guard<std::mutex> lock(mRingMutex);
+        if (mRingOverflow && !mRing->caughtUp()) {
+          return false;
+        }
+        bool pushed = false;
+        if constexpr (std::is_same_v<T, int>) {
+          pushed = mRing->push(metric.getName(), MetricType::Int, value, 0, 0, timestamp);
+        } else if constexpr (std::is_floating_point_v<T>) {
+          pushed = mRing->push(metric.getName(), MetricType::Float, 0, value, 0, timestamp);
+        } else {
+          pushed = mRing->push(metric.getName(), MetricType::Uint64, 0, 0, value, timestamp);
+        }
+        mRingOverflow = !pushed;
+        return pushed;
+      }};
+    if (std::visit(pushToRing, metric.getValues().front().second)) {
+      return;
+    }
+  }
   std::array<char, 4096> buffer;
   auto mStream = fmt::format_to(buffer.begin(), "[METRIC] {}", metric.getName());
   for (auto& value : metric.getValues()) {
@@ -83,6 +117,10 @@ void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
     throw runtime_error_f("Metric too long");
   }
   buffer[size] = '\0';
+  if (mRing) {
+    // announced before sending, so that the driver can never appear to be caught up with this metric pending
+    mRing->textMetricSent();
+  }
   mRegistry.get<framework::DriverClient>().tell(buffer.data(), size);
 }
 
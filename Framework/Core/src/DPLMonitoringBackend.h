@@ -12,14 +12,23 @@
 #define O2_FRAMEWORK_DPLMONITORINGBACKEND_H_
 
 #include "Monitoring/Backend.h"
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+class MetricsRing;
 
 /// \brief Prints metrics to standard output via std::cout
+///
+/// When the driver provides a shared memory metrics ring, the single valued
+/// numeric metrics are passed via the ring instead, falling back to the text
+/// format whenever the ring is full. After such an overflow all the metrics
+/// keep going through the text format until the driver has caught up with
+/// both channels, so that the values of a metric are not reordered.
 class DPLMonitoringBackend final : public o2::monitoring::Backend
 {
  public:
@@ -27,7 +36,7 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   DPLMonitoringBackend(ServiceRegistry& registry);
 
   /// Default destructor
-  ~DPLMonitoringBackend() override = default;
+  ~DPLMonitoringBackend() override;
 
   /// Prints metric
   /// \param metric           reference to metric object
@@ -46,6 +55,9 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistry& mRegistry;
+  std::unique_ptr<MetricsRing> mRing; ///< binary channel to the driver, if any
+  std::mutex mRingMutex;              ///< the ring has a single producer
+  bool mRingOverflow = false;         ///< the ring was full, text metrics are used until the driver catches up
 };
 
 } // namespace o2::framework
@@ -255,11 +255,21 @@ void DataAllocator::adopt(const Output& spec, std::shared_ptr<arrow::Table> ptr)
   context.addBuffer(std::move(header), buffer, std::move(writer), channel);
 }
 
+FairMQMessagePtr DataAllocator::createPayloadMessage(const Output& spec, size_t size)
+{
+  auto& context = mRegistry->get<MessageContext>();
+  if (context.hasMessagePool() == false) {
+    return context.proxy().createMessage(size);
+  }
+  // pooled blocks belong to the region of the output channel
+  std::string const& channel = matchDataHeader(spec, mRegistry->get<TimingInfo>().timeslice);
+  return context.createMessage(channel, 0, size);
+}
+
 void DataAllocator::snapshot(const Output& spec, const char* payload, size_t payloadSize,
                              o2::header::SerializationMethod serializationMethod)
 {
-  auto& proxy = mRegistry->get<MessageContext>().proxy();
-  FairMQMessagePtr payloadMessage(proxy.createMessage(payloadSize));
+  FairMQMessagePtr payloadMessage(createPayloadMessage(spec, payloadSize));
   memcpy(payloadMessage->GetData(), payload, payloadSize);
 
   addPartToContext(std::move(payloadMessage), spec, serializationMethod);
@@ -20,6 +20,13 @@
 #include "TGrid.h"
 #include "TObjString.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -90,8 +97,29 @@ bool DataInputDescriptor::setFile(int counter)
     return false;
   }
 
-  // open file
+  // Arrow input: the folders are the sub directories DF_x
   auto filename = mfilenames[counter]->fileName;
+  if (isArrowFile(counter)) {
+    closeInputFile();
+    if (mfilenames[counter]->numberOfTimeFrames <= 0) {
+      std::regex TFRegex = std::regex("DF_[0-9]+");
+      for (auto const& entry : std::filesystem::directory_iterator(filename)) {
+        auto folderName = entry.path().filename().string();
+        if (entry.is_directory() && std::regex_match(folderName, TFRegex)) {
+          mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(std::stoul(folderName.substr(3)));
+        }
+      }
+      std::sort(mfilenames[counter]->listOfTimeFrameNumbers.begin(), mfilenames[counter]->listOfTimeFrameNumbers.end());
+
+      for (auto folderNumber : mfilenames[counter]->listOfTimeFrameNumbers) {
+        mfilenames[counter]->listOfTimeFrameKeys.emplace_back("DF_" + std::to_string(folderNumber));
+      }
+      mfilenames[counter]->numberOfTimeFrames = mfilenames[counter]->listOfTimeFrameKeys.size();
+    }
+    return true;
+  }
+
+  // open file
   if (mcurrentFile) {
     if (mcurrentFile->GetName() != filename) {
       closeInputFile();
@@ -170,6 +198,67 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowFile(int counter)
+{
+  if (counter >= getNumberInputfiles()) {
+    return false;
+  }
+  std::error_code ec;
+  return std::filesystem::is_directory(mfilenames[counter]->fileName, ec);
+}
+
+std::shared_ptr<arrow::Table> DataInputDescriptor::getArrowTable(int counter, int numTF, std::string const& treename)
+{
+  // open file
+  if (!setFile(counter)) {
+    return nullptr;
+  }
+
+  // no TF left
+  if (mfilenames[counter]->numberOfTimeFrames > 0 && numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return nullptr;
+  }
+
+  // the table is stored in <treename>.arrow and possibly further parts <treename>.<n>.arrow
+  auto path = mfilenames[counter]->fileName + "/" + (mfilenames[counter]->listOfTimeFrameKeys)[numTF] + "/" + treename;
+  std::shared_ptr<arrow::Schema> schema;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int part = 0;; ++part) {
+    auto fileName = part ? fmt::format("{}.{}.arrow", path, part) : path + ".arrow";
+    if (part && !std::filesystem::exists(fileName)) {
+      break;
+    }
+    // the file is memory mapped, the record batches refer to the mapped buffers
+    auto file = arrow::io::MemoryMappedFile::Open(fileName, arrow::io::FileMode::READ);
+    if (!file.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't open table "{}" of "{}": {})", treename, mfilenames[counter]->fileName, file.status().ToString()));
+    }
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(file.ValueOrDie());
+    if (!reader.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read "{}": {})", fileName, reader.status().ToString()));
+    }
+    auto fileReader = reader.ValueOrDie();
+    if (!schema) {
+      schema = fileReader->schema();
+    }
+    for (int i = 0; i < fileReader->num_record_batches(); ++i) {
+      auto batch = fileReader->ReadRecordBatch(i);
+      if (!batch.ok()) {
+        throw std::runtime_error(fmt::format(R"(Couldn't read record batch {} of "{}": {})", i, fileName, batch.status().ToString()));
+      }
+      batches.emplace_back(batch.ValueOrDie());
+    }
+  }
+
+  // label the table like the ones read from trees
+  schema = schema->WithMetadata(std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{treename}));
+  auto table = arrow::Table::FromRecordBatches(schema, batches);
+  if (!table.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't assemble table "{}" of "{}": {})", treename, mfilenames[counter]->fileName, table.status().ToString()));
+  }
+  return table.ValueOrDie();
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -583,6 +672,36 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+bool DataInputDirector::isArrowFile(header::DataHeader dh, int counter)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  if (!didesc) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+
+  return didesc->isArrowFile(counter);
+}
+
+std::shared_ptr<arrow::Table> DataInputDirector::getArrowTable(header::DataHeader dh, int counter, int numTF)
+{
+  std::string treename;
+
+  auto didesc = getDataInputDescriptor(dh);
+  if (didesc) {
+    // if match then use filename and treename from DataInputDescriptor
+    treename = didesc->treename;
+  } else {
+    // if NOT match then use
+    //  . filename from defaultDataInputDescriptor
+    //  . treename from DataHeader
+    didesc = mdefaultDataInputDescriptor;
+    treename = aod::datamodel::getTreeName(dh);
+  }
+
+  return didesc->getArrowTable(counter, numTF, treename);
+}
+
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
@@ -15,6 +15,12 @@
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/filereadstream.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -143,9 +149,20 @@ void DataOutputDirector::reset()
   mtreeFilenames.clear();
   closeDataFiles();
   mfilePtrs.clear();
+  marrowDirectories.clear();
+  marrowFileParts.clear();
   mfilenameBase = std::string("");
 };
 
+void DataOutputDirector::setFileFormat(std::string fileformat)
+{
+  if (fileformat != "root" && fileformat != "arrow") {
+    LOGP(error, "Unknown AOD output format \"{}\", the format stays \"{}\"!", fileformat, mfileFormat);
+    return;
+  }
+  mfileFormat = fileformat;
+}
+
 void DataOutputDirector::readString(std::string const& keepString)
 {
   // the keep-string keepString consists of ','-separated items
@@ -314,6 +331,16 @@ std::tuple<std::string, std::string, int> DataOutputDirector::readJsonDocument(D
     }
   }
 
+  itemName = "resfileformat";
+  if (dodirItem.HasMember(itemName)) {
+    if (dodirItem[itemName].IsString()) {
+      setFileFormat(dodirItem[itemName].GetString());
+    } else {
+      LOGP(error, "Check the JSON document! Item \"{}\" must be a string!", itemName);
+      return memptyanswer;
+    }
+  }
+
   itemName = "ntfmerge";
   if (dodirItem.HasMember(itemName)) {
     if (dodirItem[itemName].IsNumber()) {
@@ -456,6 +483,117 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+bool DataOutputDirector::writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table)
+{
+  // folderNumber is the time frame number rounded to ntfmerge, the tables of the
+  // merged time frames are appended to the same files as further record batches
+  auto filenameBase = dodesc->getFilenameBase();
+  auto folderName = "DF_" + std::to_string(folderNumber);
+
+  // select the requested columns, the data is not copied
+  auto output = table;
+  if (!dodesc->colnames.empty()) {
+    std::vector<int> indices;
+    for (auto& cn : dodesc->colnames) {
+      auto idx = table->schema()->GetFieldIndex(cn);
+      if (idx != -1) {
+        indices.emplace_back(idx);
+      }
+    }
+    auto selected = table->SelectColumns(indices);
+    if (!selected.ok()) {
+      LOGP(error, "Unable to select the columns of tree {}: {}", dodesc->treename, selected.status().ToString());
+      return false;
+    }
+    output = selected.ValueOrDie();
+  }
+
+  // the files of the previous folders are done
+  closeArrowFiles(filenameBase, folderName);
+
+  auto file = std::find_if(marrowFiles.begin(), marrowFiles.end(), [&](ArrowOutputFile const& f) {
+    return f.filenameBase == filenameBase && f.folderName == folderName && f.treename == dodesc->treename;
+  });
+  if (file == marrowFiles.end()) {
+    auto directory = filenameBase + ".arrow";
+    if (std::find(marrowDirectories.begin(), marrowDirectories.end(), directory) == marrowDirectories.end()) {
+      if (std::filesystem::exists(directory)) {
+        if (mfileMode == "RECREATE") {
+          std::filesystem::remove_all(directory);
+        } else if (mfileMode == "NEW" || mfileMode == "CREATE") {
+          LOGP(error, "The output directory {} exists already!", directory);
+          return false;
+        }
+      }
+      marrowDirectories.emplace_back(directory);
+    }
+
+    auto path = directory + "/" + folderName;
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+    if (ec) {
+      LOGP(error, "Unable to create the output directory {}: {}", path, ec.message());
+      return false;
+    }
+
+    // a folder which is written again (e.g. when merging time frames which
+    // arrive out of order) gets an additional part <treename>.<n>.arrow
+    path += "/" + dodesc->treename;
+    auto parts = marrowFileParts.find(path);
+    if (parts == marrowFileParts.end()) {
+      // in UPDATE mode the parts written by a previous job are kept
+      int existing = 0;
+      while (std::filesystem::exists(existing ? fmt::format("{}.{}.arrow", path, existing) : path + ".arrow")) {
+        ++existing;
+      }
+      parts = marrowFileParts.emplace(path, existing).first;
+    }
+    auto part = parts->second++;
+    path += part ? fmt::format(".{}.arrow", part) : std::string(".arrow");
+
+    auto stream = arrow::io::FileOutputStream::Open(path);
+    if (!stream.ok()) {
+      LOGP(error, "Unable to open the output file {}: {}", path, stream.status().ToString());
+      return false;
+    }
+    auto writer = arrow::ipc::MakeFileWriter(stream.ValueOrDie(), output->schema());
+    if (!writer.ok()) {
+      LOGP(error, "Unable to create the writer for {}: {}", path, writer.status().ToString());
+      return false;
+    }
+    marrowFiles.push_back(ArrowOutputFile{filenameBase, folderName, dodesc->treename, stream.ValueOrDie(), writer.ValueOrDie()});
+    file = std::prev(marrowFiles.end());
+  }
+
+  // the record batches are written directly from the buffers of the table
+  auto status = file->writer->WriteTable(*output);
+  if (!status.ok()) {
+    LOGP(error, "Unable to write tree {} to {}: {}", dodesc->treename, filenameBase, status.ToString());
+    return false;
+  }
+
+  return true;
+}
+
+void DataOutputDirector::closeArrowFiles(std::string const& filenameBase, std::string const& keepFolder)
+{
+  auto toClose = [&](ArrowOutputFile const& f) {
+    return (filenameBase.empty() || f.filenameBase == filenameBase) && f.folderName != keepFolder;
+  };
+  for (auto& f : marrowFiles) {
+    if (toClose(f)) {
+      auto status = f.writer->Close();
+      if (status.ok()) {
+        status = f.stream->Close();
+      }
+      if (!status.ok()) {
+        LOGP(error, "Unable to close the output file of tree {} in {}/{}: {}", f.treename, f.filenameBase, f.folderName, status.ToString());
+      }
+    }
+  }
+  marrowFiles.erase(std::remove_if(marrowFiles.begin(), marrowFiles.end(), toClose), marrowFiles.end());
+}
+
 void DataOutputDirector::closeDataFiles()
 {
   for (auto filePtr : mfilePtrs) {
@@ -463,12 +601,14 @@ void DataOutputDirector::closeDataFiles()
       filePtr->Close();
     }
   }
+  closeArrowFiles("", "");
 }
 
 void DataOutputDirector::printOut()
 {
   LOGP(info, "DataOutputDirector");
   LOGP(info, "  Default file name    : {}", mfilenameBase);
+  LOGP(info, "  Output format        : {}", mfileFormat);
   LOGP(info, "  Number of files      : {}", mfilenameBases.size());
 
   LOGP(info, "  DataOutputDescriptors: {}", mDataOutputDescriptors.size());
@@ -37,6 +37,7 @@
 #include "Framework/Logger.h"
 #include "Framework/DriverClient.h"
 #include "Framework/Monitoring.h"
+#include "Framework/ProcessingTrace.h"
 #include "PropertyTreeHelpers.h"
 #include "DataProcessingStatus.h"
 #include "DataProcessingHelpers.h"
@@ -60,6 +61,7 @@
 #include <algorithm>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <uv.h>
 #include <execinfo.h>
@@ -409,6 +411,12 @@ void on_signal_callback(uv_signal_t* handle, int signum)
   context->stats->totalSigusr1 += 1;
 }
 
+void on_trace_export_signal(uv_signal_t* handle, int signum)
+{
+  LOG(info) << "Signal " << signum << " received, exporting processing trace.";
+  reinterpret_cast<ProcessingTrace*>(handle->data)->exportTrace();
+}
+
 /// Invoke the callbacks for the mPendingRegionInfos
 void handleRegionCallbacks(ServiceRegistry& registry, std::vector<FairMQRegionInfo>& infos)
 {
@@ -631,6 +639,16 @@ void DataProcessingDevice::InitTask()
   sigusr1Handle->data = &mDeviceContext;
   uv_signal_start(sigusr1Handle, on_signal_callback, SIGUSR1);
 
+  // When tracing, SIGUSR2 dumps the spans collected so far, so that a
+  // stalled topology can be inspected without stopping it.
+  auto& trace = mServiceRegistry.get<ProcessingTrace>();
+  if (trace.enabled()) {
+    uv_signal_t* sigusr2Handle = (uv_signal_t*)malloc(sizeof(uv_signal_t));
+    uv_signal_init(mState.loop, sigusr2Handle);
+    sigusr2Handle->data = &trace;
+    uv_signal_start(sigusr2Handle, on_trace_export_signal, SIGUSR2);
+  }
+
   /// Initialise the pollers
   DataProcessingDevice::initPollers();
 
@@ -1207,7 +1225,8 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
     registry.get<DataProcessingStats>().errorCount++;
   };
 
-  auto handleValidMessages = [&info, &context = context, &relayer = *context.relayer, &reportError](std::vector<InputInfo> const& inputInfos) {
+  auto handleValidMessages = [&info, &context = context, &relayer = *context.relayer, &reportError,
+                              &trace = context.registry->get<ProcessingTrace>()](std::vector<InputInfo> const& inputInfos) {
     static WaitBackpressurePolicy policy;
     auto& parts = info.parts;
     // We relay execution to make sure we have a complete set of parts
@@ -1230,6 +1249,11 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
             nPayloadsPerHeader = 1;
             ii += (nMessages / 2) - 1;
           }
+          TraceScope relayScope(trace, TraceStage::Relay, 0);
+          if (trace.enabled()) {
+            auto dph = o2::header::get<DataProcessingHeader*>(parts.At(headerIndex)->GetData());
+            relayScope.setTimeslice(dph ? dph->startTime : 0);
+          }
           auto relayed = relayer.relay(parts.At(headerIndex)->GetData(),
                                        &parts.At(headerIndex),
                                        nMessages,
@@ -1641,6 +1665,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   };
 
   // This is the main dispatching loop
+  auto& trace = context.registry->get<ProcessingTrace>();
   LOGP(debug, "Processing actions:");
   for (auto action : getReadyActions()) {
     LOGP(debug, "  Begin action");
@@ -1649,7 +1674,9 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       continue;
     }
 
+    auto dispatchScope = std::make_optional<TraceScope>(trace, TraceStage::Dispatch, 0);
     prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot});
+    dispatchScope->setTimeslice(context.timingInfo->timeslice);
     bool shouldConsume = action.op == CompletionPolicy::CompletionOp::Consume ||
                          action.op == CompletionPolicy::CompletionOp::Discard;
     InputSpan span = getInputSpan(action.slot, shouldConsume);
@@ -1663,6 +1690,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
       LOGP(debug, "  - Action is to Discard");
+      dispatchScope.reset();
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
         forwardInputs(action.slot, record, false);
@@ -1681,13 +1709,15 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       forwardInputs(action.slot, record, true, action.op == CompletionPolicy::CompletionOp::Consume);
     }
     markInputsAsDone(action.slot);
+    dispatchScope.reset();
 
     uint64_t tStart = uv_hrtime();
     preUpdateStats(action, record, tStart);
 
     static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
 
-    auto runNoCatch = [&context, &processContext](DataRelayer::RecordAction& action) {
+    auto runNoCatch = [&context, &processContext, &trace](DataRelayer::RecordAction& action) {
+      auto timeslice = context.timingInfo->timeslice;
       if (context.deviceContext->state->quitRequested == false) {
         {
           ZoneScopedN("service post processing");
@@ -1698,9 +1728,11 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
         }
         if (*context.statefulProcess) {
           ZoneScopedN("statefull process");
+          TraceScope processingScope(trace, TraceStage::Processing, timeslice);
           (*context.statefulProcess)(processContext);
         } else if (*context.statelessProcess) {
           ZoneScopedN("stateless process");
+          TraceScope processingScope(trace, TraceStage::Processing, timeslice);
           (*context.statelessProcess)(processContext);
         } else {
           context.deviceContext->state->streaming = StreamingState::Idle;
@@ -1713,6 +1745,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
 
         {
           ZoneScopedN("service post processing");
+          TraceScope sendScope(trace, TraceStage::Send, timeslice);
           context.registry->postProcessingCallbacks(processContext);
         }
       }
@@ -1308,6 +1308,8 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("shm-mlock-segment-on-creation", bpo::value<std::string>());
         realOdesc.add_options()("shm-zero-segment", bpo::value<std::string>());
         realOdesc.add_options()("shm-throw-bad-alloc", bpo::value<std::string>());
+        realOdesc.add_options()("shm-message-pool-size", bpo::value<std::string>());
+        realOdesc.add_options()("processing-trace", bpo::value<std::string>());
         realOdesc.add_options()("shm-segment-id", bpo::value<std::string>());
         realOdesc.add_options()("shm-allocation", bpo::value<std::string>());
         realOdesc.add_options()("shm-no-cleanup", bpo::value<std::string>());
@@ -1468,6 +1470,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("shm-zero-segment", bpo::value<std::string>()->default_value("false"), "zero shared memory segment")                                                            //
     ("shm-throw-bad-alloc", bpo::value<std::string>()->default_value("true"), "throw if insufficient shm memory")                                                    //
     ("shm-segment-id", bpo::value<std::string>()->default_value("0"), "shm segment id")                                                                              //
+    ("shm-message-pool-size", bpo::value<std::string>(), "size in bytes of the per channel region used to recycle output messages")                                   //
+    ("processing-trace", bpo::value<std::string>(), "prefix of the Chrome trace file <prefix><device>.json written on exit or on SIGUSR2")                             //
     ("shm-allocation", bpo::value<std::string>()->default_value("rbtree_best_fit"), "shm allocation method")                                                         //
     ("shm-no-cleanup", bpo::value<std::string>()->default_value("false"), "no shm cleanup")                                                                          //
     ("shmid", bpo::value<std::string>(), "shmid")                                                                                                                    //
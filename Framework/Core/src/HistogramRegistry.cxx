@@ -10,12 +10,141 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/HistogramRegistry.h"
+#include <algorithm>
 #include <regex>
 #include <TList.h>
 
 namespace o2::framework
 {
 
+HistFillBuffer::HistFillBuffer(std::shared_ptr<TH1> hist, uint32_t capacity)
+  : mHist(hist), mArrayD(dynamic_cast<TArrayD*>(hist.get())), mArrayF(dynamic_cast<TArrayF*>(hist.get())), mDim(hist->GetDimension()), mCapacity(std::max(capacity, 1u))
+{
+  for (int d = 0; d < mDim; ++d) {
+    mCoordinates[d].resize(mCapacity);
+    mBins[d].resize(mCapacity);
+  }
+  mWeights.resize(mCapacity);
+}
+
+void HistFillBuffer::flush()
+{
+  if (!mSize) {
+    return;
+  }
+  if (canFillDirectly()) {
+    fillDirectly();
+  } else {
+    fillStandard();
+  }
+  mSize = 0;
+}
+
+bool HistFillBuffer::canFillDirectly() const
+{
+  // ROOT's own buffer, extendable axes and user ranges (which make TH1::GetStats recompute the statistics) need the standard path
+  if (mHist->GetBuffer()) {
+    return false;
+  }
+  const TAxis* axes[MaxDim] = {mHist->GetXaxis(), mHist->GetYaxis(), mHist->GetZaxis()};
+  for (int d = 0; d < mDim; ++d) {
+    if (axes[d]->CanExtend() || axes[d]->TestBit(TAxis::kAxisRange)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HistFillBuffer::fillStandard()
+{
+  for (uint32_t i = 0; i < mSize; ++i) {
+    if (mDim == 1) {
+      mHist->Fill(mCoordinates[0][i], mWeights[i]);
+    } else if (mDim == 2) {
+      static_cast<TH2*>(mHist.get())->Fill(mCoordinates[0][i], mCoordinates[1][i], mWeights[i]);
+    } else {
+      static_cast<TH3*>(mHist.get())->Fill(mCoordinates[0][i], mCoordinates[1][i], mCoordinates[2][i], mWeights[i]);
+    }
+  }
+}
+
+void HistFillBuffer::fillDirectly()
+{
+  // bin indices along each axis, following TAxis::FindBin
+  const TAxis* axes[MaxDim] = {mHist->GetXaxis(), mHist->GetYaxis(), mHist->GetZaxis()};
+  int nBins[MaxDim] = {1, 1, 1};
+  for (int d = 0; d < mDim; ++d) {
+    nBins[d] = axes[d]->GetNbins();
+    const double xMin = axes[d]->GetXmin();
+    const double xMax = axes[d]->GetXmax();
+    const int n = nBins[d];
+    const double* x = mCoordinates[d].data();
+    int* bins = mBins[d].data();
+    if (!axes[d]->GetXbins()->fN) {
+      for (uint32_t i = 0; i < mSize; ++i) {
+        bins[i] = (x[i] < xMin) ? 0 : (!(x[i] < xMax) ? n + 1 : 1 + int(n * (x[i] - xMin) / (xMax - xMin)));
+      }
+    } else {
+      const double* edges = axes[d]->GetXbins()->GetArray();
+      for (uint32_t i = 0; i < mSize; ++i) {
+        bins[i] = (x[i] < xMin) ? 0 : (!(x[i] < xMax) ? n + 1 : int(std::upper_bound(edges, edges + n + 1, x[i]) - edges));
+      }
+    }
+  }
+
+  // update bin contents and statistics in the same order as TH1::Fill
+  double stats[TH1::kNstat]{};
+  mHist->GetStats(stats);
+  const bool statOverflows = mHist->GetStatOverflowsBehaviour();
+  TArrayD* sumw2 = mHist->GetSumw2();
+  for (uint32_t i = 0; i < mSize; ++i) {
+    int bin = 0;
+    bool inRange = true;
+    for (int d = mDim; d--;) {
+      const int b = mBins[d][i];
+      inRange &= (b > 0 && b <= nBins[d]);
+      bin = bin * (nBins[d] + 2) + b;
+    }
+    const double w = mWeights[i];
+    if (!sumw2->fN && w != 1. && !mHist->TestBit(TH1::kIsNotW)) {
+      mHist->Sumw2(); // must be called before the bin content is updated
+    }
+    if (sumw2->fN) {
+      sumw2->fArray[bin] += w * w;
+    }
+    if (mArrayD) {
+      mArrayD->fArray[bin] += w;
+    } else if (mArrayF) {
+      mArrayF->fArray[bin] += Float_t(w);
+    } else {
+      mHist->AddBinContent(bin, w);
+    }
+    if (!inRange && !statOverflows) {
+      continue;
+    }
+    const double x = mCoordinates[0][i];
+    stats[0] += w;
+    stats[1] += w * w;
+    stats[2] += w * x;
+    stats[3] += w * x * x;
+    if (mDim > 1) {
+      const double y = mCoordinates[1][i];
+      stats[4] += w * y;
+      stats[5] += w * y * y;
+      stats[6] += w * x * y;
+      if (mDim > 2) {
+        const double z = mCoordinates[2][i];
+        stats[7] += w * z;
+        stats[8] += w * z * z;
+        stats[9] += w * x * z;
+        stats[10] += w * y * z;
+      }
+    }
+  }
+  mHist->PutStats(stats);
+  mHist->SetEntries(mHist->GetEntries() + mSize);
+}
+
 constexpr HistogramRegistry::HistName::HistName(char const* const name)
   : str(name),
     hash(compile_time_hash(name)),
@@ -68,6 +197,7 @@ HistPtr HistogramRegistry::insert(const HistogramSpec& histSpec)
       registerName(histSpec.name);
       mRegistryKey[imask(idx + i)] = histSpec.hash;
       mRegistryValue[imask(idx + i)] = HistFactory::createHistVariant(histSpec);
+      createFillBuffer(imask(idx + i));
       lookup += i;
       return mRegistryValue[imask(idx + i)];
     }
@@ -109,9 +239,47 @@ HistPtr HistogramRegistry::add(char const* const name, char const* const title,
   return insert({name, title, {histType, axes}, callSumw2});
 }
 
+// buffer the fills of TH1, TH2 and TH3 histograms present in the registry or added later
+void HistogramRegistry::enableFillBuffering(uint32_t bufferSize)
+{
+  flush();
+  mFillBufferSize = bufferSize;
+  for (auto j = 0u; j < MAX_REGISTRY_SIZE; ++j) {
+    mFillBuffers[j].reset();
+    createFillBuffer(j);
+  }
+}
+
+void HistogramRegistry::createFillBuffer(uint32_t idx)
+{
+  if (!mFillBufferSize) {
+    return;
+  }
+  std::visit([&](const auto& sharedPtr) {
+    using T = std::decay_t<decltype(*sharedPtr)>;
+    if constexpr (std::is_same_v<T, TH1> || std::is_same_v<T, TH2> || std::is_same_v<T, TH3>) {
+      if (sharedPtr) {
+        mFillBuffers[idx] = std::make_shared<HistFillBuffer>(sharedPtr, mFillBufferSize);
+      }
+    }
+  },
+             mRegistryValue[idx]);
+}
+
+// add all buffered fills to the histograms
+void HistogramRegistry::flush()
+{
+  for (auto& buffer : mFillBuffers) {
+    if (buffer) {
+      buffer->flush();
+    }
+  }
+}
+
 // store a copy of an existing histogram (or group of histograms) under a different name
 void HistogramRegistry::addClone(const std::string& source, const std::string& target)
 {
+  flush();
   auto doInsertClone = [&](const auto& sharedPtr) {
     if (!sharedPtr.get()) {
       return;
@@ -263,6 +431,7 @@ void HistogramRegistry::print(bool showAxisDetails)
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::operator*()
 {
+  flush();
   TList* list = new TList();
   list->SetName(mName.data());
 
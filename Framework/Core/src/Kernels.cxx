@@ -12,6 +12,7 @@
 #include "Framework/Kernels.h"
 #include "Framework/BasicOps.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/SliceIndexCache.h"
 #include <arrow/compute/kernel.h>
 #include <arrow/compute/api_aggregate.h>
 #include <arrow/array/array_nested.h>
@@ -49,19 +50,14 @@ arrow::Status getSliceFor(
   std::shared_ptr<arrow::Table>& output,
   uint64_t& offset)
 {
-  std::shared_ptr<arrow::NumericArray<arrow::Int32Type>> values;
-  std::shared_ptr<arrow::NumericArray<arrow::Int64Type>> counts;
-
-  auto status = getSlices(key, input, values, counts);
-
-  for (auto slice = 0; slice < values->length(); ++slice) {
-    if (values->Value(slice) == value) {
-      output = input->Slice(offset, counts->Value(slice));
-      return arrow::Status::OK();
-    }
-    offset += counts->Value(slice);
+  std::shared_ptr<SliceIndex const> index;
+  auto status = SliceIndexCache::instance().get(input, key, index);
+  if (!status.ok()) {
+    return status;
   }
-  output = input->Slice(offset, 0);
+  auto [start, count] = index->getSliceFor(value);
+  offset += start;
+  output = input->Slice(start, count);
   return arrow::Status::OK();
 }
 
@@ -11,6 +11,7 @@
 
 #include "Framework/Output.h"
 #include "Framework/MessageContext.h"
+#include "Framework/MessagePool.h"
 #include "fairmq/FairMQDevice.h"
 
 namespace o2::framework
@@ -18,6 +19,9 @@ namespace o2::framework
 
 FairMQMessagePtr MessageContext::createMessage(const std::string& channel, int index, size_t size)
 {
+  if (mMessagePool) {
+    return mMessagePool->createMessage(channel, 0, size);
+  }
   return proxy().getDevice()->NewMessageFor(channel, 0, size, fair::mq::Alignment{64});
 }
 
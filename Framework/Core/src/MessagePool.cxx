@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/MessagePool.h"
+#include "Framework/Logger.h"
+
+#include <fairmq/FairMQDevice.h>
+#include <fairmq/FairMQMessage.h>
+#include <fairmq/FairMQTransportFactory.h>
+#include <fairmq/FairMQUnmanagedRegion.h>
+
+namespace o2::framework
+{
+
+MessagePool::MessagePool(FairMQDevice* device, size_t regionSize)
+  : MessagePool([device](std::string const& channel, int index) { return device->GetChannel(channel, index).Transport(); }, regionSize)
+{
+}
+
+MessagePool::MessagePool(TransportGetter transport, size_t regionSize)
+  : mTransport{std::move(transport)},
+    mRegionSize{regionSize}
+{
+}
+
+// The regions are owned by the pool, the transport takes care of the messages
+// still in flight.
+MessagePool::~MessagePool() = default;
+
+MessagePool::ChannelPool& MessagePool::getChannelPool(std::string const& channel, int index)
+{
+  auto it = mPools.find(channel);
+  if (it != mPools.end()) {
+    return *(it->second);
+  }
+  auto pool = std::make_unique<ChannelPool>();
+  auto* poolPtr = pool.get();
+  // the hint carries the size class of the block, so that the block can be
+  // put back in the correct free list once the message is released
+  pool->region = mTransport(channel, index)->CreateUnmanagedRegion(mRegionSize, [this, poolPtr](void* data, size_t, void* hint) {
+    this->release(*poolPtr, data, (int)reinterpret_cast<uintptr_t>(hint));
+  });
+  pool->base = reinterpret_cast<char*>(pool->region->GetData());
+  pool->size = pool->region->GetSize();
+  mStats.regionBytes += pool->size;
+  LOGP(info, "Created message pool region of {} bytes for channel {}", pool->size, channel);
+  return *(mPools[channel] = std::move(pool));
+}
+
+void MessagePool::release(ChannelPool& pool, void* data, int cls)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  pool.freeBlocks[cls].push_back(data);
+  mStats.freeBytes += sizeClassBytes(cls);
+}
+
+std::unique_ptr<FairMQMessage> MessagePool::createMessage(std::string const& channel, int index, size_t size)
+{
+  int cls = sizeClass(size);
+  if (cls < 0) {
+    return mTransport(channel, index)->CreateMessage(size, fair::mq::Alignment{64});
+  }
+  auto blockSize = sizeClassBytes(cls);
+  void* block = nullptr;
+  ChannelPool* pool = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.requests++;
+    pool = &getChannelPool(channel, index);
+    auto& freeBlocks = pool->freeBlocks[cls];
+    if (!freeBlocks.empty()) {
+      block = freeBlocks.back();
+      freeBlocks.pop_back();
+      mStats.freeBytes -= blockSize;
+      mStats.reused++;
+    } else if (pool->used + blockSize <= pool->size) {
+      // blocks sizes are multiples of the smallest class, so alignment is preserved
+      block = pool->base + pool->used;
+      pool->used += blockSize;
+      mStats.carvedBytes += blockSize;
+      mStats.carved++;
+    } else {
+      mStats.fallbacks++;
+    }
+    if (block) {
+      mStats.blockBytes += blockSize;
+      mStats.requestedBytes += size;
+    }
+  }
+  auto* transport = mTransport(channel, index);
+  if (block == nullptr) {
+    return transport->CreateMessage(size, fair::mq::Alignment{64});
+  }
+  return transport->CreateMessage(pool->region, block, size, reinterpret_cast<void*>(static_cast<uintptr_t>(cls)));
+}
+
+MessagePool::Stats MessagePool::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStats;
+}
+
+bool MessagePool::reportDue(std::chrono::steady_clock::duration interval)
+{
+  auto now = std::chrono::steady_clock::now();
+  if (now - mLastReport < interval) {
+    return false;
+  }
+  mLastReport = now;
+  return true;
+}
+
+} // namespace o2::framework
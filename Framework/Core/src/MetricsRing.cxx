@@ -0,0 +1,190 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/MetricsRing.h"
+#include "Framework/Logger.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+namespace
+{
+constexpr uint32_t RING_MAGIC = 0x4d50444f; // "ODPM"
+}
+
+MetricsRing::MetricsRing(void* memory, size_t capacity, bool init)
+{
+  if (memory == nullptr) {
+    return;
+  }
+  if (init) {
+    mHeader = new (memory) Header{};
+    mHeader->capacity = capacity;
+    mHeader->head.store(0, std::memory_order_relaxed);
+    mHeader->tail.store(0, std::memory_order_relaxed);
+    mHeader->overflows.store(0, std::memory_order_relaxed);
+    mHeader->textSent.store(0, std::memory_order_relaxed);
+    mHeader->textProcessed.store(0, std::memory_order_relaxed);
+    mHeader->magic = RING_MAGIC;
+  } else {
+    mHeader = reinterpret_cast<Header*>(memory);
+    if (mHeader->magic != RING_MAGIC || (mHeader->capacity & (mHeader->capacity - 1)) != 0) {
+      mHeader = nullptr;
+      return;
+    }
+  }
+  mRecords = reinterpret_cast<MetricRecord*>(reinterpret_cast<char*>(memory) + sizeof(Header));
+}
+
+MetricsRing::~MetricsRing()
+{
+  if (mMapping) {
+    munmap(mMapping, mMappingSize);
+  }
+  if (!mName.empty()) {
+    // The device normally did it already.
+    shm_unlink(mName.c_str());
+  }
+}
+
+std::string MetricsRing::segmentName(int driverPid, std::string const& deviceId)
+{
+  return fmt::format("/dpl-metrics-{}-{}", driverPid, deviceId);
+}
+
+std::unique_ptr<MetricsRing> MetricsRing::create(std::string const& name, size_t capacity)
+{
+  size_t roundedCapacity = 1;
+  while (roundedCapacity < capacity) {
+    roundedCapacity <<= 1;
+  }
+  auto size = memorySize(roundedCapacity);
+  // A leftover of a previous device with the same id is simply replaced
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    LOGP(warning, "Unable to create metrics segment {}: {}", name, strerror(errno));
+    return nullptr;
+  }
+  // Make sure the memory is actually available, so that we do not get a SIGBUS later on
+  int err = posix_fallocate(fd, 0, size);
+  void* mapping = err == 0 ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    LOGP(warning, "Unable to allocate {} bytes for metrics segment {}", size, name);
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  auto ring = std::make_unique<MetricsRing>(mapping, roundedCapacity, true);
+  ring->mMapping = mapping;
+  ring->mMappingSize = size;
+  ring->mName = name;
+  return ring;
+}
+
+std::unique_ptr<MetricsRing> MetricsRing::attach(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  void* mapping = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(Header)) {
+    mapping = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  shm_unlink(name.c_str());
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  auto ring = std::make_unique<MetricsRing>(mapping, 0, false);
+  ring->mMapping = mapping;
+  ring->mMappingSize = st.st_size;
+  if (!ring->valid() || memorySize(ring->capacity()) > (size_t)st.st_size) {
+    return nullptr;
+  }
+  return ring;
+}
+
+bool MetricsRing::push(std::string_view name, MetricType type, int intValue, float floatValue, uint64_t uint64Value, uint64_t timestamp)
+{
+  if (name.size() > MetricRecord::MAX_NAME_SIZE) {
+    return false;
+  }
+  auto head = mHeader->head.load(std::memory_order_relaxed);
+  auto tail = mHeader->tail.load(std::memory_order_acquire);
+  if (head - tail >= mHeader->capacity) {
+    mHeader->overflows.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  auto& record = mRecords[head & (mHeader->capacity - 1)];
+  record.timestamp = timestamp;
+  record.type = static_cast<uint8_t>(type);
+  switch (type) {
+    case MetricType::Int:
+      record.intValue = intValue;
+      break;
+    case MetricType::Float:
+      record.floatValue = floatValue;
+      break;
+    case MetricType::Uint64:
+      record.uint64Value = uint64Value;
+      break;
+    default:
+      return false;
+  }
+  record.nameSize = name.size();
+  memcpy(record.name, name.data(), name.size());
+  mHeader->head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+bool MetricsRing::toParsedMetric(MetricRecord const& record, ParsedMetricMatch& match)
+{
+  // The memory is shared with the device, do not trust it blindly
+  if (record.nameSize == 0 || record.nameSize > MetricRecord::MAX_NAME_SIZE) {
+    return false;
+  }
+  match.beginKey = record.name;
+  match.endKey = record.name + record.nameSize;
+  match.timestamp = record.timestamp;
+  match.type = static_cast<MetricType>(record.type);
+  switch (match.type) {
+    case MetricType::Int:
+      match.intValue = record.intValue;
+      match.floatValue = (float)record.intValue;
+      break;
+    case MetricType::Float:
+      match.floatValue = record.floatValue;
+      break;
+    case MetricType::Uint64:
+      match.uint64Value = record.uint64Value;
+      match.floatValue = (float)record.uint64Value;
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+} // namespace o2::framework
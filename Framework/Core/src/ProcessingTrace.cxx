@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ProcessingTrace.h"
+#include "Framework/Logger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+TraceRingBuffer::TraceRingBuffer(size_t capacityLog2, int threadIndex)
+  : mSpans(size_t(1) << capacityLog2),
+    mMask((uint64_t(1) << capacityLog2) - 1),
+    mThreadIndex{threadIndex}
+{
+}
+
+void TraceRingBuffer::collect(std::vector<TraceSpan>& spans) const
+{
+  auto head = mHead.load(std::memory_order_acquire);
+  auto size = std::min<uint64_t>(head, mSpans.size());
+  for (auto i = head - size; i < head; ++i) {
+    spans.push_back(mSpans[i & mMask]);
+  }
+}
+
+namespace
+{
+std::atomic<uint64_t> gTraceInstances = 0;
+}
+
+ProcessingTrace::ProcessingTrace(std::string filename, std::string deviceName, size_t capacityLog2)
+  : mFilename{std::move(filename)},
+    mDeviceName{std::move(deviceName)},
+    mCapacityLog2{capacityLog2},
+    mId{++gTraceInstances}
+{
+}
+
+TraceRingBuffer& ProcessingTrace::threadBuffer()
+{
+  thread_local uint64_t ownerId = 0;
+  thread_local TraceRingBuffer* buffer = nullptr;
+  if (ownerId != mId) {
+    std::lock_guard<std::mutex> lock(mBuffersMutex);
+    mBuffers.emplace_back(std::make_unique<TraceRingBuffer>(mCapacityLog2, (int)mBuffers.size()));
+    buffer = mBuffers.back().get();
+    ownerId = mId;
+  }
+  return *buffer;
+}
+
+char const* ProcessingTrace::stageName(TraceStage stage)
+{
+  switch (stage) {
+    case TraceStage::Relay:
+      return "relay";
+    case TraceStage::Dispatch:
+      return "dispatch";
+    case TraceStage::Processing:
+      return "processing";
+    case TraceStage::Send:
+      return "send";
+    case TraceStage::CCDBFetch:
+      return "ccdb-fetch";
+    default:
+      return "unknown";
+  }
+}
+
+void ProcessingTrace::exportTrace(std::ostream& out) const
+{
+  auto pid = getpid();
+  std::lock_guard<std::mutex> lock(mBuffersMutex);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":\"" << mDeviceName << "\"}}";
+  std::vector<TraceSpan> spans;
+  char buffer[256];
+  for (auto& threadBuffer : mBuffers) {
+    auto tid = threadBuffer->threadIndex();
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+    spans.clear();
+    threadBuffer->collect(spans);
+    for (auto& span : spans) {
+      // complete events, timestamps in us as mandated by the format
+      snprintf(buffer, sizeof(buffer), ",\n{\"name\":\"%s\",\"cat\":\"dpl\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"timeslice\":%lu}}",
+               stageName(span.stage), span.start * 1e-3, (span.end - span.start) * 1e-3, pid, tid, (unsigned long)span.timeslice);
+      out << buffer;
+    }
+  }
+  out << "\n]}\n";
+}
+
+void ProcessingTrace::exportTrace() const
+{
+  if (enabled() == false) {
+    return;
+  }
+  std::ofstream out(mFilename);
+  if (!out.is_open()) {
+    LOGP(error, "Unable to open {} to export the processing trace", mFilename);
+    return;
+  }
+  exportTrace(out);
+  LOGP(info, "Processing trace exported to {}", mFilename);
+}
+
+} // namespace o2::framework
@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SliceIndexCache.h"
+#include <arrow/array/array_primitive.h>
+#include <arrow/status.h>
+#include <algorithm>
+
+namespace o2::framework
+{
+
+arrow::Status SliceIndex::build(std::shared_ptr<arrow::Table> const& table, char const* key, SliceIndex& index)
+{
+  auto column = table->GetColumnByName(key);
+  if (column == nullptr) {
+    return arrow::Status::KeyError("No column ", key, " to slice by");
+  }
+  if (column->type()->id() != arrow::Type::INT32) {
+    return arrow::Status::TypeError("Column ", key, " used to slice is not int32");
+  }
+  index.offsets.clear();
+  index.counts.clear();
+  index.negatives.clear();
+  index.nRows = table->num_rows();
+
+  // the table is grouped by the key, so each value is a single run of rows
+  int64_t row = 0;
+  for (auto iChunk = 0; iChunk < column->num_chunks(); ++iChunk) {
+    auto chunk = static_cast<arrow::NumericArray<arrow::Int32Type>>(column->chunk(iChunk)->data());
+    auto values = chunk.raw_values();
+    for (int64_t i = 0; i < chunk.length(); ++i, ++row) {
+      auto v = values[i];
+      if (v >= 0) {
+        if (size_t(v) >= index.counts.size()) {
+          auto newSize = std::max(size_t(v) + 1, 2 * index.counts.size());
+          index.offsets.resize(newSize, 0);
+          index.counts.resize(newSize, 0);
+        }
+        if (index.counts[v]++ == 0) {
+          index.offsets[v] = row;
+        }
+      } else {
+        auto n = std::find_if(index.negatives.begin(), index.negatives.end(), [v](auto const& e) { return e[0] == v; });
+        if (n == index.negatives.end()) {
+          index.negatives.push_back({v, row, 1});
+        } else {
+          (*n)[2]++;
+        }
+      }
+    }
+  }
+  return arrow::Status::OK();
+}
+
+SliceIndexCache& SliceIndexCache::instance()
+{
+  static SliceIndexCache cache;
+  return cache;
+}
+
+arrow::Status SliceIndexCache::get(std::shared_ptr<arrow::Table> const& table, char const* key, std::shared_ptr<SliceIndex const>& index)
+{
+  auto column = table->GetColumnByName(key);
+  std::shared_ptr<arrow::Buffer> buffer;
+  void const* data = nullptr;
+  if (column != nullptr && column->num_chunks() > 0 && column->type()->id() == arrow::Type::INT32) {
+    auto const& chunkData = column->chunk(0)->data();
+    if (chunkData->buffers.size() > 1 && chunkData->buffers[1] != nullptr) {
+      buffer = chunkData->buffers[1];
+      data = chunkData->GetValues<int32_t>(1);
+    }
+  }
+  if (buffer == nullptr) {
+    // nothing to identify the data with, do not cache
+    auto newIndex = std::make_shared<SliceIndex>();
+    auto status = SliceIndex::build(table, key, *newIndex);
+    index = std::move(newIndex);
+    return status;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  // forget about the data which is gone (e.g. of previous timeframes)
+  mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(), [](Entry const& e) { return e.buffer.expired(); }), mEntries.end());
+  for (auto& e : mEntries) {
+    if (e.data == data && e.nRows == table->num_rows() && e.nChunks == column->num_chunks() && e.key == key) {
+      index = e.index;
+      return arrow::Status::OK();
+    }
+  }
+  auto newIndex = std::make_shared<SliceIndex>();
+  auto status = SliceIndex::build(table, key, *newIndex);
+  if (!status.ok()) {
+    return status;
+  }
+  mEntries.push_back(Entry{key, data, table->num_rows(), column->num_chunks(), buffer, newIndex});
+  index = std::move(newIndex);
+  return arrow::Status::OK();
+}
+
+size_t SliceIndexCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+void SliceIndexCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+}
+
+} // namespace o2::framework
@@ -1016,6 +1016,12 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-format")) {
+    auto format = options.get<std::string>("aod-writer-format");
+    if (!format.empty()) {
+      dod->setFileFormat(format);
+    }
+  }
   // parse the keepString
   auto isAOD = [](InputSpec const& spec) { return DataSpecUtils::partialMatch(spec, header::DataOrigin("AOD")); };
   if (options.isSet("aod-writer-keep")) {
@@ -26,6 +26,7 @@
 #include "Framework/DeviceInfo.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/MetricsRing.h"
 #include "Framework/DeviceConfigInfo.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/DeviceState.h"
@@ -478,6 +479,9 @@ struct ControlWebSocketHandler : public WebSocketHandler {
       // the DataRelayer view.
       assert(mContext.metrics);
       DeviceMetricsHelper::processMetric(metricMatch, (*mContext.metrics)[mIndex], newMetricCallback);
+      if (mContext.infos && (*mContext.infos)[mIndex].metricsRing) {
+        (*mContext.infos)[mIndex].metricsRing->textMetricProcessed();
+      }
       didProcessMetric = true;
       didHaveNewMetric |= hasNewMetric;
     } else if (ControlServiceHelpers::parseControl(token, match) && mContext.infos) {
@@ -699,6 +703,14 @@ void spawnDevice(DeviceRef ref,
       service.preFork(serviceRegistry, varmap);
     }
   }
+  // The segment must exist before the device starts, it will attach to it
+  // by name once its monitoring is set up.
+  std::shared_ptr<MetricsRing> metricsRing;
+  std::string metricsRingName;
+  if (driverInfo.metricsRingCapacity) {
+    metricsRingName = MetricsRing::segmentName(getpid(), spec.id);
+    metricsRing = MetricsRing::create(metricsRingName, driverInfo.metricsRingCapacity);
+  }
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
@@ -735,6 +747,9 @@ void spawnDevice(DeviceRef ref,
 
     auto portS = std::to_string(driverInfo.tracyPort);
     setenv("TRACY_PORT", portS.c_str(), 1);
+    if (metricsRing) {
+      setenv(MetricsRing::ENV_VARIABLE, metricsRingName.c_str(), 1);
+    }
     for (auto& service : spec.services) {
       if (service.postForkChild != nullptr) {
         service.postForkChild(serviceRegistry);
@@ -794,6 +809,7 @@ void spawnDevice(DeviceRef ref,
   info.outputsViewIndex = Metric2DViewIndex{"output_matchers", 0, 0, {}};
   info.tracyPort = driverInfo.tracyPort;
   info.lastSignal = uv_hrtime() - 10000000;
+  info.metricsRing = metricsRing;
 
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
@@ -836,17 +852,6 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     assert(specs.size() == infos.size());
     DeviceSpec const& spec = specs[di];
 
-    if (info.unprinted.empty()) {
-      continue;
-    }
-
-    O2_SIGNPOST_START(DriverStatus::ID, DriverStatus::BYTES_PROCESSED, info.pid, 0, 0);
-
-    std::string_view s = info.unprinted;
-    size_t pos = 0;
-    info.history.resize(info.historySize);
-    info.historyLevel.resize(info.historySize);
-
     auto updateMetricsViews =
       Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
                                      &info.variablesViewIndex,
@@ -858,6 +863,28 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
       hasNewMetric = true;
     };
 
+    // Binary metrics do not need any parsing and are processed first,
+    // since they do not depend on any output being available.
+    if (info.metricsRing) {
+      auto consumed = info.metricsRing->drain([&metricMatch, &metrics, &newMetricCallback](MetricRecord const& record) {
+        if (MetricsRing::toParsedMetric(record, metricMatch)) {
+          DeviceMetricsHelper::processMetric(metricMatch, metrics, newMetricCallback);
+        }
+      });
+      result.didProcessMetric |= consumed != 0;
+    }
+
+    if (info.unprinted.empty()) {
+      continue;
+    }
+
+    O2_SIGNPOST_START(DriverStatus::ID, DriverStatus::BYTES_PROCESSED, info.pid, 0, 0);
+
+    std::string_view s = info.unprinted;
+    size_t pos = 0;
+    info.history.resize(info.historySize);
+    info.historyLevel.resize(info.historySize);
+
     while ((pos = s.find(delimiter)) != std::string::npos) {
       std::string token{s.substr(0, pos)};
       auto logLevel = LogParsingHelpers::parseTokenLevel(token);
@@ -871,6 +898,9 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
         // We use this callback to cache which metrics are needed to provide a
         // the DataRelayer view.
         DeviceMetricsHelper::processMetric(metricMatch, metrics, newMetricCallback);
+        if (info.metricsRing) {
+          info.metricsRing->textMetricProcessed();
+        }
         result.didProcessMetric = true;
       } else if (logLevel == LogParsingHelpers::LogLevel::Info && ControlServiceHelpers::parseControl(token, match)) {
         ControlServiceHelpers::processCommand(infos, info.pid, match[1].str(), match[2].str());
@@ -1030,6 +1060,8 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                           //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                    //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                         //
+      ("shm-message-pool-size", bpo::value<std::string>()->default_value("0"), "size in bytes of the per channel region used to recycle output messages (0 disables)")                  //
+      ("processing-trace", bpo::value<std::string>()->default_value(""), "prefix of the Chrome trace file <prefix><device>.json (empty disables)")                                        //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
       ("infologger-mode", bpo::value<std::string>()->default_value(defaultInfologgerMode), "O2_INFOLOGGER_MODE override");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
@@ -1326,6 +1358,11 @@ int runStateMachine(DataProcessorSpecs const& workflow,
   uv_timer_t metricDumpTimer;
   metricDumpTimer.data = &serverContext;
 
+  // Metrics passed via shared memory do not wake up the loop by themselves,
+  // so we need to check for them regularly.
+  uv_timer_t metricsRingTimer;
+  uv_timer_init(loop, &metricsRingTimer);
+
   while (true) {
     // If control forced some transition on us, we push it to the queue.
     if (driverControl.forcedTransitions.empty() == false) {
@@ -1654,6 +1691,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-file",
             "--aod-memory-rate-limit",
             "--aod-writer-json",
+            "--aod-writer-format",
             "--aod-writer-ntfmerge",
             "--aod-writer-resfile",
             "--aod-writer-resmode",
@@ -1747,6 +1785,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
                          driverInfo.resourcesMonitoringDumpInterval * 1000,
                          driverInfo.resourcesMonitoringDumpInterval * 1000);
         }
+        if (driverInfo.metricsRingCapacity) {
+          uv_timer_start(&metricsRingTimer, [](uv_timer_t*) {}, 100, 100);
+        }
         LOG(info) << "Redeployment of configuration done.";
       } break;
       case DriverState::RUNNING:
@@ -1868,6 +1909,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
       } break;
       case DriverState::EXIT: {
+        uv_timer_stop(&metricsRingTimer);
         if (ResourcesMonitoringHelper::isResourcesMonitoringEnabled(driverInfo.resourcesMonitoringInterval)) {
           if (driverInfo.resourcesMonitoringDumpInterval) {
             uv_timer_stop(&metricDumpTimer);
@@ -2366,7 +2408,8 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                              //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                    //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")             //
-    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds"); //
+    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds")  //
+    ("metrics-shm-records", bpo::value<size_t>()->default_value(0), "records of the shared memory metrics channel of each device, 0 to use text metrics only"); //
   // some of the options must be forwarded by default to the device
   executorOptions.add(DeviceSpecHelpers::getForwardedDeviceOptions());
 
@@ -2599,6 +2642,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.argv = argv;
   driverInfo.batch = varmap["no-batch"].defaulted() ? varmap["batch"].as<bool>() : false;
   driverInfo.noSHMCleanup = varmap["no-cleanup"].as<bool>();
+  driverInfo.metricsRingCapacity = varmap["metrics-shm-records"].as<size_t>();
   driverInfo.processingPolicies.termination = varmap["completion-policy"].as<TerminationPolicy>();
   driverInfo.processingPolicies.earlyForward = varmap["early-forward-policy"].as<EarlyForwardPolicy>();
   if (varmap["error-policy"].defaulted() && driverInfo.batch == false) {
@@ -27,6 +27,8 @@ DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
 DECLARE_SOA_COLUMN_FULL(Y, y, float, "y");
 DECLARE_SOA_COLUMN_FULL(Z, z, float, "z");
 DECLARE_SOA_DYNAMIC_COLUMN(Sum, sum, [](float x, float y) { return x + y; });
+DECLARE_SOA_COLUMN_FULL(CollisionId, collisionId, int32_t, "fIndexCollisions");
+DECLARE_SOA_COLUMN_FULL(BCId, bcId, int32_t, "fIndexBCs");
 } // namespace test
 
 DECLARE_SOA_TABLE(TestTable, "AOD", "TESTTBL", test::X, test::Y, test::Z, test::Sum<test::X, test::Y>);
@@ -314,4 +316,39 @@ static void BM_ASoADynamicColumnCall(benchmark::State& state)
 }
 BENCHMARK(BM_ASoADynamicColumnCall)->Range(8, 8 << maxrange);
 
+// grouping of the tracks of state.range(0) collisions, as done for each
+// timeframe by the tasks of an analysis, alternating two keys
+static void BM_ASoASliceByCached(benchmark::State& state)
+{
+  constexpr int tracksPerCollision = 20;
+  constexpr int collisionsPerBC = 4;
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t, float>({"fIndexCollisions", "fIndexBCs", "x"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    for (auto j = 0; j < tracksPerCollision; ++j) {
+      rowWriter(0, i, i / collisionsPerBC, 1.f);
+    }
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::CollisionId, test::BCId, test::X>;
+
+  for (auto _ : state) {
+    // a new timeframe: the indices are built again
+    SliceIndexCache::instance().clear();
+    Test tests{table};
+    float sum = 0;
+    for (auto i = 0; i < state.range(0); ++i) {
+      for (auto& test : tests.sliceByCached(test::collisionId, i)) {
+        sum += test.x();
+      }
+      sum += tests.sliceByCached(test::bcId, i / collisionsPerBC).size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ASoASliceByCached)->Range(8, 8 << maxrange);
+
 BENCHMARK_MAIN();
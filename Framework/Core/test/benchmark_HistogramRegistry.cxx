@@ -62,6 +62,27 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+/// Fill a TH2F of a HistogramRegistry, directly or via the fill buffer of size state.range(1)
+static void BM_RegistryFill(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, -1, 1}, {100, -1, 1}}}}}};
+  if (state.range(1)) {
+    registry.enableFillBuffering(state.range(1));
+  }
+  std::vector<float> values(state.range(0));
+  for (auto i = 0u; i < values.size(); ++i) {
+    values[i] = std::sin(0.37 * i);
+  }
+  for (auto _ : state) {
+    for (auto i = 1u; i < values.size(); ++i) {
+      registry.fill(HIST("xy"), values[i - 1], values[i]);
+    }
+    registry.flush();
+  }
+  state.SetItemsProcessed(state.iterations() * (values.size() - 1));
+}
+
+BENCHMARK(BM_RegistryFill)->Args({100000, 0})->Args({100000, 256})->Args({100000, 4096});
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 
@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/MetricsRing.h"
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+
+// The names of the metrics of a typical device, so that the lookup in the
+// driver store is realistic.
+static std::vector<std::string> metricNames(int n)
+{
+  std::vector<std::string> names;
+  for (int i = 0; i < n; ++i) {
+    names.emplace_back(fmt::format("data_relayer/{}", i));
+  }
+  return names;
+}
+
+// Metrics/s processed by the driver via the text path: the device formats,
+// the driver splits lines, parses and stores them.
+static void BM_TextMetricsPath(benchmark::State& state)
+{
+  auto names = metricNames(state.range(0));
+  DeviceMetricsInfo info;
+  ParsedMetricMatch match;
+  std::string buffer;
+  size_t timestamp = 1789372894;
+  for (auto _ : state) {
+    buffer.clear();
+    for (size_t i = 0; i < names.size(); ++i) {
+      fmt::format_to(std::back_inserter(buffer), "[METRIC] {},0 {} {} hostname=test.cern.ch\n", names[i], i, timestamp);
+    }
+    std::string_view s = buffer;
+    size_t pos;
+    while ((pos = s.find('\n')) != std::string_view::npos) {
+      std::string token{s.substr(0, pos)};
+      if (DeviceMetricsHelper::parseMetric(token, match)) {
+        DeviceMetricsHelper::processMetric(match, info);
+      }
+      s.remove_prefix(pos + 1);
+    }
+    timestamp++;
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(BM_TextMetricsPath)->Arg(16)->Arg(256);
+
+// Metrics/s processed by the driver via the shared memory ring: the device
+// pushes a record, the driver drains it and stores it.
+static void BM_RingMetricsPath(benchmark::State& state)
+{
+  auto names = metricNames(state.range(0));
+  DeviceMetricsInfo info;
+  ParsedMetricMatch match;
+  std::vector<char> memory(MetricsRing::memorySize(1024));
+  MetricsRing ring(memory.data(), 1024, true);
+  size_t timestamp = 1789372894;
+  for (auto _ : state) {
+    for (size_t i = 0; i < names.size(); ++i) {
+      ring.push(names[i], MetricType::Int, i, 0, 0, timestamp);
+    }
+    ring.drain([&info, &match](MetricRecord const& record) {
+      if (MetricsRing::toParsedMetric(record, match)) {
+        DeviceMetricsHelper::processMetric(match, info);
+      }
+    });
+    timestamp++;
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(BM_RingMetricsPath)->Arg(16)->Arg(256);
+
+// Driver side only, i.e. the part which is in the critical path of the control loop.
+static void BM_RingDrainOnly(benchmark::State& state)
+{
+  auto names = metricNames(state.range(0));
+  DeviceMetricsInfo info;
+  ParsedMetricMatch match;
+  std::vector<char> memory(MetricsRing::memorySize(1024));
+  MetricsRing ring(memory.data(), 1024, true);
+  size_t timestamp = 1789372894;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t i = 0; i < names.size(); ++i) {
+      ring.push(names[i], MetricType::Int, i, 0, 0, timestamp);
+    }
+    state.ResumeTiming();
+    ring.drain([&info, &match](MetricRecord const& record) {
+      if (MetricsRing::toParsedMetric(record, match)) {
+        DeviceMetricsHelper::processMetric(match, info);
+      }
+    });
+    timestamp++;
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(BM_RingDrainOnly)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -919,6 +919,56 @@ BOOST_AUTO_TEST_CASE(TestSliceBy)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestSliceByCached)
+{
+  TableBuilder w;
+  auto writer_w = w.cursor<References>();
+  for (auto i = 0; i < 3; ++i) {
+    writer_w(0, -1); // unassigned
+  }
+  for (auto i = 0; i < 20; ++i) {
+    for (auto j = 0; j < (i % 4 == 1 ? 0 : i % 4 + 1); ++j) { // some values are missing
+      writer_w(0, i);
+    }
+  }
+  auto refs = w.finalize();
+
+  SliceIndexCache::instance().clear();
+  {
+    References r{refs};
+    uint64_t offset = 3;
+    for (auto i = 0; i < 20; ++i) {
+      auto slice = r.sliceByCached(test::originId, i);
+      BOOST_CHECK_EQUAL(slice.size(), i % 4 == 1 ? 0 : i % 4 + 1);
+      BOOST_CHECK_EQUAL(slice.size(), r.sliceBy(test::originId, i).size());
+      if (slice.size() > 0) {
+        BOOST_CHECK_EQUAL(slice.offset(), offset);
+      }
+      for (auto& ri : slice) {
+        BOOST_CHECK_EQUAL(ri.originId(), i);
+      }
+      offset += slice.size();
+    }
+    BOOST_CHECK_EQUAL(r.sliceByCached(test::originId, -1).size(), 3);
+    BOOST_CHECK_EQUAL(r.sliceByCached(test::originId, 100).size(), 0);
+
+    // another table on the same data reuses the same index
+    BOOST_CHECK_EQUAL(SliceIndexCache::instance().size(), 1);
+    References r2{refs};
+    BOOST_CHECK_EQUAL(r2.sliceByCached(test::originId, 19).size(), 4);
+    BOOST_CHECK_EQUAL(SliceIndexCache::instance().size(), 1);
+  }
+
+  // the index goes away with the data
+  refs.reset();
+  TableBuilder w2;
+  auto writer_w2 = w2.cursor<References>();
+  writer_w2(0, 0);
+  References r3{w2.finalize()};
+  BOOST_CHECK_EQUAL(r3.sliceByCached(test::originId, 0).size(), 1);
+  BOOST_CHECK_EQUAL(SliceIndexCache::instance().size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(TestIndexUnboundExceptions)
 {
   TableBuilder b;
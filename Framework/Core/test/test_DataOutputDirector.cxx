@@ -15,6 +15,10 @@
 #include <boost/test/unit_test.hpp>
 #include "Headers/DataHeader.h"
 #include "Framework/DataOutputDirector.h"
+#include "Framework/DataInputDirector.h"
+#include <arrow/builder.h>
+#include <arrow/table.h>
+#include <filesystem>
 #include <fstream>
 
 BOOST_AUTO_TEST_CASE(TestDataOutputDirector)
@@ -125,3 +129,89 @@ BOOST_AUTO_TEST_CASE(TestDataOutputDirector)
   BOOST_CHECK_EQUAL(ds[1]->treename, std::string("due"));
   BOOST_CHECK_EQUAL(ds[1]->colnames.size(), 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestDataOutputDirectorArrow)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  auto dh = DataHeader(DataDescription{"UNO"},
+                       DataOrigin{"AOD"},
+                       DataHeader::SubSpecificationType{0});
+
+  // the format is taken from the json document, unknown formats are ignored
+  DataOutputDirector dod;
+  dod.readJsonString(R"({"OutputDirector": {"resfileformat": "arrow", "OutputDescriptors": [{"table": "AOD/UNO/0", "columns": ["c2"], "treename": "uno", "filename": "arrowresults"}]}})");
+  BOOST_CHECK(dod.isArrowFormat());
+  dod.setFileFormat("parquet");
+  BOOST_CHECK_EQUAL(dod.getFileFormat(), std::string("arrow"));
+  dod.setFilenameBase("AnalysisResults");
+
+  auto makeTable = [](int offset) {
+    arrow::Int32Builder b1, b2;
+    for (int i = 0; i < 10; ++i) {
+      BOOST_REQUIRE(b1.Append(offset + i).ok());
+      BOOST_REQUIRE(b2.Append(2 * (offset + i)).ok());
+    }
+    std::shared_ptr<arrow::Array> a1, a2;
+    BOOST_REQUIRE(b1.Finish(&a1).ok());
+    BOOST_REQUIRE(b2.Finish(&a2).ok());
+    auto schema = arrow::schema({arrow::field("c1", arrow::int32()), arrow::field("c2", arrow::int32())});
+    return arrow::Table::Make(schema, {a1, a2});
+  };
+
+  // 2 tables in folder DF_0, one in DF_1
+  auto ds = dod.getDataOutputDescriptors(dh);
+  BOOST_REQUIRE_EQUAL(ds.size(), 1);
+  BOOST_CHECK(dod.writeArrowTable(ds[0], 0, makeTable(0)));
+  BOOST_CHECK(dod.writeArrowTable(ds[0], 0, makeTable(10)));
+  BOOST_CHECK(dod.writeArrowTable(ds[0], 1, makeTable(20)));
+  dod.closeDataFiles();
+
+  // read back the selected column
+  DataInputDirector didir(std::string("arrowresults.arrow"));
+  auto jsonString = R"({"InputDirector": {"InputDescriptors": [{"table": "AOD/UNO/0", "treename": "uno"}]}})";
+  std::ofstream jf("testO2arrow.json", std::ofstream::out);
+  jf << jsonString << std::endl;
+  jf.close();
+  BOOST_REQUIRE(didir.readJson("testO2arrow.json"));
+
+  BOOST_REQUIRE(didir.isArrowFile(dh, 0));
+  BOOST_CHECK_EQUAL(didir.getTimeFramesInFile(dh, 0), 0);
+  auto table = didir.getArrowTable(dh, 0, 0);
+  BOOST_REQUIRE(table);
+  BOOST_CHECK_EQUAL(didir.getTimeFramesInFile(dh, 0), 2);
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 1), 1);
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 1);
+  BOOST_CHECK_EQUAL(table->schema()->field(0)->name(), std::string("c2"));
+  BOOST_CHECK_EQUAL(table->num_rows(), 20);
+  BOOST_CHECK_EQUAL(table->schema()->metadata()->Get("label").ValueOrDie(), std::string("uno"));
+
+  table = didir.getArrowTable(dh, 0, 1);
+  BOOST_REQUIRE(table);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 10);
+  auto values = std::static_pointer_cast<arrow::Int32Array>(table->column(0)->chunk(0));
+  BOOST_CHECK_EQUAL(values->Value(3), 46);
+
+  BOOST_CHECK(!didir.getArrowTable(dh, 0, 2));
+
+  // in UPDATE mode the existing files are kept and the new table is added as a further part
+  DataOutputDirector dodUpdate;
+  dodUpdate.readJsonString(R"({"OutputDirector": {"resfileformat": "arrow", "OutputDescriptors": [{"table": "AOD/UNO/0", "columns": ["c2"], "treename": "uno", "filename": "arrowresults"}]}})");
+  dodUpdate.setFileMode("UPDATE");
+  ds = dodUpdate.getDataOutputDescriptors(dh);
+  BOOST_REQUIRE_EQUAL(ds.size(), 1);
+  BOOST_CHECK(dodUpdate.writeArrowTable(ds[0], 1, makeTable(30)));
+  dodUpdate.closeDataFiles();
+  BOOST_CHECK(std::filesystem::exists("arrowresults.arrow/DF_1/uno.arrow"));
+  BOOST_CHECK(std::filesystem::exists("arrowresults.arrow/DF_1/uno.1.arrow"));
+
+  DataInputDirector didirUpdate(std::string("arrowresults.arrow"));
+  BOOST_REQUIRE(didirUpdate.readJson("testO2arrow.json"));
+  table = didirUpdate.getArrowTable(dh, 0, 1);
+  BOOST_REQUIRE(table);
+  BOOST_CHECK_EQUAL(table->num_rows(), 20);
+  values = std::static_pointer_cast<arrow::Int32Array>(table->column(0)->chunk(1));
+  BOOST_CHECK_EQUAL(values->Value(3), 66);
+  std::filesystem::remove_all("arrowresults.arrow");
+}
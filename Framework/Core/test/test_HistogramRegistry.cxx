@@ -129,3 +129,49 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 
   registry.print();
 }
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryBufferedFill)
+{
+  std::vector<HistogramSpec> histSpecs{
+    {"x", "x", {HistType::kTH1F, {{100, -1.0, 1.0}}}},                                            //
+    {"xVar", "x variable binning", {HistType::kTH1D, {{std::vector<double>{-1., -0.5, 0., 0.1, 0.9}}}}}, //
+    {"xy", "xy", {HistType::kTH2D, {{50, -1.0, 1.0}, {20, -0.5, 0.5}}}},                          //
+    {"xyz", "xyz", {HistType::kTH3F, {{10, -1.0, 1.0}, {10, -1.0, 1.0}, {10, -1.0, 1.0}}}}        //
+  };
+  HistogramRegistry direct{"direct", histSpecs};
+  HistogramRegistry buffered{"buffered", histSpecs};
+  buffered.enableFillBuffering(64);
+
+  // values outside of the axes ranges test under- and overflows, the weighted fills trigger Sumw2
+  auto value = [](int i, int j) { return std::sin(0.37 * i + 1.3 * j) * 1.2; };
+  for (int i = 0; i < 1000; ++i) {
+    direct.fill(HIST("x"), value(i, 0));
+    buffered.fill(HIST("x"), value(i, 0));
+    direct.fill(HIST("xVar"), value(i, 1), 0.5);
+    buffered.fill(HIST("xVar"), value(i, 1), 0.5);
+    direct.fill(HIST("xy"), value(i, 0), value(i, 2));
+    buffered.fill(HIST("xy"), value(i, 0), value(i, 2));
+    direct.fill(HIST("xyz"), value(i, 0), value(i, 1), value(i, 2), i < 500 ? 1. : 2.);
+    buffered.fill(HIST("xyz"), value(i, 0), value(i, 1), value(i, 2), i < 500 ? 1. : 2.);
+  }
+
+  auto compare = [](std::shared_ptr<TH1> h1, std::shared_ptr<TH1> h2) {
+    BOOST_CHECK_EQUAL(h1->GetEntries(), h2->GetEntries());
+    BOOST_CHECK_EQUAL(h1->GetSumw2N(), h2->GetSumw2N());
+    for (int bin = 0; bin < h1->GetNcells(); ++bin) {
+      BOOST_CHECK_EQUAL(h1->GetBinContent(bin), h2->GetBinContent(bin));
+      BOOST_CHECK_EQUAL(h1->GetBinError(bin), h2->GetBinError(bin));
+    }
+    double stats1[TH1::kNstat]{}, stats2[TH1::kNstat]{};
+    h1->GetStats(stats1);
+    h2->GetStats(stats2);
+    for (int i = 0; i < TH1::kNstat; ++i) {
+      BOOST_CHECK_EQUAL(stats1[i], stats2[i]);
+    }
+  };
+  compare(direct.get<TH1>(HIST("x")), buffered.get<TH1>(HIST("x")));
+  compare(direct.get<TH1>(HIST("xVar")), buffered.get<TH1>(HIST("xVar")));
+  compare(direct.get<TH2>(HIST("xy")), buffered.get<TH2>(HIST("xy")));
+  compare(direct.get<TH3>(HIST("xyz")), buffered.get<TH3>(HIST("xyz")));
+  BOOST_CHECK(buffered.get<TH1>(HIST("xVar"))->GetSumw2N() > 0);
+}
@@ -0,0 +1,141 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework MessagePool
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/MessagePool.h"
+#include <fairmq/FairMQMessage.h>
+#include <fairmq/FairMQTransportFactory.h>
+#include <chrono>
+#include <thread>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestSizeClasses)
+{
+  BOOST_CHECK_EQUAL(MessagePool::sizeClass(0), -1);
+  BOOST_CHECK_EQUAL(MessagePool::sizeClass(1), 0);
+  BOOST_CHECK_EQUAL(MessagePool::sizeClass(256), 0);
+  BOOST_CHECK_EQUAL(MessagePool::sizeClass(257), 1);
+  BOOST_CHECK_EQUAL(MessagePool::sizeClass(1 << 20), MessagePool::NSizeClasses - 1);
+  BOOST_CHECK_EQUAL(MessagePool::sizeClass((1 << 20) + 1), -1);
+
+  for (size_t size = 1; size <= (1 << 20); size = size * 3 + 1) {
+    auto cls = MessagePool::sizeClass(size);
+    BOOST_REQUIRE(cls >= 0);
+    // the block fits the message and is the smallest one to do so
+    BOOST_CHECK(MessagePool::sizeClassBytes(cls) >= size);
+    BOOST_CHECK(cls == 0 || MessagePool::sizeClassBytes(cls - 1) < size);
+    // blocks are multiple of the smallest one, which keeps them aligned when carved sequentially
+    BOOST_CHECK_EQUAL(MessagePool::sizeClassBytes(cls) % MessagePool::sizeClassBytes(0), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDisabledPool)
+{
+  MessagePool pool(nullptr, 0);
+  BOOST_CHECK(pool.active() == false);
+  auto stats = pool.getStats();
+  BOOST_CHECK_EQUAL(stats.requests, 0);
+  BOOST_CHECK_EQUAL(stats.internalFragmentation(), 0.f);
+  BOOST_CHECK_EQUAL(stats.idleFraction(), 0.f);
+}
+
+namespace
+{
+/// the shared memory transport releases the region blocks asynchronously
+bool waitForFreeBytes(MessagePool& pool, uint64_t freeBytes)
+{
+  for (int i = 0; i < 500; i++) {
+    if (pool.getStats().freeBytes == freeBytes) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestRecycling)
+{
+  auto factory = FairMQTransportFactory::CreateTransportFactory("shmem");
+  size_t regionSize = 4096;
+  MessagePool pool([&factory](std::string const&, int) { return factory.get(); }, regionSize);
+  BOOST_REQUIRE(pool.active());
+
+  // the first request of a class carves a new block
+  auto msg = pool.createMessage("out", 0, 1000);
+  BOOST_REQUIRE(msg);
+  BOOST_CHECK_EQUAL(msg->GetSize(), 1000);
+  auto* block = msg->GetData();
+  auto stats = pool.getStats();
+  BOOST_CHECK_EQUAL(stats.requests, 1);
+  BOOST_CHECK_EQUAL(stats.carved, 1);
+  BOOST_CHECK_EQUAL(stats.reused, 0);
+  BOOST_CHECK_EQUAL(stats.fallbacks, 0);
+  BOOST_CHECK_EQUAL(stats.carvedBytes, 1024);
+  BOOST_CHECK_EQUAL(stats.freeBytes, 0);
+  BOOST_CHECK(stats.regionBytes >= regionSize);
+
+  // once released by the region callback, the block waits in the free list...
+  msg.reset();
+  BOOST_REQUIRE(waitForFreeBytes(pool, 1024));
+
+  // ... and is handed out again for the next request of the same class
+  msg = pool.createMessage("out", 0, 700);
+  BOOST_CHECK_EQUAL(msg->GetSize(), 700);
+  BOOST_CHECK(msg->GetData() == block);
+  stats = pool.getStats();
+  BOOST_CHECK_EQUAL(stats.requests, 2);
+  BOOST_CHECK_EQUAL(stats.carved, 1);
+  BOOST_CHECK_EQUAL(stats.reused, 1);
+  BOOST_CHECK_EQUAL(stats.carvedBytes, 1024);
+  BOOST_CHECK_EQUAL(stats.freeBytes, 0);
+  BOOST_CHECK_EQUAL(stats.blockBytes, 2048);
+  BOOST_CHECK_EQUAL(stats.requestedBytes, 1700);
+
+  // a different class carves a new block after the first one
+  auto msg2 = pool.createMessage("out", 0, 2048);
+  BOOST_CHECK(msg2->GetData() == static_cast<char*>(block) + 1024);
+  stats = pool.getStats();
+  BOOST_CHECK_EQUAL(stats.carved, 2);
+  BOOST_CHECK_EQUAL(stats.carvedBytes, 3072);
+
+  // the region has no room left for a 4 kB block: standard allocation
+  auto msg3 = pool.createMessage("out", 0, 3000);
+  BOOST_REQUIRE(msg3);
+  BOOST_CHECK_EQUAL(msg3->GetSize(), 3000);
+  stats = pool.getStats();
+  BOOST_CHECK_EQUAL(stats.requests, 4);
+  BOOST_CHECK_EQUAL(stats.fallbacks, 1);
+  BOOST_CHECK_EQUAL(stats.carved, 2);
+
+  // larger than the biggest class: standard allocation, not counted as poolable request
+  auto msg4 = pool.createMessage("out", 0, (size_t(1) << MessagePool::MaxSizeClassLog2) + 1);
+  BOOST_REQUIRE(msg4);
+  BOOST_CHECK_EQUAL(msg4->GetSize(), (size_t(1) << MessagePool::MaxSizeClassLog2) + 1);
+  stats = pool.getStats();
+  BOOST_CHECK_EQUAL(stats.requests, 4);
+  BOOST_CHECK_EQUAL(stats.fallbacks, 1);
+
+  // the fallback messages do not go back to the pool
+  msg.reset();
+  msg2.reset();
+  msg3.reset();
+  msg4.reset();
+  BOOST_REQUIRE(waitForFreeBytes(pool, 3072));
+  stats = pool.getStats();
+  BOOST_CHECK_CLOSE(stats.internalFragmentation(), 1.f - float(1000 + 700 + 2048) / float(1024 + 1024 + 2048), 1e-3);
+  BOOST_CHECK_CLOSE(stats.idleFraction(), 1.f, 1e-3);
+}
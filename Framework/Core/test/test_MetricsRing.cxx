@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework MetricsRing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/MetricsRing.h"
+#include "Framework/DeviceMetricsHelper.h"
+
+#include <unistd.h>
+#include <vector>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestPushDrain)
+{
+  std::vector<char> memory(MetricsRing::memorySize(4));
+  MetricsRing ring(memory.data(), 4, true);
+  BOOST_REQUIRE(ring.valid());
+
+  BOOST_CHECK(ring.push("a", MetricType::Int, 1, 0, 0, 10));
+  BOOST_CHECK(ring.push("b", MetricType::Float, 0, 2.5, 0, 11));
+  BOOST_CHECK(ring.push("c", MetricType::Uint64, 0, 0, 1ull << 40, 12));
+  BOOST_CHECK(ring.push("d", MetricType::Int, 4, 0, 0, 13));
+  // Full: the caller falls back to the text metrics
+  BOOST_CHECK(ring.push("e", MetricType::Int, 5, 0, 0, 14) == false);
+  BOOST_CHECK_EQUAL(ring.overflows(), 1);
+  // Strings are not supported
+  BOOST_CHECK(ring.push("f", MetricType::String, 0, 0, 0, 15) == false);
+
+  std::vector<std::string> names;
+  auto consumed = ring.drain([&names](MetricRecord const& record) {
+    names.emplace_back(record.name, record.nameSize);
+  });
+  BOOST_CHECK_EQUAL(consumed, 4);
+  BOOST_CHECK((names == std::vector<std::string>{"a", "b", "c", "d"}));
+  BOOST_CHECK_EQUAL(ring.drain([](MetricRecord const&) {}), 0);
+
+  // Wrap around
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(ring.push("g", MetricType::Int, i, 0, 0, 20 + i));
+    int value = -1;
+    ring.drain([&value](MetricRecord const& record) { value = record.intValue; });
+    BOOST_CHECK_EQUAL(value, i);
+  }
+
+  std::string longName(MetricRecord::MAX_NAME_SIZE + 1, 'x');
+  BOOST_CHECK(ring.push(longName, MetricType::Int, 1, 0, 0, 10) == false);
+}
+
+BOOST_AUTO_TEST_CASE(TestCaughtUp)
+{
+  std::vector<char> memory(MetricsRing::memorySize(4));
+  MetricsRing ring(memory.data(), 4, true);
+  BOOST_CHECK(ring.caughtUp());
+
+  // pending records
+  BOOST_CHECK(ring.push("a", MetricType::Int, 1, 0, 0, 10));
+  BOOST_CHECK(ring.caughtUp() == false);
+  ring.drain([](MetricRecord const&) {});
+  BOOST_CHECK(ring.caughtUp());
+
+  // pending text metrics, e.g. after an overflow
+  ring.textMetricSent();
+  ring.textMetricSent();
+  BOOST_CHECK(ring.caughtUp() == false);
+  ring.textMetricProcessed();
+  BOOST_CHECK(ring.caughtUp() == false);
+  ring.textMetricProcessed();
+  BOOST_CHECK(ring.caughtUp());
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessRecords)
+{
+  std::vector<char> memory(MetricsRing::memorySize(16));
+  MetricsRing ring(memory.data(), 16, true);
+  ring.push("int-metric", MetricType::Int, 3, 0, 0, 1000);
+  ring.push("float-metric", MetricType::Float, 0, 0.5, 0, 1001);
+  ring.push("int-metric", MetricType::Int, 7, 0, 0, 1002);
+
+  DeviceMetricsInfo info;
+  ParsedMetricMatch match;
+  ring.drain([&info, &match](MetricRecord const& record) {
+    BOOST_REQUIRE(MetricsRing::toParsedMetric(record, match));
+    BOOST_CHECK(DeviceMetricsHelper::processMetric(match, info));
+  });
+  BOOST_REQUIRE_EQUAL(info.metrics.size(), 2);
+  auto intIdx = DeviceMetricsHelper::metricIdxByName("int-metric", info);
+  BOOST_REQUIRE(intIdx < info.metrics.size());
+  auto& intMetric = info.metrics[intIdx];
+  BOOST_CHECK(intMetric.type == MetricType::Int);
+  BOOST_CHECK_EQUAL(intMetric.filledMetrics, 2);
+  BOOST_CHECK_EQUAL(info.intMetrics[intMetric.storeIdx][1], 7);
+  BOOST_CHECK_EQUAL(info.timestamps[intIdx][1], 1002);
+  auto floatIdx = DeviceMetricsHelper::metricIdxByName("float-metric", info);
+  BOOST_REQUIRE(floatIdx < info.metrics.size());
+  BOOST_CHECK_EQUAL(info.floatMetrics[info.metrics[floatIdx].storeIdx][0], 0.5);
+
+  // A corrupted record is rejected
+  MetricRecord bad;
+  bad.nameSize = MetricRecord::MAX_NAME_SIZE + 1;
+  BOOST_CHECK(MetricsRing::toParsedMetric(bad, match) == false);
+  bad.nameSize = 1;
+  bad.type = static_cast<uint8_t>(MetricType::String);
+  BOOST_CHECK(MetricsRing::toParsedMetric(bad, match) == false);
+}
+
+BOOST_AUTO_TEST_CASE(TestSharedMemory)
+{
+  auto name = MetricsRing::segmentName(getpid(), "test-metrics-ring");
+  auto owner = MetricsRing::create(name, 100);
+  BOOST_REQUIRE(owner != nullptr);
+  BOOST_CHECK_EQUAL(owner->capacity(), 128);
+  auto device = MetricsRing::attach(name);
+  BOOST_REQUIRE(device != nullptr);
+  // the name is gone once attached
+  BOOST_CHECK(MetricsRing::attach(name) == nullptr);
+
+  BOOST_CHECK(device->push("shared", MetricType::Int, 42, 0, 0, 1));
+  int value = 0;
+  BOOST_CHECK_EQUAL(owner->drain([&value](MetricRecord const& record) { value = record.intValue; }), 1);
+  BOOST_CHECK_EQUAL(value, 42);
+}
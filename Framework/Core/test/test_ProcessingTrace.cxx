@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework ProcessingTrace
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/ProcessingTrace.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestRingBuffer)
+{
+  TraceRingBuffer buffer(2, 0);
+  std::vector<TraceSpan> spans;
+  buffer.collect(spans);
+  BOOST_CHECK(spans.empty());
+
+  for (uint64_t i = 0; i < 6; ++i) {
+    buffer.push(TraceSpan{i, i + 1, i, TraceStage::Processing});
+  }
+  buffer.collect(spans);
+  // only the last 4 spans are kept, oldest first
+  BOOST_REQUIRE_EQUAL(spans.size(), 4);
+  for (size_t i = 0; i < spans.size(); ++i) {
+    BOOST_CHECK_EQUAL(spans[i].timeslice, i + 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDisabled)
+{
+  ProcessingTrace trace("", "test");
+  BOOST_CHECK(trace.enabled() == false);
+  {
+    TraceScope scope(trace, TraceStage::Processing, 1);
+  }
+  std::ostringstream out;
+  trace.exportTrace(out);
+  BOOST_CHECK(out.str().find("\"processing\"") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(TestExport)
+{
+  ProcessingTrace trace("unused.json", "test-device", 4);
+  BOOST_CHECK(trace.enabled());
+  {
+    TraceScope scope(trace, TraceStage::Relay, 10);
+  }
+  std::thread worker([&trace]() {
+    TraceScope scope(trace, TraceStage::CCDBFetch, 0);
+    scope.setTimeslice(11);
+  });
+  worker.join();
+
+  std::ostringstream out;
+  trace.exportTrace(out);
+  auto json = out.str();
+  BOOST_CHECK(json.find("\"traceEvents\"") != std::string::npos);
+  BOOST_CHECK(json.find("\"test-device\"") != std::string::npos);
+  BOOST_CHECK(json.find("\"name\":\"relay\"") != std::string::npos);
+  BOOST_CHECK(json.find("\"name\":\"ccdb-fetch\"") != std::string::npos);
+  BOOST_CHECK(json.find("\"timeslice\":10") != std::string::npos);
+  BOOST_CHECK(json.find("\"timeslice\":11") != std::string::npos);
+  // one track per recording thread
+  BOOST_CHECK(json.find("\"tid\":1") != std::string::npos);
+}
@@ -0,0 +1,67 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/runDataProcessing.h"
+#include "Framework/AnalysisTask.h"
+#include "Framework/HistogramRegistry.h"
+
+#include <chrono>
+
+using namespace o2;
+using namespace o2::framework;
+
+// Fills the same histograms per track with and without the HistogramRegistry fill buffer
+// and reports the time spent in both cases.
+struct HistogramRegistryFillBenchmark {
+  Configurable<int> nRepetitions{"nRepetitions", 10, "number of times every track is filled"};
+  Configurable<int> bufferSize{"bufferSize", 4096, "number of entries buffered per histogram"};
+
+  HistogramRegistry direct{"direct", {{"phi", "#phi", {HistType::kTH1F, {{100, 0., 2. * M_PI}}}}, //
+                                      {"etaPhi", "#eta vs #phi", {HistType::kTH2F, {{100, -2., 2.}, {100, 0., 2. * M_PI}}}}}};
+  HistogramRegistry buffered{"buffered", {{"phi", "#phi", {HistType::kTH1F, {{100, 0., 2. * M_PI}}}}, //
+                                          {"etaPhi", "#eta vs #phi", {HistType::kTH2F, {{100, -2., 2.}, {100, 0., 2. * M_PI}}}}}};
+
+  double mTimeDirect = 0.;
+  double mTimeBuffered = 0.;
+  uint64_t mNFills = 0;
+
+  void init(InitContext&)
+  {
+    buffered.enableFillBuffering(bufferSize);
+  }
+
+  void process(aod::Tracks const& tracks)
+  {
+    auto fillAll = [&](HistogramRegistry& registry) {
+      auto start = std::chrono::high_resolution_clock::now();
+      for (int i = 0; i < nRepetitions; ++i) {
+        for (auto& track : tracks) {
+          auto phi = asin(track.snp()) + track.alpha() + M_PI;
+          auto eta = log(tan(0.25 * M_PI - 0.5 * atan(track.tgl())));
+          registry.fill(HIST("phi"), phi);
+          registry.fill(HIST("etaPhi"), eta, phi);
+        }
+      }
+      registry.flush();
+      return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    };
+    mTimeDirect += fillAll(direct);
+    mTimeBuffered += fillAll(buffered);
+    mNFills += 2 * nRepetitions * tracks.size();
+    LOGF(info, "%llu fills: direct %.3f s (%.1f MHz), buffered %.3f s (%.1f MHz)", mNFills,
+         mTimeDirect, mNFills / mTimeDirect * 1e-6, mTimeBuffered, mNFills / mTimeBuffered * 1e-6);
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{
+    adaptAnalysisTask<HistogramRegistryFillBenchmark>(cfgc, TaskName{"histogram-registry-fill-benchmark"})};
+}
@@ -46,6 +46,7 @@
 #else
 static inline int omp_get_thread_num() { return 0; }
 static inline int omp_get_max_threads() { return 1; }
+static inline int omp_in_parallel() { return 0; }
 #endif
 
 using namespace GPUCA_NAMESPACE::gpu;
@@ -73,6 +74,28 @@ int GPUReconstructionCPUBackend::runKernelBackend(krnlSetup& _xyz, const Args&..
   }
   unsigned int num = y.num == 0 || y.num == -1 ? 1 : y.num;
   for (unsigned int k = 0; k < num; k++) {
+    if (mProcessingSettings.ompKernels == 3 && x.nBlocks > 1) {
+      // Blocks are OpenMP tasks. Inside runParallelOuterLoop, they are picked up by the threads of the team which are done with their sectors.
+      // The tasks are tied: a thread waiting at the end of this taskloop only runs blocks of this kernel, not those of the other sectors.
+      auto runBlock = [&](unsigned int iB) {
+        typename T::GPUSharedMemory smem;
+        T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+      };
+      if (omp_in_parallel()) {
+        GPUCA_OPENMP(taskloop grainsize(1))
+        for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
+          runBlock(iB);
+        }
+      } else {
+        GPUCA_OPENMP(parallel num_threads(mProcessingSettings.ompThreads))
+        GPUCA_OPENMP(single)
+        GPUCA_OPENMP(taskloop grainsize(1))
+        for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
+          runBlock(iB);
+        }
+      }
+      continue;
+    }
     int ompThreads = mProcessingSettings.ompKernels ? (mProcessingSettings.ompKernels == 2 ? ((mProcessingSettings.ompThreads + mNestedLoopOmpFactor - 1) / mNestedLoopOmpFactor) : mProcessingSettings.ompThreads) : 1;
     if (ompThreads > 1) {
       if (mProcessingSettings.debugLevel >= 5) {
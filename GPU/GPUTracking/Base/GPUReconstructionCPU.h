@@ -153,6 +153,8 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
 
   void SetNestedLoopOmpFactor(unsigned int f) { mNestedLoopOmpFactor = f; }
   unsigned int SetAndGetNestedLoopOmpFactor(bool condition, unsigned int max);
+  template <class T>
+  void runParallelOuterLoop(bool doGPU, unsigned int n, T&& f);
 
  protected:
   struct GPUProcessorProcessors : public GPUProcessor {
@@ -243,6 +245,9 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   timerMeta* insertTimer(unsigned int id, std::string&& name, int J, int num, int type, RecoStep step);
   int getOMPThreadNum();
   int getOMPMaxThreads();
+  // In a nested loop, only thread 0 times the kernels. With tasks (ompKernels == 3) a thread can run blocks of another iteration
+  // while waiting for the blocks of its own kernel, so there is no consistent per-thread kernel timing.
+  bool timeKernelOnThisThread() { return mNestedLoopOmpFactor < 2 || (mProcessingSettings.ompKernels != 3 && getOMPThreadNum() == 0); }
 };
 
 template <class S, int I, int J, typename... Args>
@@ -282,7 +287,7 @@ inline int GPUReconstructionCPU::runKernel(const krnlExec& x, const krnlRunRange
   }
   if (mProcessingSettings.debugLevel >= 1) {
     t = &getKernelTimer<S, I, J>(myStep, !IsGPU() || cpuFallback ? getOMPThreadNum() : x.stream);
-    if ((!mProcessingSettings.deviceTimers || !IsGPU() || cpuFallback) && (mNestedLoopOmpFactor < 2 || getOMPThreadNum() == 0)) {
+    if ((!mProcessingSettings.deviceTimers || !IsGPU() || cpuFallback) && timeKernelOnThisThread()) {
       t->Start();
     }
   }
@@ -303,7 +308,7 @@ inline int GPUReconstructionCPU::runKernel(const krnlExec& x, const krnlRunRange
     if (t) {
       if (!(!mProcessingSettings.deviceTimers || !IsGPU() || cpuFallback)) {
         t->AddTime(setup.t);
-      } else if (mNestedLoopOmpFactor < 2 || getOMPThreadNum() == 0) {
+      } else if (timeKernelOnThisThread()) {
         t->Stop();
       }
     }
@@ -323,6 +328,31 @@ inline int GPUReconstructionCPU::runKernel(const krnlExec& x, const krnlRunRange
 #include "GPUReconstructionKernels.h"
 #undef GPUCA_KRNL
 
+template <class T>
+inline void GPUReconstructionCPU::runParallelOuterLoop(bool doGPU, unsigned int n, T&& f)
+{
+  // Runs f(i) for i in [0, n[, e.g. the processing chains of the TPC sectors.
+  // With ompKernels == 3 the iterations are OpenMP tasks, as well as the blocks of the kernels they run (see runKernelBackend):
+  // a thread which is done with its own iterations picks up the blocks of the kernels of the others instead of waiting at a barrier.
+  // Being tied tasks, a thread suspended in an iteration only runs blocks of that iteration. Untied tasks could resume on another thread,
+  // while the kernel timers are selected with the OMP thread number when the kernel starts.
+  if (!doGPU && mProcessingSettings.ompKernels == 3) {
+    SetNestedLoopOmpFactor(mProcessingSettings.ompThreads);
+    GPUCA_OPENMP(parallel num_threads(mProcessingSettings.ompThreads))
+    GPUCA_OPENMP(single)
+    GPUCA_OPENMP(taskloop grainsize(1))
+    for (unsigned int i = 0; i < n; i++) {
+      f(i);
+    }
+  } else {
+    GPUCA_OPENMP(parallel for if(!doGPU && mProcessingSettings.ompKernels != 1) num_threads(SetAndGetNestedLoopOmpFactor(!doGPU, n)))
+    for (unsigned int i = 0; i < n; i++) {
+      f(i);
+    }
+  }
+  SetNestedLoopOmpFactor(1);
+}
+
 template <class T>
 inline void GPUReconstructionCPU::AddGPUEvents(T*& events)
 {
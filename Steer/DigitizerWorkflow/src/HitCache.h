@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef STEER_DIGITIZERWORKFLOW_HITCACHE_H_
+#define STEER_DIGITIZERWORKFLOW_HITCACHE_H_
+
+#include "SimulationDataFormat/DigitizationContext.h"
+#include <gsl/span>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class TChain;
+
+namespace o2
+{
+namespace steer
+{
+
+/// Hits of all the event parts of the collisions of a timeframe, read up-front
+/// and kept in memory. Each (source, entry) is read only once, even when it
+/// contributes to several collisions (e.g. a background event reused for
+/// embedding), and the entries are read in file order. Once filled, the cache
+/// is only read, so that collisions can be digitized concurrently.
+template <typename Hit>
+class HitCache
+{
+ public:
+  void fill(DigitizationContext const& context, std::vector<TChain*> const& chains, const char* brname,
+            std::vector<std::vector<EventPart>> const& eventParts)
+  {
+    clear();
+    std::vector<uint64_t> keys;
+    for (auto& parts : eventParts) {
+      for (auto& part : parts) {
+        keys.push_back(key(part.sourceID, part.entryID));
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    mHits.reserve(keys.size());
+    for (auto k : keys) {
+      context.retrieveHits(chains, brname, int(k >> 32), int(k & 0xffffffff), &mHits[k]);
+    }
+  }
+
+  /// hits of a given event part, empty if it was not requested in fill()
+  gsl::span<const Hit> get(int sourceID, int entryID) const
+  {
+    auto it = mHits.find(key(sourceID, entryID));
+    return it == mHits.end() ? gsl::span<const Hit>() : gsl::span<const Hit>(it->second);
+  }
+
+  size_t getNEntries() const { return mHits.size(); }
+
+  void clear() { mHits.clear(); }
+
+ private:
+  static uint64_t key(int sourceID, int entryID) { return (uint64_t(uint32_t(sourceID)) << 32) | uint32_t(entryID); }
+
+  std::unordered_map<uint64_t, std::vector<Hit>> mHits;
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
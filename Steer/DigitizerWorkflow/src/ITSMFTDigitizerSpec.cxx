@@ -279,6 +279,7 @@ class ITSDPLDigitizerTask : public ITSMFTDPLDigitizerTask
     digipar.setNoisePerPixel(dopt.noisePerPixel);     // noise level
     digipar.setTimeOffset(dopt.timeOffset);
     digipar.setNSimSteps(dopt.nSimSteps);
+    mDigitizer.setNThreads(dopt.nThreads);
     digipar.setIBVbb(dopt.IBVbb);
     digipar.setOBVbb(dopt.OBVbb);
 
@@ -328,6 +329,7 @@ class MFTDPLDigitizerTask : public ITSMFTDPLDigitizerTask
     digipar.setNoisePerPixel(dopt.noisePerPixel);     // noise level
     digipar.setTimeOffset(dopt.timeOffset);
     digipar.setNSimSteps(dopt.nSimSteps);
+    mDigitizer.setNThreads(dopt.nThreads);
     digipar.setVbb(dopt.Vbb);
 
     // optional noise masks file path. FIXME to be removed once switch to CCDBFetcher
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "MCHDigitizerSpec.h"
+#include "HitCache.h"
 
 #include "DataFormatsMCH/Digit.h"
 #include "DataFormatsMCH/ROFRecord.h"
@@ -29,6 +30,8 @@
 #include <SimulationDataFormat/MCCompLabel.h>
 #include <SimulationDataFormat/MCTruthContainer.h>
 #include <TGeoManager.h>
+#include <TRandom3.h>
+#include <algorithm>
 #include <map>
 
 using namespace o2::framework;
@@ -47,7 +50,21 @@ class MCHDPLDigitizerTask : public o2::base::BaseDPLDigitizer
   void initDigitizerTask(framework::InitContext& ic) override
   {
     auto transformation = o2::mch::geo::transformationFromTGeoManager(*gGeoManager);
-    mDigitizer = std::make_unique<Digitizer>(transformation);
+    int nThreads = 1;
+#ifdef WITH_OPENMP
+    nThreads = std::max(1, DigitizerParam::Instance().nThreads);
+#endif
+    // the detection elements of a digitizer accumulate the charges of the collision
+    // being processed, so each thread needs its own instance
+    for (int i = 0; i < nThreads; i++) {
+      mDigitizers.emplace_back(std::make_unique<Digitizer>(transformation));
+      // gRandom cannot be shared by the threads
+      if (nThreads > 1) {
+        mRandoms.emplace_back(std::make_unique<TRandom3>());
+        mDigitizers.back()->setRandom(mRandoms.back().get());
+      }
+    }
+    LOGP(info, "MCH digitization with {} thread(s)", nThreads);
   }
 
   void logStatus(gsl::span<Digit> digits, gsl::span<ROFRecord> rofs,
@@ -78,27 +95,66 @@ class MCHDPLDigitizerTask : public o2::base::BaseDPLDigitizer
     context->initSimChains(o2::detectors::DetID::MCH, mSimChains);
     const auto& eventRecords = context->getEventRecords();
     const auto& eventParts = context->getEventParts();
+
+    // all the hits are read once, then the groups of collisions are digitized independently
+    mHitCache.fill(*context, mSimChains, "MCHHit", eventParts);
+    auto mchRecords = groupIR(eventRecords);
+    std::vector<std::pair<o2::InteractionRecord, std::vector<int>>> groups(mchRecords.begin(), mchRecords.end());
+
+    // each thread digitizes a contiguous range of groups into its own containers,
+    // which are then concatenated in the time order
+    const int nChunks = std::max(1, std::min(int(mDigitizers.size()), int(groups.size())));
+    // with several threads, the generator is reseeded for each group, such that the
+    // result does not depend on the number of threads
+    const uint32_t baseSeed = mRandoms.empty() ? 0 : gRandom->Integer(0xffffffff);
+    std::vector<std::vector<o2::mch::Digit>> chunkDigits(nChunks);
+    std::vector<std::vector<o2::mch::ROFRecord>> chunkRofs(nChunks);
+    std::vector<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> chunkLabels(nChunks);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nChunks)
+#endif
+    for (int ic = 0; ic < nChunks; ic++) {
+      auto& digitizer = *mDigitizers[ic];
+      auto& digits = chunkDigits[ic];
+      auto& rofs = chunkRofs[ic];
+      auto& labels = chunkLabels[ic];
+      size_t firstIdx = 0;
+      for (size_t ig = groups.size() * ic / nChunks; ig < groups.size() * (ic + 1) / nChunks; ig++) {
+        const auto& mchIR = groups[ig].first;
+        if (!mRandoms.empty()) {
+          mRandoms[ic]->SetSeed(std::max(1u, uint32_t(baseSeed + ig)));
+        }
+        digitizer.startCollision(mchIR);
+        for (auto collisionIndex : groups[ig].second) {
+          for (const auto& part : eventParts[collisionIndex]) {
+            digitizer.processHits(mHitCache.get(part.sourceID, part.entryID), part.entryID, part.sourceID);
+          }
+        }
+        digitizer.addNoise(noiseProba);
+        digitizer.extractDigitsAndLabels(digits, labels);
+        auto nEntries = digits.size() - firstIdx;
+        rofs.emplace_back(ROFRecord(mchIR, firstIdx, nEntries));
+        firstIdx = digits.size();
+      }
+    }
+    mHitCache.clear();
+
     std::vector<o2::mch::Digit> digits;
     std::vector<o2::mch::ROFRecord> rofs;
     o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
-    size_t firstIdx = 0;
-    auto mchRecords = groupIR(eventRecords);
-    for (auto mrec : mchRecords) {
-      auto collisionIndices = mrec.second;
-      const auto& mchIR = mrec.first;
-      mDigitizer->startCollision(mchIR);
-      for (auto collisionIndex : collisionIndices) {
-        for (const auto& part : eventParts[collisionIndex]) {
-          std::vector<o2::mch::Hit> hits;
-          context->retrieveHits(mSimChains, "MCHHit", part.sourceID, part.entryID, &hits);
-          mDigitizer->processHits(hits, part.entryID, part.sourceID);
+    if (nChunks == 1) {
+      digits = std::move(chunkDigits[0]);
+      rofs = std::move(chunkRofs[0]);
+      labels = std::move(chunkLabels[0]);
+    } else {
+      for (int ic = 0; ic < nChunks; ic++) {
+        size_t offset = digits.size();
+        for (const auto& rof : chunkRofs[ic]) {
+          rofs.emplace_back(ROFRecord(rof.getBCData(), rof.getFirstIdx() + offset, rof.getNEntries()));
         }
+        digits.insert(digits.end(), chunkDigits[ic].begin(), chunkDigits[ic].end());
+        labels.mergeAtBack(chunkLabels[ic]);
       }
-      mDigitizer->addNoise(noiseProba);
-      mDigitizer->extractDigitsAndLabels(digits, labels);
-      auto nEntries = digits.size() - firstIdx;
-      rofs.emplace_back(ROFRecord(mchIR, firstIdx, nEntries));
-      firstIdx = digits.size();
     }
     pc.outputs().snapshot(Output{"MCH", "DIGITS", 0, Lifetime::Timeframe}, digits);
     pc.outputs().snapshot(Output{"MCH", "DIGITROFS", 0, Lifetime::Timeframe}, rofs);
@@ -116,8 +172,10 @@ class MCHDPLDigitizerTask : public o2::base::BaseDPLDigitizer
   }
 
  private:
-  std::unique_ptr<Digitizer> mDigitizer;
+  std::vector<std::unique_ptr<Digitizer>> mDigitizers; // one per thread
+  std::vector<std::unique_ptr<TRandom3>> mRandoms;     // one per thread, when running with several threads
   std::vector<TChain*> mSimChains;
+  o2::steer::HitCache<o2::mch::Hit> mHitCache;
 };
 
 o2::framework::DataProcessorSpec getMCHDigitizerSpec(int channel, bool mctruth)
@@ -14,6 +14,7 @@
 
 #include "SimulationDataFormat/DigitizationContext.h"
 #include "SimulationDataFormat/MCTrack.h"
+#include "SimulationDataFormat/MCTrackFlatFile.h"
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
@@ -70,6 +71,7 @@ class MCKinematicsReader
 
   /// query an MC track given source, event, track IDs
   /// returns nullptr if no track was found
+  /// (served from the memory-mapped flat kinematics in O(1) when available)
   MCTrack const* getTrack(int source, int event, int track) const;
 
   /// query an MC track given event, track IDs
@@ -107,6 +109,9 @@ class MCKinematicsReader
   /// Get number of events
   size_t getNEvents(int source) const;
 
+  /// whether the tracks of a source are served from the flat kinematics file
+  bool hasFlatKinematics(int source) const { return mFlatTracks[source].isOpen(); }
+
   DigitizationContext const* getDigitizationContext() const
   {
     return mDigitizationContext;
@@ -118,6 +123,7 @@ class MCKinematicsReader
   void loadHeadersForSource(int source) const;
   void loadTrackRefsForSource(int source) const;
   void initIndexedTrackRefs(std::vector<o2::TrackReference>& refs, o2::dataformats::MCTruthContainer<o2::TrackReference>& indexedrefs) const;
+  void initFlatKinematics(std::vector<std::string> const& prefixes);
 
   DigitizationContext const* mDigitizationContext = nullptr;
 
@@ -128,6 +134,7 @@ class MCKinematicsReader
   mutable std::vector<std::vector<std::vector<o2::MCTrack>*>> mTracks;                                       // the in-memory track container
   mutable std::vector<std::vector<o2::dataformats::MCEventHeader>> mHeaders;                                 // the in-memory header container
   mutable std::vector<std::vector<o2::dataformats::MCTruthContainer<o2::TrackReference>>> mIndexedTrackRefs; // the in-memory track ref container
+  std::vector<o2::dataformats::MCTrackFlatFileReader> mFlatTracks;                                           //! the memory-mapped flat kinematics (when available)
 
   bool mInitialized = false; // whether initialized
 };
@@ -142,6 +149,9 @@ inline MCTrack const* MCKinematicsReader::getTrack(o2::MCCompLabel const& label)
 
 inline MCTrack const* MCKinematicsReader::getTrack(int source, int event, int track) const
 {
+  if (mFlatTracks[source].isOpen()) {
+    return mFlatTracks[source].getTrack(event, track);
+  }
   return &getTracks(source, event)[track];
 }
 
@@ -202,6 +212,9 @@ inline size_t MCKinematicsReader::getNSources() const
 
 inline size_t MCKinematicsReader::getNEvents(int source) const
 {
+  if (mFlatTracks[source].isOpen()) {
+    return mFlatTracks[source].getNEvents();
+  }
   if (mTracks[source].size() == 0) {
     initTracksForSource(source);
   }
@@ -23,6 +23,8 @@
 #include "Rtypes.h" // for Int_t, Bool_t, Double_t, etc
 #include <TVirtualMC.h>
 #include "SimConfig/SimParams.h"
+#include <string>
+#include <vector>
 
 namespace o2
 {
@@ -62,6 +64,22 @@ class O2MCApplicationBase : public FairMCApplication
   std::map<int, std::string> mSensitiveVolumes{}; // collection of all sensitive volumes with
                                                   // keeping track of volumeIds and volume names
 
+  // step profiling (SimCutParams.stepProfiling): steps and stepping time accounted to the module
+  // owning the current volume, found with a flat volume ID -> module lookup table filled at init
+  struct StepStats {
+    unsigned long long nSteps = 0;
+    double time = 0.; // in s
+  };
+  bool mStepProfiling = false;              //!
+  std::vector<int> mVolIdToModIndex{};      //! index in mModStepStats of each volume ID
+  std::vector<std::string> mModStepNames{}; //! module of each entry of mModStepStats, the last one is for unknown volumes
+  std::vector<StepStats> mModStepStats{};   //!
+
+  /// the actual stepping, without profiling
+  void doStepping();
+  void initStepProfiling();
+  void reportStepProfiling();
+
   /// some common parts of finishEvent
   void finishEventCommon();
 
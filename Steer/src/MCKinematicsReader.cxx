@@ -50,6 +50,26 @@ void MCKinematicsReader::initIndexedTrackRefs(std::vector<o2::TrackReference>& r
   }
 }
 
+void MCKinematicsReader::initFlatKinematics(std::vector<std::string> const& prefixes)
+{
+  mFlatTracks.resize(prefixes.size());
+  for (int source = 0; source < prefixes.size(); ++source) {
+    auto& flat = mFlatTracks[source];
+    if (!flat.open(o2::base::NameConf::getMCKinematicsFlatFileName(prefixes[source]))) {
+      continue;
+    }
+    // only use the flat file if it describes the same production as the kinematics tree
+    auto chain = mInputChains[source];
+    auto br = chain ? chain->GetBranch("MCTrack") : nullptr;
+    if (!br || size_t(br->GetEntries()) != flat.getNEvents()) {
+      LOG(warn) << "Flat kinematics for " << prefixes[source] << " does not match the kinematics tree, ignoring it";
+      flat.close();
+      continue;
+    }
+    LOG(info) << "Using flat kinematics for " << prefixes[source] << " with " << flat.getNEvents() << " events";
+  }
+}
+
 void MCKinematicsReader::initTracksForSource(int source) const
 {
   auto chain = mInputChains[source];
@@ -153,6 +173,7 @@ bool MCKinematicsReader::initFromDigitContext(std::string_view name)
   mTracks.resize(mInputChains.size());
   mHeaders.resize(mInputChains.size());
   mIndexedTrackRefs.resize(mInputChains.size());
+  initFlatKinematics(mDigitizationContext->getSimPrefixes());
 
   // actual loading will be done only if someone asks
   // the first time for a particular source ...
@@ -171,6 +192,7 @@ bool MCKinematicsReader::initFromKinematics(std::string_view name)
   mTracks.resize(1);
   mHeaders.resize(1);
   mIndexedTrackRefs.resize(1);
+  initFlatKinematics({std::string(name)});
   mInitialized = true;
 
   return true;
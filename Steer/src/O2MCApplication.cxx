@@ -29,6 +29,9 @@
 #include <FairVolume.h>
 #include <CommonUtils/NameConf.h>
 #include "SimConfig/SimUserDecay.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
 
 namespace o2
 {
@@ -51,6 +54,22 @@ void TypedVectorAttach(const char* name, FairMQChannel& channel, FairMQParts& pa
 }
 
 void O2MCApplicationBase::Stepping()
+{
+  if (!mStepProfiling) {
+    doStepping();
+    return;
+  }
+  int copyNo;
+  int volId = fMC->CurrentVolID(copyNo);
+  auto start = std::chrono::steady_clock::now();
+  doStepping();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  auto& stats = mModStepStats[(volId >= 0 && volId < int(mVolIdToModIndex.size())) ? mVolIdToModIndex[volId] : mModStepStats.size() - 1];
+  stats.nSteps++;
+  stats.time += elapsed.count();
+}
+
+void O2MCApplicationBase::doStepping()
 {
   mStepCounter++;
   if (mCutParams.stepFiltering) {
@@ -139,6 +158,68 @@ void O2MCApplicationBase::InitGeometry()
   for (auto e : mSensitiveVolumes) {
     sensvolfile << e.first << ":" << e.second << "\n";
   }
+
+  mStepProfiling = mCutParams.stepProfiling;
+  if (mStepProfiling) {
+    initStepProfiling();
+  }
+}
+
+void O2MCApplicationBase::initStepProfiling()
+{
+  // one entry per module, plus one for the volumes not belonging to any module
+  std::map<int, int> modIdToIndex;
+  mModStepNames.clear();
+  for (auto& e : mModIdToName) {
+    modIdToIndex[e.first] = mModStepNames.size();
+    mModStepNames.push_back(e.second);
+  }
+  int unknown = mModStepNames.size();
+  mModStepNames.push_back("unknown");
+  mModStepStats.assign(mModStepNames.size(), StepStats{});
+
+  // fModVolMap maps the volume numbers to module IDs, flatten it such that the stepping does a single array access
+  mVolIdToModIndex.clear();
+  auto vollist = gGeoManager->GetListOfVolumes();
+  for (int i = 0; i < vollist->GetEntries(); ++i) {
+    auto vol = static_cast<TGeoVolume*>(vollist->At(i));
+    int volId = vol->GetNumber();
+    if (volId < 0) {
+      continue;
+    }
+    if (volId >= int(mVolIdToModIndex.size())) {
+      mVolIdToModIndex.resize(volId + 1, unknown);
+    }
+    auto iter = fModVolMap.find(volId);
+    if (iter != fModVolMap.end()) {
+      auto mod = modIdToIndex.find(iter->second);
+      if (mod != modIdToIndex.end()) {
+        mVolIdToModIndex[volId] = mod->second;
+      }
+    }
+  }
+  LOG(info) << "Step profiling enabled for " << mModStepNames.size() - 1 << " modules and " << mVolIdToModIndex.size() << " volumes";
+}
+
+void O2MCApplicationBase::reportStepProfiling()
+{
+  std::vector<int> order(mModStepStats.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](int a, int b) { return mModStepStats[a].time > mModStepStats[b].time; });
+  double totalTime = 0.;
+  for (auto& stats : mModStepStats) {
+    totalTime += stats.time;
+  }
+  LOG(info) << "Stepping time per module for this event/chunk: " << totalTime << " s";
+  for (auto i : order) {
+    auto& stats = mModStepStats[i];
+    if (stats.nSteps == 0) {
+      continue;
+    }
+    LOGP(info, "  {:10s} steps {:12d} time {:10.4f} s ({:5.1f}%) per step {:8.1f} ns", mModStepNames[i], stats.nSteps, stats.time,
+         totalTime > 0 ? 100. * stats.time / totalTime : 0., 1e9 * stats.time / stats.nSteps);
+    stats = StepStats{};
+  }
 }
 
 bool O2MCApplicationBase::MisalignGeometry()
@@ -173,6 +254,9 @@ bool O2MCApplicationBase::MisalignGeometry()
 void O2MCApplicationBase::finishEventCommon()
 {
   LOG(info) << "This event/chunk did " << mStepCounter << " steps";
+  if (mStepProfiling) {
+    reportStepProfiling();
+  }
 
   auto header = static_cast<o2::dataformats::MCEventHeader*>(fMCEventHeader);
   header->getMCEventStats().setNSteps(mStepCounter);
@@ -0,0 +1,85 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchMCKinematicsReader.cxx
+/// \brief Benchmark of random MC label lookups, from the kinematics tree and from the flat kinematics file
+
+#include "benchmark/benchmark.h"
+#include "Steer/MCKinematicsReader.h"
+#include "SimulationDataFormat/MCTrackFlatFile.h"
+#include "CommonUtils/NameConf.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace o2::steer;
+
+constexpr int NEvents = 100;
+constexpr int NTracksPerEvent = 5000;
+
+// the same kinematics is written for 2 prefixes, only one of them gets the flat file
+static void createKinematics()
+{
+  static bool done = false;
+  if (done) {
+    return;
+  }
+  std::mt19937 eng(42);
+  std::uniform_real_distribution<double> val(-10., 10.);
+  for (std::string prefix : {"benchkine", "benchkineflat"}) {
+    o2::dataformats::MCTrackFlatFileWriter writer;
+    if (prefix == "benchkineflat") {
+      writer.open(o2::base::NameConf::getMCKinematicsFlatFileName(prefix));
+    }
+    TFile file(o2::base::NameConf::getMCKinematicsFileName(prefix).c_str(), "RECREATE");
+    TTree tree("o2sim", "o2sim");
+    std::vector<o2::MCTrack> tracks, *tracksPtr = &tracks;
+    tree.Branch("MCTrack", &tracksPtr);
+    eng.seed(42);
+    for (int ev = 0; ev < NEvents; ev++) {
+      tracks.clear();
+      for (int i = 0; i < NTracksPerEvent; i++) {
+        tracks.emplace_back(211, i - 1, -1, -1, -1, val(eng), val(eng), val(eng), val(eng), val(eng), val(eng), 1e-9, 0);
+      }
+      tree.Fill();
+      if (writer.isOpen()) {
+        writer.addEvent(tracks);
+      }
+    }
+    writer.close();
+    tree.Write();
+  }
+  done = true;
+}
+
+// state.range(0): 0 for the kinematics tree, 1 for the flat file
+static void benchRandomLabelLookup(benchmark::State& state)
+{
+  createKinematics();
+  for (auto _ : state) {
+    // a fresh reader per iteration, such that the ROOT path pays for loading the events it touches
+    MCKinematicsReader reader(state.range(0) ? "benchkineflat" : "benchkine", MCKinematicsReader::Mode::kMCKine);
+    std::mt19937 eng(1234);
+    double sum = 0;
+    for (int i = 0; i < 100000; i++) {
+      o2::MCCompLabel label(eng() % NTracksPerEvent, eng() % NEvents, 0);
+      sum += reader.getTrack(label)->Px();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+BENCHMARK(benchRandomLabelLookup)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -21,6 +21,7 @@
 #include <FairMQDevice.h>
 #include <FairLogger.h>
 #include <SimulationDataFormat/MCEventHeader.h>
+#include <SimulationDataFormat/MCTrackFlatFile.h>
 #include <SimulationDataFormat/Stack.h>
 #include <SimulationDataFormat/PrimaryChunk.h>
 #include <DetectorsCommonDataFormats/DetID.h>
@@ -133,6 +134,7 @@ class O2HitMerger : public FairMQDevice
     if (o2::devices::O2SimDevice::querySimConfig(fChannels.at("o2sim-primserv-info").at(0))) {
       outfilename = o2::base::NameConf::getMCKinematicsFileName(o2::conf::SimConfig::Instance().getOutPrefix().c_str());
       mNExpectedEvents = o2::conf::SimConfig::Instance().getNEvents();
+      initFlatKinematics(o2::conf::SimConfig::Instance().getOutPrefix());
     }
     mAsService = o2::conf::SimConfig::Instance().asService();
 
@@ -218,6 +220,7 @@ class O2HitMerger : public FairMQDevice
     mOutFile = new TFile(outfilename.c_str(), "RECREATE");
     mOutTree = new TTree("o2sim", "o2sim");
     mOutTree->SetDirectory(mOutFile);
+    initFlatKinematics(reconfig.outputPrefix);
 
     // reinit detectorInstance files (also make sure they are closed before continuing)
     initHitFiles(reconfig.outputPrefix);
@@ -394,6 +397,8 @@ class O2HitMerger : public FairMQDevice
         if (mMergerIOThread.joinable()) {
           mMergerIOThread.join();
         }
+        // all events are in: the flat kinematics can be finalized
+        mFlatKineWriter.close();
 
         expectmore = false;
       }
@@ -495,6 +500,11 @@ class O2HitMerger : public FairMQDevice
     // to be saved as part of the MCHeader structure
     tracks_analysis_hook(*filladdr);
 
+    // the flat kinematics follows the entries of the kinematics tree
+    if (mFlatKineWriter.isOpen()) {
+      mFlatKineWriter.addEvent(*filladdr);
+    }
+
     auto targetbr = o2::base::getOrMakeBranch(target, "MCTrack", &filladdr);
     targetbr->SetAddress(&filladdr);
     targetbr->Fill();
@@ -775,8 +785,9 @@ class O2HitMerger : public FairMQDevice
   std::string mOutFileName;                    //!
 
   // structures for the final flush
-  TFile* mOutFile; //! outfile for kinematics
-  TTree* mOutTree; //! tree (kinematics) associated to mOutFile
+  TFile* mOutFile;                                        //! outfile for kinematics
+  TTree* mOutTree;                                        //! tree (kinematics) associated to mOutFile
+  o2::dataformats::MCTrackFlatFileWriter mFlatKineWriter; //! optional flat copy of the kinematics, for fast lookups
 
   template <class K, class V>
   using Hashtable = tbb::concurrent_unordered_map<K, V>;
@@ -813,8 +824,21 @@ class O2HitMerger : public FairMQDevice
   // init detector instances
   void initDetInstances();
   void initHitFiles(std::string prefix);
+  void initFlatKinematics(std::string const& prefix);
 };
 
+void O2HitMerger::initFlatKinematics(std::string const& prefix)
+{
+  auto filename = o2::base::NameConf::getMCKinematicsFlatFileName(prefix);
+  if (o2::conf::SimConfig::Instance().writeFlatKinematics()) {
+    mFlatKineWriter.open(filename);
+  } else {
+    // a flat file left over by a previous production with the same prefix would not match the new kinematics
+    std::error_code ec;
+    std::filesystem::remove(filename, ec);
+  }
+}
+
 void O2HitMerger::initHitFiles(std::string prefix)
 {
   using o2::detectors::DetID;